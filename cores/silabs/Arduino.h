@@ -70,6 +70,7 @@ extern "C" {
 #include "adc.h"
 #include "pwm.h"
 #include "silabs_additional.h"
+#include "color_conversion.h"
 
 #include "overloads.h"
 
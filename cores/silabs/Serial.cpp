@@ -28,6 +28,9 @@
 
 #include <cstdarg>
 #include "em_usart.h"
+#if defined(EUSART_PRESENT)
+#include "em_eusart.h"
+#endif // EUSART_PRESENT
 #include "sl_iostream.h"
 #include "sl_iostream_init_usart_instances.h"
 
@@ -38,18 +41,57 @@ UARTClass::UARTClass(sl_iostream_t* stream,
                      void(*baud_rate_set_fn)(uint32_t baudrate),
                      void(*init_fn)(void),
                      void(*deinit_fn)(void),
-                     void(*serial_event_fn)(void)) :
+                     void(*serial_event_fn)(void),
+                     void(*rx_idle_config_fn)(uint8_t idle_chars),
+                     bool(*rx_idle_fn)(void),
+                     bool(*low_power_init_fn)(uint32_t baudrate),
+                     bool(*rs485_hw_de_fn)(PinName de_pin, bool enable),
+                     bool(*tx_complete_fn)(void)) :
   serial_mutex(nullptr),
+  frame_callback(nullptr),
+  frame_task_handle(nullptr),
+  frame_sem(nullptr),
+  frame_buf(nullptr),
+  frame_len(0u),
+  frame_byte_count(0u),
+  frame_delimiter(-1),
+  frame_idle_chars(2u),
+  frame_line_idle(false),
+  frame_length_fn(nullptr),
+  frame_expected_len(0u),
+  frame_idle_sem(nullptr),
+  frame_dma_head(nullptr),
+  frame_quiet_periods(0u),
+  frame_idle_periods(0u),
+  frame_wake_on_data(false),
+  rs485_de_pin(PIN_NAME_NC),
+  rs485_hw_de(false),
+  rs485_tx_sem(nullptr),
+  rs485_tx_mutex(nullptr),
+  baudrate(115200u),
   initialized(true)
 {
   this->serial_mutex = xSemaphoreCreateMutexStatic(&this->serial_mutex_buf);
   configASSERT(this->serial_mutex);
+  this->frame_sem = xSemaphoreCreateBinaryStatic(&this->frame_sem_buf);
+  configASSERT(this->frame_sem);
+  this->frame_idle_sem = xSemaphoreCreateBinaryStatic(&this->frame_idle_sem_buf);
+  configASSERT(this->frame_idle_sem);
+  this->rs485_tx_sem = xSemaphoreCreateBinaryStatic(&this->rs485_tx_sem_buf);
+  configASSERT(this->rs485_tx_sem);
+  this->rs485_tx_mutex = xSemaphoreCreateMutexStatic(&this->rs485_tx_mutex_buf);
+  configASSERT(this->rs485_tx_mutex);
   this->baud_rate_set_fn = baud_rate_set_fn;
   this->init_fn = init_fn;
   this->deinit_fn = deinit_fn;
   this->stream_handle = stream;
   this->instance_handle = instance;
   this->serial_event_fn = serial_event_fn;
+  this->rx_idle_config_fn = rx_idle_config_fn;
+  this->rx_idle_fn = rx_idle_fn;
+  this->low_power_init_fn = low_power_init_fn;
+  this->rs485_hw_de_fn = rs485_hw_de_fn;
+  this->tx_complete_fn = tx_complete_fn;
 }
 
 void UARTClass::begin(unsigned long baudrate)
@@ -60,6 +102,9 @@ void UARTClass::begin(unsigned long baudrate)
   //#ifndef ARDUINO_MATTER
   this->init_fn();
   this->baud_rate_set_fn(baudrate);
+  // Programmed once while the port is coming up - nothing is received or framed before begin() returns
+  this->rx_idle_config_fn(rx_timeout_chars);
+  this->baudrate = baudrate;
   this->initialized = true;
   //#endif // ARDUINO_MATTER
 }
@@ -79,18 +124,27 @@ void UARTClass::end()
 int UARTClass::available(void)
 {
   task();
-  return rx_buf.available();
+  xSemaphoreTake(this->serial_mutex, portMAX_DELAY);
+  int res = rx_buf.available();
+  xSemaphoreGive(this->serial_mutex);
+  return res;
 }
 
 int UARTClass::peek(void)
 {
-  return rx_buf.peek();
+  xSemaphoreTake(this->serial_mutex, portMAX_DELAY);
+  int res = rx_buf.peek();
+  xSemaphoreGive(this->serial_mutex);
+  return res;
 }
 
 int UARTClass::read(void)
 {
   task();
-  return rx_buf.read_char();
+  xSemaphoreTake(this->serial_mutex, portMAX_DELAY);
+  int res = rx_buf.read_char();
+  xSemaphoreGive(this->serial_mutex);
+  return res;
 }
 
 void UARTClass::flush(void)
@@ -108,10 +162,56 @@ size_t UARTClass::write(const uint8_t* data, size_t size)
   if (!this->initialized) {
     return 0;
   }
+  if (this->rs485_de_pin == PIN_NAME_NC || this->rs485_hw_de) {
+    sl_iostream_write(this->stream_handle, data, size);
+    return size;
+  }
+  // Software driver-enable - keep the transceiver driving the bus until the last stop bit has left the shifter
+  // The last bytes are still in the FIFO when the write returns, a timer checks the TX complete flag
+  // every character time and releases the pin while the task sleeps
+  xSemaphoreTake(this->rs485_tx_mutex, portMAX_DELAY);
+  digitalWrite(this->rs485_de_pin, HIGH);
   sl_iostream_write(this->stream_handle, data, size);
+  (void)xSemaphoreTake(this->rs485_tx_sem, 0u);
+  if (sl_sleeptimer_start_periodic_timer(&this->rs485_de_timer,
+                                         this->char_time_ticks(1u),
+                                         UARTClass::rs485_de_timer_callback,
+                                         this,
+                                         0u,
+                                         0u) == SL_STATUS_OK) {
+    xSemaphoreTake(this->rs485_tx_sem, portMAX_DELAY);
+  } else {
+    while (!this->tx_complete_fn()) {
+      vTaskDelay(1u);
+    }
+    digitalWrite(this->rs485_de_pin, LOW);
+  }
+  xSemaphoreGive(this->rs485_tx_mutex);
   return size;
 }
 
+// Called from the sleeptimer interrupt
+void UARTClass::rs485_de_timer_callback(sl_sleeptimer_timer_handle_t* handle, void* data)
+{
+  UARTClass* uart = static_cast<UARTClass*>(data);
+  if (!uart->tx_complete_fn()) {
+    return;
+  }
+  (void)sl_sleeptimer_stop_timer(handle);
+  digitalWrite(uart->rs485_de_pin, LOW);
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  xSemaphoreGiveFromISR(uart->rs485_tx_sem, &higher_priority_task_woken);
+  portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+// Converts a number of character times to sleeptimer ticks - rounded up, at least one tick
+uint32_t UARTClass::char_time_ticks(uint32_t chars)
+{
+  uint64_t bits = (uint64_t)chars * bits_per_char;
+  uint32_t ticks = (uint32_t)((bits * sl_sleeptimer_get_timer_frequency() + this->baudrate - 1u) / this->baudrate);
+  return (ticks > 0u) ? ticks : 1u;
+}
+
 void UARTClass::printf(const char *fmt, ...)
 {
   char message[this->printf_buffer_size];
@@ -127,9 +227,300 @@ UARTClass::operator bool()
   return true;
 }
 
-void UARTClass::task()
+void UARTClass::onFrame(frame_callback_t callback, uint8_t idle_chars)
+{
+  this->frame_idle_chars = idle_chars;
+  this->frame_callback = callback;
+  if (!this->frame_start()) {
+    this->frame_callback = nullptr;
+  }
+}
+
+void UARTClass::setFrameTrigger(size_t byte_count, int delimiter, uint8_t idle_chars)
+{
+  this->frame_byte_count = byte_count;
+  this->frame_delimiter = delimiter;
+  this->frame_idle_chars = idle_chars;
+}
+
+bool UARTClass::waitForFrame(uint32_t timeout_ms)
+{
+  TickType_t timeout_ticks = portMAX_DELAY;
+  if (timeout_ms != 0xFFFFFFFFu) {
+    timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+  }
+  return xSemaphoreTake(this->frame_sem, timeout_ticks) == pdTRUE;
+}
+
+bool UARTClass::beginLowPower(unsigned long baudrate)
+{
+  if (!this->low_power_init_fn || baudrate > low_power_max_baudrate) {
+    return false;
+  }
+  if (this->initialized) {
+    this->end();
+  }
+  if (!this->low_power_init_fn(baudrate)) {
+    return false;
+  }
+  this->rx_idle_config_fn(rx_timeout_chars);
+  this->baudrate = baudrate;
+  this->initialized = true;
+  return this->frame_start();
+}
+
+void UARTClass::setFrameLengthFn(frame_length_fn_t fn)
+{
+  this->frame_length_fn = fn;
+}
+
+void UARTClass::enableRS485(pin_size_t de_pin)
+{
+  PinName de_pin_name = pinToPinName(de_pin);
+  if (de_pin_name == PIN_NAME_NC) {
+    return;
+  }
+  this->disableRS485();
+  pinMode(de_pin_name, OUTPUT);
+  digitalWrite(de_pin_name, LOW);
+  this->rs485_hw_de = this->rs485_hw_de_fn(de_pin_name, true);
+  this->rs485_de_pin = de_pin_name;
+}
+
+uint32_t UARTClass::getBaudrate()
+{
+  return this->baudrate;
+}
+
+void UARTClass::disableRS485()
+{
+  if (this->rs485_de_pin == PIN_NAME_NC) {
+    return;
+  }
+  if (this->rs485_hw_de) {
+    (void)this->rs485_hw_de_fn(this->rs485_de_pin, false);
+    this->rs485_hw_de = false;
+  }
+  digitalWrite(this->rs485_de_pin, LOW);
+  this->rs485_de_pin = PIN_NAME_NC;
+}
+
+bool UARTClass::frame_start()
+{
+  if (!this->frame_buf) {
+    this->frame_buf = (uint8_t*)malloc(SERIAL_FRAME_BUFFER_SIZE);
+    if (!this->frame_buf) {
+      return false;
+    }
+  }
+
+  if (this->frame_task_handle) {
+    return true;
+  }
+  // From now on the frame task owns the receive side of the stream
+  BaseType_t res = xTaskCreate(UARTClass::frame_task,
+                               "serial_frame_task",
+                               frame_task_stack_size / sizeof(StackType_t),
+                               this,
+                               frame_task_priority,
+                               &this->frame_task_handle);
+  return res == pdPASS;
+}
+
+void UARTClass::frame_task(void* p_arg)
+{
+  UARTClass* uart = static_cast<UARTClass*>(p_arg);
+  while (1) {
+    uart->frame_receive();
+  }
+}
+
+void UARTClass::frame_receive()
 {
   if (!this->initialized) {
+    vTaskDelay(frame_idle_fallback_ticks);
+    return;
+  }
+
+  size_t bytes_read = 0u;
+  bool idle_detection = this->frame_idle_chars > 0u;
+  // Frames handed over to the read() API have to fit into its buffer
+  size_t frame_max = SERIAL_FRAME_BUFFER_SIZE;
+  if (!this->frame_callback && frame_max > rx_buffer_size) {
+    frame_max = rx_buffer_size;
+  }
+
+  // Sleep until the first byte arrives, then clear any idle condition left over from the previous frame
+  if (this->frame_len == 0u) {
+    sl_iostream_uart_set_read_block(this->instance_handle, true);
+    sl_iostream_read(this->stream_handle, this->frame_buf, frame_max, &this->frame_len);
+    (void)this->rx_idle_fn();
+    this->frame_line_idle = false;
+  }
+
+  // Without idle detection keep sleeping in the blocking read until a trigger is hit,
+  // otherwise sleep until the frame idle timer reports the line idle or the DMA RX buffer filling up.
+  // If the timer can't be started the DMA RX buffer is drained once per tick with a software gap timeout.
+  // Once the frame length function announced the frame size, the remaining bytes are waited for
+  // with blocking reads as well so the frame is handed over right after its last byte.
+  bool timer_running = idle_detection && this->frame_idle_timer_start();
+  size_t frame_end = 0u;
+  size_t scanned = 0u;
+  TickType_t quiet_ticks = 0u;
+  TickType_t last_rx_tick = xTaskGetTickCount();
+  while (true) {
+    frame_end = this->frame_find_end(scanned);
+    scanned = this->frame_len;
+    if (frame_end > 0u) {
+      break;
+    }
+    if (this->frame_len >= frame_max || (idle_detection && this->frame_line_idle)) {
+      frame_end = this->frame_len;
+      break;
+    }
+    bool wait_for_rest = this->frame_expected_len > this->frame_len;
+    bool blocking = !idle_detection || wait_for_rest;
+    sl_iostream_uart_set_read_block(this->instance_handle, blocking);
+    TickType_t wait_ticks = timer_running ? frame_idle_fallback_ticks : 1u;
+    bool woken = true;
+    if (!blocking && timer_running) {
+      woken = xSemaphoreTake(this->frame_idle_sem, wait_ticks) == pdTRUE;
+    } else if (!blocking) {
+      this->frame_line_idle = this->rx_idle_fn();
+      vTaskDelay(wait_ticks);
+      woken = false;
+    }
+    bytes_read = 0u;
+    sl_iostream_read(this->stream_handle, this->frame_buf + this->frame_len, frame_max - this->frame_len, &bytes_read);
+    TickType_t now = xTaskGetTickCount();
+    // The rest of an announced frame arriving long after its start means the line went quiet in between -
+    // hand over the stale partial frame on its own so a lost byte can't shift every following frame
+    if (wait_for_rest && bytes_read > 0u && (now - last_rx_tick) >= frame_idle_fallback_ticks) {
+      frame_end = this->frame_len;
+      this->frame_len += bytes_read;
+      break;
+    }
+    this->frame_len += bytes_read;
+    if (blocking || bytes_read > 0u || this->frame_line_idle || woken) {
+      last_rx_tick = now;
+      quiet_ticks = 0u;
+      continue;
+    }
+    quiet_ticks += wait_ticks;
+    if (quiet_ticks >= frame_idle_fallback_ticks) {
+      frame_end = this->frame_len;
+      break;
+    }
+  }
+  if (timer_running) {
+    (void)sl_sleeptimer_stop_timer(&this->frame_idle_timer);
+  }
+  this->frame_line_idle = false;
+
+  // The buffer may hold more than a frame of the read() API if the callback was removed in between
+  if (frame_end > frame_max) {
+    frame_end = frame_max;
+  }
+  this->frame_deliver(frame_end);
+
+  // Keep the bytes belonging to the next frame
+  this->frame_len -= frame_end;
+  if (this->frame_len > 0u) {
+    memmove(this->frame_buf, this->frame_buf + frame_end, this->frame_len);
+  }
+}
+
+// Starts watching the line once per character time - called with the first bytes of a frame received
+bool UARTClass::frame_idle_timer_start()
+{
+  sl_iostream_uart_context_t* context = (sl_iostream_uart_context_t*)this->instance_handle->stream.context;
+  uint32_t period = this->char_time_ticks(1u);
+  this->frame_idle_periods = (this->char_time_ticks(this->frame_idle_chars) + period - 1u) / period;
+  this->frame_quiet_periods = 0u;
+  this->frame_dma_head = (uint8_t*)(uintptr_t)LDMA->CH[context->dma.channel].DST;
+  // Byte count, delimiter and length triggers are checked as soon as new data arrives
+  this->frame_wake_on_data = this->frame_byte_count > 0u || this->frame_delimiter >= 0 || this->frame_length_fn;
+  (void)xSemaphoreTake(this->frame_idle_sem, 0u);
+  return sl_sleeptimer_start_periodic_timer(&this->frame_idle_timer,
+                                            period,
+                                            UARTClass::frame_idle_timer_callback,
+                                            this,
+                                            0u,
+                                            0u) == SL_STATUS_OK;
+}
+
+// Called from the sleeptimer interrupt - the iostream driver owns the UART IRQ handlers, so the RX DMA head
+// and the RX timeout flag are sampled here and the frame task is only woken when there's something to do
+void UARTClass::frame_idle_timer_callback(sl_sleeptimer_timer_handle_t* handle, void* data)
+{
+  (void)handle;
+  UARTClass* uart = static_cast<UARTClass*>(data);
+  sl_iostream_uart_context_t* context = (sl_iostream_uart_context_t*)uart->instance_handle->stream.context;
+  uint8_t* dma_head = (uint8_t*)(uintptr_t)LDMA->CH[context->dma.channel].DST;
+  bool wake = false;
+  if (dma_head != uart->frame_dma_head) {
+    uart->frame_dma_head = dma_head;
+    uart->frame_quiet_periods = 0u;
+    // Drain the DMA RX buffer before it overflows
+    size_t fill = (size_t)((dma_head - context->rx_read_ptr) + (ptrdiff_t)context->rx_buffer_len) % context->rx_buffer_len;
+    wake = uart->frame_wake_on_data || context->rx_buffer_full || fill >= context->rx_buffer_len / 2u;
+  } else if (!uart->frame_line_idle
+             && ++uart->frame_quiet_periods >= uart->frame_idle_periods
+             && uart->rx_idle_fn()) {
+    uart->frame_line_idle = true;
+    wake = true;
+  }
+  if (!wake) {
+    return;
+  }
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  xSemaphoreGiveFromISR(uart->frame_idle_sem, &higher_priority_task_woken);
+  portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+size_t UARTClass::frame_find_end(size_t from)
+{
+  frame_length_fn_t length_fn = this->frame_length_fn;
+  this->frame_expected_len = 0u;
+  if (length_fn) {
+    size_t frame_size = length_fn(this->frame_buf, this->frame_len);
+    if (frame_size > 0u && frame_size <= this->frame_len) {
+      return frame_size;
+    }
+    this->frame_expected_len = frame_size;
+  }
+  for (size_t i = from; i < this->frame_len; i++) {
+    if ((this->frame_delimiter >= 0 && this->frame_buf[i] == (uint8_t)this->frame_delimiter)
+        || (this->frame_byte_count > 0u && i + 1u >= this->frame_byte_count)) {
+      return i + 1u;
+    }
+  }
+  return 0u;
+}
+
+void UARTClass::frame_deliver(size_t len)
+{
+  if (len == 0u) {
+    return;
+  }
+
+  frame_callback_t callback = this->frame_callback;
+  if (callback) {
+    callback(this->frame_buf, len);
+    return;
+  }
+
+  xSemaphoreTake(this->serial_mutex, portMAX_DELAY);
+  for (size_t i = 0; i < len; i++) {
+    rx_buf.store_char(this->frame_buf[i]);
+  }
+  xSemaphoreGive(this->serial_mutex);
+  xSemaphoreGive(this->frame_sem);
+}
+
+void UARTClass::task()
+{
+  if (!this->initialized || this->frame_task_handle) {
     return;
   }
   xSemaphoreTake(this->serial_mutex, portMAX_DELAY);
@@ -155,6 +546,112 @@ void UARTClass::handleSerialEvent()
   }
 }
 
+// Idle-line detection uses the RX timeout of the EUSART and the timer compare unit of the USART
+// Both only set their flag - the interrupt is left disabled as the iostream driver owns the IRQ handler,
+// the frame idle timer samples it instead. Programmed from begin() right after the port's init.
+static void uart_rx_idle_config(USART_TypeDef* usart, uint8_t idle_chars)
+{
+  // The timer counts baud periods starting from the end of the last received frame
+  uint32_t idle_bits = idle_chars * 10u;
+  if (idle_bits > _USART_TIMECMP1_TCMPVAL_MASK) {
+    idle_bits = _USART_TIMECMP1_TCMPVAL_MASK;
+  }
+  usart->TIMECMP1 = USART_TIMECMP1_TSTART_RXEOF
+                    | USART_TIMECMP1_TSTOP_RXACT
+                    | (idle_bits << _USART_TIMECMP1_TCMPVAL_SHIFT);
+  USART_IntClear(usart, USART_IF_TCMP1);
+}
+
+static bool uart_rx_idle_get(USART_TypeDef* usart)
+{
+  bool idle = (USART_IntGet(usart) & USART_IF_TCMP1) != 0u;
+  USART_IntClear(usart, USART_IF_TCMP1);
+  return idle;
+}
+
+#if defined(EUSART_PRESENT)
+static void uart_rx_idle_config(EUSART_TypeDef* eusart, uint8_t idle_chars)
+{
+  if (idle_chars > _EUSART_CFG1_RXTIMEOUT_SEVENFRAMES) {
+    idle_chars = _EUSART_CFG1_RXTIMEOUT_SEVENFRAMES;
+  }
+  // CFG1 can only be written while the EUSART is disabled - the iostream init already enabled it
+  EUSART_Enable(eusart, eusartDisable);
+  eusart->CFG1 = (eusart->CFG1 & ~_EUSART_CFG1_RXTIMEOUT_MASK)
+                 | ((uint32_t)idle_chars << _EUSART_CFG1_RXTIMEOUT_SHIFT);
+  EUSART_Enable(eusart, eusartEnable);
+  EUSART_IntClear(eusart, EUSART_IF_RXTO);
+}
+
+static bool uart_rx_idle_get(EUSART_TypeDef* eusart)
+{
+  bool idle = (EUSART_IntGet(eusart) & EUSART_IF_RXTO) != 0u;
+  EUSART_IntClear(eusart, EUSART_IF_RXTO);
+  return idle;
+}
+#endif // EUSART_PRESENT
+
+// RS-485 driver-enable - the USART drives its CS pin high for the duration of each transmission when AUTOCS is set
+// in asynchronous mode, the EUSART has no such output so write() releases the pin once the TX complete flag is set
+static bool uart_rs485_hw_de(USART_TypeDef* usart, PinName de_pin, bool enable)
+{
+#if defined(USART_NUM)
+  const uint32_t usart_index = USART_NUM(usart);
+#else
+  const uint32_t usart_index = 0u;
+#endif // USART_NUM
+  if (!enable) {
+    usart->CTRL_CLR = USART_CTRL_AUTOCS;
+    GPIO->USARTROUTE[usart_index].ROUTEEN &= ~GPIO_USART_ROUTEEN_CSPEN;
+    return false;
+  }
+  GPIO->USARTROUTE[usart_index].CSROUTE = ((uint32_t)getSilabsPortFromArduinoPin(de_pin) << _GPIO_USART_CSROUTE_PORT_SHIFT)
+                                          | (getSilabsPinFromArduinoPin(de_pin) << _GPIO_USART_CSROUTE_PIN_SHIFT);
+  GPIO->USARTROUTE[usart_index].ROUTEEN |= GPIO_USART_ROUTEEN_CSPEN;
+  usart->CTRL_SET = USART_CTRL_AUTOCS;
+  return true;
+}
+
+static bool uart_tx_complete(USART_TypeDef* usart)
+{
+  return (usart->STATUS & USART_STATUS_TXC) != 0u;
+}
+
+#if defined(EUSART_PRESENT)
+static bool uart_rs485_hw_de(EUSART_TypeDef* eusart, PinName de_pin, bool enable)
+{
+  (void)eusart;
+  (void)de_pin;
+  (void)enable;
+  return false;
+}
+
+static bool uart_tx_complete(EUSART_TypeDef* eusart)
+{
+  return (eusart->STATUS & EUSART_STATUS_TXC) != 0u;
+}
+#endif // EUSART_PRESENT
+
+static void serial_rx_idle_config(uint8_t idle_chars)
+{
+  uart_rx_idle_config(SL_SERIAL_PERIPHERAL, idle_chars);
+}
+
+static bool serial_rx_idle()
+{
+  return uart_rx_idle_get(SL_SERIAL_PERIPHERAL);
+}
+
+static bool serial_rs485_hw_de(PinName de_pin, bool enable)
+{
+  return uart_rs485_hw_de(SL_SERIAL_PERIPHERAL, de_pin, enable);
+}
+
+static bool serial_tx_complete()
+{
+  return uart_tx_complete(SL_SERIAL_PERIPHERAL);
+}
+
 __attribute__((weak)) void serialEvent(void)
 {
   ;
@@ -165,9 +662,34 @@ arduino::UARTClass Serial(sl_serial_stream_handle,
                           sl_serial_set_baud_rate,
                           sl_serial_init,
                           sl_serial_deinit,
-                          serialEvent);
+                          serialEvent,
+                          serial_rx_idle_config,
+                          serial_rx_idle,
+                          nullptr,
+                          serial_rs485_hw_de,
+                          serial_tx_complete);
 
 #if (NUM_HW_SERIAL > 1)
+static void serial1_rx_idle_config(uint8_t idle_chars)
+{
+  uart_rx_idle_config(SL_SERIAL1_PERIPHERAL, idle_chars);
+}
+
+static bool serial1_rx_idle()
+{
+  return uart_rx_idle_get(SL_SERIAL1_PERIPHERAL);
+}
+
+static bool serial1_rs485_hw_de(PinName de_pin, bool enable)
+{
+  return uart_rs485_hw_de(SL_SERIAL1_PERIPHERAL, de_pin, enable);
+}
+
+static bool serial1_tx_complete()
+{
+  return uart_tx_complete(SL_SERIAL1_PERIPHERAL);
+}
+
 __attribute__((weak)) void serialEvent1(void)
 {
   ;
@@ -178,5 +700,14 @@ arduino::UARTClass Serial1(sl_serial1_stream_handle,
                            sl_serial1_set_baud_rate,
                            sl_serial1_init,
                            sl_serial1_deinit,
-                           serialEvent1);
+                           serialEvent1,
+                           serial1_rx_idle_config,
+                           serial1_rx_idle,
+#if defined(SL_SERIAL1_LOW_POWER_CAPABLE)
+                           sl_serial1_low_power_init,
+#else
+                           nullptr,
+#endif // SL_SERIAL1_LOW_POWER_CAPABLE
+                           serial1_rs485_hw_de,
+                           serial1_tx_complete);
 #endif // #if (NUM_HW_SERIAL > 1)
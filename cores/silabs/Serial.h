@@ -37,18 +37,34 @@
 #include "api/Stream.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+#include "sl_sleeptimer.h"
 #include "arduino_serial_config.h"
 
+#ifndef SERIAL_FRAME_BUFFER_SIZE
+#define SERIAL_FRAME_BUFFER_SIZE 256u
+#endif // SERIAL_FRAME_BUFFER_SIZE
+
 namespace arduino {
 class UARTClass : public HardwareSerial
 {
 public:
+  // Called with a complete received frame - the data points into the frame buffer and is only valid until the callback returns
+  typedef void (*frame_callback_t)(const uint8_t* data, size_t len);
+  // Returns the total length of the frame starting at 'data' as soon as it can be told from the 'len' bytes received so far, 0 otherwise
+  typedef size_t (*frame_length_fn_t)(const uint8_t* data, size_t len);
+
   UARTClass(sl_iostream_t* stream,
             sl_iostream_uart_t* instance,
             void(*baud_rate_set_fn)(uint32_t baudrate),
             void(*init_fn)(void),
             void(*deinit_fn)(void),
-            void(*serial_event_fn)(void));
+            void(*serial_event_fn)(void),
+            void(*rx_idle_config_fn)(uint8_t idle_chars),
+            bool(*rx_idle_fn)(void),
+            bool(*low_power_init_fn)(uint32_t baudrate),
+            bool(*rs485_hw_de_fn)(PinName de_pin, bool enable),
+            bool(*tx_complete_fn)(void));
   void begin(unsigned long);
   void begin(unsigned long baudrate, uint16_t config);
   void end();
@@ -63,10 +79,50 @@ public:
   void task();
   void handleSerialEvent();
   void printf(const char* fmt, ...);
+  // Delivers received data as frames delimited by the line being idle for 'idle_chars' character times
+  // Passing nullptr returns the received data to the regular read() API
+  void onFrame(frame_callback_t callback, uint8_t idle_chars = 2u);
+  // Additionally ends a frame after 'byte_count' bytes and/or after the 'delimiter' character (-1 disables it)
+  // An 'idle_chars' value of 0 disables idle-line detection - the receiver then only wakes up on incoming data
+  void setFrameTrigger(size_t byte_count, int delimiter = -1, uint8_t idle_chars = 2u);
+  // Blocks the calling task until a frame is received into the read() buffer - returns false on timeout
+  // Without a callback the frames end at the size of the read() buffer at the latest
+  bool waitForFrame(uint32_t timeout_ms = 0xFFFFFFFFu);
+  // Keeps the receiver running in EM2 clocked from the LFXO - only available on EUSART instances, max 9600 baud
+  // Received data is framed by the configured triggers and the device may sleep in EM2 while waiting
+  bool beginLowPower(unsigned long baudrate = 9600u);
+  // Ends a frame as soon as 'fn' reports its length - lets protocols with self-describing frames skip the idle wait
+  void setFrameLengthFn(frame_length_fn_t fn);
+  // Drives the driver-enable pin of an RS-485 transceiver high while transmitting - call after begin()
+  // USART instances toggle the pin in hardware, on EUSART instances a timer releases it once the TX complete flag is set
+  void enableRS485(pin_size_t de_pin);
+  void disableRS485();
+  // Returns the baud rate the port was started with
+  uint32_t getBaudrate();
 private:
   static const uint8_t printf_buffer_size = 128u;
+  static const uint32_t frame_task_stack_size = 1024u;
+  static const UBaseType_t frame_task_priority = 2u;
+  static const TickType_t frame_idle_fallback_ticks = pdMS_TO_TICKS(10u);
+
+  static const uint32_t low_power_max_baudrate = 9600u;
+  // Start bit, 8 data bits and a stop bit
+  static const uint32_t bits_per_char = 10u;
+  // The receiver flags the line idle one character after the last stop bit, longer gaps are timed by the frame idle timer
+  static const uint8_t rx_timeout_chars = 1u;
+
+  static void frame_task(void* p_arg);
+  bool frame_start();
+  void frame_receive();
+  size_t frame_find_end(size_t from);
+  void frame_deliver(size_t len);
+  bool frame_idle_timer_start();
+  static void frame_idle_timer_callback(sl_sleeptimer_timer_handle_t* handle, void* data);
+  uint32_t char_time_ticks(uint32_t chars);
+  static void rs485_de_timer_callback(sl_sleeptimer_timer_handle_t* handle, void* data);
 
-  RingBufferN<128> rx_buf;
+  static const size_t rx_buffer_size = 128u;
+  RingBufferN<rx_buffer_size> rx_buf;
 
   SemaphoreHandle_t serial_mutex;
   StaticSemaphore_t serial_mutex_buf;
@@ -75,6 +131,41 @@ private:
   void (*init_fn)(void);
   void (*deinit_fn)(void);
   void (*serial_event_fn)(void);
+  void (*rx_idle_config_fn)(uint8_t idle_chars);
+  bool (*rx_idle_fn)(void);
+  bool (*low_power_init_fn)(uint32_t baudrate);
+  bool (*rs485_hw_de_fn)(PinName de_pin, bool enable);
+  bool (*tx_complete_fn)(void);
+
+  volatile frame_callback_t frame_callback;
+  TaskHandle_t frame_task_handle;
+  SemaphoreHandle_t frame_sem;
+  StaticSemaphore_t frame_sem_buf;
+  uint8_t* frame_buf;
+  size_t frame_len;
+  size_t frame_byte_count;
+  int frame_delimiter;
+  uint8_t frame_idle_chars;
+  volatile bool frame_line_idle;
+  volatile frame_length_fn_t frame_length_fn;
+  size_t frame_expected_len;
+  sl_sleeptimer_timer_handle_t frame_idle_timer;
+  SemaphoreHandle_t frame_idle_sem;
+  StaticSemaphore_t frame_idle_sem_buf;
+  uint8_t* frame_dma_head;
+  uint32_t frame_quiet_periods;
+  uint32_t frame_idle_periods;
+  bool frame_wake_on_data;
+
+  PinName rs485_de_pin;
+  bool rs485_hw_de;
+  sl_sleeptimer_timer_handle_t rs485_de_timer;
+  SemaphoreHandle_t rs485_tx_sem;
+  StaticSemaphore_t rs485_tx_sem_buf;
+  SemaphoreHandle_t rs485_tx_mutex;
+  StaticSemaphore_t rs485_tx_mutex_buf;
+
+  uint32_t baudrate;
 
   sl_iostream_t* stream_handle;
   sl_iostream_uart_t* instance_handle;
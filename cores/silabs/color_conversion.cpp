@@ -0,0 +1,193 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "color_conversion.h"
+
+// round(65535 * (i / 256) ^ 2.2) - one extra entry for the interpolation at the top of the range
+static const uint16_t gamma_table[257] = {
+      0,     0,     2,     4,     7,    11,    17,    24,    32,    41,    52,    64,
+     78,    93,   110,   128,   147,   168,   191,   215,   240,   267,   296,   327,
+    359,   392,   428,   465,   504,   544,   586,   630,   676,   723,   772,   823,
+    875,   930,   986,  1044,  1104,  1165,  1229,  1294,  1361,  1430,  1501,  1574,
+   1648,  1725,  1803,  1884,  1966,  2050,  2136,  2224,  2314,  2406,  2500,  2595,
+   2693,  2793,  2895,  2998,  3104,  3212,  3322,  3433,  3547,  3663,  3781,  3900,
+   4022,  4146,  4272,  4400,  4530,  4663,  4797,  4933,  5072,  5212,  5355,  5499,
+   5646,  5795,  5946,  6099,  6255,  6412,  6572,  6733,  6897,  7063,  7231,  7402,
+   7574,  7749,  7926,  8105,  8286,  8469,  8655,  8843,  9033,  9225,  9419,  9616,
+   9815, 10016, 10219, 10425, 10632, 10842, 11054, 11269, 11486, 11705, 11926, 12149,
+  12375, 12603, 12833, 13066, 13301, 13538, 13777, 14019, 14263, 14509, 14758, 15009,
+  15262, 15517, 15775, 16035, 16298, 16563, 16830, 17099, 17371, 17645, 17922, 18201,
+  18482, 18765, 19051, 19339, 19630, 19923, 20218, 20516, 20816, 21119, 21424, 21731,
+  22040, 22352, 22667, 22984, 23303, 23624, 23949, 24275, 24604, 24935, 25269, 25605,
+  25943, 26284, 26628, 26973, 27322, 27672, 28026, 28381, 28739, 29100, 29462, 29828,
+  30196, 30566, 30939, 31314, 31692, 32072, 32454, 32840, 33227, 33617, 34010, 34405,
+  34802, 35202, 35605, 36010, 36417, 36827, 37240, 37655, 38072, 38493, 38915, 39340,
+  39768, 40198, 40631, 41066, 41503, 41944, 42387, 42832, 43280, 43730, 44183, 44639,
+  45097, 45557, 46020, 46486, 46954, 47425, 47899, 48374, 48853, 49334, 49818, 50304,
+  50793, 51284, 51778, 52275, 52774, 53276, 53780, 54287, 54796, 55308, 55823, 56341,
+  56860, 57383, 57908, 58436, 58966, 59499, 60035, 60573, 61114, 61657, 62203, 62752,
+  63303, 63857, 64414, 64973, 65535,
+};
+
+// CIE 1931 lightness to luminance - L* = level / 255 * 100, round(65535 * Y)
+static const uint16_t brightness_table[256] = {
+      0,    28,    57,    85,   114,   142,   171,   199,   228,   256,   285,   313,
+    341,   370,   398,   427,   455,   484,   512,   541,   569,   598,   627,   658,
+    689,   721,   755,   789,   825,   861,   899,   937,   977,  1018,  1060,  1103,
+   1147,  1192,  1239,  1287,  1336,  1386,  1437,  1490,  1544,  1599,  1656,  1714,
+   1773,  1834,  1896,  1959,  2024,  2090,  2157,  2226,  2297,  2369,  2442,  2517,
+   2593,  2671,  2751,  2832,  2914,  2999,  3085,  3172,  3261,  3352,  3444,  3538,
+   3634,  3732,  3831,  3932,  4035,  4139,  4245,  4354,  4464,  4575,  4689,  4804,
+   4922,  5041,  5162,  5285,  5410,  5537,  5666,  5797,  5930,  6065,  6202,  6341,
+   6482,  6626,  6771,  6918,  7068,  7220,  7373,  7529,  7687,  7848,  8010,  8175,
+   8342,  8512,  8683,  8857,  9033,  9212,  9393,  9576,  9762,  9949, 10140, 10333,
+  10528, 10725, 10926, 11128, 11333, 11541, 11751, 11963, 12179, 12396, 12617, 12840,
+  13065, 13293, 13524, 13757, 13993, 14232, 14474, 14718, 14965, 15215, 15467, 15722,
+  15980, 16241, 16505, 16771, 17041, 17313, 17588, 17866, 18147, 18431, 18717, 19007,
+  19300, 19596, 19894, 20196, 20501, 20809, 21119, 21433, 21750, 22071, 22394, 22720,
+  23050, 23383, 23719, 24058, 24400, 24746, 25095, 25447, 25802, 26161, 26523, 26888,
+  27257, 27629, 28004, 28383, 28765, 29151, 29540, 29932, 30328, 30728, 31131, 31537,
+  31947, 32360, 32777, 33198, 33622, 34050, 34481, 34916, 35355, 35797, 36243, 36693,
+  37146, 37603, 38064, 38529, 38997, 39469, 39945, 40425, 40908, 41396, 41887, 42382,
+  42881, 43384, 43891, 44401, 44916, 45435, 45957, 46484, 47015, 47549, 48088, 48631,
+  49178, 49728, 50283, 50843, 51406, 51973, 52545, 53120, 53700, 54284, 54873, 55465,
+  56062, 56663, 57269, 57878, 58492, 59111, 59733, 60360, 60992, 61627, 62268, 62912,
+  63561, 64215, 64873, 65535,
+};
+
+// Multiplies two 16-bit fractions with rounding - 65535 is 1.0
+static inline uint32_t mul16(uint32_t a, uint32_t b)
+{
+  return (a * b + 32767u) / 65535u;
+}
+
+rgb16_t hsvToRgb16(uint16_t hue, uint16_t saturation, uint16_t value)
+{
+  // The color wheel is split into six sectors - the fraction is the position within the sector
+  uint32_t position = (uint32_t)hue * 6u;
+  uint32_t sector = position >> 16;
+  uint32_t fraction = position & 0xFFFFu;
+
+  uint32_t v = value;
+  uint32_t p = mul16(v, 65535u - saturation);
+  uint32_t q = mul16(v, 65535u - mul16(saturation, fraction));
+  uint32_t t = mul16(v, 65535u - mul16(saturation, 65535u - fraction));
+
+  rgb16_t color;
+  switch (sector) {
+    case 0:
+      color = { (uint16_t)v, (uint16_t)t, (uint16_t)p };
+      break;
+    case 1:
+      color = { (uint16_t)q, (uint16_t)v, (uint16_t)p };
+      break;
+    case 2:
+      color = { (uint16_t)p, (uint16_t)v, (uint16_t)t };
+      break;
+    case 3:
+      color = { (uint16_t)p, (uint16_t)q, (uint16_t)v };
+      break;
+    case 4:
+      color = { (uint16_t)t, (uint16_t)p, (uint16_t)v };
+      break;
+    default:
+      color = { (uint16_t)v, (uint16_t)p, (uint16_t)q };
+      break;
+  }
+  return color;
+}
+
+void rgbToHsv16(rgb16_t color, uint16_t* hue, uint16_t* saturation, uint16_t* value)
+{
+  if (!hue || !saturation || !value) {
+    return;
+  }
+  int32_t r = color.red;
+  int32_t g = color.green;
+  int32_t b = color.blue;
+  int32_t max = r > g ? (r > b ? r : b) : (g > b ? g : b);
+  int32_t min = r < g ? (r < b ? r : b) : (g < b ? g : b);
+  int32_t delta = max - min;
+
+  *value = (uint16_t)max;
+  if (delta == 0) {
+    *hue = 0u;
+    *saturation = 0u;
+    return;
+  }
+  *saturation = (uint16_t)(((uint32_t)delta * 65535u + (uint32_t)max / 2u) / (uint32_t)max);
+
+  // One sector of the color wheel is 65536 / 6 - the offset within the sector fits 32 bits this way
+  const int32_t sector_size = 10923;
+  int32_t h;
+  if (max == r) {
+    h = (g - b) * sector_size / delta;
+  } else if (max == g) {
+    h = 2 * sector_size + (b - r) * sector_size / delta;
+  } else {
+    h = 4 * sector_size + (r - g) * sector_size / delta;
+  }
+  if (h < 0) {
+    h += 65536;
+  }
+  *hue = (uint16_t)h;
+}
+
+uint16_t gammaToLinear16(uint16_t value)
+{
+  if (value == 65535u) {
+    return 65535u;
+  }
+  uint32_t index = value >> 8;
+  uint32_t fraction = value & 0xFFu;
+  uint32_t low = gamma_table[index];
+  uint32_t high = gamma_table[index + 1u];
+  return (uint16_t)(low + (((high - low) * fraction + 128u) >> 8));
+}
+
+uint16_t brightnessToLinear16(uint8_t level)
+{
+  return brightness_table[level];
+}
+
+rgb16_t hsvToLinearRgb16(uint16_t hue, uint16_t saturation, uint8_t level)
+{
+  rgb16_t color = hsvToRgb16(hue, saturation, 65535u);
+  uint32_t brightness = brightnessToLinear16(level);
+  color.red = (uint16_t)mul16(gammaToLinear16(color.red), brightness);
+  color.green = (uint16_t)mul16(gammaToLinear16(color.green), brightness);
+  color.blue = (uint16_t)mul16(gammaToLinear16(color.blue), brightness);
+  return color;
+}
+
+uint32_t scaleToResolution16(uint16_t value, uint8_t resolution)
+{
+  if (resolution == 0u || resolution >= 16u) {
+    return value;
+  }
+  uint32_t max = (1u << resolution) - 1u;
+  return ((uint32_t)value * max + 32767u) / 65535u;
+}
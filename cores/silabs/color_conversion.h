@@ -0,0 +1,109 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Fixed-point color conversion - HSV/RGB conversion, gamma and brightness curves without floating point
+
+#ifndef COLOR_CONVERSION_H
+#define COLOR_CONVERSION_H
+
+#include <stdint.h>
+
+// Color with 16-bit channels - full scale is 0-65535
+typedef struct {
+  uint16_t red;
+  uint16_t green;
+  uint16_t blue;
+} rgb16_t;
+
+/***************************************************************************//**
+ * Converts a HSV color to RGB
+ * All values are full scale 16-bit numbers - a hue of 65536 would be a full
+ * turn of the color wheel (65536 / 360 per degree).
+ *
+ * @param[in] hue the hue (0-65535)
+ * @param[in] saturation the saturation (0-65535)
+ * @param[in] value the value (0-65535)
+ *
+ * @return the RGB color
+ ******************************************************************************/
+rgb16_t hsvToRgb16(uint16_t hue, uint16_t saturation, uint16_t value);
+
+/***************************************************************************//**
+ * Converts a RGB color to HSV
+ *
+ * @param[in] color the RGB color
+ * @param[out] hue the hue (0-65535)
+ * @param[out] saturation the saturation (0-65535)
+ * @param[out] value the value (0-65535)
+ ******************************************************************************/
+void rgbToHsv16(rgb16_t color, uint16_t* hue, uint16_t* saturation, uint16_t* value);
+
+/***************************************************************************//**
+ * Converts a gamma encoded color channel to linear light intensity
+ * Uses a gamma of 2.2 from a precomputed table with linear interpolation.
+ *
+ * @param[in] value the gamma encoded value (0-65535)
+ *
+ * @return the linear intensity (0-65535)
+ ******************************************************************************/
+uint16_t gammaToLinear16(uint16_t value);
+
+/***************************************************************************//**
+ * Converts a brightness level to linear light intensity
+ * Follows the CIE 1931 lightness curve from a precomputed table, so that equal
+ * steps in the level look like equal steps in brightness.
+ *
+ * @param[in] level the brightness level (0-255)
+ *
+ * @return the linear intensity (0-65535)
+ ******************************************************************************/
+uint16_t brightnessToLinear16(uint8_t level);
+
+/***************************************************************************//**
+ * Converts a HSV color and a brightness level to linear RGB intensities
+ * The output is meant for PWM or LED drivers - the hue and saturation are
+ * converted at full value, gamma corrected and scaled by the brightness curve.
+ *
+ * @param[in] hue the hue (0-65535)
+ * @param[in] saturation the saturation (0-65535)
+ * @param[in] level the brightness level (0-255)
+ *
+ * @return the linear RGB intensities
+ ******************************************************************************/
+rgb16_t hsvToLinearRgb16(uint16_t hue, uint16_t saturation, uint8_t level);
+
+/***************************************************************************//**
+ * Scales a 16-bit value to the given resolution
+ * 65535 is mapped to the maximum value of the resolution, e.g. 4095 for 12 bits.
+ *
+ * @param[in] value the 16-bit value
+ * @param[in] resolution the resolution in bits (1-16)
+ *
+ * @return the scaled value
+ ******************************************************************************/
+uint32_t scaleToResolution16(uint16_t value, uint8_t resolution);
+
+#endif // COLOR_CONVERSION_H
@@ -25,6 +25,7 @@
  */
 
 #include "Arduino.h"
+#include "semphr.h"
 
 void arduino_task(void *p_arg);
 inline static void handle_serial_events();
@@ -35,6 +36,17 @@ static StaticTask_t arduino_task_buffer;
 static TaskHandle_t arduino_task_handle;
 bool system_init_finished = false;
 
+#ifdef ARDUINO_MATTER
+void matter_init_task(void *p_arg);
+// The init task is created on the heap so that its stack is freed when the init is done
+#ifndef ARDUINO_MATTER_INIT_TASK_STACK_SIZE
+#define ARDUINO_MATTER_INIT_TASK_STACK_SIZE 1280
+#endif
+static StaticSemaphore_t matter_init_done_buf;
+static SemaphoreHandle_t matter_init_done = xSemaphoreCreateBinaryStatic(&matter_init_done_buf);
+static bool matter_fast_boot = false;
+#endif // ARDUINO_MATTER
+
 int main()
 {
   // Board specific init - in most cases it's just a call to sl_system_init(),
@@ -42,6 +54,20 @@ int main()
   init_arduino_variant();
   system_init_finished = true;
 
+  #ifdef ARDUINO_MATTER
+  // In fast boot mode the variant skips the Matter init - it runs concurrently with setup() instead
+  matter_fast_boot = matterFastBootEnabled();
+  if (matter_fast_boot) {
+    BaseType_t result = xTaskCreate(matter_init_task,
+                                    "matter_init",
+                                    ARDUINO_MATTER_INIT_TASK_STACK_SIZE,
+                                    NULL,
+                                    arduino_task_priority,
+                                    NULL);
+    app_assert(pdPASS == result, "Matter init task creation failed");
+  }
+  #endif // ARDUINO_MATTER
+
   arduino_task_handle = xTaskCreateStatic(arduino_task,
                                           "arduino_task",
                                           arduino_task_stack_size,
@@ -58,7 +84,9 @@ int main()
 void arduino_task(void *p_arg)
 {
   (void)p_arg;
+  bootPhaseStart(BOOT_PHASE_SETUP);
   setup();
+  bootPhaseEnd(BOOT_PHASE_SETUP);
   while (1) {
     loop();
     handle_serial_events();
@@ -76,3 +104,28 @@ inline static void handle_serial_events()
   Serial1.handleSerialEvent();
   #endif // #if (NUM_HW_SERIAL > 1)
 }
+
+#ifdef ARDUINO_MATTER
+void matter_init_task(void *p_arg)
+{
+  (void)p_arg;
+  init_arduino_matter();
+  xSemaphoreGive(matter_init_done);
+  vTaskDelete(NULL);
+}
+
+__attribute__((weak)) bool matterFastBootEnabled()
+{
+  return false;
+}
+
+void waitForMatterInit()
+{
+  if (!matter_fast_boot) {
+    return;
+  }
+  // Give the semaphore back so that every later call returns right away
+  xSemaphoreTake(matter_init_done, portMAX_DELAY);
+  xSemaphoreGive(matter_init_done);
+}
+#endif // ARDUINO_MATTER
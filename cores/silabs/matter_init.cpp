@@ -0,0 +1,79 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifdef ARDUINO_MATTER
+
+#include "Arduino.h"
+
+#include "AppConfig.h"
+#include <DeviceInfoProviderImpl.h>
+#include <MatterConfig.h>
+#include <app/server/Server.h>
+#include <provision/ProvisionManager.h>
+
+#ifdef BLE_DEV_NAME
+#undef BLE_DEV_NAME
+#endif
+#define BLE_DEV_NAME "Arduino Matter device"
+
+static chip::DeviceLayer::DeviceInfoProviderImpl gExampleDeviceInfoProvider;
+
+using namespace ::chip;
+using namespace ::chip::DeviceLayer;
+using namespace ::chip::Credentials;
+using namespace ::chip::DeviceLayer::Silabs;
+
+// Initializes the Matter stack - shared by all the Matter variants
+// It's called by init_arduino_variant() right after the platform init, or in fast boot mode by a task
+// running concurrently with setup(). In both cases the variant deinitializes Serial, Wire and SPI
+// before setup() runs. Those peripherals are brought up by sl_system_init() in the platform init
+// (the same as for the non-Matter builds, which have no Matter init at all) - the Matter init itself
+// only starts the CHIP stack, OpenThread and BLE, so the deinit doesn't depend on running after it.
+void init_arduino_matter()
+{
+  bootPhaseStart(BOOT_PHASE_MATTER_INIT);
+  if (Provision::Manager::GetInstance().ProvisionRequired()) {
+    Provision::Manager::GetInstance().Start();
+    bootPhaseEnd(BOOT_PHASE_MATTER_INIT);
+  } else {
+    if (SilabsMatterConfig::InitMatter(BLE_DEV_NAME) != CHIP_NO_ERROR) {
+      appError(CHIP_ERROR_INTERNAL);
+    }
+    bootPhaseEnd(BOOT_PHASE_MATTER_INIT);
+
+    bootPhaseStart(BOOT_PHASE_DEVICE_INFO_INIT);
+    gExampleDeviceInfoProvider.SetStorageDelegate(&chip::Server::GetInstance().GetPersistentStorage());
+    chip::DeviceLayer::SetDeviceInfoProvider(&gExampleDeviceInfoProvider);
+
+    chip::DeviceLayer::PlatformMgr().LockChipStack();
+    // Initialize device attestation config
+    SetDeviceAttestationCredentialsProvider(&Provision::Manager::GetInstance().GetStorage());
+    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+    bootPhaseEnd(BOOT_PHASE_DEVICE_INFO_INIT);
+  }
+}
+
+#endif // ARDUINO_MATTER
@@ -68,7 +68,7 @@ bool PwmClass::init(PinName pin, int frequency)
   #endif // SL_CATALOG_POWER_MANAGER_PRESENT
 
   this->pwm_pins[pwm_channel_idx].pin = pin;
-  this->pwm_pins[pwm_channel_idx].duty_cycle_percent = 101;
+  this->pwm_pins[pwm_channel_idx].compare = UINT32_MAX;
   this->pwm_pins[pwm_channel_idx].inst.port = getSilabsPortFromArduinoPin(pin);
   this->pwm_pins[pwm_channel_idx].inst.pin = getSilabsPinFromArduinoPin(pin);
   this->pwm_pins[pwm_channel_idx].inst.channel = pwm_channel_idx;
@@ -82,51 +82,75 @@ bool PwmClass::init(PinName pin, int frequency)
 
 void PwmClass::duty_cycle_mode(PinName pin, int duty_cycle)
 {
-  if (duty_cycle < 0 || duty_cycle > (int)this->duty_cycle_mode_max_value || pin >= PIN_NAME_MAX) {
+  if (duty_cycle < 0 || duty_cycle > (int)this->duty_cycle_mode_max_value) {
     return;
   }
+  // Arduino passes the duty cycle as a number from 0 to the configured write resolution's max (255 by default).
+  this->set_duty_cycle(pin, (uint32_t)duty_cycle, this->duty_cycle_mode_max_value);
+}
+
+void PwmClass::duty_cycle_mode_16bit(PinName pin, uint16_t duty_cycle)
+{
+  this->set_duty_cycle(pin, duty_cycle, UINT16_MAX);
+}
 
-  // If the previous duty cycle setting was within the stabilization time - we wait for the stabilization time to elapse
-  // If different channels's duty cycles are set in quick succession they won't take effect - therefore we have to wait in between
-  while (millis() < this->duty_cycle_set_time + this->pwm_stabilization_time_ms) {
-    yield();
+void PwmClass::set_duty_cycle(PinName pin, uint32_t duty_cycle, uint32_t max_value)
+{
+  if (pin >= PIN_NAME_MAX) {
+    return;
   }
 
   xSemaphoreTake(this->pwm_mutex, portMAX_DELAY);
 
-  // If the PWM was running in a different mode before - deinitialize it
-  if (this->pwm_mode != pwm_mode_t::DUTY_CYCLE) {
-    deinit_all_pwm_channels();
-    this->pwm_mode = pwm_mode_t::DUTY_CYCLE;
-  }
-
-  // Initialize PWM if the pin doesn't have an initialized instance
-  if (get_pwm_channel_idx_for_pin(pin) == UINT8_MAX) {
-    bool res = this->init(pin, this->duty_cycle_mode_default_freq);
-    // Return if PWM could not be initialized
-    if (!res) {
-      xSemaphoreGive(this->pwm_mutex);
-      return;
+  while (true) {
+    // If the PWM was running in a different mode before - deinitialize it
+    if (this->pwm_mode != pwm_mode_t::DUTY_CYCLE) {
+      deinit_all_pwm_channels();
+      this->pwm_mode = pwm_mode_t::DUTY_CYCLE;
+    }
+    // Initialize PWM if the pin doesn't have an initialized instance
+    if (get_pwm_channel_idx_for_pin(pin) != UINT8_MAX) {
+      break;
+    }
+    // Initializing a channel within the stabilization time of the previous duty cycle setting makes that setting
+    // not take effect - therefore we block (without spinning) until the stabilization time elapses.
+    // Duty cycle changes of running channels only update their compare buffer and don't have to wait.
+    uint32_t elapsed_ms = millis() - this->duty_cycle_set_time;
+    if (elapsed_ms >= this->pwm_stabilization_time_ms) {
+      bool res = this->init(pin, this->duty_cycle_mode_default_freq);
+      // Return if PWM could not be initialized
+      if (!res) {
+        xSemaphoreGive(this->pwm_mutex);
+        return;
+      }
+      break;
     }
+    // Wait without holding the mutex so the running channels can be updated meanwhile - another task may
+    // change the mode, initialize the pin or set a new duty cycle in the meantime, so everything is checked again
+    xSemaphoreGive(this->pwm_mutex);
+    // One extra tick as the current tick may be almost over
+    vTaskDelay(pdMS_TO_TICKS(this->pwm_stabilization_time_ms - elapsed_ms) + 1u);
+    xSemaphoreTake(this->pwm_mutex, portMAX_DELAY);
   }
-  // Calculate the duty cycle percent from the provided value
-  // Arduino passes the duty cycle as a number from 0 to the configured write resolution's max (255 by default).
-  // We need the duty cycle to be expressed as a number from 0-100.
-  int duty_cycle_percent = duty_cycle * 100 / this->duty_cycle_mode_max_value;
-
+  // The compare value is scaled to the timer's top value directly instead of going through a 0-100 percent value,
+  // so every step of the requested resolution is preserved up to the resolution of the timer.
   uint8_t pwm_channel_idx = get_pwm_channel_idx_for_pin(pin);
+  sl_pwm_instance_t* inst = &this->pwm_pins[pwm_channel_idx].inst;
+  uint64_t top = TIMER_TopGet(inst->timer);
+  uint32_t compare = (uint32_t)((top * duty_cycle + max_value / 2u) / max_value);
+
   // Don't change anything if the requested duty cycle is the same as the currently set
-  if (this->pwm_pins[pwm_channel_idx].duty_cycle_percent == (uint8_t)duty_cycle_percent) {
+  if (this->pwm_pins[pwm_channel_idx].compare == compare) {
     xSemaphoreGive(this->pwm_mutex);
     return;
   }
-  this->pwm_pins[pwm_channel_idx].duty_cycle_percent = (uint8_t)duty_cycle_percent;
+  this->pwm_pins[pwm_channel_idx].compare = compare;
 
   // Stop the PWM on 0 duty cycle (if auto deinit is enabled), set the requested duty cycle otherwise
-  if (duty_cycle_percent == 0 && this->auto_deinit) {
+  if (duty_cycle == 0u && this->auto_deinit) {
     this->stop(pin);
   } else {
-    sl_pwm_set_duty_cycle(&this->pwm_pins[pwm_channel_idx].inst, (uint8_t)duty_cycle_percent);
+    TIMER_CompareBufSet(inst->timer, inst->channel, compare);
     this->duty_cycle_set_time = millis();
   }
 
@@ -191,8 +215,14 @@ void PwmClass::duty_cycle_mode_set_write_resolution(uint8_t resolution)
   if (resolution < 1 || resolution > this->duty_cycle_mode_write_resolution_max) {
     return;
   }
+  xSemaphoreTake(this->pwm_mutex, portMAX_DELAY);
   this->duty_cycle_mode_write_resolution = resolution;
   this->duty_cycle_mode_max_value = pow(2, this->duty_cycle_mode_write_resolution) - 1;
+  // Forget the cached duty cycles - the same value means a different duty cycle with the new resolution
+  for (auto& pwm_pin : this->pwm_pins) {
+    pwm_pin.compare = UINT32_MAX;
+  }
+  xSemaphoreGive(this->pwm_mutex);
 }
 
 void PwmClass::set_auto_deinit(bool auto_deinit)
@@ -57,10 +57,20 @@ public:
    * Can handle multiple channels.
    *
    * @param[in] pin output pin for the PWM signal
-   * @param[in] duty_cycle duty cycle for the PWM signal (0-255)
+   * @param[in] duty_cycle duty cycle for the PWM signal (0 to the max value of the write resolution - 0-255 by default)
    *****************************************************************************/
   void duty_cycle_mode(PinName pin, int duty_cycle);
 
+  /**************************************************************************//**
+   * PWM signal generation in duty cycle mode with a full scale 16-bit duty cycle
+   * Works the same as duty_cycle_mode() regardless of the configured write
+   * resolution - used by drivers which fade outputs with fine steps.
+   *
+   * @param[in] pin output pin for the PWM signal
+   * @param[in] duty_cycle duty cycle for the PWM signal (0-65535)
+   *****************************************************************************/
+  void duty_cycle_mode_16bit(PinName pin, uint16_t duty_cycle);
+
   /**************************************************************************//**
    * PWM signal generation in frequency mode
    * In this mode the duty cycle is fixed at 50% and the frequency
@@ -81,7 +91,8 @@ public:
 
   /***************************************************************************//**
    * Sets the write resolution in bits.
-   * The default is 8 bits, the maximum is 12 bits.
+   * The default is 8 bits, the maximum is 16 bits.
+   * The effective resolution is limited by the top value of the PWM timer.
    *
    * @param[in] resolution the requested write resolution in bits
    ******************************************************************************/
@@ -110,6 +121,15 @@ private:
    *****************************************************************************/
   bool init(PinName pin, int frequency);
 
+  /**************************************************************************//**
+   * Sets the duty cycle of a pin in duty cycle mode
+   *
+   * @param[in] pin output pin for the PWM signal
+   * @param[in] duty_cycle duty cycle for the PWM signal (0 to max_value)
+   * @param[in] max_value the duty cycle value representing 100%
+   *****************************************************************************/
+  void set_duty_cycle(PinName pin, uint32_t duty_cycle, uint32_t max_value);
+
   enum pwm_mode_t {
     DUTY_CYCLE,
     FREQUENCY
@@ -131,11 +151,11 @@ private:
 
   uint8_t duty_cycle_mode_write_resolution;
   uint32_t duty_cycle_mode_max_value;
-  static const uint8_t duty_cycle_mode_write_resolution_max = 12u;
+  static const uint8_t duty_cycle_mode_write_resolution_max = 16u;
 
   typedef struct {
     PinName pin;
-    uint8_t duty_cycle_percent;
+    uint32_t compare;
     sl_pwm_instance_t inst;
   } pwm_pin_t;
 
@@ -26,6 +26,8 @@
 
 #include <cstdio>
 #include "silabs_additional.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
 extern "C" {
   #include "em_emu.h"
   #include "em_cmu.h"
@@ -95,6 +97,117 @@ uint32_t getCPUClock()
   return SystemCoreClockGet();
 }
 
+static StaticSemaphore_t gpcrc_mutex_buf;
+static SemaphoreHandle_t gpcrc_mutex = xSemaphoreCreateMutexStatic(&gpcrc_mutex_buf);
+
+// Feeds the data to the GPCRC - the aligned part is written in 32-bit words which are processed LSB first
+static uint32_t gpcrc_calculate(const uint8_t* data, size_t len, uint32_t ctrl, uint32_t poly, uint32_t init)
+{
+  xSemaphoreTake(gpcrc_mutex, portMAX_DELAY);
+  CMU_ClockEnable(cmuClock_GPCRC, true);
+  GPCRC->EN_SET = GPCRC_EN_EN;
+  GPCRC->CTRL = ctrl;
+  GPCRC->POLY = poly;
+  GPCRC->INIT = init;
+  GPCRC->CMD = GPCRC_CMD_INIT;
+
+  while (len > 0u && ((uintptr_t)data & 0x3u) != 0u) {
+    GPCRC->INPUTDATABYTE = *data++;
+    len--;
+  }
+  while (len >= 4u) {
+    GPCRC->INPUTDATA = *(const uint32_t*)data;
+    data += 4u;
+    len -= 4u;
+  }
+  while (len > 0u) {
+    GPCRC->INPUTDATABYTE = *data++;
+    len--;
+  }
+
+  uint32_t crc = GPCRC->DATA;
+  xSemaphoreGive(gpcrc_mutex);
+  return crc;
+}
+
+uint32_t calculateCRC32(const uint8_t* data, size_t len)
+{
+  return gpcrc_calculate(data, len, GPCRC_CTRL_POLYSEL_CRC32, 0u, 0xFFFFFFFFu) ^ 0xFFFFFFFFu;
+}
+
+uint16_t calculateCRC16(const uint8_t* data, size_t len, uint16_t polynomial, uint16_t init)
+{
+  // The GPCRC expects custom polynomials in reversed bit order
+  uint32_t poly_reversed = __RBIT((uint32_t)polynomial) >> 16;
+  return (uint16_t)gpcrc_calculate(data, len, GPCRC_CTRL_POLYSEL_CRC16, poly_reversed, init);
+}
+
+static uint32_t boot_phase_start_times[BOOT_PHASE_COUNT];
+static uint32_t boot_phase_end_times[BOOT_PHASE_COUNT];
+
+static const char* const boot_phase_names[BOOT_PHASE_COUNT] = {
+  "Platform init",
+  "Matter init",
+  "Device info init",
+  "Peripheral deinit",
+  "setup()",
+};
+
+void bootPhaseStart(boot_phase_t phase)
+{
+  if (phase < BOOT_PHASE_COUNT) {
+    boot_phase_start_times[phase] = micros();
+  }
+}
+
+void bootPhaseEnd(boot_phase_t phase)
+{
+  if (phase < BOOT_PHASE_COUNT) {
+    boot_phase_end_times[phase] = micros();
+  }
+}
+
+uint32_t getBootPhaseStartTime(boot_phase_t phase)
+{
+  if (phase >= BOOT_PHASE_COUNT) {
+    return 0u;
+  }
+  return boot_phase_start_times[phase];
+}
+
+uint32_t getBootPhaseEndTime(boot_phase_t phase)
+{
+  if (phase >= BOOT_PHASE_COUNT) {
+    return 0u;
+  }
+  return boot_phase_end_times[phase];
+}
+
+void printBootReport(Print& output)
+{
+  output.println("Boot report (us):");
+  for (int phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+    uint32_t start = boot_phase_start_times[phase];
+    uint32_t end = boot_phase_end_times[phase];
+    // Phases which haven't started are skipped - the platform init starts before the sleeptimer, so its start is 0
+    if (start == 0u && end == 0u) {
+      continue;
+    }
+    output.print("  ");
+    output.print(boot_phase_names[phase]);
+    output.print(": start ");
+    output.print(start);
+    if (end == 0u) {
+      output.println(", running");
+      continue;
+    }
+    output.print(", end ");
+    output.print(end);
+    output.print(", took ");
+    output.println(end - start);
+  }
+}
+
 void I2C_Deinit(I2C_TypeDef* i2c_peripheral) {
   I2C_Reset(i2c_peripheral);
 
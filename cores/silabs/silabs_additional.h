@@ -38,6 +38,15 @@ typedef enum {
   CPU_80MHZ
 } cpu_clock_t;
 
+typedef enum {
+  BOOT_PHASE_PLATFORM_INIT,     // sl_system_init() or the Matter platform init
+  BOOT_PHASE_MATTER_INIT,       // Provisioning check and Matter stack init
+  BOOT_PHASE_DEVICE_INFO_INIT,  // Matter device info provider and attestation credentials
+  BOOT_PHASE_PERIPHERAL_DEINIT, // Serial, Wire and SPI returned to their reset state
+  BOOT_PHASE_SETUP,             // The sketch's setup()
+  BOOT_PHASE_COUNT
+} boot_phase_t;
+
 /***************************************************************************//**
  * Returns the internal die temperature sensor's measured value in Celsius
  * The sensor is factory calibrated and has an accuracy of +/- 1.5 degrees and
@@ -87,6 +96,83 @@ void setCPUClock(cpu_clock_t clock);
  ******************************************************************************/
 uint32_t getCPUClock();
 
+/***************************************************************************//**
+ * Calculates the CRC-32 (IEEE 802.3) checksum of a buffer using the GPCRC
+ * hardware. The result is the same as the one of zlib's crc32().
+ *
+ * @param[in] data pointer to the data
+ * @param[in] len length of the data in bytes
+ *
+ * @return the CRC-32 checksum of the data
+ ******************************************************************************/
+uint32_t calculateCRC32(const uint8_t* data, size_t len);
+
+/***************************************************************************//**
+ * Calculates a reflected CRC-16 checksum of a buffer using the GPCRC hardware.
+ * The default parameters produce the CRC-16/MODBUS checksum.
+ *
+ * @param[in] data pointer to the data
+ * @param[in] len length of the data in bytes
+ * @param[in] polynomial the CRC polynomial in normal (non-reversed) notation
+ * @param[in] init the initial value of the CRC
+ *
+ * @return the CRC-16 checksum of the data
+ ******************************************************************************/
+uint16_t calculateCRC16(const uint8_t* data, size_t len, uint16_t polynomial = 0x8005u, uint16_t init = 0xFFFFu);
+
+/***************************************************************************//**
+ * Returns when a boot phase started
+ * Boot times are measured in microseconds from the start of the sleeptimer
+ * which is initialized early in the platform init.
+ *
+ * @param[in] phase the boot phase
+ *
+ * @return the start of the phase in microseconds, 0 if it hasn't started
+ ******************************************************************************/
+uint32_t getBootPhaseStartTime(boot_phase_t phase);
+
+/***************************************************************************//**
+ * Returns when a boot phase ended
+ *
+ * @param[in] phase the boot phase
+ *
+ * @return the end of the phase in microseconds, 0 if it hasn't ended
+ ******************************************************************************/
+uint32_t getBootPhaseEndTime(boot_phase_t phase);
+
+/***************************************************************************//**
+ * Prints the start, end and duration of each boot phase
+ *
+ * @param[in] output the output to print the report to (e.g. Serial)
+ ******************************************************************************/
+void printBootReport(Print& output);
+
+// Called by the core and the variants to record the boot phases
+void bootPhaseStart(boot_phase_t phase);
+void bootPhaseEnd(boot_phase_t phase);
+
+#ifdef ARDUINO_MATTER
+/***************************************************************************//**
+ * Selects the fast boot mode of the Matter stack
+ * Sketches can override this weak function to return true - the Matter stack
+ * is then initialized in a task running concurrently with setup(), so the
+ * hardware init in setup() isn't delayed by the Matter init.
+ * Matter.begin() waits until the stack is ready.
+ *
+ * @return true to initialize the Matter stack concurrently with setup()
+ ******************************************************************************/
+bool matterFastBootEnabled();
+
+/***************************************************************************//**
+ * Waits until the Matter stack is initialized
+ * Returns right away if the stack was initialized before setup().
+ ******************************************************************************/
+void waitForMatterInit();
+
+// Initializes the Matter stack - called by the variants or by the fast boot task
+void init_arduino_matter();
+#endif // ARDUINO_MATTER
+
 void I2C_Deinit(I2C_TypeDef* i2c_peripheral);
 
 #endif // SILABS_ADDITIONAL_H
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+   Matter bridge example
+
+   The example shows how to expose non-Matter devices as bridged Matter endpoints with MatterBridge.
+
+   The bridged devices come from a source - here a simulated one which stands in for BLE sensors.
+   It adds temperature, humidity and contact sensors as children of the bridge, posts their readings
+   and takes their links down and up now and then. A real source (e.g. a BLE central) implements the
+   same begin() and poll() functions and posts the values read from the GATT characteristics.
+   Links which don't report anything for a while are shown as unreachable.
+   The device has to be commissioned to a Matter hub first.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+#include <Matter.h>
+#include <MatterBridge.h>
+
+class SimulatedSensorSource : public MatterBridgeSource {
+public:
+  void begin(MatterBridge& bridge) override
+  {
+    // The addresses stand in for the BLE addresses of the sensors
+    this->children[0] = bridge.add_child(MatterBridge::child_temperature, 0x0000AABBCC000001ull, "Living room temperature");
+    this->children[1] = bridge.add_child(MatterBridge::child_humidity, 0x0000AABBCC000002ull, "Living room humidity");
+    this->children[2] = bridge.add_child(MatterBridge::child_temperature, 0x0000AABBCC000003ull, "Bedroom temperature");
+    this->children[3] = bridge.add_child(MatterBridge::child_humidity, 0x0000AABBCC000004ull, "Bedroom humidity");
+    this->children[4] = bridge.add_child(MatterBridge::child_contact, 0x0000AABBCC000005ull, "Front door");
+    this->children[5] = bridge.add_child(MatterBridge::child_contact, 0x0000AABBCC000006ull, "Window");
+  }
+
+  void poll(MatterBridge& bridge) override
+  {
+    // Wait 5 seconds between the readings
+    if ((millis() - this->last_poll) < 5000) {
+      return;
+    }
+    this->last_poll = millis();
+    this->poll_count++;
+
+    // Every sensor reports - the bridge applies all of them with the Matter stack locked once
+    bridge.post_temperature(this->children[0], 21.0f + random(-100, 100) / 100.0f);
+    bridge.post_humidity(this->children[1], 45.0f + random(-500, 500) / 100.0f);
+    bridge.post_humidity(this->children[3], 50.0f + random(-500, 500) / 100.0f);
+    bridge.post_contact(this->children[4], random(0, 2) == 1);
+    bridge.post_contact(this->children[5], true);
+
+    // The bedroom temperature sensor drops off every fourth round and comes back on the next one
+    if ((this->poll_count % 4) == 0) {
+      bridge.post_link_state(this->children[2], false);
+      Serial.println("Bedroom temperature sensor disconnected");
+    } else {
+      bridge.post_temperature(this->children[2], 19.0f + random(-100, 100) / 100.0f);
+    }
+  }
+
+private:
+  int children[6];
+  uint32_t last_poll = 0;
+  uint32_t poll_count = 0;
+};
+
+MatterBridge matter_bridge;
+SimulatedSensorSource simulated_source;
+
+void setup()
+{
+  Serial.begin(115200);
+  Matter.begin();
+
+  // Mark sensors unreachable if they're silent for 30 seconds
+  matter_bridge.set_link_timeout(30000);
+  matter_bridge.begin(&simulated_source);
+
+  Serial.println("Matter bridge");
+
+  if (!Matter.isDeviceCommissioned()) {
+    Serial.println("Matter device is not commissioned");
+    Serial.println("Commission it to your Matter hub with the manual pairing code or QR code");
+    Serial.printf("Manual pairing code: %s\n", Matter.getManualPairingCode().c_str());
+    Serial.printf("QR code URL: %s\n", Matter.getOnboardingQRCodeUrl().c_str());
+  }
+  while (!Matter.isDeviceCommissioned()) {
+    delay(200);
+  }
+
+  Serial.println("Waiting for Thread network...");
+  while (!Matter.isDeviceThreadConnected()) {
+    delay(200);
+  }
+  Serial.println("Connected to Thread network");
+}
+
+void loop()
+{
+  // Polls the source, registers new children and applies the queued updates
+  matter_bridge.process();
+
+  static uint32_t last_dropped = 0;
+  uint32_t dropped = matter_bridge.get_dropped_update_count();
+  if (dropped != last_dropped) {
+    last_dropped = dropped;
+    Serial.printf("Dropped updates: %lu\n", dropped);
+  }
+}
@@ -0,0 +1,101 @@
+/*
+   Matter fast boot example
+
+   The example shows how to make a Matter lightbulb respond to its button right after power-on.
+
+   In fast boot mode the Matter stack is initialized concurrently with setup(), so the button and the LED
+   are ready a few milliseconds after the power-on instead of after the Matter init.
+   The button controls the onboard LED even before the Matter stack is running - the state is synchronized
+   with Matter when it's ready. A boot report shows the duration of each boot phase.
+   The device has to be commissioned to a Matter hub to be controlled through Matter.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+ */
+#include <Matter.h>
+#include <MatterLightbulb.h>
+
+MatterLightbulb matter_bulb;
+
+void handle_button_press();
+void update_onboard_led(bool on);
+volatile bool button_pressed = false;
+volatile bool light_on = false;
+
+// Initialize the Matter stack concurrently with setup()
+bool matterFastBootEnabled()
+{
+  return true;
+}
+
+void setup()
+{
+  // Set up the onboard LED and button first - they work while the Matter stack is starting
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+
+  #ifndef BTN_BUILTIN
+  #define BTN_BUILTIN PA0
+  #endif
+  pinMode(BTN_BUILTIN, INPUT_PULLUP);
+  attachInterrupt(BTN_BUILTIN, &handle_button_press, FALLING);
+
+  Serial.begin(115200);
+
+  // Waits until the Matter stack is ready
+  Matter.begin();
+  matter_bulb.begin();
+
+  Serial.println("Matter fast boot");
+  printBootReport(Serial);
+
+  if (!Matter.isDeviceCommissioned()) {
+    Serial.println("Matter device is not commissioned");
+    Serial.println("Commission it to your Matter hub with the manual pairing code or QR code");
+    Serial.printf("Manual pairing code: %s\n", Matter.getManualPairingCode().c_str());
+    Serial.printf("QR code URL: %s\n", Matter.getOnboardingQRCodeUrl().c_str());
+  }
+}
+
+void loop()
+{
+  // Report the button presses to Matter - the LED has already been switched by the interrupt
+  if (button_pressed) {
+    button_pressed = false;
+    matter_bulb.set_onoff(light_on);
+    Serial.println(light_on ? "Bulb ON (button)" : "Bulb OFF (button)");
+  }
+
+  // Follow the on/off state changes from Matter
+  bool matter_lightbulb_state = matter_bulb.get_onoff();
+  if (matter_lightbulb_state != light_on && !button_pressed) {
+    light_on = matter_lightbulb_state;
+    update_onboard_led(light_on);
+    Serial.println(light_on ? "Bulb ON" : "Bulb OFF");
+  }
+}
+
+void handle_button_press()
+{
+  static uint32_t btn_last_press = 0;
+  if (millis() < btn_last_press + 200) {
+    return;
+  }
+  btn_last_press = millis();
+  // Switch the LED right away
+  light_on = !light_on;
+  update_onboard_led(light_on);
+  button_pressed = true;
+}
+
+void update_onboard_led(bool on)
+{
+  if (on) {
+    digitalWrite(LED_BUILTIN, LED_BUILTIN_ACTIVE);
+  } else {
+    digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+  }
+}
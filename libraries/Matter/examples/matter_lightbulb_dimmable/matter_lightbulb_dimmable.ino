@@ -5,6 +5,7 @@
 
    The example lets users control the onboard LED through Matter.
    It's possible to switch the LED on/off and adjust the brightness as well.
+   The on/off state and the brightness are kept across reboots.
    The device has to be commissioned to a Matter hub first.
 
    Compatible boards:
@@ -26,6 +27,8 @@ void setup()
 {
   Serial.begin(115200);
   Matter.begin();
+  // Keep the state of the bulb in NVM3 under key 1 - it's restored by begin()
+  matter_dimmable_bulb.set_persistence(1);
   matter_dimmable_bulb.begin();
 
   pinMode(LED_BUILTIN, OUTPUT);
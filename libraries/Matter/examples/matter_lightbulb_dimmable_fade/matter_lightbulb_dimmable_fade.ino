@@ -0,0 +1,69 @@
+/*
+   Matter dimmable lightbulb with smooth transitions example
+
+   The example shows how to let the Arduino Matter API drive a lightbulb's LED.
+
+   The onboard LED is driven by the lightbulb in the background. Brightness changes
+   with a transition time (e.g. from a slider or a scene) fade smoothly over the requested
+   time and turning the light on/off fades it in/out as well - loop() has nothing to do.
+   The device has to be commissioned to a Matter hub first.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+#include <Matter.h>
+#include <MatterLightbulb.h>
+
+MatterDimmableLightbulb matter_dimmable_bulb;
+
+void setup()
+{
+  Serial.begin(115200);
+  Matter.begin();
+  matter_dimmable_bulb.begin();
+
+  // Drive the onboard LED with the state of the bulb - on/off changes fade in 500 ms
+  matter_dimmable_bulb.set_output_pin(LED_BUILTIN, LED_BUILTIN_ACTIVE == LOW);
+  matter_dimmable_bulb.set_transition_time(500);
+
+  Serial.println("Matter dimmable lightbulb with smooth transitions");
+
+  if (!Matter.isDeviceCommissioned()) {
+    Serial.println("Matter device is not commissioned");
+    Serial.println("Commission it to your Matter hub with the manual pairing code or QR code");
+    Serial.printf("Manual pairing code: %s\n", Matter.getManualPairingCode().c_str());
+    Serial.printf("QR code URL: %s\n", Matter.getOnboardingQRCodeUrl().c_str());
+  }
+  while (!Matter.isDeviceCommissioned()) {
+    delay(200);
+  }
+
+  Serial.println("Waiting for Thread network...");
+  while (!Matter.isDeviceThreadConnected()) {
+    delay(200);
+  }
+  Serial.println("Connected to Thread network");
+
+  Serial.println("Waiting for Matter device discovery...");
+  while (!matter_dimmable_bulb.is_online()) {
+    delay(200);
+  }
+  Serial.println("Matter device is now online");
+}
+
+void loop()
+{
+  // The LED is updated in the background - print the state once a transition is done
+  static bool last_transitioning = false;
+  bool transitioning = matter_dimmable_bulb.is_transitioning();
+  if (last_transitioning && !transitioning) {
+    Serial.printf("Bulb %s, brightness: %u%%\n", matter_dimmable_bulb.get_onoff() ? "ON" : "OFF", matter_dimmable_bulb.get_brightness_percent());
+  }
+  last_transitioning = transitioning;
+  delay(50);
+}
@@ -0,0 +1,98 @@
+/*
+   Matter event driven lightbulb example
+
+   The example shows how to react to Matter events instead of polling the device state.
+
+   The example lets users control the onboard LED through Matter.
+   The sketch blocks on the Matter event queue - it wakes up right when the device is
+   commissioned, joins the Thread network, gets discovered or the controller changes
+   the lightbulb, and the device can sleep in the meantime.
+   The device has to be commissioned to a Matter hub first.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+#include <Matter.h>
+#include <MatterLightbulb.h>
+
+MatterLightbulb matter_bulb;
+
+void update_onboard_led(bool on);
+void handle_bulb_change(const matter_event_t& event);
+
+void setup()
+{
+  Serial.begin(115200);
+  Matter.begin();
+  matter_bulb.begin();
+  // Called from Matter.waitForEvent() when the controller changes the bulb
+  matter_bulb.set_change_callback(handle_bulb_change);
+
+  pinMode(LED_BUILTIN, OUTPUT);
+  update_onboard_led(false);
+
+  Serial.println("Matter event driven lightbulb");
+
+  // Events only report changes - print the state at startup
+  if (!Matter.isDeviceCommissioned()) {
+    Serial.println("Matter device is not commissioned");
+    Serial.println("Commission it to your Matter hub with the manual pairing code or QR code");
+    Serial.printf("Manual pairing code: %s\n", Matter.getManualPairingCode().c_str());
+    Serial.printf("QR code URL: %s\n", Matter.getOnboardingQRCodeUrl().c_str());
+  } else if (Matter.isDeviceThreadConnected()) {
+    Serial.println("Connected to Thread network");
+  }
+}
+
+void loop()
+{
+  // Sleep until the next Matter event
+  matter_event_t event;
+  if (!Matter.waitForEvent(event)) {
+    return;
+  }
+
+  switch (event.type) {
+    case MATTER_EVENT_COMMISSIONED:
+      Serial.println("Matter device commissioned");
+      break;
+    case MATTER_EVENT_DECOMMISSIONED:
+      Serial.println("Matter device decommissioned");
+      break;
+    case MATTER_EVENT_THREAD_ATTACHED:
+      Serial.println("Connected to Thread network");
+      break;
+    case MATTER_EVENT_THREAD_DETACHED:
+      Serial.println("Disconnected from Thread network");
+      break;
+    case MATTER_EVENT_ONLINE:
+      Serial.printf("Endpoint %u is now online\n", event.endpoint_id);
+      break;
+    default:
+      break;
+  }
+}
+
+void handle_bulb_change(const matter_event_t& event)
+{
+  if (event.type != MATTER_EVENT_ATTRIBUTE_WRITE) {
+    return;
+  }
+  bool on = matter_bulb.get_onoff();
+  update_onboard_led(on);
+  Serial.printf("Bulb %s\n", on ? "ON" : "OFF");
+}
+
+void update_onboard_led(bool on)
+{
+  if (on) {
+    digitalWrite(LED_BUILTIN, LED_BUILTIN_ACTIVE);
+  } else {
+    digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+  }
+}
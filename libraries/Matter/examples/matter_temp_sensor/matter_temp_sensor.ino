@@ -4,6 +4,7 @@
    The example shows how to create a temperature sensor with the Arduino Matter API.
 
    The example creates a Matter temperature sensor device and publishes the current CPU temperature through it.
+   A reporting policy keeps the small fluctuations of the reading from generating Matter reports.
    The device has to be commissioned to a Matter hub first.
 
    Compatible boards:
@@ -24,6 +25,10 @@ void setup()
   Serial.begin(115200);
   Matter.begin();
   matter_temp_sensor.begin();
+  // Smooth the readings and only report changes larger than 0.2 C - at most every 10 seconds, at least every 5 minutes
+  matter_temp_sensor.set_report_smoothing(0.25f);
+  matter_temp_sensor.set_report_deadband(20);
+  matter_temp_sensor.set_report_interval(10000, 300000);
 
   Serial.println("Matter temperature sensor");
 
@@ -20,6 +20,10 @@
 #define LED_G LED_BUILTIN_1
 #define LED_B LED_BUILTIN_2
 
+// The LEDs are driven with 12 bit PWM for smooth fading at low brightness
+#define LED_PWM_RESOLUTION 12
+#define LED_PWM_MAX ((1 << LED_PWM_RESOLUTION) - 1)
+
 MatterColorLightbulb matter_color_bulb;
 
 void update_led_color();
@@ -33,6 +37,7 @@ void setup()
   Matter.begin();
   matter_color_bulb.begin();
   matter_color_bulb.boost_saturation(51); // Boost saturation by 20 percent
+  analogWriteResolution(LED_PWM_RESOLUTION);
 
   // Set up the onboard button
   pinMode(BTN_BUILTIN, INPUT_PULLUP);
@@ -116,13 +121,14 @@ void update_led_color()
   if (!matter_color_bulb.get_onoff()) {
     return;
   }
-  uint8_t r, g, b;
-  matter_color_bulb.get_rgb(&r, &g, &b);
+  // Get the gamma and brightness corrected duty cycles for the LEDs
+  uint16_t r, g, b;
+  matter_color_bulb.get_rgb_pwm(&r, &g, &b, LED_PWM_RESOLUTION);
   // If our built-in LED is active LOW, we need to invert the brightness values
   if (LED_BUILTIN_ACTIVE == LOW) {
-    analogWrite(LED_R, 255 - r);
-    analogWrite(LED_G, 255 - g);
-    analogWrite(LED_B, 255 - b);
+    analogWrite(LED_R, LED_PWM_MAX - r);
+    analogWrite(LED_G, LED_PWM_MAX - g);
+    analogWrite(LED_B, LED_PWM_MAX - b);
   } else {
     analogWrite(LED_R, r);
     analogWrite(LED_G, g);
@@ -136,9 +142,9 @@ void led_off()
 {
   // If our built-in LED is active LOW, we need to invert the brightness values
   if (LED_BUILTIN_ACTIVE == LOW) {
-    analogWrite(LED_R, 255);
-    analogWrite(LED_G, 255);
-    analogWrite(LED_B, 255);
+    analogWrite(LED_R, LED_PWM_MAX);
+    analogWrite(LED_G, LED_PWM_MAX);
+    analogWrite(LED_B, LED_PWM_MAX);
   } else {
     analogWrite(LED_R, 0);
     analogWrite(LED_G, 0);
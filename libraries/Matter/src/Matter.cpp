@@ -93,15 +93,20 @@ void TriggerIdentifyEffectHandler(::Identify* identify)
   ;
 }
 
+ArduinoMatterAppliance* ArduinoMatterAppliance::callback_appliances_head = nullptr;
+
 ArduinoMatterAppliance::ArduinoMatterAppliance() :
-  base_matter_device(nullptr)
+  base_matter_device(nullptr),
+  persistence_key(0u),
+  change_callback(nullptr),
+  next_callback_appliance(nullptr)
 {
   ;
 }
 
 ArduinoMatterAppliance::~ArduinoMatterAppliance()
 {
-  ;
+  this->unlink_change_callback();
 }
 
 bool ArduinoMatterAppliance::get_identify_in_progress()
@@ -148,9 +153,169 @@ bool ArduinoMatterAppliance::is_online()
   return false;
 }
 
+/***************************************************************************//**
+ * Enables keeping the state of the device in NVM3 across reboots
+ * Must be called before begin() - the stored state is restored when the
+ * device is created, before its endpoint is published. Only devices with a
+ * state (lightbulbs, plugs, thermostats, window coverings and fans) are
+ * persisted.
+ *
+ * @param[in] key the NVM3 key of the state, unique for each device (1-0xFFFF)
+ ******************************************************************************/
+void ArduinoMatterAppliance::set_persistence(uint16_t key)
+{
+  this->persistence_key = key;
+}
+
+/***************************************************************************//**
+ * Restores the state of the device if persistence is enabled
+ * Called by begin() between creating the device and adding its endpoint.
+ *
+ * @return true if a stored state was restored
+ ******************************************************************************/
+bool ArduinoMatterAppliance::restore_persistent_state()
+{
+  if (this->base_matter_device == nullptr || this->persistence_key == 0u) {
+    return false;
+  }
+  return this->base_matter_device->EnablePersistence(this->persistence_key);
+}
+
+/***************************************************************************//**
+ * Sets a callback for the events of the device's endpoint
+ * The callback gets the MATTER_EVENT_ONLINE and MATTER_EVENT_ATTRIBUTE_WRITE
+ * events of the endpoint - e.g. when the controller turns a lightbulb on.
+ * It's called from Matter.waitForEvent() in the sketch's context, so the
+ * appliance's functions can be used from it.
+ *
+ * @param[in] callback the change callback - nullptr to remove it
+ ******************************************************************************/
+void ArduinoMatterAppliance::set_change_callback(matter_change_callback_t callback)
+{
+  this->unlink_change_callback();
+  if (callback == nullptr) {
+    return;
+  }
+  taskENTER_CRITICAL();
+  this->change_callback = callback;
+  this->next_callback_appliance = callback_appliances_head;
+  callback_appliances_head = this;
+  taskEXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * Removes the appliance from the ones with a change callback
+ ******************************************************************************/
+void ArduinoMatterAppliance::unlink_change_callback()
+{
+  taskENTER_CRITICAL();
+  ArduinoMatterAppliance** link = &callback_appliances_head;
+  while (*link && *link != this) {
+    link = &(*link)->next_callback_appliance;
+  }
+  if (*link) {
+    *link = this->next_callback_appliance;
+  }
+  this->next_callback_appliance = nullptr;
+  this->change_callback = nullptr;
+  taskEXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * Calls the change callback of the appliance the event belongs to
+ *
+ * @param[in] event the event received from the queue
+ ******************************************************************************/
+void ArduinoMatterAppliance::dispatch_event(const matter_event_t& event)
+{
+  if (event.type != MATTER_EVENT_ONLINE && event.type != MATTER_EVENT_ATTRIBUTE_WRITE) {
+    return;
+  }
+  matter_change_callback_t callback = nullptr;
+  taskENTER_CRITICAL();
+  for (ArduinoMatterAppliance* appliance = callback_appliances_head; appliance; appliance = appliance->next_callback_appliance) {
+    if (appliance->base_matter_device && appliance->base_matter_device->GetEndpointId() == event.endpoint_id) {
+      callback = appliance->change_callback;
+      break;
+    }
+  }
+  taskEXIT_CRITICAL();
+  if (callback) {
+    callback(event);
+  }
+}
+
+/***************************************************************************//**
+ * Sets the absolute reporting deadband
+ * New measurements within the deadband around the last reported value
+ * are not reported.
+ *
+ * @param[in] raw_delta the deadband in the raw units of the sensor
+ ******************************************************************************/
+void ArduinoMatterMeasurementAppliance::set_report_deadband(uint32_t raw_delta)
+{
+  this->report_deadband = raw_delta;
+  this->report_policy.set_deadband(this->report_deadband, this->report_deadband_percent);
+}
+
+/***************************************************************************//**
+ * Sets the relative reporting deadband
+ * The larger of the absolute and the relative deadband is used.
+ *
+ * @param[in] percent the deadband in percent of the last reported value
+ ******************************************************************************/
+void ArduinoMatterMeasurementAppliance::set_report_deadband_percent(float percent)
+{
+  this->report_deadband_percent = percent;
+  this->report_policy.set_deadband(this->report_deadband, this->report_deadband_percent);
+}
+
+/***************************************************************************//**
+ * Sets the time limits between reports
+ * The limits are checked when a new measurement is set - measurements
+ * arriving sooner than the minimum interval are dropped. After the maximum
+ * interval the next measurement is reported even if it's within the deadband.
+ *
+ * @param[in] min_interval_ms the minimum time between reports - 0 for no limit
+ * @param[in] max_interval_ms the maximum time without a report - 0 to disable
+ ******************************************************************************/
+void ArduinoMatterMeasurementAppliance::set_report_interval(uint32_t min_interval_ms, uint32_t max_interval_ms)
+{
+  this->report_policy.set_intervals(min_interval_ms, max_interval_ms);
+}
+
+/***************************************************************************//**
+ * Enables smoothing of the measurements with an exponential moving average
+ *
+ * @param[in] factor the weight of a new measurement between 0 and 1 - 0 disables smoothing
+ ******************************************************************************/
+void ArduinoMatterMeasurementAppliance::set_report_smoothing(float factor)
+{
+  this->report_policy.set_smoothing(factor);
+}
+
+/***************************************************************************//**
+ * Runs a new measurement through the reporting policy
+ *
+ * @param[in] value the new measurement in raw units
+ * @param[out] report_value the value to publish
+ * @param[out] forced true if the value has to be published even if it's unchanged
+ *
+ * @return true if the value has to be published, false otherwise
+ ******************************************************************************/
+bool ArduinoMatterMeasurementAppliance::filter_measurement(int32_t value, int32_t& report_value, bool& forced)
+{
+  return this->report_policy.update(value, millis(), report_value, forced);
+}
+
 void MatterClass::begin()
 {
+  // The Matter stack may still be starting in fast boot mode
+  waitForMatterInit();
   InitDynamicEndpointHandler();
+  PlatformMgr().LockChipStack();
+  MatterEventsInit();
+  PlatformMgr().UnlockChipStack();
 }
 
 String MatterClass::getManualPairingCode()
@@ -194,17 +359,61 @@ bool MatterClass::isDeviceThreadConnected()
   return ConnectivityMgr().IsThreadAttached();
 }
 
-MatterClass Matter;
+/***************************************************************************//**
+ * Sets the delay between a change of a persisted device and writing it to NVM3
+ * Longer delays coalesce more changes into one flash write.
+ *
+ * @param[in] delay_ms the write delay in milliseconds
+ ******************************************************************************/
+void MatterClass::setPersistenceWriteDelay(uint32_t delay_ms)
+{
+  Device::SetPersistenceWriteDelay(delay_ms);
+}
+
+/***************************************************************************//**
+ * Writes the pending state of all persisted devices to NVM3 right away
+ * Call it before a planned reset or power down.
+ ******************************************************************************/
+void MatterClass::flushPersistentState()
+{
+  Device::FlushAllPersistentStates();
+}
 
-void CallMatterReportingCallback(intptr_t closure)
+/***************************************************************************//**
+ * Waits for the next Matter event
+ * Commissioning, Thread network and endpoint events are queued by the
+ * Matter stack - the sketch can block here instead of polling the getters
+ * and the device can sleep in the meantime. The change callback of the
+ * event's endpoint is called before returning (see set_change_callback()).
+ * Only changes are reported - use the getters for the state at startup.
+ *
+ * @param[out] event the received event
+ * @param[in] timeout_ms the maximum time to wait - UINT32_MAX waits forever
+ *
+ * @return true if an event was received, false on timeout
+ ******************************************************************************/
+bool MatterClass::waitForEvent(matter_event_t& event, uint32_t timeout_ms)
 {
-  auto path = reinterpret_cast<app::ConcreteAttributePath*>(closure);
-  MatterReportingAttributeChangeCallback(*path);
-  Platform::Delete(path);
+  TickType_t timeout_ticks = portMAX_DELAY;
+  if (timeout_ms != UINT32_MAX) {
+    timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+  }
+  if (!MatterReceiveEvent(event, timeout_ticks)) {
+    return false;
+  }
+  ArduinoMatterAppliance::dispatch_event(event);
+  return true;
 }
 
-void ScheduleMatterReportingCallback(EndpointId endpointId, ClusterId cluster, AttributeId attribute)
+/***************************************************************************//**
+ * Provides the number of events dropped because the queue was full
+ * The queue length can be set with the MATTER_EVENT_QUEUE_LENGTH build flag.
+ *
+ * @return the number of dropped events
+ ******************************************************************************/
+uint32_t MatterClass::getDroppedEventCount()
 {
-  auto* path = Platform::New<app::ConcreteAttributePath>(endpointId, cluster, attribute);
-  chip::DeviceLayer::PlatformMgr().ScheduleWork(CallMatterReportingCallback, reinterpret_cast<intptr_t>(path));
+  return MatterGetDroppedEventCount();
 }
+
+MatterClass Matter;
@@ -34,6 +34,8 @@
 #include "Arduino.h"
 #include "MatterEndpointHandler.h"
 #include "MatterEndpoint.h"
+#include "MatterEvents.h"
+#include "util/report_policy.h"
 #include <platform/CHIPDeviceLayer.h>
 #include <app-common/zap-generated/attributes/Accessors.h>
 #include <app/server/OnboardingCodesUtil.h>
@@ -57,9 +59,38 @@ public:
   void set_product_name(const char* product_name);
   void set_serial_number(const char* serial_number);
   bool is_online();
+  void set_persistence(uint16_t key);
+  void set_change_callback(matter_change_callback_t callback);
 
 protected:
+  bool restore_persistent_state();
   Device* base_matter_device;
+  uint16_t persistence_key;
+
+private:
+  friend class MatterClass;
+  static void dispatch_event(const matter_event_t& event);
+  void unlink_change_callback();
+  matter_change_callback_t change_callback;
+  ArduinoMatterAppliance* next_callback_appliance;
+  static ArduinoMatterAppliance* callback_appliances_head;
+};
+
+// Base of the measurement sensors - adds a reporting policy to limit the number of reports
+class ArduinoMatterMeasurementAppliance : public ArduinoMatterAppliance {
+public:
+  void set_report_deadband(uint32_t raw_delta);
+  void set_report_deadband_percent(float percent);
+  void set_report_interval(uint32_t min_interval_ms, uint32_t max_interval_ms);
+  void set_report_smoothing(float factor);
+
+protected:
+  bool filter_measurement(int32_t value, int32_t& report_value, bool& forced);
+
+private:
+  ReportPolicy report_policy;
+  uint32_t report_deadband = 0u;
+  float report_deadband_percent = 0.0f;
 };
 
 class MatterClass {
@@ -69,6 +100,10 @@ public:
   static String getOnboardingQRCodeUrl();
   static bool isDeviceCommissioned();
   static bool isDeviceThreadConnected();
+  static void setPersistenceWriteDelay(uint32_t delay_ms);
+  static void flushPersistentState();
+  static bool waitForEvent(matter_event_t& event, uint32_t timeout_ms = UINT32_MAX);
+  static uint32_t getDroppedEventCount();
 };
 
 extern MatterClass Matter;
@@ -77,7 +112,4 @@ void IdentifyStartHandler(::Identify* identify);
 void IdentifyStopHandler(::Identify* identify);
 void TriggerIdentifyEffectHandler(::Identify* identify);
 
-void CallMatterReportingCallback(intptr_t closure);
-void ScheduleMatterReportingCallback(EndpointId endpointId, ClusterId cluster, AttributeId attribute);
-
 #endif // MATTER_H
@@ -65,8 +65,7 @@ public:
 
 private:
   DeviceAirQualitySensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceAirQualitySensor> device_endpoint;
   bool initialized;
 };
 
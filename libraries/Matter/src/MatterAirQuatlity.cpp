@@ -47,13 +47,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType airQualityEndpointType = DynamicEndpointType(airQualityEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterAirQuality
  ******************************************************************************/
 MatterAirQuality::MatterAirQuality() :
   sensor_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -79,7 +79,7 @@ bool MatterAirQuality::begin()
   }
 
   // Create new device
-  DeviceAirQualitySensor* sensor = new (std::nothrow)DeviceAirQualitySensor("Air Quality sensor", 0);
+  DeviceAirQualitySensor* sensor = this->device_endpoint.create<DeviceAirQualitySensor>("Air Quality sensor", 0);
   if (sensor == nullptr) {
     return false;
   }
@@ -89,40 +89,12 @@ bool MatterAirQuality::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = sensor;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(sensor);
-    return false;
-  }
-  new_endpoint->cluster = airQualityEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(airQualityEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(airQualityEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_sensor_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_sensor_data_version == nullptr) {
-    delete(sensor);
-    free(new_endpoint);
-    return false;
-  }
-
   // Add new endpoint
-  int result = AddDeviceEndpoint(sensor,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gAirQualitySensorDeviceTypes),
-                                 Span<DataVersion>(new_sensor_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(sensor);
-    free(new_endpoint);
-    free(new_sensor_data_version);
+  if (!this->device_endpoint.add(airQualityEndpointType, Span<const EmberAfDeviceType>(gAirQualitySensorDeviceTypes))) {
     return false;
   }
 
   this->sensor_device = sensor;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_sensor_data_version;
   this->initialized = true;
   return true;
 }
@@ -135,10 +107,7 @@ void MatterAirQuality::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->sensor_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->sensor_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
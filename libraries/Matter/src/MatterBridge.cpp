@@ -0,0 +1,476 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MatterBridge.h"
+
+using namespace ::chip;
+using namespace ::chip::app::Clusters;
+
+static_assert(MATTER_BRIDGE_MAX_CHILDREN < UINT8_MAX, "Queued updates store the child index in a byte");
+
+/***************************************************************************//**
+ * Constructor for MatterBridge
+ ******************************************************************************/
+MatterBridge::MatterBridge() :
+  source(nullptr),
+  update_head(0u),
+  update_count(0u),
+  dropped_updates(0u),
+  link_timeout_ms(0u),
+  initialized(false)
+{
+  memset(this->children, 0, sizeof(this->children));
+}
+
+/***************************************************************************//**
+ * Destructor for MatterBridge
+ ******************************************************************************/
+MatterBridge::~MatterBridge()
+{
+  this->end();
+}
+
+/***************************************************************************//**
+ * Initializes the MatterBridge instance
+ *
+ * @param[in] source the source of the bridged devices - optional, children can
+ *                   also be added and updated directly
+ *
+ * @return true if the initialization succeeded, false otherwise
+ ******************************************************************************/
+bool MatterBridge::begin(MatterBridgeSource* source)
+{
+  if (this->initialized) {
+    return false;
+  }
+  this->source = source;
+  this->initialized = true;
+  if (this->source) {
+    this->source->begin(*this);
+  }
+  return true;
+}
+
+/***************************************************************************//**
+ * Deinitializes the MatterBridge instance and removes all the children
+ ******************************************************************************/
+void MatterBridge::end()
+{
+  if (!this->initialized) {
+    return;
+  }
+  for (int i = 0; i < MATTER_BRIDGE_MAX_CHILDREN; i++) {
+    this->remove_child(i);
+  }
+  this->source = nullptr;
+  this->initialized = false;
+}
+
+/***************************************************************************//**
+ * Adds a bridged device
+ * The device shows up as a Matter endpoint on the next call of process() -
+ * the endpoints added between two calls are registered in one batch.
+ * Must be called from the same task as process().
+ *
+ * @param[in] type the type of the device
+ * @param[in] address the address of the device on its own network - e.g. the BLE address
+ * @param[in] name the name of the device
+ *
+ * @return the index of the child or -1 on failure
+ ******************************************************************************/
+int MatterBridge::add_child(child_types_e type, uint64_t address, const char* name)
+{
+  if (!this->initialized || name == nullptr || this->find_child(address) >= 0) {
+    return -1;
+  }
+
+  int index = -1;
+  for (int i = 0; i < MATTER_BRIDGE_MAX_CHILDREN; i++) {
+    if (!this->children[i].in_use) {
+      index = i;
+      break;
+    }
+  }
+  if (index < 0) {
+    return -1;
+  }
+
+  Device* device = nullptr;
+  switch (type) {
+    case child_temperature:
+      device = gDevicePool.create<DeviceTempSensor>(name, -4000, 10000, 0);
+      if (device) {
+        device->SetProductName("Temperature sensor");
+      }
+      break;
+
+    case child_humidity:
+      device = gDevicePool.create<DeviceHumiditySensor>(name, 0, 10000, 0);
+      if (device) {
+        device->SetProductName("Humidity sensor");
+      }
+      break;
+
+    case child_contact:
+      device = gDevicePool.create<DeviceContactSensor>(name);
+      if (device) {
+        device->SetProductName("Contact sensor");
+      }
+      break;
+  }
+  if (device == nullptr) {
+    return -1;
+  }
+
+  // The address is the serial number - it identifies the device across reboots of the bridge
+  char serial_number[17];
+  snprintf(serial_number, sizeof(serial_number), "%08lX%08lX", (unsigned long)(address >> 32), (unsigned long)(address & 0xFFFFFFFFu));
+  device->SetSerialNumber(serial_number);
+  // The device is unreachable until its link is reported up
+  device->SetReachable(false);
+
+  child_t& child = this->children[index];
+  child.address = address;
+  child.device = device;
+  child.data_versions = nullptr;
+  child.last_seen_ms = millis();
+  child.type = type;
+  child.registered = false;
+  child.connected = false;
+  child.in_use = true;
+  return index;
+}
+
+/***************************************************************************//**
+ * Removes a bridged device and its endpoint
+ * Must be called from the same task as process().
+ *
+ * @param[in] child the index of the child
+ ******************************************************************************/
+void MatterBridge::remove_child(int child)
+{
+  if (child < 0 || child >= MATTER_BRIDGE_MAX_CHILDREN || !this->children[child].in_use) {
+    return;
+  }
+
+  // Drop the updates still waiting for the child - the slot may be reused right away
+  taskENTER_CRITICAL();
+  for (size_t i = 0u; i < this->update_count; i++) {
+    update_t& update = this->updates[(this->update_head + i) % MATTER_BRIDGE_UPDATE_QUEUE_SIZE];
+    if (update.child == child) {
+      update.child = UINT8_MAX;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  this->release_child(this->children[child]);
+}
+
+/***************************************************************************//**
+ * Finds a bridged device by its address
+ *
+ * @param[in] address the address of the device
+ *
+ * @return the index of the child or -1 if there's no such child
+ ******************************************************************************/
+int MatterBridge::find_child(uint64_t address)
+{
+  for (int i = 0; i < MATTER_BRIDGE_MAX_CHILDREN; i++) {
+    if (this->children[i].in_use && this->children[i].address == address) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/***************************************************************************//**
+ * Posts a new temperature reading of a child
+ * Readings also mark the link of the child as up.
+ *
+ * @param[in] child the index of the child
+ * @param[in] celsius the measured temperature in celsius
+ *
+ * @return true if the update was queued, false otherwise
+ ******************************************************************************/
+bool MatterBridge::post_temperature(int child, float celsius)
+{
+  return this->post_update(child, update_measurement, static_cast<int32_t>(celsius * 100.0f));
+}
+
+/***************************************************************************//**
+ * Posts a new relative humidity reading of a child
+ * Readings also mark the link of the child as up.
+ *
+ * @param[in] child the index of the child
+ * @param[in] percent the measured relative humidity in percent
+ *
+ * @return true if the update was queued, false otherwise
+ ******************************************************************************/
+bool MatterBridge::post_humidity(int child, float percent)
+{
+  return this->post_update(child, update_measurement, static_cast<int32_t>(percent * 100.0f));
+}
+
+/***************************************************************************//**
+ * Posts a new contact state of a child
+ * Readings also mark the link of the child as up.
+ *
+ * @param[in] child the index of the child
+ * @param[in] closed true if the contact is closed
+ *
+ * @return true if the update was queued, false otherwise
+ ******************************************************************************/
+bool MatterBridge::post_contact(int child, bool closed)
+{
+  return this->post_update(child, update_measurement, closed ? 1 : 0);
+}
+
+/***************************************************************************//**
+ * Posts the link state of a child
+ * The link state is shown with the Reachable attribute of the child.
+ *
+ * @param[in] child the index of the child
+ * @param[in] connected true if the link is up
+ *
+ * @return true if the update was queued, false otherwise
+ ******************************************************************************/
+bool MatterBridge::post_link_state(int child, bool connected)
+{
+  return this->post_update(child, update_link_state, connected ? 1 : 0);
+}
+
+/***************************************************************************//**
+ * Sets the time after which a child without updates is marked unreachable
+ *
+ * @param[in] timeout_ms the timeout in milliseconds - 0 disables the timeout
+ ******************************************************************************/
+void MatterBridge::set_link_timeout(uint32_t timeout_ms)
+{
+  this->link_timeout_ms = timeout_ms;
+}
+
+/***************************************************************************//**
+ * Processes the bridge - should be called periodically from loop()
+ * Polls the source, registers the new children in one batch and applies all
+ * the queued updates with the Matter stack locked once.
+ ******************************************************************************/
+void MatterBridge::process()
+{
+  if (!this->initialized) {
+    return;
+  }
+  if (this->source) {
+    this->source->poll(*this);
+  }
+  this->register_pending_children();
+
+  PlatformMgr().LockChipStack();
+  this->apply_updates();
+  this->check_link_timeouts();
+  PlatformMgr().UnlockChipStack();
+}
+
+/***************************************************************************//**
+ * Checks whether the endpoint of a child is registered and its link is up
+ *
+ * @param[in] child the index of the child
+ *
+ * @return true if the child is online, false otherwise
+ ******************************************************************************/
+bool MatterBridge::is_child_online(int child)
+{
+  if (child < 0 || child >= MATTER_BRIDGE_MAX_CHILDREN || !this->children[child].in_use) {
+    return false;
+  }
+  return this->children[child].registered && this->children[child].connected;
+}
+
+/***************************************************************************//**
+ * Provides the number of updates dropped because the queue was full
+ *
+ * @return the number of dropped updates
+ ******************************************************************************/
+uint32_t MatterBridge::get_dropped_update_count()
+{
+  return this->dropped_updates;
+}
+
+bool MatterBridge::post_update(int child, update_types_e type, int32_t value)
+{
+  if (child < 0 || child >= MATTER_BRIDGE_MAX_CHILDREN) {
+    return false;
+  }
+
+  bool queued = false;
+  taskENTER_CRITICAL();
+  if (this->update_count < MATTER_BRIDGE_UPDATE_QUEUE_SIZE) {
+    update_t& update = this->updates[(this->update_head + this->update_count) % MATTER_BRIDGE_UPDATE_QUEUE_SIZE];
+    update.child = static_cast<uint8_t>(child);
+    update.type = static_cast<uint8_t>(type);
+    update.value = value;
+    this->update_count++;
+    queued = true;
+  } else {
+    this->dropped_updates++;
+  }
+  taskEXIT_CRITICAL();
+  return queued;
+}
+
+void MatterBridge::register_pending_children()
+{
+  static DeviceEndpointRequest requests[MATTER_BRIDGE_MAX_CHILDREN];
+  static uint8_t request_children[MATTER_BRIDGE_MAX_CHILDREN];
+  size_t request_count = 0u;
+
+  for (int i = 0; i < MATTER_BRIDGE_MAX_CHILDREN; i++) {
+    child_t& child = this->children[i];
+    if (!child.in_use || child.registered) {
+      continue;
+    }
+
+    const EmberAfEndpointType* endpoint_type = nullptr;
+    const EmberAfDeviceType* device_type = nullptr;
+    switch (child.type) {
+      case child_temperature:
+        endpoint_type = &tempMeasurementEndpointType;
+        device_type = gTempSensorDeviceTypes;
+        break;
+
+      case child_humidity:
+        endpoint_type = &humidityMeasurementEndpointType;
+        device_type = gHumiditySensorDeviceTypes;
+        break;
+
+      case child_contact:
+        endpoint_type = &contactSensorEndpointType;
+        device_type = gContactSensorDeviceTypes;
+        break;
+    }
+
+    child.data_versions = AllocateDataVersionStorage(endpoint_type->clusterCount);
+    if (child.data_versions == nullptr) {
+      this->release_child(child);
+      continue;
+    }
+
+    DeviceEndpointRequest& request = requests[request_count];
+    request.dev = child.device;
+    request.ep = endpoint_type;
+    request.deviceTypeList = Span<const EmberAfDeviceType>(device_type, 1u);
+    request.dataVersionStorage = Span<DataVersion>(child.data_versions, endpoint_type->clusterCount);
+    request.parentEndpointId = MATTER_AGGREGATOR_ENDPOINT_ID;
+    request.result = -1;
+    request_children[request_count] = static_cast<uint8_t>(i);
+    request_count++;
+  }
+
+  if (request_count == 0u) {
+    return;
+  }
+
+  (void)AddDeviceEndpoints(requests, request_count);
+  for (size_t i = 0u; i < request_count; i++) {
+    child_t& child = this->children[request_children[i]];
+    if (requests[i].result < 0) {
+      // Out of dynamic endpoints - the child is dropped instead of retrying on every call
+      this->release_child(child);
+      continue;
+    }
+    child.registered = true;
+  }
+}
+
+void MatterBridge::apply_updates()
+{
+  while (true) {
+    update_t update;
+    taskENTER_CRITICAL();
+    if (this->update_count == 0u) {
+      taskEXIT_CRITICAL();
+      return;
+    }
+    update = this->updates[this->update_head];
+    this->update_head = (this->update_head + 1u) % MATTER_BRIDGE_UPDATE_QUEUE_SIZE;
+    this->update_count--;
+    taskEXIT_CRITICAL();
+
+    if (update.child >= MATTER_BRIDGE_MAX_CHILDREN || !this->children[update.child].in_use) {
+      continue;
+    }
+    child_t& child = this->children[update.child];
+    child.last_seen_ms = millis();
+
+    if (update.type == update_link_state) {
+      child.connected = (update.value != 0);
+      child.device->SetReachable(child.connected);
+      continue;
+    }
+
+    if (!child.connected) {
+      child.connected = true;
+      child.device->SetReachable(true);
+    }
+    switch (child.type) {
+      case child_temperature:
+        static_cast<DeviceTempSensor*>(child.device)->SetMeasuredValue(static_cast<int16_t>(update.value));
+        break;
+
+      case child_humidity:
+        static_cast<DeviceHumiditySensor*>(child.device)->SetMeasuredValue(static_cast<uint16_t>(update.value));
+        break;
+
+      case child_contact:
+        static_cast<DeviceContactSensor*>(child.device)->SetStateValue(update.value != 0);
+        break;
+    }
+  }
+}
+
+void MatterBridge::check_link_timeouts()
+{
+  if (this->link_timeout_ms == 0u) {
+    return;
+  }
+  uint32_t now = millis();
+  for (int i = 0; i < MATTER_BRIDGE_MAX_CHILDREN; i++) {
+    child_t& child = this->children[i];
+    if (child.in_use && child.connected && (now - child.last_seen_ms) > this->link_timeout_ms) {
+      child.connected = false;
+      child.device->SetReachable(false);
+    }
+  }
+}
+
+void MatterBridge::release_child(child_t& child)
+{
+  if (child.registered) {
+    (void)RemoveDeviceEndpoint(child.device);
+  }
+  FreeDataVersionStorage(child.data_versions);
+  DestroyDevice(child.device);
+  memset(&child, 0, sizeof(child));
+}
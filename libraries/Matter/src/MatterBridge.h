@@ -0,0 +1,128 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MATTER_BRIDGE_H
+#define MATTER_BRIDGE_H
+
+#include "Matter.h"
+#include "MatterTemperature.h"
+#include "MatterHumidity.h"
+#include "MatterContact.h"
+#include "devices/DeviceTempSensor.h"
+#include "devices/DeviceHumiditySensor.h"
+#include "devices/DeviceContactSensor.h"
+
+// Number of non-Matter devices a bridge can expose - each of them takes a dynamic endpoint
+#ifndef MATTER_BRIDGE_MAX_CHILDREN
+#define MATTER_BRIDGE_MAX_CHILDREN MATTER_DYNAMIC_ENDPOINT_POOL_SIZE
+#endif
+
+// Number of updates which can wait for MatterBridge::process()
+#ifndef MATTER_BRIDGE_UPDATE_QUEUE_SIZE
+#define MATTER_BRIDGE_UPDATE_QUEUE_SIZE 64
+#endif
+
+class MatterBridge;
+
+/***************************************************************************//**
+ * Source of bridged devices - e.g. a BLE central connected to sensors
+ * The source adds its devices as children of the bridge and posts their
+ * readings and link state. Posting is allowed from any task.
+ ******************************************************************************/
+class MatterBridgeSource {
+public:
+  virtual ~MatterBridgeSource()
+  {
+    ;
+  }
+  virtual void begin(MatterBridge& bridge) = 0;
+  virtual void poll(MatterBridge& bridge) = 0;
+};
+
+class MatterBridge {
+public:
+  enum child_types_e {
+    child_temperature,
+    child_humidity,
+    child_contact
+  };
+
+  MatterBridge();
+  ~MatterBridge();
+  bool begin(MatterBridgeSource* source = nullptr);
+  void end();
+  int add_child(child_types_e type, uint64_t address, const char* name);
+  void remove_child(int child);
+  int find_child(uint64_t address);
+  bool post_temperature(int child, float celsius);
+  bool post_humidity(int child, float percent);
+  bool post_contact(int child, bool closed);
+  bool post_link_state(int child, bool connected);
+  void set_link_timeout(uint32_t timeout_ms);
+  void process();
+  bool is_child_online(int child);
+  uint32_t get_dropped_update_count();
+
+private:
+  enum update_types_e {
+    update_measurement,
+    update_link_state
+  };
+
+  typedef struct {
+    uint8_t child;
+    uint8_t type;
+    int32_t value;
+  } update_t;
+
+  typedef struct {
+    uint64_t address;
+    Device* device;
+    DataVersion* data_versions;
+    uint32_t last_seen_ms;
+    child_types_e type;
+    bool in_use;
+    bool registered;
+    bool connected;
+  } child_t;
+
+  bool post_update(int child, update_types_e type, int32_t value);
+  void register_pending_children();
+  void apply_updates();
+  void check_link_timeouts();
+  void release_child(child_t& child);
+
+  MatterBridgeSource* source;
+  child_t children[MATTER_BRIDGE_MAX_CHILDREN];
+  update_t updates[MATTER_BRIDGE_UPDATE_QUEUE_SIZE];
+  size_t update_head;
+  size_t update_count;
+  uint32_t dropped_updates;
+  uint32_t link_timeout_ms;
+  bool initialized;
+};
+
+#endif // MATTER_BRIDGE_H
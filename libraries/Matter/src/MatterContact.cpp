@@ -46,13 +46,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType contactSensorEndpointType = DynamicEndpointType(contactSensorEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterContact
  ******************************************************************************/
 MatterContact::MatterContact() :
   sensor_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -78,7 +78,7 @@ bool MatterContact::begin()
   }
 
   // Create new device
-  DeviceContactSensor* sensor = new (std::nothrow)DeviceContactSensor("Contact sensor");
+  DeviceContactSensor* sensor = this->device_endpoint.create<DeviceContactSensor>("Contact sensor");
   if (sensor == nullptr) {
     return false;
   }
@@ -88,40 +88,12 @@ bool MatterContact::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = sensor;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(sensor);
-    return false;
-  }
-  new_endpoint->cluster = contactSensorEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(contactSensorEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(contactSensorEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_sensor_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_sensor_data_version == nullptr) {
-    delete(sensor);
-    free(new_endpoint);
-    return false;
-  }
-
   // Add new endpoint
-  int result = AddDeviceEndpoint(sensor,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gContactSensorDeviceTypes),
-                                 Span<DataVersion>(new_sensor_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(sensor);
-    free(new_endpoint);
-    free(new_sensor_data_version);
+  if (!this->device_endpoint.add(contactSensorEndpointType, Span<const EmberAfDeviceType>(gContactSensorDeviceTypes))) {
     return false;
   }
 
   this->sensor_device = sensor;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_sensor_data_version;
   this->initialized = true;
   return true;
 }
@@ -134,10 +106,7 @@ void MatterContact::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->sensor_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->sensor_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
@@ -35,6 +35,10 @@
 using namespace chip;
 using namespace ::chip::DeviceLayer;
 
+// Endpoint layout of the contact sensor - also used by MatterBridge
+extern const EmberAfDeviceType gContactSensorDeviceTypes[1];
+extern const EmberAfEndpointType contactSensorEndpointType;
+
 class MatterContact : public ArduinoMatterAppliance {
 public:
   MatterContact();
@@ -48,8 +52,7 @@ public:
 
 private:
   DeviceContactSensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceContactSensor> device_endpoint;
   bool initialized;
 };
 
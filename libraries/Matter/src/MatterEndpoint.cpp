@@ -26,6 +26,7 @@
 
 #include "MatterEndpoint.h"
 #include "devices/DeviceWindowCovering.h"
+#include "MatterEvents.h"
 #include <app/CommandHandler.h>
 
 using namespace ::chip;
@@ -36,10 +37,80 @@ using namespace ::chip::app::Clusters;
 using chip::Protocols::InteractionModel::Status;
 using namespace chip::app::Clusters::WindowCovering;
 
-template<typename Base, typename T>
-inline bool instanceof(const T* ptr)
+/***************************************************************************//**
+ * Constructor for MatterEndpointBase
+ ******************************************************************************/
+MatterEndpointBase::MatterEndpointBase() :
+  device(nullptr),
+  data_versions(nullptr),
+  added(false)
 {
-  return dynamic_cast<const Base*>(ptr) != nullptr;
+  ;
+}
+
+/***************************************************************************//**
+ * Destructor for MatterEndpointBase
+ ******************************************************************************/
+MatterEndpointBase::~MatterEndpointBase()
+{
+  this->remove();
+}
+
+/***************************************************************************//**
+ * Publishes the endpoint with the device created before
+ * The device is destroyed if the endpoint can't be added.
+ *
+ * @param[in] endpoint_type the endpoint type built with DynamicEndpointType()
+ * @param[in] device_types the device types of the endpoint
+ * @param[in] parent_endpoint_id the ID of the parent endpoint
+ *
+ * @return true if the endpoint was added, false otherwise
+ ******************************************************************************/
+bool MatterEndpointBase::add(const EmberAfEndpointType& endpoint_type,
+                             const Span<const EmberAfDeviceType>& device_types,
+                             EndpointId parent_endpoint_id)
+{
+  if (this->device == nullptr || this->added) {
+    return false;
+  }
+
+  this->data_versions = AllocateDataVersionStorage(endpoint_type.clusterCount);
+  if (this->data_versions == nullptr) {
+    this->remove();
+    return false;
+  }
+
+  int result = AddDeviceEndpoint(this->device,
+                                 &endpoint_type,
+                                 device_types,
+                                 Span<DataVersion>(this->data_versions, endpoint_type.clusterCount),
+                                 parent_endpoint_id);
+  if (result < 0) {
+    this->remove();
+    return false;
+  }
+
+  this->added = true;
+  return true;
+}
+
+/***************************************************************************//**
+ * Removes the endpoint and destroys its device
+ ******************************************************************************/
+void MatterEndpointBase::remove()
+{
+  if (this->added) {
+    (void)RemoveDeviceEndpoint(this->device);
+    this->added = false;
+  }
+  FreeDataVersionStorage(this->data_versions);
+  this->data_versions = nullptr;
+  // Write the pending state of the device before it's gone
+  if (this->device) {
+    this->device->FlushPersistentState();
+  }
+  DestroyDevice(this->device);
+  this->device = nullptr;
 }
 
 EmberAfStatus emberAfExternalAttributeReadCallback(EndpointId endpoint,
@@ -48,7 +119,6 @@ EmberAfStatus emberAfExternalAttributeReadCallback(EndpointId endpoint,
                                                    uint8_t* buffer,
                                                    uint16_t maxReadLength)
 {
-  ChipLogProgress(DeviceLayer, "emberAfExternalAttributeReadCallback");
   uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(endpoint);
 
   Device* dev = GetDeviceForEndpointIndex(endpointIndex);
@@ -60,6 +130,7 @@ EmberAfStatus emberAfExternalAttributeReadCallback(EndpointId endpoint,
 
   if (!dev->IsOnline() && result == EMBER_ZCL_STATUS_SUCCESS) {
     dev->SetOnline(true);
+    MatterPostEvent(MATTER_EVENT_ONLINE, endpoint);
   }
   return result;
 }
@@ -69,7 +140,6 @@ EmberAfStatus emberAfExternalAttributeWriteCallback(EndpointId endpoint,
                                                     const EmberAfAttributeMetadata* attributeMetadata,
                                                     uint8_t* buffer)
 {
-  ChipLogProgress(DeviceLayer, "emberAfExternalAttributeWriteCallback");
   uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(endpoint);
 
   Device* dev = GetDeviceForEndpointIndex(endpointIndex);
@@ -77,7 +147,11 @@ EmberAfStatus emberAfExternalAttributeWriteCallback(EndpointId endpoint,
     return EMBER_ZCL_STATUS_FAILURE;
   }
 
-  return dev->HandleWriteEmberAfAttribute(clusterId, attributeMetadata->attributeId, buffer);
+  EmberAfStatus result = dev->HandleWriteEmberAfAttribute(clusterId, attributeMetadata->attributeId, buffer);
+  if (result == EMBER_ZCL_STATUS_SUCCESS) {
+    MatterPostEvent(MATTER_EVENT_ATTRIBUTE_WRITE, endpoint, clusterId, attributeMetadata->attributeId);
+  }
+  return result;
 }
 
 bool emberAfWindowCoveringClusterUpOrOpenCallback(app::CommandHandler* commandObj,
@@ -93,7 +167,7 @@ bool emberAfWindowCoveringClusterUpOrOpenCallback(app::CommandHandler* commandOb
     commandObj->AddStatus(commandPath, Status::Failure);
     return false;
   }
-  if (instanceof<DeviceWindowCovering>(dev)) {
+  if (dev->GetDeviceType() == Device::kDeviceType_WindowCovering) {
     DeviceWindowCovering* window_covering_device = static_cast<DeviceWindowCovering*>(dev);
     window_covering_device->SetRequestedLiftPosition(0u);
     commandObj->AddStatus(commandPath, Status::Success);
@@ -116,7 +190,7 @@ bool emberAfWindowCoveringClusterDownOrCloseCallback(app::CommandHandler* comman
     commandObj->AddStatus(commandPath, Status::Failure);
     return false;
   }
-  if (instanceof<DeviceWindowCovering>(dev)) {
+  if (dev->GetDeviceType() == Device::kDeviceType_WindowCovering) {
     DeviceWindowCovering* window_covering_device = static_cast<DeviceWindowCovering*>(dev);
     window_covering_device->SetRequestedLiftPosition(10000u);
     commandObj->AddStatus(commandPath, Status::Success);
@@ -158,7 +232,7 @@ bool emberAfWindowCoveringClusterGoToLiftPercentageCallback(app::CommandHandler*
     commandObj->AddStatus(commandPath, Status::Failure);
     return false;
   }
-  if (instanceof<DeviceWindowCovering>(dev)) {
+  if (dev->GetDeviceType() == Device::kDeviceType_WindowCovering) {
     DeviceWindowCovering* window_covering_device = static_cast<DeviceWindowCovering*>(dev);
     window_covering_device->SetRequestedLiftPosition(percent);
     commandObj->AddStatus(commandPath, Status::Success);
@@ -57,4 +57,71 @@
 
 using namespace ::chip;
 
+// Parent of the dynamic endpoints - the aggregator endpoint of the bridge
+#define MATTER_AGGREGATOR_ENDPOINT_ID 1
+
+/***************************************************************************//**
+ * Builds the endpoint type of a dynamic endpoint from its cluster list
+ * The result is meant for a constexpr variable - every instance of a device
+ * type shares it and it needs no RAM.
+ *
+ * @param[in] clusters the cluster list of the endpoint
+ *
+ * @return the endpoint type
+ ******************************************************************************/
+template<size_t ClusterCount>
+constexpr EmberAfEndpointType DynamicEndpointType(EmberAfCluster (&clusters)[ClusterCount])
+{
+  static_assert(ClusterCount <= kMaxClustersPerDynamicEndpoint, "Too many clusters for a dynamic endpoint");
+  return { clusters, static_cast<uint8_t>(ClusterCount), 0u };
+}
+
+/***************************************************************************//**
+ * Dynamic endpoint with its device and data version storage
+ * Holds the registration logic shared between all the device types - only
+ * the device creation in MatterEndpoint is typed.
+ ******************************************************************************/
+class MatterEndpointBase {
+public:
+  MatterEndpointBase();
+  ~MatterEndpointBase();
+  bool add(const EmberAfEndpointType& endpoint_type,
+           const Span<const EmberAfDeviceType>& device_types,
+           EndpointId parent_endpoint_id = MATTER_AGGREGATOR_ENDPOINT_ID);
+  void remove();
+
+protected:
+  Device* device;
+  DataVersion* data_versions;
+  bool added;
+};
+
+/***************************************************************************//**
+ * Dynamic endpoint of a given device type
+ * Create the device with create(), configure it and publish it with add().
+ * remove() unpublishes the endpoint and destroys the device.
+ ******************************************************************************/
+template<typename DeviceT>
+class MatterEndpoint : public MatterEndpointBase {
+public:
+  /***************************************************************************//**
+   * Creates the device of the endpoint in the device pool
+   *
+   * @param[in] args the arguments passed to the constructor of the device
+   *
+   * @return pointer to the device or nullptr if it couldn't be created
+   ******************************************************************************/
+  template<typename T = DeviceT, typename ... Args>
+  T* create(Args&& ... args)
+  {
+    static_assert(std::is_base_of<DeviceT, T>::value, "The device must be derived from the device type of the endpoint");
+    if (this->device != nullptr) {
+      return nullptr;
+    }
+    T* new_device = gDevicePool.create<T>(std::forward<Args>(args) ...);
+    this->device = new_device;
+    return new_device;
+  }
+};
+
 #endif // MATTER_ENDPOINT_H
@@ -25,15 +25,42 @@
  */
 
 #include "MatterEndpointHandler.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
 
 EndpointId gCurrentEndpointId;
 EndpointId gFirstDynamicEndpointId;
 Device* gDevices[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT + 1];
 
+// Free dynamic endpoint indexes - used as a stack, only touched with the CHIP stack locked
+static uint16_t gFreeEndpointIndexes[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT];
+static uint16_t gFreeEndpointIndexCount;
+
+// Synchronizes AddDeviceEndpoints() with the work item it schedules
+static SemaphoreHandle_t gBatchDoneSemaphore;
+static StaticSemaphore_t gBatchDoneSemaphoreBuf;
+static SemaphoreHandle_t gBatchMutex;
+static StaticSemaphore_t gBatchMutexBuf;
+
+StaticPool<DevicePoolSlot, MATTER_DYNAMIC_ENDPOINT_POOL_SIZE> gDevicePool;
+StaticPool<::Identify, MATTER_DYNAMIC_ENDPOINT_POOL_SIZE> gIdentifyPool;
+static StaticPool<DataVersion[kMaxClustersPerDynamicEndpoint], MATTER_DYNAMIC_ENDPOINT_POOL_SIZE> gDataVersionPool;
+
 void InitDynamicEndpointHandler()
 {
   memset(gDevices, 0, sizeof(gDevices));
 
+  // Hand out the lowest indexes first
+  gFreeEndpointIndexCount = 0u;
+  for (uint16_t index = CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT; index > 0u; index--) {
+    gFreeEndpointIndexes[gFreeEndpointIndexCount++] = static_cast<uint16_t>(index - 1u);
+  }
+
+  if (gBatchMutex == nullptr) {
+    gBatchMutex = xSemaphoreCreateMutexStatic(&gBatchMutexBuf);
+    gBatchDoneSemaphore = xSemaphoreCreateBinaryStatic(&gBatchDoneSemaphoreBuf);
+  }
+
   gFirstDynamicEndpointId = static_cast<chip::EndpointId>(
     static_cast<int>(emberAfEndpointFromIndex(static_cast<uint16_t>(emberAfFixedEndpointCount() - 1))) + 1);
   gCurrentEndpointId = gFirstDynamicEndpointId;
@@ -43,52 +70,132 @@ void InitDynamicEndpointHandler()
   emberAfEndpointEnableDisable(emberAfEndpointFromIndex(static_cast<uint16_t>(emberAfFixedEndpointCount() - 1)), false);
 }
 
-int AddDeviceEndpoint(Device* dev, EmberAfEndpointType* ep,
+/***************************************************************************//**
+ * Provides the next endpoint ID which isn't in use
+ * IDs are handed out in increasing order and wrap around to the first dynamic
+ * endpoint ID - IDs of removed endpoints are not reused right away.
+ *
+ * @return the endpoint ID
+ ******************************************************************************/
+static EndpointId AllocateEndpointId()
+{
+  while (emberAfIndexFromEndpointIncludingDisabledEndpoints(gCurrentEndpointId) != kEmberInvalidEndpointIndex) {
+    // Handle wrap condition
+    if (++gCurrentEndpointId < gFirstDynamicEndpointId || gCurrentEndpointId == chip::kInvalidEndpointId) {
+      gCurrentEndpointId = gFirstDynamicEndpointId;
+    }
+  }
+  return gCurrentEndpointId;
+}
+
+/***************************************************************************//**
+ * Adds a dynamic endpoint - the CHIP stack must be locked by the caller
+ *
+ * @return the index of the dynamic endpoint or -1 on failure
+ ******************************************************************************/
+static int AddDeviceEndpointLocked(Device* dev, const EmberAfEndpointType* ep,
+                                   const Span<const EmberAfDeviceType>& deviceTypeList,
+                                   const Span<DataVersion>& dataVersionStorage,
+                                   chip::EndpointId parentEndpointId)
+{
+  if (gFreeEndpointIndexCount == 0u) {
+    ChipLogProgress(DeviceLayer, "Failed to add dynamic endpoint: No endpoints available!");
+    return -1;
+  }
+  uint16_t index = gFreeEndpointIndexes[--gFreeEndpointIndexCount];
+
+  EndpointId endpoint_id = AllocateEndpointId();
+  gDevices[index] = dev;
+  dev->SetEndpointId(endpoint_id);
+  dev->SetParentEndpointId(parentEndpointId);
+  EmberAfStatus ret = emberAfSetDynamicEndpoint(index, endpoint_id, ep, dataVersionStorage, deviceTypeList, parentEndpointId);
+  if (ret != EMBER_ZCL_STATUS_SUCCESS) {
+    ChipLogProgress(DeviceLayer, "Failed to add dynamic endpoint; err='%d'", ret);
+    gDevices[index] = nullptr;
+    gFreeEndpointIndexes[gFreeEndpointIndexCount++] = index;
+    return -1;
+  }
+
+  ChipLogProgress(DeviceLayer, "Added device %s to dynamic endpoint %d (index=%d)", dev->GetName(), endpoint_id, index);
+  ++gCurrentEndpointId;
+  return index;
+}
+
+int AddDeviceEndpoint(Device* dev, const EmberAfEndpointType* ep,
                       const Span<const EmberAfDeviceType>& deviceTypeList,
                       const Span<DataVersion> & dataVersionStorage,
                       chip::EndpointId parentEndpointId)
 {
-  uint8_t index = 0;
-  while (index < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT) {
-    if (nullptr == gDevices[index]) {
-      gDevices[index] = dev;
-      EmberAfStatus ret;
-      while (true) {
-        // Todo: Update this to schedule the work rather than use this lock
-        DeviceLayer::StackLock lock;
-        dev->SetEndpointId(gCurrentEndpointId);
-        dev->SetParentEndpointId(parentEndpointId);
-        ret = emberAfSetDynamicEndpoint(index, gCurrentEndpointId, ep, dataVersionStorage, deviceTypeList, parentEndpointId);
-        if (ret == EMBER_ZCL_STATUS_SUCCESS) {
-          ChipLogProgress(DeviceLayer, "Added device %s to dynamic endpoint %d (index=%d)", dev->GetName(),
-                          gCurrentEndpointId, index);
-          return index;
-        }
-        if (ret != EMBER_ZCL_STATUS_DUPLICATE_EXISTS) {
-          ChipLogProgress(DeviceLayer, "Failed to add dynamic endpoint; err='%d'", ret);
-          return -1;
-        }
-        // Handle wrap condition
-        if (++gCurrentEndpointId < gFirstDynamicEndpointId) {
-          gCurrentEndpointId = gFirstDynamicEndpointId;
-        }
-      }
+  DeviceLayer::StackLock lock;
+  return AddDeviceEndpointLocked(dev, ep, deviceTypeList, dataVersionStorage, parentEndpointId);
+}
+
+// Arguments of the work item scheduled by AddDeviceEndpoints()
+typedef struct {
+  DeviceEndpointRequest* requests;
+  size_t count;
+  size_t added;
+} DeviceEndpointBatch;
+
+/***************************************************************************//**
+ * Adds every endpoint of a batch - runs on the CHIP task
+ * The PartsList of the parents is marked dirty once after all the endpoints
+ * were added, so subscribers get a single report for the whole batch.
+ ******************************************************************************/
+static void AddDeviceEndpointsWork(intptr_t arg)
+{
+  DeviceEndpointBatch* batch = reinterpret_cast<DeviceEndpointBatch*>(arg);
+  chip::EndpointId last_parent_id = chip::kInvalidEndpointId;
+
+  for (size_t i = 0u; i < batch->count; i++) {
+    DeviceEndpointRequest& request = batch->requests[i];
+    request.result = AddDeviceEndpointLocked(request.dev, request.ep, request.deviceTypeList,
+                                             request.dataVersionStorage, request.parentEndpointId);
+    if (request.result < 0) {
+      continue;
+    }
+    batch->added++;
+    if (request.parentEndpointId != last_parent_id && request.parentEndpointId != chip::kInvalidEndpointId) {
+      last_parent_id = request.parentEndpointId;
+      MatterReportingAttributeChangeCallback(last_parent_id, app::Clusters::Descriptor::Id,
+                                             app::Clusters::Descriptor::Attributes::PartsList::Id);
     }
-    index++;
   }
-  ChipLogProgress(DeviceLayer, "Failed to add dynamic endpoint: No endpoints available!");
-  return -1;
+  MatterReportingAttributeChangeCallback(0u, app::Clusters::Descriptor::Id, app::Clusters::Descriptor::Attributes::PartsList::Id);
+
+  xSemaphoreGive(gBatchDoneSemaphore);
+}
+
+size_t AddDeviceEndpoints(DeviceEndpointRequest* requests, size_t count)
+{
+  if (requests == nullptr || count == 0u || gBatchMutex == nullptr) {
+    return 0u;
+  }
+
+  xSemaphoreTake(gBatchMutex, portMAX_DELAY);
+  DeviceEndpointBatch batch = { requests, count, 0u };
+  if (DeviceLayer::PlatformMgr().ScheduleWork(AddDeviceEndpointsWork, reinterpret_cast<intptr_t>(&batch)) == CHIP_NO_ERROR) {
+    xSemaphoreTake(gBatchDoneSemaphore, portMAX_DELAY);
+  } else {
+    // Fall back to locking the stack if the work item couldn't be queued
+    DeviceLayer::StackLock lock;
+    AddDeviceEndpointsWork(reinterpret_cast<intptr_t>(&batch));
+    xSemaphoreTake(gBatchDoneSemaphore, 0u);
+  }
+  xSemaphoreGive(gBatchMutex);
+  return batch.added;
 }
 
 int RemoveDeviceEndpoint(Device* dev)
 {
-  uint8_t index = 0;
+  uint16_t index = 0;
   while (index < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT) {
     if (gDevices[index] == dev) {
       // Todo: Update this to schedule the work rather than use this lock
       DeviceLayer::StackLock lock;
       EndpointId ep   = emberAfClearDynamicEndpoint(index);
       gDevices[index] = nullptr;
+      gFreeEndpointIndexes[gFreeEndpointIndexCount++] = index;
       ChipLogProgress(DeviceLayer, "Removed device %s from dynamic endpoint %d (index=%d)", dev->GetName(), ep, index);
       // Silence complaints about unused ep when progress logging is disabled
       UNUSED_VAR(ep);
@@ -106,3 +213,27 @@ Device* GetDeviceForEndpointIndex(uint16_t endpointIndex)
   }
   return gDevices[endpointIndex];
 }
+
+DataVersion* AllocateDataVersionStorage(size_t cluster_count)
+{
+  if (cluster_count > kMaxClustersPerDynamicEndpoint) {
+    return nullptr;
+  }
+  return static_cast<DataVersion*>(gDataVersionPool.allocate());
+}
+
+void FreeDataVersionStorage(DataVersion* storage)
+{
+  gDataVersionPool.release(storage);
+}
+
+void DestroyDevice(Device* dev)
+{
+  if (dev == nullptr) {
+    return;
+  }
+  // Changed attributes are flushed on the CHIP task with the stack locked -
+  // holding the lock keeps a flush in progress from using the device while it's destroyed
+  DeviceLayer::StackLock lock;
+  gDevicePool.destroy(dev);
+}
@@ -29,17 +29,90 @@
 
 #include <app/util/attribute-storage.h>
 #include <app/reporting/reporting.h>
+#include <app/clusters/identify-server/identify-server.h>
 #include "devices/MatterDevice.h"
+#include "devices/DeviceAirQualitySensor.h"
+#include "devices/DeviceContactSensor.h"
+#include "devices/DeviceFan.h"
+#include "devices/DeviceFlowSensor.h"
+#include "devices/DeviceHumiditySensor.h"
+#include "devices/DeviceIlluminanceSensor.h"
+#include "devices/DeviceLightbulb.h"
+#include "devices/DeviceOccupancySensor.h"
+#include "devices/DeviceOnOffPluginUnit.h"
+#include "devices/DevicePressureSensor.h"
+#include "devices/DeviceSwitch.h"
+#include "devices/DeviceTempSensor.h"
+#include "devices/DeviceThermostat.h"
+#include "devices/DeviceWindowCovering.h"
+#include "util/static_pool.h"
 
 using namespace ::chip;
 
+// Number of devices/endpoints the static pools have room for
+#ifndef MATTER_DYNAMIC_ENDPOINT_POOL_SIZE
+#define MATTER_DYNAMIC_ENDPOINT_POOL_SIZE CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
+#endif
+
+// Most clusters a dynamic endpoint can have - the color lightbulb has six
+const size_t kMaxClustersPerDynamicEndpoint = 8u;
+
+// A pool slot fits any of the devices
+typedef std::aligned_union<0,
+                           DeviceAirQualitySensor,
+                           DeviceContactSensor,
+                           DeviceFan,
+                           DeviceFlowSensor,
+                           DeviceHumiditySensor,
+                           DeviceIlluminanceSensor,
+                           DeviceLightbulb,
+                           DeviceOccupancySensor,
+                           DeviceOnOffPluginUnit,
+                           DevicePressureSensor,
+                           DeviceSwitch,
+                           DeviceTempSensor,
+                           DeviceThermostat,
+                           DeviceWindowCovering>::type DevicePoolSlot;
+
+// Static storage for everything a dynamic endpoint needs - nothing is allocated from the heap
+extern StaticPool<DevicePoolSlot, MATTER_DYNAMIC_ENDPOINT_POOL_SIZE> gDevicePool;
+extern StaticPool<::Identify, MATTER_DYNAMIC_ENDPOINT_POOL_SIZE> gIdentifyPool;
+
+DataVersion* AllocateDataVersionStorage(size_t cluster_count);
+void FreeDataVersionStorage(DataVersion* storage);
+
+// Destroys a device created in gDevicePool - must not be called from the CHIP task
+void DestroyDevice(Device* dev);
+
 void InitDynamicEndpointHandler();
 
-int AddDeviceEndpoint(Device* dev, EmberAfEndpointType* ep,
+int AddDeviceEndpoint(Device* dev, const EmberAfEndpointType* ep,
                       const Span<const EmberAfDeviceType>& deviceTypeList,
                       const Span<DataVersion>& dataVersionStorage,
                       chip::EndpointId parentEndpointId = chip::kInvalidEndpointId);
 
+// One endpoint of a batch added with AddDeviceEndpoints()
+typedef struct {
+  Device* dev;
+  const EmberAfEndpointType* ep;
+  Span<const EmberAfDeviceType> deviceTypeList;
+  Span<DataVersion> dataVersionStorage;
+  chip::EndpointId parentEndpointId;
+  int result; // Set to the dynamic endpoint index or -1 on failure
+} DeviceEndpointRequest;
+
+/***************************************************************************//**
+ * Adds several dynamic endpoints in a single work item on the CHIP task
+ * Blocks until all the endpoints were processed - must not be called from
+ * the CHIP task. The PartsList is reported once for the whole batch.
+ *
+ * @param[in,out] requests the endpoints to add - their 'result' is filled in
+ * @param[in] count the number of requests
+ *
+ * @return the number of endpoints added
+ ******************************************************************************/
+size_t AddDeviceEndpoints(DeviceEndpointRequest* requests, size_t count);
+
 int RemoveDeviceEndpoint(Device* dev);
 
 Device* GetDeviceForEndpointIndex(uint16_t endpointIndex);
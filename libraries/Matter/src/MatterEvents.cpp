@@ -0,0 +1,153 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MatterEvents.h"
+#include <platform/CHIPDeviceLayer.h>
+
+using namespace ::chip::DeviceLayer;
+
+static_assert(MATTER_EVENT_QUEUE_RESERVED < MATTER_EVENT_QUEUE_LENGTH, "Attribute writes need at least one queue slot");
+
+static StaticQueue_t event_queue_buf;
+static uint8_t event_queue_storage[MATTER_EVENT_QUEUE_LENGTH * sizeof(matter_event_t)];
+static QueueHandle_t event_queue = xQueueCreateStatic(MATTER_EVENT_QUEUE_LENGTH,
+                                                      sizeof(matter_event_t),
+                                                      event_queue_storage,
+                                                      &event_queue_buf);
+static volatile uint32_t dropped_event_count = 0u;
+
+// Attribute write events waiting in the queue - a burst of writes to the same attribute becomes a single event,
+// the sketch reads the current value when it handles it
+static matter_event_t pending_writes[MATTER_EVENT_QUEUE_LENGTH];
+static size_t pending_write_count = 0u;
+static bool events_initialized = false;
+
+// Last seen state of the Matter stack - only accessed from the Matter task
+static bool last_commissioned = false;
+static bool last_thread_attached = false;
+
+static bool IsSameAttribute(const matter_event_t& a, const matter_event_t& b)
+{
+  return a.endpoint_id == b.endpoint_id && a.cluster_id == b.cluster_id && a.attribute_id == b.attribute_id;
+}
+
+// Called in a critical section
+static bool IsWritePending(const matter_event_t& event)
+{
+  for (size_t i = 0; i < pending_write_count; i++) {
+    if (IsSameAttribute(pending_writes[i], event)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Called in a critical section
+static void RemovePendingWrite(const matter_event_t& event)
+{
+  for (size_t i = 0; i < pending_write_count; i++) {
+    if (IsSameAttribute(pending_writes[i], event)) {
+      pending_writes[i] = pending_writes[pending_write_count - 1u];
+      pending_write_count--;
+      return;
+    }
+  }
+}
+
+static void PostWriteEvent(const matter_event_t& event)
+{
+  bool queued = true;
+  taskENTER_CRITICAL();
+  if (!IsWritePending(event)) {
+    queued = uxQueueSpacesAvailable(event_queue) > MATTER_EVENT_QUEUE_RESERVED
+             && xQueueSend(event_queue, &event, 0) == pdTRUE;
+    if (queued) {
+      pending_writes[pending_write_count++] = event;
+    }
+  }
+  taskEXIT_CRITICAL();
+  if (!queued) {
+    dropped_event_count = dropped_event_count + 1u;
+  }
+}
+
+void MatterPostEvent(matter_event_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+  matter_event_t event = { type, endpoint_id, cluster_id, attribute_id };
+  if (type == MATTER_EVENT_ATTRIBUTE_WRITE) {
+    PostWriteEvent(event);
+    return;
+  }
+  if (xQueueSend(event_queue, &event, 0) != pdTRUE) {
+    dropped_event_count = dropped_event_count + 1u;
+  }
+}
+
+// Compares the commissioning and Thread state with the last seen one on every platform event
+static void PlatformEventHandler(const ChipDeviceEvent* event, intptr_t arg)
+{
+  (void)event;
+  (void)arg;
+  bool commissioned = ConnectivityMgr().IsThreadProvisioned();
+  if (commissioned != last_commissioned) {
+    last_commissioned = commissioned;
+    MatterPostEvent(commissioned ? MATTER_EVENT_COMMISSIONED : MATTER_EVENT_DECOMMISSIONED);
+  }
+  bool thread_attached = ConnectivityMgr().IsThreadAttached();
+  if (thread_attached != last_thread_attached) {
+    last_thread_attached = thread_attached;
+    MatterPostEvent(thread_attached ? MATTER_EVENT_THREAD_ATTACHED : MATTER_EVENT_THREAD_DETACHED);
+  }
+}
+
+void MatterEventsInit()
+{
+  if (events_initialized) {
+    return;
+  }
+  // Only changes after the init are reported - the sketch can read the current state with the getters
+  last_commissioned = ConnectivityMgr().IsThreadProvisioned();
+  last_thread_attached = ConnectivityMgr().IsThreadAttached();
+  events_initialized = (PlatformMgr().AddEventHandler(PlatformEventHandler) == CHIP_NO_ERROR);
+}
+
+bool MatterReceiveEvent(matter_event_t& event, TickType_t timeout_ticks)
+{
+  if (xQueueReceive(event_queue, &event, timeout_ticks) != pdTRUE) {
+    return false;
+  }
+  if (event.type == MATTER_EVENT_ATTRIBUTE_WRITE) {
+    taskENTER_CRITICAL();
+    RemovePendingWrite(event);
+    taskEXIT_CRITICAL();
+  }
+  return true;
+}
+
+uint32_t MatterGetDroppedEventCount()
+{
+  return dropped_event_count;
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MATTER_EVENTS_H
+#define MATTER_EVENTS_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+
+// Number of events the queue can hold - events are dropped while it's full
+#ifndef MATTER_EVENT_QUEUE_LENGTH
+#define MATTER_EVENT_QUEUE_LENGTH 16u
+#endif
+
+// Number of queue slots attribute writes leave free for the state events
+#ifndef MATTER_EVENT_QUEUE_RESERVED
+#define MATTER_EVENT_QUEUE_RESERVED 4u
+#endif
+
+typedef enum {
+  MATTER_EVENT_COMMISSIONED,      // The device joined a Matter fabric and its Thread network
+  MATTER_EVENT_DECOMMISSIONED,    // The device lost its Thread network credentials
+  MATTER_EVENT_THREAD_ATTACHED,   // The device attached to the Thread network
+  MATTER_EVENT_THREAD_DETACHED,   // The device detached from the Thread network
+  MATTER_EVENT_ONLINE,            // An endpoint was discovered by the controller - see 'endpoint_id'
+  MATTER_EVENT_ATTRIBUTE_WRITE,   // An attribute was written by the controller or a cluster server - see all fields
+} matter_event_type_t;
+
+typedef struct {
+  matter_event_type_t type;
+  uint16_t endpoint_id;
+  uint32_t cluster_id;
+  uint32_t attribute_id;
+} matter_event_t;
+
+// Called from Matter.waitForEvent() in the sketch's context for the events of an endpoint
+typedef void (*matter_change_callback_t)(const matter_event_t& event);
+
+// Adds an event to the queue - doesn't block, the event is dropped if the queue is full
+// A write of an attribute which already has a write event waiting in the queue isn't queued again
+void MatterPostEvent(matter_event_type_t type, uint16_t endpoint_id = 0u, uint32_t cluster_id = 0u, uint32_t attribute_id = 0u);
+// Starts turning the state changes of the Matter stack into events - must be called with the Matter stack locked
+void MatterEventsInit();
+// Waits for the next event - returns false on timeout
+bool MatterReceiveEvent(matter_event_t& event, TickType_t timeout_ticks);
+// Number of events dropped because the queue was full
+uint32_t MatterGetDroppedEventCount();
+
+#endif // MATTER_EVENTS_H
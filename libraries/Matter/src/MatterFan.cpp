@@ -50,13 +50,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType fanControlEndpointType = DynamicEndpointType(fanControlEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterFan
  ******************************************************************************/
 MatterFan::MatterFan() :
   fan_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -82,7 +82,7 @@ bool MatterFan::begin()
   }
 
   // Create new device
-  DeviceFan* fan_device = new (std::nothrow)DeviceFan("Fan");
+  DeviceFan* fan_device = this->device_endpoint.create<DeviceFan>("Fan");
   if (fan_device == nullptr) {
     return false;
   }
@@ -92,40 +92,15 @@ bool MatterFan::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = fan_device;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(fan_device);
-    return false;
-  }
-  new_endpoint->cluster = fanControlEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(fanControlEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(fanControlEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_device_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_device_data_version == nullptr) {
-    delete(fan_device);
-    free(new_endpoint);
-    return false;
-  }
+  // Restore the stored state before the endpoint is published
+  (void)this->restore_persistent_state();
 
   // Add new endpoint
-  int result = AddDeviceEndpoint(fan_device,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gFanDeviceTypes),
-                                 Span<DataVersion>(new_device_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(fan_device);
-    free(new_endpoint);
-    free(new_device_data_version);
+  if (!this->device_endpoint.add(fanControlEndpointType, Span<const EmberAfDeviceType>(gFanDeviceTypes))) {
     return false;
   }
 
   this->fan_device = fan_device;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_device_data_version;
   this->initialized = true;
   return true;
 }
@@ -138,10 +113,7 @@ void MatterFan::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->fan_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->fan_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
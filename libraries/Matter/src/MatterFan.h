@@ -49,8 +49,7 @@ public:
 
 private:
   DeviceFan* fan_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceFan> device_endpoint;
   bool initialized;
 };
 
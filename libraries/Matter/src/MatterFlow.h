@@ -35,7 +35,7 @@
 using namespace chip;
 using namespace ::chip::DeviceLayer;
 
-class MatterFlow : public ArduinoMatterAppliance {
+class MatterFlow : public ArduinoMatterMeasurementAppliance {
 public:
   MatterFlow();
   ~MatterFlow();
@@ -51,8 +51,7 @@ public:
 
 private:
   DeviceFlowSensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceFlowSensor> device_endpoint;
   bool initialized;
 };
 
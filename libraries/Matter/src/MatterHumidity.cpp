@@ -49,13 +49,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType humidityMeasurementEndpointType = DynamicEndpointType(humidityMeasurementEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterHumidity
  ******************************************************************************/
 MatterHumidity::MatterHumidity() :
   sensor_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -81,7 +81,7 @@ bool MatterHumidity::begin()
   }
 
   // Create new device
-  DeviceHumiditySensor* sensor = new (std::nothrow)DeviceHumiditySensor("Humidity sensor", 0, 10000, 0);
+  DeviceHumiditySensor* sensor = this->device_endpoint.create<DeviceHumiditySensor>("Humidity sensor", 0, 10000, 0);
   if (sensor == nullptr) {
     return false;
   }
@@ -91,40 +91,12 @@ bool MatterHumidity::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = sensor;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(sensor);
-    return false;
-  }
-  new_endpoint->cluster = humidityMeasurementEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(humidityMeasurementEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(humidityMeasurementEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_sensor_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_sensor_data_version == nullptr) {
-    delete(sensor);
-    free(new_endpoint);
-    return false;
-  }
-
   // Add new endpoint
-  int result = AddDeviceEndpoint(sensor,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gHumiditySensorDeviceTypes),
-                                 Span<DataVersion>(new_sensor_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(sensor);
-    free(new_endpoint);
-    free(new_sensor_data_version);
+  if (!this->device_endpoint.add(humidityMeasurementEndpointType, Span<const EmberAfDeviceType>(gHumiditySensorDeviceTypes))) {
     return false;
   }
 
   this->sensor_device = sensor;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_sensor_data_version;
   this->initialized = true;
   return true;
 }
@@ -137,10 +109,7 @@ void MatterHumidity::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->sensor_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->sensor_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
@@ -155,8 +124,13 @@ void MatterHumidity::set_measured_value_raw(uint16_t value)
   if (!this->initialized) {
     return;
   }
+  int32_t report_value;
+  bool forced;
+  if (!this->filter_measurement(value, report_value, forced)) {
+    return;
+  }
   PlatformMgr().LockChipStack();
-  this->sensor_device->SetMeasuredValue(value);
+  this->sensor_device->SetMeasuredValue(static_cast<uint16_t>(report_value), forced);
   PlatformMgr().UnlockChipStack();
 }
 
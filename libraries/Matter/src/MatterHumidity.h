@@ -35,7 +35,11 @@
 using namespace chip;
 using namespace ::chip::DeviceLayer;
 
-class MatterHumidity : public ArduinoMatterAppliance {
+// Endpoint layout of the humidity sensor - also used by MatterBridge
+extern const EmberAfDeviceType gHumiditySensorDeviceTypes[1];
+extern const EmberAfEndpointType humidityMeasurementEndpointType;
+
+class MatterHumidity : public ArduinoMatterMeasurementAppliance {
 public:
   MatterHumidity();
   ~MatterHumidity();
@@ -53,8 +57,7 @@ public:
 
 private:
   DeviceHumiditySensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceHumiditySensor> device_endpoint;
   bool initialized;
 };
 
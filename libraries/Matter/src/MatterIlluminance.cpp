@@ -49,13 +49,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType illuminanceMeasurementEndpointType = DynamicEndpointType(illuminanceMeasurementEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterIlluminance
  ******************************************************************************/
 MatterIlluminance::MatterIlluminance() :
   sensor_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false),
   current_light_value_lux(0.0)
 {
@@ -82,7 +82,7 @@ bool MatterIlluminance::begin()
   }
 
   // Create new device
-  DeviceIlluminanceSensor* sensor = new (std::nothrow)DeviceIlluminanceSensor("Light sensor", 0, UINT16_MAX, 0);
+  DeviceIlluminanceSensor* sensor = this->device_endpoint.create<DeviceIlluminanceSensor>("Light sensor", 0, UINT16_MAX, 0);
   if (sensor == nullptr) {
     return false;
   }
@@ -92,40 +92,12 @@ bool MatterIlluminance::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = sensor;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(sensor);
-    return false;
-  }
-  new_endpoint->cluster = illuminanceMeasurementEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(illuminanceMeasurementEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(illuminanceMeasurementEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_sensor_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_sensor_data_version == nullptr) {
-    delete(sensor);
-    free(new_endpoint);
-    return false;
-  }
-
   // Add new endpoint
-  int result = AddDeviceEndpoint(sensor,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gIlluminanceSensorDeviceTypes),
-                                 Span<DataVersion>(new_sensor_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(sensor);
-    free(new_endpoint);
-    free(new_sensor_data_version);
+  if (!this->device_endpoint.add(illuminanceMeasurementEndpointType, Span<const EmberAfDeviceType>(gIlluminanceSensorDeviceTypes))) {
     return false;
   }
 
   this->sensor_device = sensor;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_sensor_data_version;
   this->initialized = true;
   this->current_light_value_lux = 0.0;
   return true;
@@ -139,10 +111,7 @@ void MatterIlluminance::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->sensor_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->sensor_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
@@ -158,8 +127,13 @@ void MatterIlluminance::set_measured_value_raw(uint16_t value)
   if (!this->initialized) {
     return;
   }
+  int32_t report_value;
+  bool forced;
+  if (!this->filter_measurement(value, report_value, forced)) {
+    return;
+  }
   PlatformMgr().LockChipStack();
-  this->sensor_device->SetMeasuredValue(value);
+  this->sensor_device->SetMeasuredValue(static_cast<uint16_t>(report_value), forced);
   PlatformMgr().UnlockChipStack();
 }
 
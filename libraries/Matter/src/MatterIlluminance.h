@@ -35,7 +35,7 @@
 using namespace chip;
 using namespace ::chip::DeviceLayer;
 
-class MatterIlluminance : public ArduinoMatterAppliance {
+class MatterIlluminance : public ArduinoMatterMeasurementAppliance {
 public:
   MatterIlluminance();
   ~MatterIlluminance();
@@ -54,8 +54,7 @@ public:
 
 private:
   DeviceIlluminanceSensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceIlluminanceSensor> device_endpoint;
   bool initialized;
   double current_light_value_lux;
 };
@@ -0,0 +1,459 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MatterLightTransition.h"
+
+MatterLightTransition* MatterLightTransition::first = nullptr;
+TaskHandle_t MatterLightTransition::task_handle = nullptr;
+StaticSemaphore_t MatterLightTransition::mutex_buf;
+SemaphoreHandle_t MatterLightTransition::mutex = xSemaphoreCreateMutexStatic(&MatterLightTransition::mutex_buf);
+
+/***************************************************************************//**
+ * Constructor for MatterLightTransition
+ ******************************************************************************/
+MatterLightTransition::MatterLightTransition() :
+  device(nullptr),
+  dimmable(false),
+  color(false),
+  channels(),
+  level_remaining_time(0u),
+  color_remaining_time(0u),
+  transition_ms(0u),
+  output_callback(nullptr),
+  output_pins(),
+  output_pin_count(0u),
+  output_active_low(false),
+  last_output(),
+  last_output_valid(false),
+  attached(false),
+  next(nullptr)
+{
+  this->channels[channel_hue].wraps = true;
+}
+
+/***************************************************************************//**
+ * Destructor for MatterLightTransition
+ ******************************************************************************/
+MatterLightTransition::~MatterLightTransition()
+{
+  this->end();
+}
+
+/***************************************************************************//**
+ * Starts following the state of a lightbulb device
+ * The outputs are only driven once an output pin or callback is set.
+ *
+ * @param[in] device the lightbulb device to follow
+ * @param[in] dimmable true if the device has the LevelControl cluster
+ * @param[in] color true if the device has the ColorControl cluster
+ ******************************************************************************/
+void MatterLightTransition::begin(DeviceLightbulb* device, bool dimmable, bool color)
+{
+  this->device = device;
+  this->dimmable = dimmable;
+  this->color = color;
+  this->update_targets(true);
+  device->SetOutputChangedHandler(MatterLightTransition::handle_output_changed, this);
+}
+
+/***************************************************************************//**
+ * Stops following the lightbulb device and driving the outputs
+ ******************************************************************************/
+void MatterLightTransition::end()
+{
+  this->detach();
+  if (this->device) {
+    this->device->SetOutputChangedHandler(nullptr, nullptr);
+    this->device = nullptr;
+  }
+}
+
+/***************************************************************************//**
+ * Drives a single PWM pin with the brightness of the light
+ *
+ * @param[in] pin the output pin
+ * @param[in] active_low true if the light is on when the pin is low
+ ******************************************************************************/
+void MatterLightTransition::set_output_pin(pin_size_t pin, bool active_low)
+{
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  this->output_pins[0] = pin;
+  this->output_pin_count = 1u;
+  this->output_active_low = active_low;
+  this->last_output_valid = false;
+  xSemaphoreGive(mutex);
+  this->attach();
+}
+
+/***************************************************************************//**
+ * Drives three PWM pins with the red, green and blue intensities of the light
+ *
+ * @param[in] red the output pin of the red LED
+ * @param[in] green the output pin of the green LED
+ * @param[in] blue the output pin of the blue LED
+ * @param[in] active_low true if the LEDs are on when the pins are low
+ ******************************************************************************/
+void MatterLightTransition::set_output_pins(pin_size_t red, pin_size_t green, pin_size_t blue, bool active_low)
+{
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  this->output_pins[0] = red;
+  this->output_pins[1] = green;
+  this->output_pins[2] = blue;
+  this->output_pin_count = 3u;
+  this->output_active_low = active_low;
+  this->last_output_valid = false;
+  xSemaphoreGive(mutex);
+  this->attach();
+}
+
+/***************************************************************************//**
+ * Sets a callback receiving the output intensities on every frame
+ * Can be used for LED drivers (e.g. ezWS2812) instead of PWM pins.
+ *
+ * @param[in] callback the output callback - nullptr to remove it
+ ******************************************************************************/
+void MatterLightTransition::set_output_callback(output_callback_t callback)
+{
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  this->output_callback = callback;
+  this->last_output_valid = false;
+  xSemaphoreGive(mutex);
+  this->attach();
+}
+
+/***************************************************************************//**
+ * Sets the fade time used for changes without a cluster transition
+ * Applies to on/off changes and to attribute writes without a transition time.
+ *
+ * @param[in] transition_ms the fade time in milliseconds - 0 switches instantly
+ ******************************************************************************/
+void MatterLightTransition::set_transition_time(uint16_t transition_ms)
+{
+  this->transition_ms = transition_ms;
+}
+
+/***************************************************************************//**
+ * Tells if the outputs are in the middle of a transition
+ *
+ * @return true if a transition is running, false otherwise
+ ******************************************************************************/
+bool MatterLightTransition::is_running()
+{
+  uint32_t now_ms = millis();
+  bool running = false;
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0u; i < channel_count; i++) {
+    running |= is_channel_running(this->channels[i], now_ms);
+  }
+  taskEXIT_CRITICAL();
+  return running;
+}
+
+/***************************************************************************//**
+ * Called by the lightbulb device when its output related state changes
+ * Can be called from the Matter task or from the sketch.
+ *
+ * @param[in] context the MatterLightTransition instance
+ ******************************************************************************/
+void MatterLightTransition::handle_output_changed(void* context)
+{
+  MatterLightTransition* transition = static_cast<MatterLightTransition*>(context);
+  transition->update_targets(false);
+  if (transition->attached && task_handle) {
+    xTaskNotifyGive(task_handle);
+  }
+}
+
+/***************************************************************************//**
+ * Moves the channel targets to the current state of the device
+ *
+ * @param[in] immediate true to jump to the new state without a transition
+ ******************************************************************************/
+void MatterLightTransition::update_targets(bool immediate)
+{
+  if (!this->device) {
+    return;
+  }
+  uint32_t now_ms = millis();
+  uint16_t level_remaining_time = this->device->GetLevelControlRemainingTime();
+  uint16_t color_remaining_time = this->device->GetColorControlRemainingTime();
+
+  // The level is scaled from the 0-254 range of the cluster to 16 bits
+  uint16_t level = 0u;
+  if (this->device->IsOn()) {
+    level = UINT16_MAX;
+    if (this->dimmable) {
+      level = (uint16_t)((uint32_t)this->device->GetLevel() * UINT16_MAX / 254u);
+    }
+  }
+  // A hue of 254 is a full turn of the color wheel - the same as 0
+  uint16_t hue = (uint16_t)(((uint32_t)this->device->GetHue() * 65536u / 254u) & 0xFFFFu);
+  uint32_t saturation = this->device->GetSaturation();
+  if (saturation > 254u) {
+    saturation = 254u;
+  }
+  saturation = saturation * UINT16_MAX / 254u;
+
+  taskENTER_CRITICAL();
+  if (immediate) {
+    uint16_t targets[channel_count] = { level, hue, (uint16_t)saturation };
+    for (uint8_t i = 0u; i < channel_count; i++) {
+      this->channels[i].start = targets[i];
+      this->channels[i].target = targets[i];
+      this->channels[i].duration_ms = 0u;
+      this->channels[i].last_change_ms = now_ms;
+    }
+  } else {
+    // A cluster server transition starts with setting the RemainingTime - the first step arrives one step interval later
+    if (this->level_remaining_time == 0u && level_remaining_time != 0u) {
+      this->channels[channel_level].last_change_ms = now_ms;
+    }
+    if (this->color_remaining_time == 0u && color_remaining_time != 0u) {
+      this->channels[channel_hue].last_change_ms = now_ms;
+      this->channels[channel_saturation].last_change_ms = now_ms;
+    }
+    this->retarget(this->channels[channel_level], level, now_ms, level_remaining_time != 0u);
+    this->retarget(this->channels[channel_hue], hue, now_ms, color_remaining_time != 0u);
+    this->retarget(this->channels[channel_saturation], (uint16_t)saturation, now_ms, color_remaining_time != 0u);
+  }
+  this->level_remaining_time = level_remaining_time;
+  this->color_remaining_time = color_remaining_time;
+  taskEXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * Starts moving a channel from its current value to a new target
+ * During a cluster server transition the channel reaches each step when the
+ * next one is expected - the step interval is measured between the steps.
+ * Otherwise the configured transition time is used.
+ *
+ * @param[in] channel the channel to move
+ * @param[in] target the new target value
+ * @param[in] now_ms the current time in milliseconds
+ * @param[in] in_transition true if the cluster server is running a transition
+ ******************************************************************************/
+void MatterLightTransition::retarget(channel_t& channel, uint16_t target, uint32_t now_ms, bool in_transition)
+{
+  if (channel.target == target) {
+    return;
+  }
+  uint32_t duration_ms = this->transition_ms;
+  if (in_transition) {
+    duration_ms = now_ms - channel.last_change_ms;
+    if (duration_ms > MATTER_LIGHT_TRANSITION_MAX_STEP_MS) {
+      duration_ms = MATTER_LIGHT_TRANSITION_MAX_STEP_MS;
+    }
+  }
+  channel.start = get_channel_value(channel, now_ms);
+  channel.target = target;
+  channel.start_ms = now_ms;
+  channel.duration_ms = duration_ms;
+  channel.last_change_ms = now_ms;
+}
+
+/***************************************************************************//**
+ * Provides the interpolated value of a channel
+ *
+ * @param[in] channel the channel
+ * @param[in] now_ms the current time in milliseconds
+ *
+ * @return the value of the channel at the given time
+ ******************************************************************************/
+uint16_t MatterLightTransition::get_channel_value(const channel_t& channel, uint32_t now_ms)
+{
+  if (!is_channel_running(channel, now_ms)) {
+    return channel.target;
+  }
+  // The hue takes the shorter way around the color wheel
+  int32_t delta = (int32_t)channel.target - (int32_t)channel.start;
+  if (channel.wraps) {
+    delta = (int16_t)(uint16_t)(channel.target - channel.start);
+  }
+  int64_t offset = (int64_t)delta * (int64_t)(now_ms - channel.start_ms) / (int64_t)channel.duration_ms;
+  return (uint16_t)((int32_t)channel.start + (int32_t)offset);
+}
+
+/***************************************************************************//**
+ * Tells if a channel is moving
+ *
+ * @param[in] channel the channel
+ * @param[in] now_ms the current time in milliseconds
+ *
+ * @return true if the channel hasn't reached its target yet
+ ******************************************************************************/
+bool MatterLightTransition::is_channel_running(const channel_t& channel, uint32_t now_ms)
+{
+  return (now_ms - channel.start_ms) < channel.duration_ms;
+}
+
+/***************************************************************************//**
+ * Converts a 16-bit level to linear intensity along the perceptual brightness
+ * curve - the 8-bit curve is interpolated to keep the fine steps
+ *
+ * @param[in] level the level (0-65535)
+ *
+ * @return the linear intensity (0-65535)
+ ******************************************************************************/
+uint16_t MatterLightTransition::level_to_linear(uint16_t level)
+{
+  uint8_t index = (uint8_t)(level >> 8);
+  uint32_t low = brightnessToLinear16(index);
+  if (index == UINT8_MAX) {
+    return (uint16_t)low;
+  }
+  uint32_t high = brightnessToLinear16((uint8_t)(index + 1u));
+  return (uint16_t)(low + (((high - low) * (level & 0xFFu) + 128u) >> 8));
+}
+
+/***************************************************************************//**
+ * Renders the current frame to the outputs - called from the transition task
+ *
+ * @param[in] now_ms the current time in milliseconds
+ *
+ * @return true if a transition is still running, false otherwise
+ ******************************************************************************/
+bool MatterLightTransition::render(uint32_t now_ms)
+{
+  uint16_t values[channel_count];
+  bool running = false;
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0u; i < channel_count; i++) {
+    values[i] = get_channel_value(this->channels[i], now_ms);
+    running |= is_channel_running(this->channels[i], now_ms);
+  }
+  taskEXIT_CRITICAL();
+
+  uint32_t brightness = level_to_linear(values[channel_level]);
+  uint16_t output[3] = { (uint16_t)brightness, (uint16_t)brightness, (uint16_t)brightness };
+  if (this->color) {
+    rgb16_t rgb = hsvToRgb16(values[channel_hue], values[channel_saturation], UINT16_MAX);
+    output[0] = (uint16_t)(((uint32_t)gammaToLinear16(rgb.red) * brightness + 32767u) / 65535u);
+    output[1] = (uint16_t)(((uint32_t)gammaToLinear16(rgb.green) * brightness + 32767u) / 65535u);
+    output[2] = (uint16_t)(((uint32_t)gammaToLinear16(rgb.blue) * brightness + 32767u) / 65535u);
+  }
+
+  // Only changes are written to the outputs
+  if (this->last_output_valid && memcmp(output, this->last_output, sizeof(output)) == 0) {
+    return running;
+  }
+  memcpy(this->last_output, output, sizeof(output));
+  this->last_output_valid = true;
+
+  // The PWM compare values are double buffered by the timer - every change takes effect at the start of a period
+  for (uint8_t i = 0u; i < this->output_pin_count; i++) {
+    PinName pin = pinToPinName(this->output_pins[i]);
+    if (pin == PIN_NAME_NC) {
+      continue;
+    }
+    uint16_t duty_cycle = output[i];
+    if (this->output_active_low) {
+      duty_cycle = UINT16_MAX - duty_cycle;
+    }
+    PWM.duty_cycle_mode_16bit(pin, duty_cycle);
+  }
+  if (this->output_callback) {
+    this->output_callback(output[0], output[1], output[2]);
+  }
+  return running;
+}
+
+/***************************************************************************//**
+ * Adds the instance to the rendered ones and starts the transition task
+ ******************************************************************************/
+void MatterLightTransition::attach()
+{
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if (!this->attached) {
+    this->next = first;
+    first = this;
+    this->attached = true;
+  }
+  if (task_handle == nullptr) {
+    BaseType_t result = xTaskCreate(MatterLightTransition::transition_task,
+                                    "light_transition",
+                                    MATTER_LIGHT_TRANSITION_TASK_STACK_SIZE,
+                                    NULL,
+                                    MATTER_LIGHT_TRANSITION_TASK_PRIORITY,
+                                    &task_handle);
+    if (result != pdPASS) {
+      task_handle = nullptr;
+    }
+  }
+  xSemaphoreGive(mutex);
+  // Render the current state
+  if (task_handle) {
+    xTaskNotifyGive(task_handle);
+  }
+}
+
+/***************************************************************************//**
+ * Removes the instance from the rendered ones
+ ******************************************************************************/
+void MatterLightTransition::detach()
+{
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if (this->attached) {
+    MatterLightTransition** link = &first;
+    while (*link && *link != this) {
+      link = &(*link)->next;
+    }
+    if (*link) {
+      *link = this->next;
+    }
+    this->next = nullptr;
+    this->attached = false;
+  }
+  xSemaphoreGive(mutex);
+}
+
+/***************************************************************************//**
+ * Renders the frames of all instances while any of them is in a transition
+ * Sleeps until the next change otherwise.
+ *
+ * @param[in] param unused
+ ******************************************************************************/
+void MatterLightTransition::transition_task(void* param)
+{
+  (void)param;
+  const TickType_t frame_ticks = pdMS_TO_TICKS(1000u / MATTER_LIGHT_TRANSITION_FRAME_RATE);
+  TickType_t last_wake = xTaskGetTickCount();
+  while (true) {
+    bool running = false;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    uint32_t now_ms = millis();
+    for (MatterLightTransition* transition = first; transition; transition = transition->next) {
+      running |= transition->render(now_ms);
+    }
+    xSemaphoreGive(mutex);
+
+    if (running) {
+      vTaskDelayUntil(&last_wake, frame_ticks);
+    } else {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      last_wake = xTaskGetTickCount();
+    }
+  }
+}
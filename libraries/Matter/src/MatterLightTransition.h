@@ -0,0 +1,129 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MATTER_LIGHT_TRANSITION_H
+#define MATTER_LIGHT_TRANSITION_H
+
+#include "Arduino.h"
+#include "devices/DeviceLightbulb.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+// Number of output updates per second while a transition is running
+#ifndef MATTER_LIGHT_TRANSITION_FRAME_RATE
+#define MATTER_LIGHT_TRANSITION_FRAME_RATE 50u
+#endif
+
+// Stack size of the transition task in words
+#ifndef MATTER_LIGHT_TRANSITION_TASK_STACK_SIZE
+#define MATTER_LIGHT_TRANSITION_TASK_STACK_SIZE 512u
+#endif
+
+// Priority of the transition task - above the Arduino task so that fades don't stutter when loop() is busy
+#ifndef MATTER_LIGHT_TRANSITION_TASK_PRIORITY
+#define MATTER_LIGHT_TRANSITION_TASK_PRIORITY 2u
+#endif
+
+// Longest interpolation between two steps of a cluster server transition
+#define MATTER_LIGHT_TRANSITION_MAX_STEP_MS 1000u
+
+// Renders the on/off state, level and color of a lightbulb device to its outputs
+// The LevelControl and ColorControl cluster servers change the attributes in steps during a transition.
+// The outputs follow these steps with a linear interpolation at a fixed frame rate with 16-bit precision,
+// so that the light fades smoothly. The frames are rendered by a shared task which only runs while
+// a transition is in progress - loop() has nothing to do.
+class MatterLightTransition {
+public:
+  // Receives the linear output intensities (0-65535) - called from the transition task
+  typedef void (*output_callback_t)(uint16_t red, uint16_t green, uint16_t blue);
+
+  MatterLightTransition();
+  ~MatterLightTransition();
+
+  void begin(DeviceLightbulb* device, bool dimmable, bool color);
+  void end();
+
+  void set_output_pin(pin_size_t pin, bool active_low);
+  void set_output_pins(pin_size_t red, pin_size_t green, pin_size_t blue, bool active_low);
+  void set_output_callback(output_callback_t callback);
+  void set_transition_time(uint16_t transition_ms);
+  bool is_running();
+
+private:
+  enum channel_index_t {
+    channel_level,
+    channel_hue,
+    channel_saturation,
+    channel_count
+  };
+
+  // A channel moves linearly from 'start' to 'target' in 'duration_ms'
+  struct channel_t {
+    uint16_t start;
+    uint16_t target;
+    uint32_t start_ms;
+    uint32_t duration_ms;
+    uint32_t last_change_ms;
+    bool wraps;
+  };
+
+  static void handle_output_changed(void* context);
+  void update_targets(bool immediate);
+  static void transition_task(void* param);
+  void retarget(channel_t& channel, uint16_t target, uint32_t now_ms, bool in_transition);
+  static uint16_t get_channel_value(const channel_t& channel, uint32_t now_ms);
+  static bool is_channel_running(const channel_t& channel, uint32_t now_ms);
+  static uint16_t level_to_linear(uint16_t level);
+  bool render(uint32_t now_ms);
+  void attach();
+  void detach();
+
+  DeviceLightbulb* device;
+  bool dimmable;
+  bool color;
+  channel_t channels[channel_count];
+  uint16_t level_remaining_time;
+  uint16_t color_remaining_time;
+  uint16_t transition_ms;
+
+  output_callback_t output_callback;
+  pin_size_t output_pins[3];
+  uint8_t output_pin_count;
+  bool output_active_low;
+  uint16_t last_output[3];
+  bool last_output_valid;
+
+  bool attached;
+  MatterLightTransition* next;
+
+  static MatterLightTransition* first;
+  static TaskHandle_t task_handle;
+  static SemaphoreHandle_t mutex;
+  static StaticSemaphore_t mutex_buf;
+};
+
+#endif // MATTER_LIGHT_TRANSITION_H
@@ -25,7 +25,6 @@
  */
 
 #include "MatterLightbulb.h"
-#include "util/hsv_rgb.h"
 
 using namespace ::chip;
 using namespace ::chip::Platform;
@@ -87,7 +86,7 @@ DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::OnOff::Id, BOOLEAN, 1, 0),
 DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::GlobalSceneControl::Id, BOOLEAN, 1, 0), /* GlobalSceneControl */
 DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::OnTime::Id, INT16U, 2, 0),              /* OnTime */
 DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::OffWaitTime::Id, INT16U, 2, 0),         /* OffWaitTime */
-DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::StartUpOnOff::Id, INT8U, 1, 0),         /* StartUpOnOff */
+DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::StartUpOnOff::Id, INT8U, 1, ZAP_ATTRIBUTE_MASK(NULLABLE)), /* StartUpOnOff */
 DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::FeatureMap::Id, BITMAP32, 4, 0),        /* FeatureMap */
 DECLARE_DYNAMIC_ATTRIBUTE(OnOff::Attributes::ClusterRevision::Id, INT16U, 2, 0),     /* ClusterRevision */
 DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
@@ -109,6 +108,7 @@ DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
 DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(colorControlAttrs)
 DECLARE_DYNAMIC_ATTRIBUTE(ColorControl::Attributes::CurrentHue::Id, INT8U, 1, 0),            /* CurrentHue */
 DECLARE_DYNAMIC_ATTRIBUTE(ColorControl::Attributes::CurrentSaturation::Id, INT8U, 1, 0),     /* CurrentSaturation */
+DECLARE_DYNAMIC_ATTRIBUTE(ColorControl::Attributes::RemainingTime::Id, INT16U, 2, 0),        /* RemainingTime */
 DECLARE_DYNAMIC_ATTRIBUTE(ColorControl::Attributes::ColorMode::Id, ENUM8, 1, 0),             /* ColorMode */
 DECLARE_DYNAMIC_ATTRIBUTE(ColorControl::Attributes::EnhancedColorMode::Id, ENUM8, 1, 0),     /* EnhancedColorMode */
 DECLARE_DYNAMIC_ATTRIBUTE(ColorControl::Attributes::ColorCapabilities::Id, BITMAP16, 2, 0),  /* ColorCapabilities */
@@ -125,6 +125,8 @@ DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAtt
 DECLARE_DYNAMIC_CLUSTER(Identify::Id, identifyAttrs, identifyIncomingCommands, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType SimpleLightbulbEndpointType = DynamicEndpointType(SimpleLightbulbEndpointClusters);
+
 // Dimmable Lightbulb endpoint cluster list
 DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(DimmableLightbulbEndpointClusters)
 DECLARE_DYNAMIC_CLUSTER(OnOff::Id, onOffAttrs, onOffIncomingCommands, nullptr),
@@ -134,6 +136,8 @@ DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAtt
 DECLARE_DYNAMIC_CLUSTER(Identify::Id, identifyAttrs, identifyIncomingCommands, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType DimmableLightbulbEndpointType = DynamicEndpointType(DimmableLightbulbEndpointClusters);
+
 // Color Lightbulb endpoint cluster list
 DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(ColorLightbulbEndpointClusters)
 DECLARE_DYNAMIC_CLUSTER(OnOff::Id, onOffAttrs, onOffIncomingCommands, nullptr),
@@ -144,6 +148,8 @@ DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAtt
 DECLARE_DYNAMIC_CLUSTER(Identify::Id, identifyAttrs, identifyIncomingCommands, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType ColorLightbulbEndpointType = DynamicEndpointType(ColorLightbulbEndpointClusters);
+
 //##################################################################################################
 // Functions for MatterLightbulb
 //##################################################################################################
@@ -153,8 +159,6 @@ DECLARE_DYNAMIC_CLUSTER_LIST_END;
  ******************************************************************************/
 MatterLightbulb::MatterLightbulb() :
   lightbulb_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   identify_server(nullptr),
   initialized(false)
 {
@@ -177,8 +181,7 @@ MatterLightbulb::~MatterLightbulb()
 bool MatterLightbulb::begin()
 {
   return this->begin_internal(lightbulb_simple,
-                              SimpleLightbulbEndpointClusters,
-                              ArraySize(SimpleLightbulbEndpointClusters));
+                              SimpleLightbulbEndpointType);
 }
 
 /***************************************************************************//**
@@ -186,14 +189,14 @@ bool MatterLightbulb::begin()
  *
  * @return true if the initialization succeeded, false otherwise
  ******************************************************************************/
-bool MatterLightbulb::begin_internal(bulb_types_e bulb_type, EmberAfCluster* endpoint_clusters, uint8_t cluster_count)
+bool MatterLightbulb::begin_internal(bulb_types_e bulb_type, const EmberAfEndpointType& endpoint_type)
 {
   if (this->initialized) {
     return false;
   }
 
   // Create new device
-  DeviceLightbulb* new_lightbulb_device = new (std::nothrow)DeviceLightbulb("Matter bulb");
+  DeviceLightbulb* new_lightbulb_device = this->device_endpoint.create<DeviceLightbulb>("Matter bulb");
   if (new_lightbulb_device == nullptr) {
     return false;
   }
@@ -216,57 +219,26 @@ bool MatterLightbulb::begin_internal(bulb_types_e bulb_type, EmberAfCluster* end
       break;
   }
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(new_lightbulb_device);
-    return false;
-  }
-  new_endpoint->cluster = endpoint_clusters;
-  new_endpoint->clusterCount = cluster_count;
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = cluster_count * sizeof(DataVersion);
-  DataVersion* new_bulb_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_bulb_data_version == nullptr) {
-    delete(new_lightbulb_device);
-    free(new_endpoint);
-    return false;
-  }
+  // Restore the stored state before the endpoint is published
+  bool state_restored = this->restore_persistent_state();
 
   // Add new endpoint
-  int result = -1;
-  if (bulb_type == lightbulb_simple) {
-    result = AddDeviceEndpoint(new_lightbulb_device,
-                               new_endpoint,
-                               Span<const EmberAfDeviceType>(gOnOffDeviceType),
-                               Span<DataVersion>(new_bulb_data_version, dataversion_size), 1);
-  } else if (bulb_type == lightbulb_dimmable || bulb_type == lightbulb_color) {
-    result = AddDeviceEndpoint(new_lightbulb_device,
-                               new_endpoint,
-                               Span<const EmberAfDeviceType>(gDimmableBulbDeviceType),
-                               Span<DataVersion>(new_bulb_data_version, dataversion_size), 1);
+  const EmberAfDeviceType* device_type = gOnOffDeviceType;
+  if (bulb_type == lightbulb_dimmable || bulb_type == lightbulb_color) {
+    device_type = gDimmableBulbDeviceType;
   }
-
-  if (result < 0) {
-    delete(new_lightbulb_device);
-    free(new_endpoint);
-    free(new_bulb_data_version);
+  if (!this->device_endpoint.add(endpoint_type, Span<const EmberAfDeviceType>(device_type, 1u))) {
     return false;
   }
 
   // Create a new Identify cluster server
-  ::Identify* identify_server = new (std::nothrow)::Identify(new_lightbulb_device->GetEndpointId(),
-                                                             IdentifyStartHandler,
-                                                             IdentifyStopHandler,
-                                                             Identify::IdentifyTypeEnum::kLightOutput,
-                                                             TriggerIdentifyEffectHandler);
+  ::Identify* identify_server = gIdentifyPool.create<::Identify>(new_lightbulb_device->GetEndpointId(),
+                                                                 IdentifyStartHandler,
+                                                                 IdentifyStopHandler,
+                                                                 Identify::IdentifyTypeEnum::kLightOutput,
+                                                                 TriggerIdentifyEffectHandler);
   if (identify_server == nullptr) {
-    (void)RemoveDeviceEndpoint(new_lightbulb_device);
-    delete(new_lightbulb_device);
-    free(new_endpoint);
-    free(new_bulb_data_version);
+    this->device_endpoint.remove();
     return false;
   }
 
@@ -277,14 +249,22 @@ bool MatterLightbulb::begin_internal(bulb_types_e bulb_type, EmberAfCluster* end
     // Call the LevelControl init callback one more time to have the min/max values set.
     // It's called first when adding the cluster/endpoint, but the min/max is not initialized at that point.
     // Without this the min/max is at 0 and every level change results in the bulb being turned off.
+    // The callback may also apply the StartUpCurrentLevel - a restored level is set back afterwards.
+    uint8_t restored_level = new_lightbulb_device->GetLevel();
     emberAfLevelControlClusterServerInitCallback(new_lightbulb_device->GetEndpointId());
+    if (state_restored) {
+      new_lightbulb_device->SetLevel(restored_level);
+    }
     // Set the device back to offline as the LevelControlClusterServer init inadvertently sets it to online
     new_lightbulb_device->SetOnline(false);
   }
 
+  // Follow the device state on the outputs once they're configured
+  this->transition.begin(new_lightbulb_device,
+                         bulb_type == lightbulb_dimmable || bulb_type == lightbulb_color,
+                         bulb_type == lightbulb_color);
+
   this->lightbulb_device = new_lightbulb_device;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_bulb_data_version;
   this->identify_server = identify_server;
   this->initialized = true;
   return true;
@@ -298,11 +278,9 @@ void MatterLightbulb::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->lightbulb_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->lightbulb_device);
-  delete(this->identify_server);
+  this->transition.end();
+  this->device_endpoint.remove();
+  gIdentifyPool.destroy(this->identify_server);
   this->initialized = false;
 }
 
@@ -347,6 +325,63 @@ void MatterLightbulb::toggle()
   PlatformMgr().UnlockChipStack();
 }
 
+/***************************************************************************//**
+ * Drives a PWM pin with the lightbulb's brightness
+ * The on/off state and the brightness are rendered with smooth transitions
+ * in the background - nothing has to be done in loop().
+ * For color lightbulbs the pin gets the brightness without the color.
+ *
+ * @param[in] pin the output pin
+ * @param[in] active_low true if the light is on when the pin is low
+ ******************************************************************************/
+void MatterLightbulb::set_output_pin(pin_size_t pin, bool active_low)
+{
+  if (!this->initialized) {
+    return;
+  }
+  this->transition.set_output_pin(pin, active_low);
+}
+
+/***************************************************************************//**
+ * Sets a callback which receives the lightbulb's output intensities
+ * The callback is called from the transition task with linear (gamma and
+ * brightness corrected) red, green and blue intensities in the range of
+ * 0-65535 whenever they change - all three are the same for lightbulbs
+ * without color. Can be used to drive LED drivers like ezWS2812.
+ *
+ * @param[in] callback the output callback
+ ******************************************************************************/
+void MatterLightbulb::set_output_callback(MatterLightTransition::output_callback_t callback)
+{
+  if (!this->initialized) {
+    return;
+  }
+  this->transition.set_output_callback(callback);
+}
+
+/***************************************************************************//**
+ * Sets the fade time for changes which don't come with a transition time
+ * The LevelControl and ColorControl transitions requested by the controller
+ * are always followed - this applies to on/off changes and to changes from
+ * the sketch. The default is 0 (instant).
+ *
+ * @param[in] transition_ms the fade time in milliseconds
+ ******************************************************************************/
+void MatterLightbulb::set_transition_time(uint16_t transition_ms)
+{
+  this->transition.set_transition_time(transition_ms);
+}
+
+/***************************************************************************//**
+ * Tells if the outputs are in the middle of a transition
+ *
+ * @return true if a transition is running, false otherwise
+ ******************************************************************************/
+bool MatterLightbulb::is_transitioning()
+{
+  return this->transition.is_running();
+}
+
 /***************************************************************************//**
  * Bool operator for getting the on/off state of the lightbulb
  *
@@ -395,8 +430,7 @@ MatterDimmableLightbulb::~MatterDimmableLightbulb()
 bool MatterDimmableLightbulb::begin()
 {
   return this->begin_internal(lightbulb_dimmable,
-                              DimmableLightbulbEndpointClusters,
-                              ArraySize(DimmableLightbulbEndpointClusters));
+                              DimmableLightbulbEndpointType);
 }
 
 /***************************************************************************//**
@@ -518,8 +552,7 @@ MatterColorLightbulb::~MatterColorLightbulb()
 bool MatterColorLightbulb::begin()
 {
   return this->begin_internal(lightbulb_color,
-                              ColorLightbulbEndpointClusters,
-                              ArraySize(ColorLightbulbEndpointClusters));
+                              ColorLightbulbEndpointType);
 }
 
 /***************************************************************************//**
@@ -645,21 +678,11 @@ void MatterColorLightbulb::get_rgb(uint8_t* r, uint8_t* g, uint8_t* b)
   if (!r || !g || !b) {
     return;
   }
-  uint8_t hue = this->get_hue();
-  uint8_t saturation = this->get_saturation();
-  uint8_t value = this->get_brightness();
-
-  // Adjust the hue range from 0-255 to 0-360 to represent the true hue
-  double hue_f = (double)hue * 360.0 / 254.0;
-  double saturation_f = (double)saturation / 254.0;
-  double value_f = (double)value / 255.0;
-
-  double in[3] = { hue_f, saturation_f, value_f };
-  uint8_t res[3];
-  HSVtoRGB(in, res);
-  *r = res[0];
-  *g = res[1];
-  *b = res[2];
+  // The brightness is scaled with 255 as the maximum to stay consistent with the previous floating point conversion
+  rgb16_t color = hsvToRgb16(this->get_hue16(), this->get_saturation16(), (uint16_t)(this->get_brightness() * 257u));
+  *r = (uint8_t)(color.red >> 8);
+  *g = (uint8_t)(color.green >> 8);
+  *b = (uint8_t)(color.blue >> 8);
 }
 
 /***************************************************************************//**
@@ -677,21 +700,38 @@ void MatterColorLightbulb::get_rgb_raw(uint8_t* r, uint8_t* g, uint8_t* b)
   if (!r || !g || !b) {
     return;
   }
-  uint8_t hue = this->get_hue();
-  // Adjust the hue range from 0-255 to 0-360 to represent the true hue
-  uint32_t hue_adj = (uint32_t)hue * 360 / 254;
-  uint8_t saturation = this->get_saturation();
-
-  double hue_f = (double)hue_adj;
-  double saturation_f = (double)saturation / 254.0;
-  double value_f = (double)1.0;
+  rgb16_t color = hsvToRgb16(this->get_hue16(), this->get_saturation16(), UINT16_MAX);
+  *r = (uint8_t)(color.red >> 8);
+  *g = (uint8_t)(color.green >> 8);
+  *b = (uint8_t)(color.blue >> 8);
+}
 
-  double in[3] = { hue_f, saturation_f, value_f };
-  uint8_t res[3];
-  HSVtoRGB(in, res);
-  *r = res[0];
-  *g = res[1];
-  *b = res[2];
+/***************************************************************************//**
+ * Provides the lightbulb's currently set color as linear PWM duty cycles
+ * The color is gamma corrected and scaled by the perceptual brightness curve,
+ * so the values can be written to the LED driving PWM outputs directly.
+ * Use the same resolution as the one set with analogWriteResolution().
+ * The output is all zeros when the lightbulb is off.
+ *
+ * @param[out] r pointer to a variable to hold the Red duty cycle
+ * @param[out] g pointer to a variable to hold the Green duty cycle
+ * @param[out] b pointer to a variable to hold the Blue duty cycle
+ * @param[in] resolution the resolution of the duty cycles in bits (1-16)
+ ******************************************************************************/
+void MatterColorLightbulb::get_rgb_pwm(uint16_t* r, uint16_t* g, uint16_t* b, uint8_t resolution)
+{
+  if (!r || !g || !b) {
+    return;
+  }
+  uint8_t level = 0u;
+  if (this->get_onoff()) {
+    // Scale the level from 0-254 to the 0-255 range of the brightness curve
+    level = (uint8_t)(((uint32_t)this->get_brightness() * 255u + 127u) / 254u);
+  }
+  rgb16_t color = hsvToLinearRgb16(this->get_hue16(), this->get_saturation16(), level);
+  *r = (uint16_t)scaleToResolution16(color.red, resolution);
+  *g = (uint16_t)scaleToResolution16(color.green, resolution);
+  *b = (uint16_t)scaleToResolution16(color.blue, resolution);
 }
 
 /***************************************************************************//**
@@ -706,15 +746,58 @@ void MatterColorLightbulb::set_rgb(uint8_t r, uint8_t g, uint8_t b)
   if (!this->initialized) {
     return;
   }
-  uint8_t rgb_in[3] = { r, g, b };
-  double hsv_out[3];
-  RGBtoHSV(rgb_in, hsv_out);
-  uint16_t true_hue = (uint16_t)hsv_out[0];
-  uint8_t saturation = (uint8_t)hsv_out[1];
-  uint8_t brightness = (uint8_t)hsv_out[2];
-  this->set_true_hue(true_hue);
-  this->set_saturation(saturation);
-  this->set_brightness(brightness);
+  rgb16_t color = { (uint16_t)(r * 257u), (uint16_t)(g * 257u), (uint16_t)(b * 257u) };
+  uint16_t hue, saturation, value;
+  rgbToHsv16(color, &hue, &saturation, &value);
+  // Scale the hue and the saturation down to the 0-254 range of the device
+  this->set_hue((uint8_t)((((uint32_t)hue * 254u) + 32768u) >> 16));
+  this->set_saturation((uint8_t)(((uint32_t)saturation * 254u + 32767u) / 65535u));
+  this->set_brightness((uint8_t)(value >> 8));
+}
+
+/***************************************************************************//**
+ * Drives three PWM pins with the lightbulb's color
+ * The color and brightness are rendered with smooth transitions in the
+ * background - nothing has to be done in loop().
+ *
+ * @param[in] red_pin the output pin of the red LED
+ * @param[in] green_pin the output pin of the green LED
+ * @param[in] blue_pin the output pin of the blue LED
+ * @param[in] active_low true if the LEDs are on when the pins are low
+ ******************************************************************************/
+void MatterColorLightbulb::set_output_pins(pin_size_t red_pin, pin_size_t green_pin, pin_size_t blue_pin, bool active_low)
+{
+  if (!this->initialized) {
+    return;
+  }
+  this->transition.set_output_pins(red_pin, green_pin, blue_pin, active_low);
+}
+
+/***************************************************************************//**
+ * Provides the lightbulb's current hue scaled to the 16-bit range of the
+ * fixed-point color conversion
+ *
+ * @return the current hue (0-65535)
+ ******************************************************************************/
+uint16_t MatterColorLightbulb::get_hue16()
+{
+  // A hue of 254 is a full turn of the color wheel - the same as 0
+  return (uint16_t)(((uint32_t)this->get_hue() * 65536u / 254u) & 0xFFFFu);
+}
+
+/***************************************************************************//**
+ * Provides the lightbulb's current (boosted) saturation scaled to the 16-bit
+ * range of the fixed-point color conversion
+ *
+ * @return the current saturation (0-65535)
+ ******************************************************************************/
+uint16_t MatterColorLightbulb::get_saturation16()
+{
+  uint32_t saturation = this->get_saturation();
+  if (saturation > 254u) {
+    saturation = 254u;
+  }
+  return (uint16_t)(saturation * 65535u / 254u);
 }
 
 /***************************************************************************//**
@@ -29,6 +29,7 @@
 
 #include "Matter.h"
 #include "devices/DeviceLightbulb.h"
+#include "MatterLightTransition.h"
 #include <platform/CHIPDeviceLayer.h>
 #include <app-common/zap-generated/attributes/Accessors.h>
 #include <app-common/zap-generated/callback.h>
@@ -47,6 +48,11 @@ public:
   bool get_onoff();
   void toggle();
 
+  void set_output_pin(pin_size_t pin, bool active_low = false);
+  void set_output_callback(MatterLightTransition::output_callback_t callback);
+  void set_transition_time(uint16_t transition_ms);
+  bool is_transitioning();
+
   operator bool();
   void operator=(bool state);
 
@@ -57,11 +63,11 @@ protected:
     lightbulb_color
   };
 
-  bool begin_internal(bulb_types_e bulb_type, EmberAfCluster* endpoint_clusters, uint8_t cluster_count);
+  bool begin_internal(bulb_types_e bulb_type, const EmberAfEndpointType& endpoint_type);
   DeviceLightbulb* lightbulb_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceLightbulb> device_endpoint;
   ::Identify* identify_server;
+  MatterLightTransition transition;
   bool initialized;
 };
 
@@ -99,13 +105,18 @@ public:
 
   void get_rgb(uint8_t* r, uint8_t* g, uint8_t* b);
   void get_rgb_raw(uint8_t* r, uint8_t* g, uint8_t* b);
+  void get_rgb_pwm(uint16_t* r, uint16_t* g, uint16_t* b, uint8_t resolution = 16u);
   void set_rgb(uint8_t r, uint8_t g, uint8_t b);
+  void set_output_pins(pin_size_t red_pin, pin_size_t green_pin, pin_size_t blue_pin, bool active_low = false);
   void boost_saturation(uint8_t amount);
 
   void operator=(bool state);
   void operator=(unsigned int brightness);
 
 protected:
+  uint16_t get_hue16();
+  uint16_t get_saturation16();
+
   uint8_t saturation_boost;
 };
 
@@ -48,8 +48,7 @@ public:
 
 private:
   DeviceOccupancySensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceOccupancySensor> device_endpoint;
   bool initialized;
 };
 
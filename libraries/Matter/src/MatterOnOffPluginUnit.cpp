@@ -54,13 +54,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType OnOffPluginUnitEndpointType = DynamicEndpointType(OnOffPluginUnitEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterOnOffPluginUnit
  ******************************************************************************/
 MatterOnOffPluginUnit::MatterOnOffPluginUnit() :
   pluginunit_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -86,7 +86,7 @@ bool MatterOnOffPluginUnit::begin()
   }
 
   // Create new device
-  DeviceOnOffPluginUnit* pluginunit_device = new (std::nothrow)DeviceOnOffPluginUnit("Matter On/Off Outlet");
+  DeviceOnOffPluginUnit* pluginunit_device = this->device_endpoint.create<DeviceOnOffPluginUnit>("Matter On/Off Outlet");
   if (pluginunit_device == nullptr) {
     return false;
   }
@@ -95,40 +95,15 @@ bool MatterOnOffPluginUnit::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = pluginunit_device;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(pluginunit_device);
-    return false;
-  }
-  new_endpoint->cluster = OnOffPluginUnitEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(OnOffPluginUnitEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(OnOffPluginUnitEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_pluginunit_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_pluginunit_data_version == nullptr) {
-    delete(pluginunit_device);
-    free(new_endpoint);
-    return false;
-  }
+  // Restore the stored state before the endpoint is published
+  (void)this->restore_persistent_state();
 
   // Add new endpoint
-  int result = AddDeviceEndpoint(pluginunit_device,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gOnOffPluginUnitDeviceType),
-                                 Span<DataVersion>(new_pluginunit_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(pluginunit_device);
-    free(new_endpoint);
-    free(new_pluginunit_data_version);
+  if (!this->device_endpoint.add(OnOffPluginUnitEndpointType, Span<const EmberAfDeviceType>(gOnOffPluginUnitDeviceType))) {
     return false;
   }
 
   this->pluginunit_device = pluginunit_device;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_pluginunit_data_version;
   this->initialized = true;
   return true;
 }
@@ -141,10 +116,7 @@ void MatterOnOffPluginUnit::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->pluginunit_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->pluginunit_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
@@ -52,8 +52,7 @@ public:
 
 private:
   DeviceOnOffPluginUnit* pluginunit_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceOnOffPluginUnit> device_endpoint;
   bool initialized;
 };
 
@@ -35,7 +35,7 @@
 using namespace chip;
 using namespace ::chip::DeviceLayer;
 
-class MatterPressure : public ArduinoMatterAppliance {
+class MatterPressure : public ArduinoMatterMeasurementAppliance {
 public:
   MatterPressure();
   ~MatterPressure();
@@ -54,8 +54,7 @@ public:
 
 private:
   DevicePressureSensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DevicePressureSensor> device_endpoint;
   bool initialized;
 };
 
@@ -60,13 +60,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType switchEndpointType = DynamicEndpointType(switchEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterSwitch
  ******************************************************************************/
 MatterSwitch::MatterSwitch() :
   switch_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -92,7 +92,7 @@ bool MatterSwitch::begin()
   }
 
   // Create new device
-  DeviceSwitch* new_switch_device = new (std::nothrow)DeviceSwitch("Switch");
+  DeviceSwitch* new_switch_device = this->device_endpoint.create<DeviceSwitch>("Switch");
   if (new_switch_device == nullptr) {
     return false;
   }
@@ -102,34 +102,8 @@ bool MatterSwitch::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = new_switch_device;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(new_switch_device);
-    return false;
-  }
-  new_endpoint->cluster = switchEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(switchEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(switchEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_switch_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_switch_data_version == nullptr) {
-    delete(new_switch_device);
-    free(new_endpoint);
-    return false;
-  }
-
   // Add new endpoint
-  int result = AddDeviceEndpoint(new_switch_device,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gSwitchDeviceTypes),
-                                 Span<DataVersion>(new_switch_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(new_switch_device);
-    free(new_endpoint);
-    free(new_switch_data_version);
+  if (!this->device_endpoint.add(switchEndpointType, Span<const EmberAfDeviceType>(gSwitchDeviceTypes))) {
     return false;
   }
 
@@ -138,8 +112,6 @@ bool MatterSwitch::begin()
   new_switch_device->SetMultiPressMax(1);
 
   this->switch_device = new_switch_device;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_switch_data_version;
   this->initialized = true;
   return true;
 }
@@ -152,10 +124,7 @@ void MatterSwitch::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->switch_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->switch_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
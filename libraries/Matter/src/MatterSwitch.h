@@ -48,8 +48,7 @@ public:
 
 private:
   DeviceSwitch* switch_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceSwitch> device_endpoint;
   bool initialized;
 };
 
@@ -35,7 +35,11 @@
 using namespace chip;
 using namespace ::chip::DeviceLayer;
 
-class MatterTemperature : public ArduinoMatterAppliance {
+// Endpoint layout of the temperature sensor - also used by MatterBridge
+extern const EmberAfDeviceType gTempSensorDeviceTypes[1];
+extern const EmberAfEndpointType tempMeasurementEndpointType;
+
+class MatterTemperature : public ArduinoMatterMeasurementAppliance {
 public:
   MatterTemperature();
   ~MatterTemperature();
@@ -54,8 +58,7 @@ public:
 
 private:
   DeviceTempSensor* sensor_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceTempSensor> device_endpoint;
   bool initialized;
 };
 
@@ -59,13 +59,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType thermostatEndpointType = DynamicEndpointType(thermostatEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterThermostat
  ******************************************************************************/
 MatterThermostat::MatterThermostat() :
   thermostat_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -91,7 +91,7 @@ bool MatterThermostat::begin()
   }
 
   // Create new device
-  DeviceThermostat* new_thermostat_device = new (std::nothrow)DeviceThermostat("Thermostat", 20, 20);
+  DeviceThermostat* new_thermostat_device = this->device_endpoint.create<DeviceThermostat>("Thermostat", 20, 20);
   if (new_thermostat_device == nullptr) {
     return false;
   }
@@ -101,40 +101,15 @@ bool MatterThermostat::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = new_thermostat_device;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(new_thermostat_device);
-    return false;
-  }
-  new_endpoint->cluster = thermostatEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(thermostatEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(thermostatEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_sensor_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_sensor_data_version == nullptr) {
-    delete(new_thermostat_device);
-    free(new_endpoint);
-    return false;
-  }
+  // Restore the stored state before the endpoint is published
+  (void)this->restore_persistent_state();
 
   // Add new endpoint
-  int result = AddDeviceEndpoint(new_thermostat_device,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gThermostatDeviceTypes),
-                                 Span<DataVersion>(new_sensor_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(new_thermostat_device);
-    free(new_endpoint);
-    free(new_sensor_data_version);
+  if (!this->device_endpoint.add(thermostatEndpointType, Span<const EmberAfDeviceType>(gThermostatDeviceTypes))) {
     return false;
   }
 
   this->thermostat_device = new_thermostat_device;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_sensor_data_version;
   this->initialized = true;
   return true;
 }
@@ -147,10 +122,7 @@ void MatterThermostat::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->thermostat_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->thermostat_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
@@ -71,8 +71,7 @@ public:
 
 private:
   DeviceThermostat* thermostat_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceThermostat> device_endpoint;
   bool initialized;
 };
 
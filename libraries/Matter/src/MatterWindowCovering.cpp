@@ -61,13 +61,13 @@ DECLARE_DYNAMIC_CLUSTER(Descriptor::Id, descriptorAttrs, nullptr, nullptr),
 DECLARE_DYNAMIC_CLUSTER(BridgedDeviceBasicInformation::Id, bridgedDeviceBasicAttrs, nullptr, nullptr)
 DECLARE_DYNAMIC_CLUSTER_LIST_END;
 
+constexpr EmberAfEndpointType windowCoveringEndpointType = DynamicEndpointType(windowCoveringEndpointClusters);
+
 /***************************************************************************//**
  * Constructor for MatterWindowCovering
  ******************************************************************************/
 MatterWindowCovering::MatterWindowCovering() :
   window_covering_device(nullptr),
-  device_endpoint(nullptr),
-  endpoint_dataversion_storage(nullptr),
   initialized(false)
 {
   ;
@@ -93,7 +93,7 @@ bool MatterWindowCovering::begin()
   }
 
   // Create new device
-  DeviceWindowCovering* device = new (std::nothrow)DeviceWindowCovering("Window covering");
+  DeviceWindowCovering* device = this->device_endpoint.create<DeviceWindowCovering>("Window covering");
   if (device == nullptr) {
     return false;
   }
@@ -103,40 +103,15 @@ bool MatterWindowCovering::begin()
   // Set the device instance pointer in the base class
   this->base_matter_device = device;
 
-  // Create new endpoint
-  EmberAfEndpointType* new_endpoint = (EmberAfEndpointType*)malloc(sizeof(EmberAfEndpointType));
-  if (new_endpoint == nullptr) {
-    delete(device);
-    return false;
-  }
-  new_endpoint->cluster = windowCoveringEndpointClusters;
-  new_endpoint->clusterCount = ArraySize(windowCoveringEndpointClusters);
-  new_endpoint->endpointSize = 0;
-
-  // Create data version storage for the endpoint
-  size_t dataversion_size = ArraySize(windowCoveringEndpointClusters) * sizeof(DataVersion);
-  DataVersion* new_sensor_data_version = (DataVersion*)malloc(dataversion_size);
-  if (new_sensor_data_version == nullptr) {
-    delete(device);
-    free(new_endpoint);
-    return false;
-  }
+  // Restore the stored state before the endpoint is published
+  (void)this->restore_persistent_state();
 
   // Add new endpoint
-  int result = AddDeviceEndpoint(device,
-                                 new_endpoint,
-                                 Span<const EmberAfDeviceType>(gWindowCoveringDeviceTypes),
-                                 Span<DataVersion>(new_sensor_data_version, dataversion_size), 1);
-  if (result < 0) {
-    delete(device);
-    free(new_endpoint);
-    free(new_sensor_data_version);
+  if (!this->device_endpoint.add(windowCoveringEndpointType, Span<const EmberAfDeviceType>(gWindowCoveringDeviceTypes))) {
     return false;
   }
 
   this->window_covering_device = device;
-  this->device_endpoint = new_endpoint;
-  this->endpoint_dataversion_storage = new_sensor_data_version;
   this->initialized = true;
   return true;
 }
@@ -149,10 +124,7 @@ void MatterWindowCovering::end()
   if (!this->initialized) {
     return;
   }
-  (void)RemoveDeviceEndpoint(this->window_covering_device);
-  free(this->device_endpoint);
-  free(this->endpoint_dataversion_storage);
-  delete(this->window_covering_device);
+  this->device_endpoint.remove();
   this->initialized = false;
 }
 
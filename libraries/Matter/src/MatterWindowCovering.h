@@ -63,8 +63,7 @@ public:
 
 private:
   DeviceWindowCovering* window_covering_device;
-  EmberAfEndpointType* device_endpoint;
-  DataVersion* endpoint_dataversion_storage;
+  MatterEndpoint<DeviceWindowCovering> device_endpoint;
   bool initialized;
 };
 
@@ -27,7 +27,7 @@
 #include "DeviceAirQualitySensor.h"
 
 DeviceAirQualitySensor::DeviceAirQualitySensor(const char* device_name, uint8_t measured_value) :
-  Device(device_name),
+  Device(device_name, kDeviceType_AirQualitySensor, DeviceAirQualitySensor::GetAttributeTable()),
   measured_value(measured_value)
 {
   ;
@@ -41,11 +41,11 @@ uint8_t DeviceAirQualitySensor::GetMeasuredValue()
 void DeviceAirQualitySensor::SetMeasuredValue(uint8_t measurement)
 {
   bool changed = this->measured_value != measurement;
-  ChipLogProgress(DeviceLayer, "AirQualitySensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
+  ChipLogAttributeAccess("AirQualitySensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
   this->measured_value = measurement;
 
   if (changed) {
-    this->HandleAirQualitySensorDeviceStatusChanged(kChanged_MeasurementValue);
+    this->HandleDeviceStatusChanged(kChanged_MeasurementValue);
   }
 }
 
@@ -59,47 +59,25 @@ uint16_t DeviceAirQualitySensor::GetAirQualitySensorClusterRevision()
   return this->air_quality_sensor_cluster_revision;
 }
 
-EmberAfStatus DeviceAirQualitySensor::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                           chip::AttributeId attributeId,
-                                                           uint8_t* buffer,
-                                                           uint16_t maxReadLength)
+Device::AttributeTable DeviceAirQualitySensor::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::AirQuality::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadAirQualitySensorAttribute: clusterId=%lu attrId=%ld, length:%d", clusterId, attributeId, maxReadLength);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::AirQuality::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == AirQuality::Id) && (maxReadLength == 1)) {
-    uint8_t measuredValue = this->GetMeasuredValue();
-    memcpy(buffer, &measuredValue, sizeof(measuredValue));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetAirQualitySensorClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetAirQualitySensorClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
+  using namespace ::chip::app::Clusters::AirQuality;
 
-  return EMBER_ZCL_STATUS_SUCCESS;
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DeviceAirQualitySensor, Id, Attributes::AirQuality::Id, uint8_t, dev->GetMeasuredValue()),
+    DEVICE_ATTRIBUTE_READ(DeviceAirQualitySensor, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetAirQualitySensorClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceAirQualitySensor, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetAirQualitySensorClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DeviceAirQualitySensor::HandleAirQualitySensorDeviceStatusChanged(Changed_t itemChangedMask)
+void DeviceAirQualitySensor::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & DeviceAirQualitySensor::kChanged_MeasurementValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, AirQuality::Id, AirQuality::Attributes::AirQuality::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, AirQuality::Id, AirQuality::Attributes::AirQuality::Id);
   }
 }
@@ -42,12 +42,9 @@ public:
   uint32_t GetAirQualitySensorClusterFeatureMap();
   uint16_t GetAirQualitySensorClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
 private:
-  void HandleAirQualitySensorDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
 
   uint8_t measured_value;
 
@@ -27,7 +27,7 @@
 #include "DeviceContactSensor.h"
 
 DeviceContactSensor::DeviceContactSensor(const char* device_name) :
-  Device(device_name),
+  Device(device_name, kDeviceType_ContactSensor, DeviceContactSensor::GetAttributeTable()),
   state_value(false)
 {
   ;
@@ -42,9 +42,9 @@ void DeviceContactSensor::SetStateValue(bool state_value)
 {
   bool changed = this->state_value != state_value;
   if (changed) {
-    ChipLogProgress(DeviceLayer, "ContactSensorDevice[%s]: new state='%d'", this->device_name, state_value);
+    ChipLogAttributeAccess("ContactSensorDevice[%s]: new state='%d'", this->device_name, state_value);
     this->state_value = state_value;
-    this->HandleContactSensorDeviceStatusChanged(kChanged_StateValue);
+    this->HandleDeviceStatusChanged(kChanged_StateValue);
   }
 }
 
@@ -53,44 +53,24 @@ uint16_t DeviceContactSensor::GetBooleanStateClusterRevision()
   return this->boolean_state_cluster_revision;
 }
 
-EmberAfStatus DeviceContactSensor::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                              chip::AttributeId attributeId,
-                                                              uint8_t* buffer,
-                                                              uint16_t maxReadLength)
+Device::AttributeTable DeviceContactSensor::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::BooleanState::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadContactSensorAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::BooleanState::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == StateValue::Id) && (maxReadLength == 1)) {
-    uint8_t stateValue = (uint8_t)this->GetStateValue();
-    memcpy(buffer, &stateValue, sizeof(stateValue));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetBooleanStateClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
+  using namespace ::chip::app::Clusters::BooleanState;
 
-  return EMBER_ZCL_STATUS_SUCCESS;
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DeviceContactSensor, Id, Attributes::StateValue::Id, uint8_t, (uint8_t)dev->GetStateValue()),
+    DEVICE_ATTRIBUTE_READ(DeviceContactSensor, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetBooleanStateClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DeviceContactSensor::HandleContactSensorDeviceStatusChanged(Changed_t itemChangedMask)
+void DeviceContactSensor::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & kChanged_StateValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, BooleanState::Id, BooleanState::Attributes::StateValue::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, BooleanState::Id, BooleanState::Attributes::StateValue::Id);
   }
 }
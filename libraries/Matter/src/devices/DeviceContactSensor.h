@@ -41,13 +41,9 @@ public:
   void SetStateValue(bool state_value);
   uint16_t GetBooleanStateClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
 private:
-  void HandleContactSensorDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
 
   bool state_value;
   static const uint16_t boolean_state_cluster_revision = 1u;
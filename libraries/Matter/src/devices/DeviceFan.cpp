@@ -27,7 +27,7 @@
 #include "DeviceFan.h"
 
 DeviceFan::DeviceFan(const char* device_name) :
-  Device(device_name),
+  Device(device_name, kDeviceType_Fan, DeviceFan::GetAttributeTable()),
   current_percent(0),
   current_fan_mode(fan_mode_t::Off)
 {
@@ -46,12 +46,11 @@ void DeviceFan::SetPercentSetting(uint8_t percent)
   }
 
   bool changed = this->current_percent != percent;
-  ChipLogProgress(DeviceLayer, "FanDevice[%s]: new percent='%d'", this->device_name, percent);
+  ChipLogAttributeAccess("FanDevice[%s]: new percent='%d'", this->device_name, percent);
   this->current_percent = percent;
 
   if (changed) {
-    this->HandleFanDeviceStatusChanged(kChanged_PercentSetting);
-    this->HandleFanDeviceStatusChanged(kChanged_PercentCurrent);
+    this->HandleDeviceStatusChanged(kChanged_PercentSetting | kChanged_PercentCurrent);
   }
 }
 
@@ -68,11 +67,11 @@ void DeviceFan::SetPercentCurrent(uint8_t percent)
 void DeviceFan::SetFanMode(uint8_t fan_mode)
 {
   bool changed = this->current_fan_mode != fan_mode;
-  ChipLogProgress(DeviceLayer, "FanDevice[%s]: new mode='%d'", this->device_name, fan_mode);
+  ChipLogAttributeAccess("FanDevice[%s]: new mode='%d'", this->device_name, fan_mode);
   this->current_fan_mode = (fan_mode_t)fan_mode;
 
   if (changed) {
-    this->HandleFanDeviceStatusChanged(kChanged_ModeSetting);
+    this->HandleDeviceStatusChanged(kChanged_ModeSetting);
   }
 
   if (!changed) {
@@ -118,88 +117,64 @@ uint16_t DeviceFan::GetFanClusterRevision()
   return this->fan_cluster_revision;
 }
 
-EmberAfStatus DeviceFan::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                    chip::AttributeId attributeId,
-                                                    uint8_t* buffer,
-                                                    uint16_t maxReadLength)
+Device::AttributeTable DeviceFan::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
+  using namespace ::chip::app::Clusters::FanControl;
+
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceFan, Id, Attributes::FanMode::Id, uint8_t, dev->GetFanMode(), dev->SetFanMode(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceFan, Id, Attributes::FanModeSequence::Id, uint8_t, dev->GetFanModeSequence()),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceFan, Id, Attributes::PercentSetting::Id, uint8_t, dev->GetPercentSetting(), dev->SetPercentSetting(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceFan, Id, Attributes::PercentCurrent::Id, uint8_t, dev->GetPercentCurrent()),
+    DEVICE_ATTRIBUTE_READ(DeviceFan, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetFanClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceFan, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetFanClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
+}
 
-  using namespace ::chip::app::Clusters::FanControl::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadFanControlAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
+void DeviceFan::ReportChangedAttributes(uint32_t itemChangedMask)
+{
+  using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
+  if (itemChangedMask & kChanged_PercentSetting) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, FanControl::Id, FanControl::Attributes::PercentSetting::Id);
   }
-
-  if (clusterId != chip::app::Clusters::FanControl::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
+  if (itemChangedMask & kChanged_PercentCurrent) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, FanControl::Id, FanControl::Attributes::PercentCurrent::Id);
   }
-
-  if ((attributeId == FanMode::Id) && (maxReadLength == 1)) {
-    uint8_t fanmode = this->GetFanMode();
-    memcpy(buffer, &fanmode, sizeof(fanmode));
-  } else if ((attributeId == FanModeSequence::Id) && (maxReadLength == 1)) {
-    uint8_t fanmode_sequence = this->GetFanModeSequence();
-    memcpy(buffer, &fanmode_sequence, sizeof(fanmode_sequence));
-  } else if ((attributeId == PercentSetting::Id) && (maxReadLength == 1)) {
-    uint8_t percent_setting = this->GetPercentSetting();
-    memcpy(buffer, &percent_setting, sizeof(percent_setting));
-  } else if ((attributeId == PercentCurrent::Id) && (maxReadLength == 1)) {
-    uint8_t percent_current = this->GetPercentCurrent();
-    memcpy(buffer, &percent_current, sizeof(percent_current));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetFanClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetFanClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
+  if (itemChangedMask & kChanged_ModeSetting) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, FanControl::Id, FanControl::Attributes::FanMode::Id);
   }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
 }
 
-EmberAfStatus DeviceFan::HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                                     chip::AttributeId attributeId,
-                                                     uint8_t* buffer)
+uint32_t DeviceFan::GetPersistentChangedMask()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::FanControl::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleWriteFanControlAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId != chip::app::Clusters::FanControl::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
+  return kChanged_PercentSetting | kChanged_ModeSetting;
+}
 
-  if (attributeId == PercentSetting::Id) {
-    this->SetPercentSetting(*buffer);
-  } else if (attributeId == FanMode::Id) {
-    this->SetFanMode(*buffer);
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
+size_t DeviceFan::GetPersistentState(uint8_t* buffer, size_t size)
+{
+  PersistentState state = { this->current_percent, static_cast<uint8_t>(this->current_fan_mode) };
+  if (size < sizeof(state)) {
+    return 0u;
   }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  memcpy(buffer, &state, sizeof(state));
+  return sizeof(state);
 }
 
-void DeviceFan::HandleFanDeviceStatusChanged(Changed_t itemChangedMask)
+bool DeviceFan::SetPersistentState(const uint8_t* buffer, size_t length)
 {
-  using namespace ::chip::app::Clusters;
-
-  if (itemChangedMask & kChanged_PercentSetting) {
-    ScheduleMatterReportingCallback(this->endpoint_id, FanControl::Id, FanControl::Attributes::PercentSetting::Id);
+  PersistentState state;
+  if (length != sizeof(state)) {
+    return false;
   }
-  if (itemChangedMask & kChanged_PercentCurrent) {
-    ScheduleMatterReportingCallback(this->endpoint_id, FanControl::Id, FanControl::Attributes::PercentCurrent::Id);
-  }
-  if (itemChangedMask & kChanged_ModeSetting) {
-    ScheduleMatterReportingCallback(this->endpoint_id, FanControl::Id, FanControl::Attributes::FanMode::Id);
+  memcpy(&state, buffer, sizeof(state));
+  if (state.percent > 100u || state.fan_mode > fan_mode_t::Smart) {
+    return false;
   }
+  this->current_percent = state.percent;
+  this->current_fan_mode = static_cast<fan_mode_t>(state.fan_mode);
+  return true;
 }
@@ -50,15 +50,6 @@ public:
   uint32_t GetFanClusterFeatureMap();
   uint16_t GetFanClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
-  EmberAfStatus HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                            chip::AttributeId attributeId,
-                                            uint8_t* buffer) override;
-
   enum fan_mode_t {
     Off,
     Low,
@@ -70,7 +61,16 @@ public:
   };
 
 private:
-  void HandleFanDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
+  uint32_t GetPersistentChangedMask() override;
+  size_t GetPersistentState(uint8_t* buffer, size_t size) override;
+  bool SetPersistentState(const uint8_t* buffer, size_t length) override;
+
+  struct PersistentState {
+    uint8_t percent;
+    uint8_t fan_mode;
+  };
 
   uint8_t current_percent;
   fan_mode_t current_fan_mode;
@@ -30,7 +30,7 @@ DeviceFlowSensor::DeviceFlowSensor(const char* device_name,
                                    uint16_t min,
                                    uint16_t max,
                                    uint16_t measured_value) :
-  Device(device_name),
+  Device(device_name, kDeviceType_FlowSensor, DeviceFlowSensor::GetAttributeTable()),
   min_value(min),
   max_value(max),
   measured_value(measured_value)
@@ -43,7 +43,7 @@ uint16_t DeviceFlowSensor::GetMeasuredValue()
   return this->measured_value;
 }
 
-void DeviceFlowSensor::SetMeasuredValue(uint16_t measurement)
+void DeviceFlowSensor::SetMeasuredValue(uint16_t measurement, bool force)
 {
   if (measurement < this->min_value) {
     measurement = this->min_value;
@@ -52,11 +52,11 @@ void DeviceFlowSensor::SetMeasuredValue(uint16_t measurement)
   }
 
   bool changed = this->measured_value != measurement;
-  ChipLogProgress(DeviceLayer, "FlowSensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
+  ChipLogAttributeAccess("FlowSensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
   this->measured_value = measurement;
 
-  if (changed) {
-    this->HandleFlowSensorDeviceStatusChanged(kChanged_MeasurementValue);
+  if (changed || force) {
+    this->HandleDeviceStatusChanged(kChanged_MeasurementValue);
   }
 }
 
@@ -70,53 +70,27 @@ uint16_t DeviceFlowSensor::GetFlowSensorClusterRevision()
   return this->flow_sensor_cluster_revision;
 }
 
-EmberAfStatus DeviceFlowSensor::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                           chip::AttributeId attributeId,
-                                                           uint8_t* buffer,
-                                                           uint16_t maxReadLength)
+Device::AttributeTable DeviceFlowSensor::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::FlowMeasurement::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadFlowMeasurementAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::FlowMeasurement::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == MeasuredValue::Id) && (maxReadLength == 2)) {
-    uint16_t measuredValue = this->GetMeasuredValue();
-    memcpy(buffer, &measuredValue, sizeof(measuredValue));
-  } else if ((attributeId == MinMeasuredValue::Id) && (maxReadLength == 2)) {
-    uint16_t minValue = this->min_value;
-    memcpy(buffer, &minValue, sizeof(minValue));
-  } else if ((attributeId == MaxMeasuredValue::Id) && (maxReadLength == 2)) {
-    uint16_t maxValue = this->max_value;
-    memcpy(buffer, &maxValue, sizeof(maxValue));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetFlowSensorClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetFlowSensorClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  using namespace ::chip::app::Clusters::FlowMeasurement;
+
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DeviceFlowSensor, Id, Attributes::MeasuredValue::Id, uint16_t, dev->GetMeasuredValue()),
+    DEVICE_ATTRIBUTE_READ(DeviceFlowSensor, Id, Attributes::MinMeasuredValue::Id, uint16_t, dev->min_value),
+    DEVICE_ATTRIBUTE_READ(DeviceFlowSensor, Id, Attributes::MaxMeasuredValue::Id, uint16_t, dev->max_value),
+    DEVICE_ATTRIBUTE_READ(DeviceFlowSensor, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetFlowSensorClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceFlowSensor, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetFlowSensorClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DeviceFlowSensor::HandleFlowSensorDeviceStatusChanged(Changed_t itemChangedMask)
+void DeviceFlowSensor::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & kChanged_MeasurementValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, FlowMeasurement::Id, FlowMeasurement::Attributes::MeasuredValue::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, FlowMeasurement::Id, FlowMeasurement::Attributes::MeasuredValue::Id);
   }
 }
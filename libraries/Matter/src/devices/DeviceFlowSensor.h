@@ -38,20 +38,16 @@ public:
   DeviceFlowSensor(const char* device_name, uint16_t min, uint16_t max, uint16_t measured_value);
 
   uint16_t GetMeasuredValue();
-  void SetMeasuredValue(uint16_t measurement);
+  void SetMeasuredValue(uint16_t measurement, bool force = false);
   uint32_t GetFlowSensorClusterFeatureMap();
   uint16_t GetFlowSensorClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
   const uint16_t min_value;
   const uint16_t max_value;
 
 private:
-  void HandleFlowSensorDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
 
   uint16_t measured_value;
 
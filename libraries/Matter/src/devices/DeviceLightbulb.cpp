@@ -27,15 +27,19 @@
 #include "DeviceLightbulb.h"
 
 DeviceLightbulb::DeviceLightbulb(const char* device_name) :
-  Device(device_name),
+  Device(device_name, kDeviceType_Lightbulb, DeviceLightbulb::GetAttributeTable()),
   onoff(false),
   global_scene_control(false),
   on_time(0u),
   off_wait_time(0u),
-  startup_on_off(0u),
+  startup_on_off(startup_on_off_previous),
   hue(0),
   saturation(0),
-  level(52)
+  level(52),
+  level_control_remaining_time(0u),
+  color_control_remaining_time(0u),
+  output_changed_handler(nullptr),
+  output_changed_context(nullptr)
 {
   ;
 }
@@ -49,9 +53,10 @@ void DeviceLightbulb::SetOnOff(bool onoff)
 {
   bool changed = onoff ^ this->onoff;
   this->onoff = onoff;
-  ChipLogProgress(DeviceLayer, "DeviceLightbulb[%s]: %s", this->device_name, onoff ? "ON" : "OFF");
+  ChipLogAttributeAccess("DeviceLightbulb[%s]: %s", this->device_name, onoff ? "ON" : "OFF");
   if (changed) {
-    this->HandleLightbulbDeviceStatusChanged(kChanged_OnOff);
+    this->HandleDeviceStatusChanged(kChanged_OnOff);
+    this->HandleOutputChanged();
   }
 }
 
@@ -61,6 +66,20 @@ void DeviceLightbulb::Toggle()
   this->SetOnOff(inverse_state);
 }
 
+void DeviceLightbulb::SetStartUpOnOff(uint8_t startup_on_off)
+{
+  if (this->startup_on_off == startup_on_off) {
+    return;
+  }
+  this->startup_on_off = startup_on_off;
+  this->HandleDeviceStatusChanged(kChanged_StartUpOnOff);
+}
+
+uint8_t DeviceLightbulb::GetStartUpOnOff()
+{
+  return this->startup_on_off;
+}
+
 uint8_t DeviceLightbulb::GetLevel()
 {
   return this->level;
@@ -77,7 +96,8 @@ void DeviceLightbulb::SetLevel(uint8_t level)
   } else {
     this->level = level;
   }
-  this->HandleLightbulbDeviceStatusChanged(kChanged_Level);
+  this->HandleDeviceStatusChanged(kChanged_Level);
+  this->HandleOutputChanged();
 }
 
 void DeviceLightbulb::SetHue(uint8_t hue)
@@ -86,7 +106,8 @@ void DeviceLightbulb::SetHue(uint8_t hue)
     return;
   }
   this->hue = hue;
-  this->HandleLightbulbDeviceStatusChanged(kChanged_Color);
+  this->HandleDeviceStatusChanged(kChanged_Color);
+  this->HandleOutputChanged();
 }
 
 uint8_t DeviceLightbulb::GetHue()
@@ -100,7 +121,8 @@ void DeviceLightbulb::SetSaturation(uint8_t saturation)
     return;
   }
   this->saturation = saturation;
-  this->HandleLightbulbDeviceStatusChanged(kChanged_Color);
+  this->HandleDeviceStatusChanged(kChanged_Color);
+  this->HandleOutputChanged();
 }
 
 uint8_t DeviceLightbulb::GetSaturation()
@@ -108,6 +130,19 @@ uint8_t DeviceLightbulb::GetSaturation()
   return this->saturation;
 }
 
+void DeviceLightbulb::SetOutputChangedHandler(OutputChangedHandler handler, void* context)
+{
+  this->output_changed_handler = handler;
+  this->output_changed_context = context;
+}
+
+void DeviceLightbulb::HandleOutputChanged()
+{
+  if (this->output_changed_handler) {
+    this->output_changed_handler(this->output_changed_context);
+  }
+}
+
 uint32_t DeviceLightbulb::GetOnoffClusterFeatureMap()
 {
   return this->onoff_cluster_feature_map;
@@ -168,6 +203,20 @@ uint16_t DeviceLightbulb::GetLevelControlRemainingTime()
   return this->level_control_remaining_time;
 }
 
+void DeviceLightbulb::SetLevelControlRemainingTime(uint16_t remaining_time)
+{
+  if (this->level_control_remaining_time == remaining_time) {
+    return;
+  }
+  // The cluster server updates the remaining time on every step - it's only reported when a transition starts or ends
+  bool report = (this->level_control_remaining_time == 0u) || (remaining_time == 0u);
+  this->level_control_remaining_time = remaining_time;
+  if (report) {
+    this->HandleDeviceStatusChanged(kChanged_LevelControlRemainingTime);
+  }
+  this->HandleOutputChanged();
+}
+
 uint8_t DeviceLightbulb::GetColorControlOptions()
 {
   return this->color_control_options;
@@ -188,170 +237,126 @@ uint8_t DeviceLightbulb::GetColorControlColorCapabilities()
   return this->color_control_color_capabilities;
 }
 
-EmberAfStatus DeviceLightbulb::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                          chip::AttributeId attributeId,
-                                                          uint8_t* buffer,
-                                                          uint16_t maxReadLength)
+uint16_t DeviceLightbulb::GetColorControlRemainingTime()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters;
-  ChipLogProgress(DeviceLayer, "HandleReadLightbulbAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-  if (clusterId == Identify::Id) {
-    return this->HandleReadIdentifyAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId == OnOff::Id) {
-    if ((attributeId == OnOff::Attributes::OnOff::Id) && (maxReadLength == 1)) {
-      *buffer = this->IsOn() ? 1 : 0;
-    } else if ((attributeId == OnOff::Attributes::GlobalSceneControl::Id) && (maxReadLength == 1)) {
-      *buffer = this->global_scene_control ? 1 : 0;
-    } else if ((attributeId == OnOff::Attributes::OnTime::Id) && (maxReadLength == 2)) {
-      uint16_t onTime = this->on_time;
-      memcpy(buffer, &onTime, sizeof(onTime));
-    } else if ((attributeId == OnOff::Attributes::OffWaitTime::Id) && (maxReadLength == 2)) {
-      uint16_t offWaitTime = this->off_wait_time;
-      memcpy(buffer, &offWaitTime, sizeof(offWaitTime));
-    } else if ((attributeId == OnOff::Attributes::StartUpOnOff::Id) && (maxReadLength == 1)) {
-      *buffer = this->startup_on_off;
-    } else if ((attributeId == OnOff::Attributes::ClusterRevision::Id) && (maxReadLength == 2)) {
-      uint16_t rev = this->GetOnoffClusterRevision();
-      memcpy(buffer, &rev, sizeof(rev));
-    } else if ((attributeId == OnOff::Attributes::FeatureMap::Id) && (maxReadLength == 4)) {
-      uint32_t featureMap = this->GetOnoffClusterFeatureMap();
-      memcpy(buffer, &featureMap, sizeof(featureMap));
-    } else {
-      ChipLogProgress(DeviceLayer, "HandleReadLightbulbAttribute - OnOff: invalid read");
-      return EMBER_ZCL_STATUS_FAILURE;
-    }
-  }
+  return this->color_control_remaining_time;
+}
 
-  if (clusterId == LevelControl::Id) {
-    if ((attributeId == LevelControl::Attributes::CurrentLevel::Id) && (maxReadLength == 1)) {
-      uint8_t level = this->GetLevel();
-      memcpy(buffer, &level, sizeof(level));
-    } else if ((attributeId == LevelControl::Attributes::Options::Id) && (maxReadLength == 1)) {
-      uint8_t options = this->GetLevelControlOptions();
-      memcpy(buffer, &options, sizeof(options));
-    } else if ((attributeId == LevelControl::Attributes::OnLevel::Id) && (maxReadLength == 1)) {
-      uint8_t onLevel = this->GetLevelControlOnLevel();
-      memcpy(buffer, &onLevel, sizeof(onLevel));
-    } else if ((attributeId == LevelControl::Attributes::MaxLevel::Id) && (maxReadLength == 1)) {
-      uint8_t maxLevel = this->GetLevelControlMaxLevel();
-      memcpy(buffer, &maxLevel, sizeof(maxLevel));
-    } else if ((attributeId == LevelControl::Attributes::MinLevel::Id) && (maxReadLength == 1)) {
-      uint8_t minLevel = this->GetLevelControlMinLevel();
-      memcpy(buffer, &minLevel, sizeof(minLevel));
-    } else if ((attributeId == LevelControl::Attributes::RemainingTime::Id) && (maxReadLength == 2)) {
-      uint16_t remainingTime = this->GetLevelControlRemainingTime();
-      memcpy(buffer, &remainingTime, sizeof(remainingTime));
-    } else if ((attributeId == LevelControl::Attributes::StartUpCurrentLevel::Id) && (maxReadLength == 1)) {
-      uint8_t startupCurrentLevel = this->GetLevelControlStartupCurrentLevel();
-      memcpy(buffer, &startupCurrentLevel, sizeof(startupCurrentLevel));
-    } else if ((attributeId == LevelControl::Attributes::FeatureMap::Id) && (maxReadLength == 4)) {
-      uint32_t featureMap = this->GetLevelControlClusterFeatureMap();
-      memcpy(buffer, &featureMap, sizeof(featureMap));
-    } else if ((attributeId == LevelControl::Attributes::ClusterRevision::Id) && (maxReadLength == 2)) {
-      uint16_t clusterRevision = this->GetLevelControlClusterRevision();
-      memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-    } else {
-      ChipLogProgress(DeviceLayer, "HandleReadLightbulbAttribute - LevelControl: invalid read");
-      return EMBER_ZCL_STATUS_FAILURE;
-    }
+void DeviceLightbulb::SetColorControlRemainingTime(uint16_t remaining_time)
+{
+  if (this->color_control_remaining_time == remaining_time) {
+    return;
   }
-
-  if (clusterId == ColorControl::Id) {
-    if ((attributeId == ColorControl::Attributes::CurrentHue::Id) && (maxReadLength == 1)) {
-      uint8_t hue = this->GetHue();
-      memcpy(buffer, &hue, sizeof(hue));
-    } else if ((attributeId == ColorControl::Attributes::CurrentSaturation::Id) && (maxReadLength == 1)) {
-      uint8_t saturation = this->GetSaturation();
-      memcpy(buffer, &saturation, sizeof(saturation));
-    } else if ((attributeId == ColorControl::Attributes::Options::Id) && (maxReadLength == 1)) {
-      uint8_t options = this->GetColorControlOptions();
-      memcpy(buffer, &options, sizeof(options));
-    } else if ((attributeId == ColorControl::Attributes::ColorMode::Id) && (maxReadLength == 1)) {
-      uint8_t colorMode = this->GetColorControlColorMode();
-      memcpy(buffer, &colorMode, sizeof(colorMode));
-    } else if ((attributeId == ColorControl::Attributes::EnhancedColorMode::Id) && (maxReadLength == 1)) {
-      uint8_t enhancedColorMode = this->GetColorControlEnhancedColorMode();
-      memcpy(buffer, &enhancedColorMode, sizeof(enhancedColorMode));
-    } else if ((attributeId == ColorControl::Attributes::ColorCapabilities::Id) && (maxReadLength == 2)) {
-      uint16_t colorCapabilities = this->GetColorControlColorCapabilities();
-      memcpy(buffer, &colorCapabilities, sizeof(colorCapabilities));
-    } else if ((attributeId == ColorControl::Attributes::FeatureMap::Id) && (maxReadLength == 4)) {
-      uint32_t featureMap = this->GetColorControlClusterFeatureMap();
-      memcpy(buffer, &featureMap, sizeof(featureMap));
-    } else if ((attributeId == ColorControl::Attributes::ClusterRevision::Id) && (maxReadLength == 2)) {
-      uint16_t clusterRevision = this->GetColorControlClusterRevision();
-      memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-    } else {
-      ChipLogProgress(DeviceLayer, "HandleReadLightbulbAttribute - ColorControl: invalid read");
-      return EMBER_ZCL_STATUS_FAILURE;
-    }
+  bool report = (this->color_control_remaining_time == 0u) || (remaining_time == 0u);
+  this->color_control_remaining_time = remaining_time;
+  if (report) {
+    this->HandleDeviceStatusChanged(kChanged_ColorControlRemainingTime);
   }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  this->HandleOutputChanged();
 }
 
-EmberAfStatus DeviceLightbulb::HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                                           chip::AttributeId attributeId,
-                                                           uint8_t* buffer)
+Device::AttributeTable DeviceLightbulb::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
   using namespace ::chip::app::Clusters;
-  ChipLogProgress(DeviceLayer, "HandleWriteLightbulbAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == Identify::Id) {
-    return this->HandleWriteIdentifyAttribute(clusterId, attributeId, buffer);
-  }
 
-  if ((attributeId == OnOff::Attributes::OnOff::Id) && (clusterId == OnOff::Id)) {
-    if (*buffer) {
-      this->SetOnOff(true);
-    } else {
-      this->SetOnOff(false);
-    }
-  } else if ((attributeId == LevelControl::Attributes::CurrentLevel::Id) && (clusterId == LevelControl::Id)) {
-    this->SetLevel(*buffer);
-  } else if ((attributeId == ColorControl::Attributes::CurrentHue::Id) && (clusterId == ColorControl::Id)) {
-    this->SetHue(*buffer);
-  } else if ((attributeId == ColorControl::Attributes::CurrentSaturation::Id) && (clusterId == ColorControl::Id)) {
-    this->SetSaturation(*buffer);
-  } else if ((attributeId == OnOff::Attributes::OnTime::Id) && (clusterId == OnOff::Id)) {
-    memcpy(&this->on_time, buffer, sizeof(this->on_time));
-  } else if ((attributeId == OnOff::Attributes::OffWaitTime::Id) && (clusterId == OnOff::Id)) {
-    memcpy(&this->off_wait_time, buffer, sizeof(this->off_wait_time));
-  } else if ((attributeId == OnOff::Attributes::StartUpOnOff::Id) && (clusterId == OnOff::Id)) {
-    this->startup_on_off = *buffer;
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, OnOff::Id, OnOff::Attributes::OnOff::Id, uint8_t, dev->IsOn() ? 1u : 0u, dev->SetOnOff(value != 0u)),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, OnOff::Id, OnOff::Attributes::GlobalSceneControl::Id, uint8_t, dev->global_scene_control ? 1u : 0u),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, OnOff::Id, OnOff::Attributes::OnTime::Id, uint16_t, dev->on_time, dev->on_time = value),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, OnOff::Id, OnOff::Attributes::OffWaitTime::Id, uint16_t, dev->off_wait_time, dev->off_wait_time = value),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, OnOff::Id, OnOff::Attributes::StartUpOnOff::Id, uint8_t, dev->startup_on_off, dev->SetStartUpOnOff(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, OnOff::Id, OnOff::Attributes::FeatureMap::Id, uint32_t, dev->GetOnoffClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, OnOff::Id, OnOff::Attributes::ClusterRevision::Id, uint16_t, dev->GetOnoffClusterRevision()),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id, uint8_t, dev->GetLevel(), dev->SetLevel(value)),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::RemainingTime::Id, uint16_t, dev->GetLevelControlRemainingTime(), dev->SetLevelControlRemainingTime(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::MinLevel::Id, uint8_t, dev->GetLevelControlMinLevel()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::MaxLevel::Id, uint8_t, dev->GetLevelControlMaxLevel()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::Options::Id, uint8_t, dev->GetLevelControlOptions()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::OnLevel::Id, uint8_t, dev->GetLevelControlOnLevel()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::StartUpCurrentLevel::Id, uint8_t, dev->GetLevelControlStartupCurrentLevel()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::FeatureMap::Id, uint32_t, dev->GetLevelControlClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, LevelControl::Id, LevelControl::Attributes::ClusterRevision::Id, uint16_t, dev->GetLevelControlClusterRevision()),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::CurrentHue::Id, uint8_t, dev->GetHue(), dev->SetHue(value)),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::CurrentSaturation::Id, uint8_t, dev->GetSaturation(), dev->SetSaturation(value)),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::RemainingTime::Id, uint16_t, dev->GetColorControlRemainingTime(), dev->SetColorControlRemainingTime(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::ColorMode::Id, uint8_t, dev->GetColorControlColorMode()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::Options::Id, uint8_t, dev->GetColorControlOptions()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::EnhancedColorMode::Id, uint8_t, dev->GetColorControlEnhancedColorMode()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::ColorCapabilities::Id, uint16_t, dev->GetColorControlColorCapabilities()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::FeatureMap::Id, uint32_t, dev->GetColorControlClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceLightbulb, ColorControl::Id, ColorControl::Attributes::ClusterRevision::Id, uint16_t, dev->GetColorControlClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DeviceLightbulb::HandleLightbulbDeviceStatusChanged(Changed_t itemChangedMask)
+void DeviceLightbulb::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & kChanged_OnOff) {
-    ScheduleMatterReportingCallback(this->endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id);
   }
   if (itemChangedMask & kChanged_Level) {
-    ScheduleMatterReportingCallback(this->endpoint_id, LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id);
   }
   if (itemChangedMask & kChanged_Color) {
-    ScheduleMatterReportingCallback(this->endpoint_id, ColorControl::Id, ColorControl::Attributes::CurrentHue::Id);
-    ScheduleMatterReportingCallback(this->endpoint_id, ColorControl::Id, ColorControl::Attributes::CurrentSaturation::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, ColorControl::Id, ColorControl::Attributes::CurrentHue::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, ColorControl::Id, ColorControl::Attributes::CurrentSaturation::Id);
+  }
+  if (itemChangedMask & kChanged_StartUpOnOff) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, OnOff::Id, OnOff::Attributes::StartUpOnOff::Id);
+  }
+  if (itemChangedMask & kChanged_LevelControlRemainingTime) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, LevelControl::Id, LevelControl::Attributes::RemainingTime::Id);
+  }
+  if (itemChangedMask & kChanged_ColorControlRemainingTime) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, ColorControl::Id, ColorControl::Attributes::RemainingTime::Id);
+  }
+}
+
+uint32_t DeviceLightbulb::GetPersistentChangedMask()
+{
+  return kChanged_OnOff | kChanged_Level | kChanged_Color | kChanged_StartUpOnOff;
+}
+
+size_t DeviceLightbulb::GetPersistentState(uint8_t* buffer, size_t size)
+{
+  PersistentState state = { static_cast<uint8_t>(this->onoff), this->startup_on_off, this->level, this->hue, this->saturation };
+  if (size < sizeof(state)) {
+    return 0u;
+  }
+  memcpy(buffer, &state, sizeof(state));
+  return sizeof(state);
+}
+
+bool DeviceLightbulb::SetPersistentState(const uint8_t* buffer, size_t length)
+{
+  PersistentState state;
+  if (length != sizeof(state)) {
+    return false;
+  }
+  memcpy(&state, buffer, sizeof(state));
+
+  // Restored before the endpoint is added - the members are set directly as there's nothing to report yet
+  this->startup_on_off = state.startup_on_off;
+  switch (state.startup_on_off) {
+    case 0u:  // Off
+      this->onoff = false;
+      break;
+    case 1u:  // On
+      this->onoff = true;
+      break;
+    case 2u:  // Toggle
+      this->onoff = (state.onoff == 0u);
+      break;
+    default:  // Previous
+      this->onoff = (state.onoff != 0u);
+      break;
   }
+  this->level = (state.level > this->level_control_max_level) ? this->level_control_max_level : state.level;
+  this->hue = state.hue;
+  this->saturation = state.saturation;
+  return true;
 }
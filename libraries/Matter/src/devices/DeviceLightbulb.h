@@ -35,19 +35,28 @@ public:
     kChanged_OnOff = kChanged_Last << 1,
     kChanged_Level = kChanged_Last << 2,
     kChanged_Color = kChanged_Last << 3,
+    kChanged_StartUpOnOff = kChanged_Last << 4,
+    kChanged_LevelControlRemainingTime = kChanged_Last << 5,
+    kChanged_ColorControlRemainingTime = kChanged_Last << 6,
   } Changed;
 
+  // Called when the on/off state, the level, the color or a remaining transition time changes
+  typedef void (*OutputChangedHandler)(void* context);
+
   DeviceLightbulb(const char* device_name);
 
   bool IsOn();
   void SetOnOff(bool onoff);
   void Toggle();
+  void SetStartUpOnOff(uint8_t startup_on_off);
+  uint8_t GetStartUpOnOff();
   uint8_t GetLevel();
   void SetLevel(uint8_t level);
   void SetHue(uint8_t hue);
   uint8_t GetHue();
   void SetSaturation(uint8_t saturation);
   uint8_t GetSaturation();
+  void SetOutputChangedHandler(OutputChangedHandler handler, void* context);
 
   uint32_t GetOnoffClusterFeatureMap();
   uint32_t GetLevelControlClusterFeatureMap();
@@ -62,23 +71,30 @@ public:
   uint8_t GetLevelControlOnLevel();
   uint8_t GetLevelControlStartupCurrentLevel();
   uint16_t GetLevelControlRemainingTime();
+  void SetLevelControlRemainingTime(uint16_t remaining_time);
 
   uint8_t GetColorControlOptions();
   uint8_t GetColorControlColorMode();
   uint8_t GetColorControlEnhancedColorMode();
   uint8_t GetColorControlColorCapabilities();
-
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
-  EmberAfStatus HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                            chip::AttributeId attributeId,
-                                            uint8_t* buffer) override;
+  uint16_t GetColorControlRemainingTime();
+  void SetColorControlRemainingTime(uint16_t remaining_time);
 
 private:
-  void HandleLightbulbDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
+  uint32_t GetPersistentChangedMask() override;
+  size_t GetPersistentState(uint8_t* buffer, size_t size) override;
+  bool SetPersistentState(const uint8_t* buffer, size_t length) override;
+  void HandleOutputChanged();
+
+  struct PersistentState {
+    uint8_t onoff;
+    uint8_t startup_on_off;
+    uint8_t level;
+    uint8_t hue;
+    uint8_t saturation;
+  };
 
   bool onoff;
   bool global_scene_control;
@@ -90,6 +106,15 @@ private:
   uint8_t saturation;
   uint8_t level;
 
+  // Written by the LevelControl and ColorControl cluster servers while they run a transition - in 1/10 seconds
+  uint16_t level_control_remaining_time;
+  uint16_t color_control_remaining_time;
+
+  OutputChangedHandler output_changed_handler;
+  void* output_changed_context;
+
+  static const uint8_t startup_on_off_previous = 0xFFu;           // Null - the previous on/off state is restored at startup
+
   static const uint32_t onoff_cluster_feature_map         = 1u;   // Level control for lighting (bit 0) enabled
   static const uint32_t level_control_cluster_feature_map = 3u;   // On/Off (bit 0) and Lighting support (bit 1) enabled
   static const uint32_t color_control_cluster_feature_map = 1u;   // Hue/Saturation support (bit 0) enabled
@@ -103,7 +128,6 @@ private:
   static const uint8_t level_control_options = 0u;                // No extra options enabled
   static const uint8_t level_control_on_level = 254u;
   static const uint8_t level_control_startup_current_level = 254u;
-  static const uint16_t level_control_remaining_time = 0u;
 
   static const uint8_t color_control_options = 0u;                // No extra options enabled
   static const uint8_t color_control_color_mode = 0u;             // Current hue and saturation determines the color
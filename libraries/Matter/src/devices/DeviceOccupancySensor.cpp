@@ -27,7 +27,7 @@
 #include "DeviceOccupancySensor.h"
 
 DeviceOccupancySensor::DeviceOccupancySensor(const char* device_name) :
-  Device(device_name)
+  Device(device_name, kDeviceType_OccupancySensor, DeviceOccupancySensor::GetAttributeTable())
 {
 }
 
@@ -39,11 +39,11 @@ bool DeviceOccupancySensor::GetOccupancy()
 void DeviceOccupancySensor::SetOccupancy(bool occupied)
 {
   bool changed = this->occupancy != occupied;
-  ChipLogProgress(DeviceLayer, "OccupancySensorDevice[%s]: New state='%u'", this->device_name, occupied);
+  ChipLogAttributeAccess("OccupancySensorDevice[%s]: New state='%u'", this->device_name, occupied);
   this->occupancy = occupied;
 
   if (changed) {
-    this->HandleOccupancySensorDeviceStatusChanged(kChanged_OccupancyValue);
+    this->HandleDeviceStatusChanged(kChanged_OccupancyValue);
   }
 }
 
@@ -57,47 +57,25 @@ uint16_t DeviceOccupancySensor::GetOccupancySensorClusterRevision()
   return this->occupancy_sensor_cluster_revision;
 }
 
-EmberAfStatus DeviceOccupancySensor::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                                chip::AttributeId attributeId,
-                                                                uint8_t* buffer,
-                                                                uint16_t maxReadLength)
+Device::AttributeTable DeviceOccupancySensor::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::OccupancySensing::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadOccupancySensingAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::OccupancySensing::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == Occupancy::Id) && (maxReadLength == 1)) {
-    bool occupied = this->GetOccupancy();
-    memcpy(buffer, &occupied, sizeof(occupied));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetOccupancySensorClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetOccupancySensorClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
+  using namespace ::chip::app::Clusters::OccupancySensing;
 
-  return EMBER_ZCL_STATUS_SUCCESS;
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DeviceOccupancySensor, Id, Attributes::Occupancy::Id, bool, dev->GetOccupancy()),
+    DEVICE_ATTRIBUTE_READ(DeviceOccupancySensor, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetOccupancySensorClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceOccupancySensor, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetOccupancySensorClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DeviceOccupancySensor::HandleOccupancySensorDeviceStatusChanged(Changed_t itemChangedMask)
+void DeviceOccupancySensor::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & kChanged_OccupancyValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, OccupancySensing::Id, OccupancySensing::Attributes::Occupancy::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, OccupancySensing::Id, OccupancySensing::Attributes::Occupancy::Id);
   }
 }
@@ -42,13 +42,9 @@ public:
   uint32_t GetOccupancySensorClusterFeatureMap();
   uint16_t GetOccupancySensorClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
 private:
-  void HandleOccupancySensorDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
 
   bool occupancy;
 
@@ -27,7 +27,7 @@
 #include "DeviceOnOffPluginUnit.h"
 
 DeviceOnOffPluginUnit::DeviceOnOffPluginUnit(const char* device_name) :
-  Device(device_name),
+  Device(device_name, kDeviceType_OnOffPluginUnit, DeviceOnOffPluginUnit::GetAttributeTable()),
   is_on(false)
 {
   ;
@@ -42,9 +42,9 @@ void DeviceOnOffPluginUnit::SetOnOff(bool onoff)
 {
   bool changed = onoff ^ this->is_on;
   this->is_on = onoff;
-  ChipLogProgress(DeviceLayer, "DeviceOnOffPluginUnit[%s]: %s", this->device_name, onoff ? "ON" : "OFF");
+  ChipLogAttributeAccess("DeviceOnOffPluginUnit[%s]: %s", this->device_name, onoff ? "ON" : "OFF");
   if (changed) {
-    this->HandleDeviceOnOffPluginUnitStatusChanged(kChanged_OnOff);
+    this->HandleDeviceStatusChanged(kChanged_OnOff);
   }
 }
 
@@ -64,69 +64,51 @@ uint16_t DeviceOnOffPluginUnit::GetOnoffClusterRevision()
   return this->onoff_cluster_revision;
 }
 
-EmberAfStatus DeviceOnOffPluginUnit::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                                chip::AttributeId attributeId,
-                                                                uint8_t* buffer,
-                                                                uint16_t maxReadLength)
+Device::AttributeTable DeviceOnOffPluginUnit::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
+  using namespace ::chip::app::Clusters::OnOff;
+
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceOnOffPluginUnit, Id, Attributes::OnOff::Id, uint8_t, dev->IsOn() ? 1u : 0u, dev->SetOnOff(value != 0u)),
+    DEVICE_ATTRIBUTE_READ(DeviceOnOffPluginUnit, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetOnoffClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceOnOffPluginUnit, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetOnoffClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
+}
 
+void DeviceOnOffPluginUnit::ReportChangedAttributes(uint32_t itemChangedMask)
+{
   using namespace ::chip::app::Clusters;
-  ChipLogProgress(DeviceLayer, "HandleReadOnOffPluginUnitAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
+  Device::ReportChangedAttributes(itemChangedMask);
 
-  if (clusterId == OnOff::Id) {
-    if ((attributeId == OnOff::Attributes::OnOff::Id) && (maxReadLength == 1)) {
-      *buffer = this->IsOn() ? 1 : 0;
-    } else if ((attributeId == OnOff::Attributes::ClusterRevision::Id) && (maxReadLength == 2)) {
-      uint16_t rev = this->GetOnoffClusterRevision();
-      memcpy(buffer, &rev, sizeof(rev));
-    } else if ((attributeId == OnOff::Attributes::FeatureMap::Id) && (maxReadLength == 4)) {
-      uint32_t featureMap = this->GetOnoffClusterFeatureMap();
-      memcpy(buffer, &featureMap, sizeof(featureMap));
-    } else {
-      ChipLogProgress(DeviceLayer, "HandleReadOnOffPluginUnitAttribute - OnOff: invalid read");
-      return EMBER_ZCL_STATUS_FAILURE;
-    }
+  if (itemChangedMask & kChanged_OnOff) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id);
   }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
 }
 
-EmberAfStatus DeviceOnOffPluginUnit::HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                                                 chip::AttributeId attributeId,
-                                                                 uint8_t* buffer)
+uint32_t DeviceOnOffPluginUnit::GetPersistentChangedMask()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters;
-  ChipLogProgress(DeviceLayer, "HandleWriteOnOffPluginUnitAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
+  return kChanged_OnOff;
+}
 
-  if ((attributeId == OnOff::Attributes::OnOff::Id) && (clusterId == OnOff::Id)) {
-    if (*buffer) {
-      this->SetOnOff(true);
-    } else {
-      this->SetOnOff(false);
-    }
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
+size_t DeviceOnOffPluginUnit::GetPersistentState(uint8_t* buffer, size_t size)
+{
+  PersistentState state = { static_cast<uint8_t>(this->is_on) };
+  if (size < sizeof(state)) {
+    return 0u;
   }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  memcpy(buffer, &state, sizeof(state));
+  return sizeof(state);
 }
 
-void DeviceOnOffPluginUnit::HandleDeviceOnOffPluginUnitStatusChanged(Changed_t itemChangedMask)
+bool DeviceOnOffPluginUnit::SetPersistentState(const uint8_t* buffer, size_t length)
 {
-  using namespace ::chip::app::Clusters;
-
-  if (itemChangedMask & kChanged_OnOff) {
-    ScheduleMatterReportingCallback(this->endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id);
+  PersistentState state;
+  if (length != sizeof(state)) {
+    return false;
   }
+  memcpy(&state, buffer, sizeof(state));
+  this->is_on = (state.is_on != 0u);
+  return true;
 }
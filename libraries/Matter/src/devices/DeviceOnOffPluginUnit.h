@@ -44,17 +44,16 @@ public:
   uint32_t GetOnoffClusterFeatureMap();
   uint16_t GetOnoffClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
-  EmberAfStatus HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                            chip::AttributeId attributeId,
-                                            uint8_t* buffer) override;
-
 private:
-  void HandleDeviceOnOffPluginUnitStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
+  uint32_t GetPersistentChangedMask() override;
+  size_t GetPersistentState(uint8_t* buffer, size_t size) override;
+  bool SetPersistentState(const uint8_t* buffer, size_t length) override;
+
+  struct PersistentState {
+    uint8_t is_on;
+  };
 
   bool is_on;
 
@@ -30,7 +30,7 @@ DevicePressureSensor::DevicePressureSensor(const char* device_name,
                                            int16_t min,
                                            int16_t max,
                                            int16_t measured_value) :
-  Device(device_name),
+  Device(device_name, kDeviceType_PressureSensor, DevicePressureSensor::GetAttributeTable()),
   min_value(min),
   max_value(max),
   measured_value(measured_value)
@@ -43,7 +43,7 @@ int16_t DevicePressureSensor::GetMeasuredValue()
   return this->measured_value;
 }
 
-void DevicePressureSensor::SetMeasuredValue(int16_t measurement)
+void DevicePressureSensor::SetMeasuredValue(int16_t measurement, bool force)
 {
   if (measurement < this->min_value) {
     measurement = this->min_value;
@@ -52,11 +52,11 @@ void DevicePressureSensor::SetMeasuredValue(int16_t measurement)
   }
 
   bool changed = this->measured_value != measurement;
-  ChipLogProgress(DeviceLayer, "PressureSensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
+  ChipLogAttributeAccess("PressureSensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
   this->measured_value = measurement;
 
-  if (changed) {
-    this->HandlePressureSensorDeviceStatusChanged(kChanged_MeasurementValue);
+  if (changed || force) {
+    this->HandleDeviceStatusChanged(kChanged_MeasurementValue);
   }
 }
 
@@ -70,53 +70,27 @@ uint16_t DevicePressureSensor::GetPressureSensorClusterRevision()
   return this->pressure_sensor_cluster_revision;
 }
 
-EmberAfStatus DevicePressureSensor::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                               chip::AttributeId attributeId,
-                                                               uint8_t* buffer,
-                                                               uint16_t maxReadLength)
+Device::AttributeTable DevicePressureSensor::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::PressureMeasurement::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadPressureMeasurementAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::PressureMeasurement::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == MeasuredValue::Id) && (maxReadLength == 2)) {
-    int16_t measuredValue = this->GetMeasuredValue();
-    memcpy(buffer, &measuredValue, sizeof(measuredValue));
-  } else if ((attributeId == MinMeasuredValue::Id) && (maxReadLength == 2)) {
-    int16_t minValue = this->min_value;
-    memcpy(buffer, &minValue, sizeof(minValue));
-  } else if ((attributeId == MaxMeasuredValue::Id) && (maxReadLength == 2)) {
-    int16_t maxValue = this->max_value;
-    memcpy(buffer, &maxValue, sizeof(maxValue));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetPressureSensorClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetPressureSensorClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  using namespace ::chip::app::Clusters::PressureMeasurement;
+
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DevicePressureSensor, Id, Attributes::MeasuredValue::Id, int16_t, dev->GetMeasuredValue()),
+    DEVICE_ATTRIBUTE_READ(DevicePressureSensor, Id, Attributes::MinMeasuredValue::Id, int16_t, dev->min_value),
+    DEVICE_ATTRIBUTE_READ(DevicePressureSensor, Id, Attributes::MaxMeasuredValue::Id, int16_t, dev->max_value),
+    DEVICE_ATTRIBUTE_READ(DevicePressureSensor, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetPressureSensorClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DevicePressureSensor, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetPressureSensorClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DevicePressureSensor::HandlePressureSensorDeviceStatusChanged(Changed_t itemChangedMask)
+void DevicePressureSensor::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & kChanged_MeasurementValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, PressureMeasurement::Id, PressureMeasurement::Attributes::MeasuredValue::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, PressureMeasurement::Id, PressureMeasurement::Attributes::MeasuredValue::Id);
   }
 }
@@ -29,7 +29,7 @@
 #include <app/clusters/switch-server/switch-server.h>
 
 DeviceSwitch::DeviceSwitch(const char* device_name) :
-  Device(device_name),
+  Device(device_name, kDeviceType_Switch, DeviceSwitch::GetAttributeTable()),
   number_of_positions(2),
   current_position(0),
   multi_press_max(2)
@@ -89,74 +89,19 @@ uint16_t DeviceSwitch::GetSwitchClusterRevision()
   return this->switch_cluster_revision;
 }
 
-EmberAfStatus DeviceSwitch::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                       chip::AttributeId attributeId,
-                                                       uint8_t* buffer,
-                                                       uint16_t maxReadLength)
+Device::AttributeTable DeviceSwitch::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::Switch::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadSwitchAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::Switch::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == CurrentPosition::Id) && (maxReadLength == 1)) {
-    uint8_t current_pos = this->GetCurrentPosition();
-    memcpy(buffer, &current_pos, sizeof(current_pos));
-  } else if ((attributeId == NumberOfPositions::Id) && (maxReadLength == 1)) {
-    uint8_t max_positions = this->GetNumberOfPositions();
-    memcpy(buffer, &max_positions, sizeof(max_positions));
-  } else if ((attributeId == MultiPressMax::Id) && (maxReadLength == 1)) {
-    uint8_t multipress_max = this->GetMultiPressMax();
-    memcpy(buffer, &multipress_max, sizeof(multipress_max));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetSwitchClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
-}
-
-EmberAfStatus DeviceSwitch::HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                                        chip::AttributeId attributeId,
-                                                        uint8_t* buffer)
-{
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::Switch::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleWriteSwitchAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId != chip::app::Clusters::Switch::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if (attributeId == CurrentPosition::Id) {
-    this->SetCurrentPosition(*buffer);
-  } else if (attributeId == NumberOfPositions::Id) {
-    this->SetNumberOfPositions(*buffer);
-  } else if (attributeId == MultiPressMax::Id) {
-    this->SetMultiPressMax(*buffer);
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  using namespace ::chip::app::Clusters::Switch;
+
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceSwitch, Id, Attributes::NumberOfPositions::Id, uint8_t, dev->GetNumberOfPositions(), dev->SetNumberOfPositions(value)),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceSwitch, Id, Attributes::CurrentPosition::Id, uint8_t, dev->GetCurrentPosition(), dev->SetCurrentPosition(value)),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceSwitch, Id, Attributes::MultiPressMax::Id, uint8_t, dev->GetMultiPressMax(), dev->SetMultiPressMax(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceSwitch, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceSwitch, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetSwitchClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
 void DeviceSwitch::HandleSwitchDeviceStatusChanged(Changed_t itemChangedMask)
@@ -164,10 +109,8 @@ void DeviceSwitch::HandleSwitchDeviceStatusChanged(Changed_t itemChangedMask)
   using namespace ::chip::app::Clusters;
   using namespace ::chip::DeviceLayer;
 
+  // Events are sent right away so that quick press/release pairs aren't coalesced like the attributes
   if (itemChangedMask & kChanged_CurrentPosition) {
-    ScheduleMatterReportingCallback(this->endpoint_id, Switch::Id, Switch::Attributes::CurrentPosition::Id);
-
-    // Send the corresponding event for press or release
     PlatformMgr().LockChipStack();
     if (this->current_position) {
       SwitchServer::Instance().OnInitialPress(this->endpoint_id, this->current_position);
@@ -176,10 +119,21 @@ void DeviceSwitch::HandleSwitchDeviceStatusChanged(Changed_t itemChangedMask)
     }
     PlatformMgr().UnlockChipStack();
   }
+  this->HandleDeviceStatusChanged(itemChangedMask);
+}
+
+void DeviceSwitch::ReportChangedAttributes(uint32_t itemChangedMask)
+{
+  using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
+
+  if (itemChangedMask & kChanged_CurrentPosition) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, Switch::Id, Switch::Attributes::CurrentPosition::Id);
+  }
   if (itemChangedMask & kChanged_NumberOfPositions) {
-    ScheduleMatterReportingCallback(this->endpoint_id, Switch::Id, Switch::Attributes::NumberOfPositions::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, Switch::Id, Switch::Attributes::NumberOfPositions::Id);
   }
   if (itemChangedMask & kChanged_MultiPressMax) {
-    ScheduleMatterReportingCallback(this->endpoint_id, Switch::Id, Switch::Attributes::MultiPressMax::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, Switch::Id, Switch::Attributes::MultiPressMax::Id);
   }
 }
@@ -48,17 +48,10 @@ public:
   uint32_t GetFeatureMap();
   uint16_t GetSwitchClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
-  EmberAfStatus HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                            chip::AttributeId attributeId,
-                                            uint8_t* buffer) override;
-
 private:
+  static AttributeTable GetAttributeTable();
   void HandleSwitchDeviceStatusChanged(Changed_t itemChangedMask);
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
 
   uint8_t number_of_positions;
   uint8_t current_position;
@@ -30,7 +30,7 @@ DeviceTempSensor::DeviceTempSensor(const char* device_name,
                                    int16_t min,
                                    int16_t max,
                                    int16_t measured_value) :
-  Device(device_name),
+  Device(device_name, kDeviceType_TempSensor, DeviceTempSensor::GetAttributeTable()),
   min_value(min),
   max_value(max),
   measured_value(measured_value)
@@ -43,7 +43,7 @@ int16_t DeviceTempSensor::GetMeasuredValue()
   return this->measured_value;
 }
 
-void DeviceTempSensor::SetMeasuredValue(int16_t measurement)
+void DeviceTempSensor::SetMeasuredValue(int16_t measurement, bool force)
 {
   if (measurement < this->min_value) {
     measurement = this->min_value;
@@ -52,11 +52,11 @@ void DeviceTempSensor::SetMeasuredValue(int16_t measurement)
   }
 
   bool changed = this->measured_value != measurement;
-  ChipLogProgress(DeviceLayer, "TempSensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
+  ChipLogAttributeAccess("TempSensorDevice[%s]: new measurement='%d'", this->device_name, measurement);
   this->measured_value = measurement;
 
-  if (changed) {
-    this->HandleTempSensorDeviceStatusChanged(kChanged_MeasurementValue);
+  if (changed || force) {
+    this->HandleDeviceStatusChanged(kChanged_MeasurementValue);
   }
 }
 
@@ -70,53 +70,27 @@ uint16_t DeviceTempSensor::GetTempSensorClusterRevision()
   return this->temp_sensor_cluster_revision;
 }
 
-EmberAfStatus DeviceTempSensor::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                           chip::AttributeId attributeId,
-                                                           uint8_t* buffer,
-                                                           uint16_t maxReadLength)
+Device::AttributeTable DeviceTempSensor::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::TemperatureMeasurement::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadTempSensorAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::TemperatureMeasurement::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == MeasuredValue::Id) && (maxReadLength == 2)) {
-    int16_t measuredValue = this->GetMeasuredValue();
-    memcpy(buffer, &measuredValue, sizeof(measuredValue));
-  } else if ((attributeId == MinMeasuredValue::Id) && (maxReadLength == 2)) {
-    int16_t minValue = this->min_value;
-    memcpy(buffer, &minValue, sizeof(minValue));
-  } else if ((attributeId == MaxMeasuredValue::Id) && (maxReadLength == 2)) {
-    int16_t maxValue = this->max_value;
-    memcpy(buffer, &maxValue, sizeof(maxValue));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetTempSensorClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetTempSensorClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  using namespace ::chip::app::Clusters::TemperatureMeasurement;
+
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DeviceTempSensor, Id, Attributes::MeasuredValue::Id, int16_t, dev->GetMeasuredValue()),
+    DEVICE_ATTRIBUTE_READ(DeviceTempSensor, Id, Attributes::MinMeasuredValue::Id, int16_t, dev->min_value),
+    DEVICE_ATTRIBUTE_READ(DeviceTempSensor, Id, Attributes::MaxMeasuredValue::Id, int16_t, dev->max_value),
+    DEVICE_ATTRIBUTE_READ(DeviceTempSensor, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetTempSensorClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceTempSensor, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetTempSensorClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DeviceTempSensor::HandleTempSensorDeviceStatusChanged(Changed_t itemChangedMask)
+void DeviceTempSensor::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & DeviceTempSensor::kChanged_MeasurementValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, TemperatureMeasurement::Id, TemperatureMeasurement::Attributes::MeasuredValue::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, TemperatureMeasurement::Id, TemperatureMeasurement::Attributes::MeasuredValue::Id);
   }
 }
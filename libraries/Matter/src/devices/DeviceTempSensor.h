@@ -38,20 +38,16 @@ public:
   DeviceTempSensor(const char* device_name, int16_t min, int16_t max, int16_t measured_value);
 
   int16_t GetMeasuredValue();
-  void SetMeasuredValue(int16_t measurement);
+  void SetMeasuredValue(int16_t measurement, bool force = false);
   uint32_t GetTempSensorClusterFeatureMap();
   uint16_t GetTempSensorClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
   const int16_t min_value;
   const int16_t max_value;
 
 private:
-  void HandleTempSensorDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
 
   int16_t measured_value;
 
@@ -29,7 +29,7 @@
 DeviceThermostat::DeviceThermostat(const char* device_name,
                                    int16_t local_temperature,
                                    int16_t heating_setpoint) :
-  Device(device_name),
+  Device(device_name, kDeviceType_Thermostat, DeviceThermostat::GetAttributeTable()),
   local_temperature(local_temperature),
   heating_setpoint(heating_setpoint),
   system_mode(0),
@@ -49,11 +49,11 @@ int16_t DeviceThermostat::GetLocalTemperatureValue()
 void DeviceThermostat::SetLocalTemperatureValue(int16_t local_temp)
 {
   bool changed = this->local_temperature != local_temp;
-  ChipLogProgress(DeviceLayer, "ThermostatDevice[%s]: new local temp='%d'", this->device_name, local_temp);
+  ChipLogAttributeAccess("ThermostatDevice[%s]: new local temp='%d'", this->device_name, local_temp);
   this->local_temperature = local_temp;
 
   if (changed) {
-    this->HandleThermostatDeviceStatusChanged(kChanged_LocalTemperatureValue);
+    this->HandleDeviceStatusChanged(kChanged_LocalTemperatureValue);
   }
 }
 
@@ -73,11 +73,11 @@ void DeviceThermostat::SetHeatingSetpointValue(int16_t heating_setpoint)
     heating_setpoint = this->abs_max_heating_setpoint;
   }
 
-  ChipLogProgress(DeviceLayer, "ThermostatDevice[%s]: new heating setpoint='%d'", this->device_name, heating_setpoint);
+  ChipLogAttributeAccess("ThermostatDevice[%s]: new heating setpoint='%d'", this->device_name, heating_setpoint);
   this->heating_setpoint = heating_setpoint;
 
   if (changed) {
-    this->HandleThermostatDeviceStatusChanged(kChanged_HeatingSetpointValue);
+    this->HandleDeviceStatusChanged(kChanged_HeatingSetpointValue);
   }
 }
 
@@ -89,11 +89,11 @@ uint8_t DeviceThermostat::GetSystemMode()
 void DeviceThermostat::SetSystemMode(uint8_t system_mode)
 {
   bool changed = this->system_mode != system_mode;
-  ChipLogProgress(DeviceLayer, "ThermostatDevice[%s]: new system mode='%u'", this->device_name, system_mode);
+  ChipLogAttributeAccess("ThermostatDevice[%s]: new system mode='%u'", this->device_name, system_mode);
   this->system_mode = system_mode;
 
   if (changed) {
-    this->HandleThermostatDeviceStatusChanged(kChanged_SystemModeValue);
+    this->HandleDeviceStatusChanged(kChanged_SystemModeValue);
   }
 }
 
@@ -164,101 +164,65 @@ int16_t DeviceThermostat::GetMaxHeatingSetpoint()
   return this->max_heating_setpoint;
 }
 
-EmberAfStatus DeviceThermostat::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                           chip::AttributeId attributeId,
-                                                           uint8_t* buffer,
-                                                           uint16_t maxReadLength)
+Device::AttributeTable DeviceThermostat::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::Thermostat::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadThermostatAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
+  using namespace ::chip::app::Clusters::Thermostat;
 
-  if (clusterId != chip::app::Clusters::Thermostat::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == LocalTemperature::Id) && (maxReadLength == 2)) {
-    int16_t localTemp = this->GetLocalTemperatureValue();
-    memcpy(buffer, &localTemp, sizeof(localTemp));
-  } else if ((attributeId == OccupiedHeatingSetpoint::Id) && (maxReadLength == 2)) {
-    int16_t heatingSetpoint = this->GetHeatingSetpointValue();
-    memcpy(buffer, &heatingSetpoint, sizeof(heatingSetpoint));
-  } else if ((attributeId == SystemMode::Id) && (maxReadLength == 1)) {
-    uint8_t systemMode = this->GetSystemMode();
-    memcpy(buffer, &systemMode, sizeof(systemMode));
-  } else if ((attributeId == ControlSequenceOfOperation::Id) && (maxReadLength == 1)) {
-    uint8_t seq_op = this->GetControlSequenceOfOperation();
-    memcpy(buffer, &seq_op, sizeof(seq_op));
-  } else if ((attributeId == AbsMinHeatSetpointLimit::Id) && (maxReadLength == 2)) {
-    int16_t abs_min_heat_setpoint = this->GetAbsMinHeatingSetpoint();
-    memcpy(buffer, &abs_min_heat_setpoint, sizeof(abs_min_heat_setpoint));
-  } else if ((attributeId == AbsMaxHeatSetpointLimit::Id) && (maxReadLength == 2)) {
-    int16_t abs_max_heat_setpoint = this->GetAbsMaxHeatingSetpoint();
-    memcpy(buffer, &abs_max_heat_setpoint, sizeof(abs_max_heat_setpoint));
-  } else if ((attributeId == MinHeatSetpointLimit::Id) && (maxReadLength == 2)) {
-    int16_t min_heat_setpoint = this->GetMinHeatingSetpoint();
-    memcpy(buffer, &min_heat_setpoint, sizeof(min_heat_setpoint));
-  } else if ((attributeId == MaxHeatSetpointLimit::Id) && (maxReadLength == 2)) {
-    int16_t max_heat_setpoint = this->GetMaxHeatingSetpoint();
-    memcpy(buffer, &max_heat_setpoint, sizeof(max_heat_setpoint));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetThermostatClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetThermostatClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::LocalTemperature::Id, int16_t, dev->GetLocalTemperatureValue()),
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::AbsMinHeatSetpointLimit::Id, int16_t, dev->GetAbsMinHeatingSetpoint()),
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::AbsMaxHeatSetpointLimit::Id, int16_t, dev->GetAbsMaxHeatingSetpoint()),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceThermostat, Id, Attributes::OccupiedHeatingSetpoint::Id, int16_t, dev->GetHeatingSetpointValue(), dev->SetHeatingSetpointValue(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::MinHeatSetpointLimit::Id, int16_t, dev->GetMinHeatingSetpoint()),
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::MaxHeatSetpointLimit::Id, int16_t, dev->GetMaxHeatingSetpoint()),
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::ControlSequenceOfOperation::Id, uint8_t, dev->GetControlSequenceOfOperation()),
+    DEVICE_ATTRIBUTE_READ_WRITE(DeviceThermostat, Id, Attributes::SystemMode::Id, uint8_t, dev->GetSystemMode(), dev->SetSystemMode(value)),
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetThermostatClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceThermostat, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetThermostatClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-EmberAfStatus DeviceThermostat::HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                                            chip::AttributeId attributeId,
-                                                            uint8_t* buffer)
+void DeviceThermostat::ReportChangedAttributes(uint32_t itemChangedMask)
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
   using namespace ::chip::app::Clusters;
-  using namespace ::chip::app::Clusters::Thermostat::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleWriteThermostatAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
+  Device::ReportChangedAttributes(itemChangedMask);
 
-  if (clusterId != chip::app::Clusters::Thermostat::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
+  if (itemChangedMask & kChanged_HeatingSetpointValue) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, Thermostat::Id, Thermostat::Attributes::OccupiedHeatingSetpoint::Id);
   }
-
-  if (attributeId == OccupiedHeatingSetpoint::Id) {
-    this->SetHeatingSetpointValue(*((int16_t*)buffer));
-  } else if (attributeId == SystemMode::Id) {
-    this->SetSystemMode(*buffer);
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
+  if (itemChangedMask & kChanged_LocalTemperatureValue) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, Thermostat::Id, Thermostat::Attributes::LocalTemperature::Id);
+  }
+  if (itemChangedMask & kChanged_SystemModeValue) {
+    MatterReportingAttributeChangeCallback(this->endpoint_id, Thermostat::Id, Thermostat::Attributes::SystemMode::Id);
   }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
 }
 
-void DeviceThermostat::HandleThermostatDeviceStatusChanged(Changed_t itemChangedMask)
+uint32_t DeviceThermostat::GetPersistentChangedMask()
 {
-  using namespace ::chip::app::Clusters;
+  return kChanged_HeatingSetpointValue | kChanged_SystemModeValue;
+}
 
-  if (itemChangedMask & kChanged_HeatingSetpointValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, Thermostat::Id, Thermostat::Attributes::OccupiedHeatingSetpoint::Id);
-  }
-  if (itemChangedMask & kChanged_LocalTemperatureValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, Thermostat::Id, Thermostat::Attributes::LocalTemperature::Id);
+size_t DeviceThermostat::GetPersistentState(uint8_t* buffer, size_t size)
+{
+  PersistentState state = { this->heating_setpoint, this->system_mode, 0u };
+  if (size < sizeof(state)) {
+    return 0u;
   }
-  if (itemChangedMask & kChanged_SystemModeValue) {
-    ScheduleMatterReportingCallback(this->endpoint_id, Thermostat::Id, Thermostat::Attributes::SystemMode::Id);
+  memcpy(buffer, &state, sizeof(state));
+  return sizeof(state);
+}
+
+bool DeviceThermostat::SetPersistentState(const uint8_t* buffer, size_t length)
+{
+  PersistentState state;
+  if (length != sizeof(state)) {
+    return false;
   }
+  memcpy(&state, buffer, sizeof(state));
+  this->heating_setpoint = state.heating_setpoint;
+  this->system_mode = state.system_mode;
+  return true;
 }
@@ -60,17 +60,18 @@ public:
   uint32_t GetThermostatClusterFeatureMap();
   uint16_t GetThermostatClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
-  EmberAfStatus HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                            chip::AttributeId attributeId,
-                                            uint8_t* buffer) override;
-
 private:
-  void HandleThermostatDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
+  uint32_t GetPersistentChangedMask() override;
+  size_t GetPersistentState(uint8_t* buffer, size_t size) override;
+  bool SetPersistentState(const uint8_t* buffer, size_t length) override;
+
+  struct PersistentState {
+    int16_t heating_setpoint;
+    uint8_t system_mode;
+    uint8_t reserved;
+  };
 
   int16_t local_temperature;
   int16_t heating_setpoint;
@@ -27,7 +27,7 @@
 #include "DeviceWindowCovering.h"
 
 DeviceWindowCovering::DeviceWindowCovering(const char* device_name) :
-  Device(device_name),
+  Device(device_name, kDeviceType_WindowCovering, DeviceWindowCovering::GetAttributeTable()),
   current_operational_status(kOperationalStatus_Stopped),
   requested_lift_pos(0u),
   actual_lift_pos(0u)
@@ -41,15 +41,15 @@ void DeviceWindowCovering::SetCurrentOperationalStatus(OperationalStatus_t opera
 
   switch (operational_status) {
     case kOperationalStatus_Opening:
-      ChipLogProgress(DeviceLayer, "WindowCoveringDevice[%s]: operational status='opening'", this->device_name);
+      ChipLogAttributeAccess("WindowCoveringDevice[%s]: operational status='opening'", this->device_name);
       opstate_map = 0x05u;
       break;
     case kOperationalStatus_Closing:
-      ChipLogProgress(DeviceLayer, "WindowCoveringDevice[%s]: operational status='closing'", this->device_name);
+      ChipLogAttributeAccess("WindowCoveringDevice[%s]: operational status='closing'", this->device_name);
       opstate_map = 0x0Au;
       break;
     case kOperationalStatus_Stopped:
-      ChipLogProgress(DeviceLayer, "WindowCoveringDevice[%s]: operational status='stopped'", this->device_name);
+      ChipLogAttributeAccess("WindowCoveringDevice[%s]: operational status='stopped'", this->device_name);
       opstate_map = 0x00u;
       break;
     default:
@@ -59,7 +59,7 @@ void DeviceWindowCovering::SetCurrentOperationalStatus(OperationalStatus_t opera
   }
 
   this->current_operational_status = opstate_map;
-  this->HandleWindowCoveringDeviceStatusChanged(kChanged_OperationalStatus);
+  this->HandleDeviceStatusChanged(kChanged_OperationalStatus);
 }
 
 void DeviceWindowCovering::SetRequestedLiftPosition(uint16_t lift_position)
@@ -67,9 +67,9 @@ void DeviceWindowCovering::SetRequestedLiftPosition(uint16_t lift_position)
   if (lift_position > this->max_lift_position) {
     lift_position = this->max_lift_position;
   }
-  ChipLogProgress(DeviceLayer, "WindowCoveringDevice[%s]: new requested position='%d'", this->device_name, lift_position);
+  ChipLogAttributeAccess("WindowCoveringDevice[%s]: new requested position='%d'", this->device_name, lift_position);
   this->requested_lift_pos = lift_position;
-  this->HandleWindowCoveringDeviceStatusChanged(kChanged_LiftPositionTargetPercent);
+  this->HandleDeviceStatusChanged(kChanged_LiftPositionTargetPercent);
 }
 
 uint16_t DeviceWindowCovering::GetRequestedLiftPosition()
@@ -82,9 +82,9 @@ void DeviceWindowCovering::SetActualLiftPosition(uint16_t lift_position)
   if (lift_position > this->max_lift_position) {
     lift_position = this->max_lift_position;
   }
-  ChipLogProgress(DeviceLayer, "WindowCoveringDevice[%s]: new actual position='%d'", this->device_name, lift_position);
+  ChipLogAttributeAccess("WindowCoveringDevice[%s]: new actual position='%d'", this->device_name, lift_position);
   this->actual_lift_pos = lift_position;
-  this->HandleWindowCoveringDeviceStatusChanged(kChanged_LiftPositionCurrentPercent);
+  this->HandleDeviceStatusChanged(kChanged_LiftPositionCurrentPercent);
 }
 
 uint16_t DeviceWindowCovering::GetActualLiftPosition()
@@ -102,74 +102,71 @@ uint16_t DeviceWindowCovering::GetWindowCoveringClusterRevision()
   return this->window_covering_cluster_revision;
 }
 
-EmberAfStatus DeviceWindowCovering::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                               chip::AttributeId attributeId,
-                                                               uint8_t* buffer,
-                                                               uint16_t maxReadLength)
+Device::AttributeTable DeviceWindowCovering::GetAttributeTable()
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  using namespace ::chip::app::Clusters::WindowCovering::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadWindowCoveringAttribute: clusterId=%lu attrId=%ld", clusterId, attributeId);
-
-  if (clusterId == chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return this->HandleReadBridgedDeviceBasicAttribute(clusterId, attributeId, buffer, maxReadLength);
-  }
-
-  if (clusterId != chip::app::Clusters::WindowCovering::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  if ((attributeId == Type::Id) && (maxReadLength == 1)) {
-    uint8_t type = 0u; // roller shade
-    memcpy(buffer, &type, sizeof(type));
-  } else if ((attributeId == CurrentPositionLiftPercent100ths::Id) && (maxReadLength == 2)) {
-    uint16_t currentPercent100s = this->actual_lift_pos;
-    memcpy(buffer, &currentPercent100s, sizeof(currentPercent100s));
-  } else if ((attributeId == TargetPositionLiftPercent100ths::Id) && (maxReadLength == 2)) {
-    uint16_t currentPercent100s = this->requested_lift_pos;
-    memcpy(buffer, &currentPercent100s, sizeof(currentPercent100s));
-  } else if ((attributeId == ConfigStatus::Id) && (maxReadLength == 1)) {
-    uint8_t configStatus = 1u; // operational
-    memcpy(buffer, &configStatus, sizeof(configStatus));
-  } else if ((attributeId == OperationalStatus::Id) && (maxReadLength == 1)) {
-    uint8_t opStatus = this->current_operational_status;
-    memcpy(buffer, &opStatus, sizeof(opStatus));
-  } else if ((attributeId == EndProductType::Id) && (maxReadLength == 1)) {
-    uint8_t endProductType = 0u; // roller shade
-    memcpy(buffer, &endProductType, sizeof(endProductType));
-  } else if ((attributeId == Mode::Id) && (maxReadLength == 1)) {
-    uint8_t mode = 0u; // no special mode
-    memcpy(buffer, &mode, sizeof(mode));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetWindowCoveringClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->GetWindowCoveringClusterRevision();
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
-  }
-
-  return EMBER_ZCL_STATUS_SUCCESS;
+  using namespace ::chip::app::Clusters::WindowCovering;
+
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::Type::Id, uint8_t, 0u), // roller shade
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::ConfigStatus::Id, uint8_t, 1u), // operational
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::OperationalStatus::Id, uint8_t, dev->current_operational_status),
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::TargetPositionLiftPercent100ths::Id, uint16_t, dev->requested_lift_pos),
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::EndProductType::Id, uint8_t, 0u), // roller shade
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::CurrentPositionLiftPercent100ths::Id, uint16_t, dev->actual_lift_pos),
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::Mode::Id, uint8_t, 0u), // no special mode
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::FeatureMap::Id, uint32_t, dev->GetWindowCoveringClusterFeatureMap()),
+    DEVICE_ATTRIBUTE_READ(DeviceWindowCovering, Id, Attributes::ClusterRevision::Id, uint16_t, dev->GetWindowCoveringClusterRevision()),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
 }
 
-void DeviceWindowCovering::HandleWindowCoveringDeviceStatusChanged(Changed_t itemChangedMask)
+void DeviceWindowCovering::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
+  Device::ReportChangedAttributes(itemChangedMask);
 
   if (itemChangedMask & DeviceWindowCovering::kChanged_LiftPosition) {
-    ScheduleMatterReportingCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::CurrentPositionLift::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::CurrentPositionLift::Id);
   }
   if (itemChangedMask & DeviceWindowCovering::kChanged_LiftPositionCurrentPercent) {
-    ScheduleMatterReportingCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::CurrentPositionLiftPercent100ths::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::CurrentPositionLiftPercent100ths::Id);
   }
   if (itemChangedMask & DeviceWindowCovering::kChanged_LiftPositionTargetPercent) {
-    ScheduleMatterReportingCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::TargetPositionLiftPercent100ths::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::TargetPositionLiftPercent100ths::Id);
   }
   if (itemChangedMask & DeviceWindowCovering::kChanged_OperationalStatus) {
-    ScheduleMatterReportingCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::OperationalStatus::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, WindowCovering::Id, WindowCovering::Attributes::OperationalStatus::Id);
+  }
+}
+
+uint32_t DeviceWindowCovering::GetPersistentChangedMask()
+{
+  return kChanged_LiftPositionCurrentPercent;
+}
+
+size_t DeviceWindowCovering::GetPersistentState(uint8_t* buffer, size_t size)
+{
+  PersistentState state = { this->actual_lift_pos };
+  if (size < sizeof(state)) {
+    return 0u;
+  }
+  memcpy(buffer, &state, sizeof(state));
+  return sizeof(state);
+}
+
+bool DeviceWindowCovering::SetPersistentState(const uint8_t* buffer, size_t length)
+{
+  PersistentState state;
+  if (length != sizeof(state)) {
+    return false;
+  }
+  memcpy(&state, buffer, sizeof(state));
+  // The covering doesn't move after a reboot - it's targeted to where it stopped
+  if (state.lift_position > max_lift_position) {
+    return false;
   }
+  this->actual_lift_pos = state.lift_position;
+  this->requested_lift_pos = state.lift_position;
+  return true;
 }
@@ -57,15 +57,18 @@ public:
   uint32_t GetWindowCoveringClusterFeatureMap();
   uint16_t GetWindowCoveringClusterRevision();
 
-  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                           chip::AttributeId attributeId,
-                                           uint8_t* buffer,
-                                           uint16_t maxReadLength) override;
-
   static const uint16_t max_lift_position = 10000u;
 
 private:
-  void HandleWindowCoveringDeviceStatusChanged(Changed_t itemChangedMask);
+  static AttributeTable GetAttributeTable();
+  void ReportChangedAttributes(uint32_t itemChangedMask) override;
+  uint32_t GetPersistentChangedMask() override;
+  size_t GetPersistentState(uint8_t* buffer, size_t size) override;
+  bool SetPersistentState(const uint8_t* buffer, size_t length) override;
+
+  struct PersistentState {
+    uint16_t lift_position;
+  };
 
   uint8_t current_operational_status;
   uint16_t requested_lift_pos;
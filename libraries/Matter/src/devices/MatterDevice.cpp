@@ -24,22 +24,49 @@
 #include <cstdio>
 #include <platform/CHIPDeviceLayer.h>
 #include <app-common/zap-generated/callback.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "nvm3_default.h"
 
 using namespace chip::app::Clusters::Actions;
 
-Device::Device(const char* device_name) :
+Device::Device(const char* device_name, DeviceType_t device_type, AttributeTable attribute_table) :
   reachable(false),
   online(false),
   identify_in_progress(false),
   identify_time(0),
   identify_type(0),
-  location(""),
-  endpoint_id(0)
+  endpoint_id(0),
+  device_type(device_type),
+  attribute_table(attribute_table),
+  changed_attributes(0u),
+  changed_queued(false),
+  next_changed_device(nullptr),
+  persistence_key(0u),
+  persistence_queued(false),
+  next_persistence_device(nullptr)
 {
   chip::Platform::CopyString(this->device_name, device_name);
   chip::Platform::CopyString(this->vendor_name, "Silicon Labs");
   chip::Platform::CopyString(this->product_name, "Matter device");
   chip::Platform::CopyString(this->serial_number, "0000000042");
+  chip::Platform::CopyString(this->location, "");
+}
+
+Device::~Device()
+{
+  // Drop pending changes so the flush doesn't touch a destroyed device
+  // A flush already in progress is excluded by DestroyDevice() holding the CHIP stack lock
+  taskENTER_CRITICAL();
+  for (Device** dev = &changed_devices_head; *dev; dev = &(*dev)->next_changed_device) {
+    if (*dev == this) {
+      *dev = this->next_changed_device;
+      break;
+    }
+  }
+  taskEXIT_CRITICAL();
+  // The state can't be saved from here as the overrides of the derived classes are already gone
+  this->UnlinkPersistentState();
 }
 
 bool Device::IsReachable()
@@ -63,9 +90,9 @@ void Device::SetReachable(bool reachable)
   if (changed) {
     this->reachable = reachable;
     if (reachable) {
-      ChipLogProgress(DeviceLayer, "Device[%s]: ONLINE", this->device_name);
+      ChipLogAttributeAccess("Device[%s]: ONLINE", this->device_name);
     } else {
-      ChipLogProgress(DeviceLayer, "Device[%s]: OFFLINE", this->device_name);
+      ChipLogAttributeAccess("Device[%s]: OFFLINE", this->device_name);
     }
     this->HandleDeviceStatusChanged(kChanged_Reachable);
   }
@@ -75,7 +102,7 @@ void Device::SetName(const char* name)
 {
   bool changed = (strncmp(this->device_name, name, sizeof(this->device_name)) != 0);
   if (changed) {
-    ChipLogProgress(DeviceLayer, "Device[%s]: New DeviceName=\"%s\"", this->device_name, name);
+    ChipLogAttributeAccess("Device[%s]: New DeviceName=\"%s\"", this->device_name, name);
     chip::Platform::CopyString(this->device_name, name);
     this->HandleDeviceStatusChanged(kChanged_Name);
   }
@@ -85,7 +112,7 @@ void Device::SetVendorName(const char* vendorname)
 {
   bool changed = (strncmp(this->vendor_name, vendorname, sizeof(this->vendor_name)) != 0);
   if (changed) {
-    ChipLogProgress(DeviceLayer, "Device[%s]: New VendorName=\"%s\"", this->device_name, vendorname);
+    ChipLogAttributeAccess("Device[%s]: New VendorName=\"%s\"", this->device_name, vendorname);
     chip::Platform::CopyString(this->vendor_name, vendorname);
     this->HandleDeviceStatusChanged(kChanged_VendorName);
   }
@@ -95,7 +122,7 @@ void Device::SetProductName(const char* productname)
 {
   bool changed = (strncmp(this->product_name, productname, sizeof(this->product_name)) != 0);
   if (changed) {
-    ChipLogProgress(DeviceLayer, "Device[%s]: New ProductName=\"%s\"", this->device_name, productname);
+    ChipLogAttributeAccess("Device[%s]: New ProductName=\"%s\"", this->device_name, productname);
     chip::Platform::CopyString(this->product_name, productname);
     this->HandleDeviceStatusChanged(kChanged_ProductName);
   }
@@ -105,18 +132,18 @@ void Device::SetSerialNumber(const char* serialnumber)
 {
   bool changed = (strncmp(this->serial_number, serialnumber, sizeof(this->serial_number)) != 0);
   if (changed) {
-    ChipLogProgress(DeviceLayer, "Device[%s]: New SerialNumber=\"%s\"", this->device_name, serialnumber);
+    ChipLogAttributeAccess("Device[%s]: New SerialNumber=\"%s\"", this->device_name, serialnumber);
     chip::Platform::CopyString(this->serial_number, serialnumber);
     this->HandleDeviceStatusChanged(kChanged_SerialNumber);
   }
 }
 
-void Device::SetLocation(std::string location)
+void Device::SetLocation(const char* location)
 {
-  bool changed = (this->location.compare(location) != 0);
+  bool changed = (strncmp(this->location, location, sizeof(this->location)) != 0);
   if (changed) {
-    this->location = location;
-    ChipLogProgress(DeviceLayer, "Device[%s]: New location=\"%s\"", this->device_name, this->location.c_str());
+    chip::Platform::CopyString(this->location, location);
+    ChipLogAttributeAccess("Device[%s]: New location=\"%s\"", this->device_name, this->location);
     this->HandleDeviceStatusChanged(kChanged_Location);
   }
 }
@@ -131,136 +158,341 @@ uint16_t Device::GetBridgedDeviceBasicInformationClusterRevision()
   return this->bridged_device_basic_information_cluster_revision;
 }
 
+EmberAfStatus Device::HandleReadEmberAfAttribute(ClusterId clusterId,
+                                                 chip::AttributeId attributeId,
+                                                 uint8_t* buffer,
+                                                 uint16_t maxReadLength)
+{
+  ChipLogAttributeAccess("Device[%s]: read clusterId=%lu attrId=%lu", this->device_name, (unsigned long)clusterId, (unsigned long)attributeId);
+  const AttributeDescriptor* attribute = this->FindAttribute(clusterId, attributeId);
+  if (attribute == nullptr || attribute->read == nullptr || maxReadLength < attribute->size) {
+    return EMBER_ZCL_STATUS_FAILURE;
+  }
+  attribute->read(this, buffer);
+  return EMBER_ZCL_STATUS_SUCCESS;
+}
+
 EmberAfStatus Device::HandleWriteEmberAfAttribute(ClusterId clusterId,
                                                   chip::AttributeId attributeId,
                                                   uint8_t* buffer)
 {
-  return EMBER_ZCL_STATUS_FAILURE;
+  ChipLogAttributeAccess("Device[%s]: write clusterId=%lu attrId=%lu", this->device_name, (unsigned long)clusterId, (unsigned long)attributeId);
+  const AttributeDescriptor* attribute = this->FindAttribute(clusterId, attributeId);
+  if (attribute == nullptr || attribute->write == nullptr) {
+    return EMBER_ZCL_STATUS_FAILURE;
+  }
+  attribute->write(this, buffer);
+  return EMBER_ZCL_STATUS_SUCCESS;
 }
 
-EmberAfStatus Device::HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                 chip::AttributeId attributeId,
-                                                 uint8_t* buffer,
-                                                 uint16_t maxReadLength)
+const Device::AttributeDescriptor* Device::FindAttribute(ClusterId clusterId, chip::AttributeId attributeId)
 {
-  return EMBER_ZCL_STATUS_FAILURE;
+  // The common attributes are served even if the device isn't reachable - that's how controllers read Reachable=false
+  const AttributeDescriptor* attribute = SearchAttributeTable(GetCommonAttributeTable(), clusterId, attributeId);
+  if (attribute == nullptr && this->reachable) {
+    attribute = SearchAttributeTable(this->attribute_table, clusterId, attributeId);
+  }
+  return attribute;
 }
 
-EmberAfStatus Device::HandleReadBridgedDeviceBasicAttribute(ClusterId clusterId,
-                                                            chip::AttributeId attributeId,
-                                                            uint8_t * buffer,
-                                                            uint16_t maxReadLength)
+const Device::AttributeDescriptor* Device::SearchAttributeTable(AttributeTable table, ClusterId clusterId, chip::AttributeId attributeId)
 {
-  if (!this->reachable) {
-    return EMBER_ZCL_STATUS_FAILURE;
+  size_t low = 0u;
+  size_t high = table.count;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2u;
+    const AttributeDescriptor* entry = &table.entries[mid];
+    if (entry->cluster_id == clusterId && entry->attribute_id == attributeId) {
+      return entry;
+    }
+    if (entry->cluster_id < clusterId || (entry->cluster_id == clusterId && entry->attribute_id < attributeId)) {
+      low = mid + 1u;
+    } else {
+      high = mid;
+    }
   }
+  return nullptr;
+}
 
-  using namespace ::chip::app::Clusters::BridgedDeviceBasicInformation::Attributes;
-  ChipLogProgress(DeviceLayer, "HandleReadBridgedDeviceBasicAttribute: clusterId='%lu' attrId=%ld, maxReadLength=%d", clusterId, attributeId, maxReadLength);
+Device::AttributeTable Device::GetCommonAttributeTable()
+{
+  using namespace ::chip::app::Clusters;
 
-  if (clusterId != chip::app::Clusters::BridgedDeviceBasicInformation::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
+  // Bridged Device Basic Information and Identify - served for every device
+  static constexpr AttributeDescriptor table[] = {
+    DEVICE_ATTRIBUTE_READ_WRITE(Device, Identify::Id, Identify::Attributes::IdentifyTime::Id, uint16_t,
+                                dev->identify_time,
+                                dev->identify_time = value;
+                                MatterIdentifyClusterServerAttributeChangedCallback(app::ConcreteAttributePath(dev->endpoint_id, Identify::Id, Identify::Attributes::IdentifyTime::Id))),
+    DEVICE_ATTRIBUTE_READ_WRITE(Device, Identify::Id, Identify::Attributes::IdentifyType::Id, uint8_t,
+                                dev->identify_type,
+                                dev->identify_type = value;
+                                MatterIdentifyClusterServerAttributeChangedCallback(app::ConcreteAttributePath(dev->endpoint_id, Identify::Id, Identify::Attributes::IdentifyType::Id))),
+    DEVICE_ATTRIBUTE_READ(Device, Identify::Id, Identify::Attributes::FeatureMap::Id, uint32_t, identify_cluster_feature_map),
+    DEVICE_ATTRIBUTE_READ(Device, Identify::Id, Identify::Attributes::ClusterRevision::Id, uint16_t, identify_cluster_revision),
+    { BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::VendorName::Id, DeviceDescStrSize,
+      [](Device* dev, uint8_t* buffer) {
+        MutableByteSpan zclNameSpan(buffer, DeviceDescStrSize);
+        MakeZclCharString(zclNameSpan, dev->GetVendorName());
+      }, nullptr },
+    { BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::ProductName::Id, DeviceDescStrSize,
+      [](Device* dev, uint8_t* buffer) {
+        MutableByteSpan zclNameSpan(buffer, DeviceDescStrSize);
+        MakeZclCharString(zclNameSpan, dev->GetProductName());
+      }, nullptr },
+    { BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::NodeLabel::Id, DeviceDescStrSize,
+      [](Device* dev, uint8_t* buffer) {
+        MutableByteSpan zclNameSpan(buffer, DeviceDescStrSize);
+        MakeZclCharString(zclNameSpan, dev->GetName());
+      }, nullptr },
+    { BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::SerialNumber::Id, DeviceDescStrSize,
+      [](Device* dev, uint8_t* buffer) {
+        MutableByteSpan zclNameSpan(buffer, DeviceDescStrSize);
+        MakeZclCharString(zclNameSpan, dev->GetSerialNumber());
+      }, nullptr },
+    DEVICE_ATTRIBUTE_READ(Device, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::Reachable::Id, bool, dev->IsReachable()),
+    DEVICE_ATTRIBUTE_READ(Device, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::FeatureMap::Id, uint32_t, bridged_device_basic_information_cluster_feature_map),
+    DEVICE_ATTRIBUTE_READ(Device, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::ClusterRevision::Id, uint16_t, bridged_device_basic_information_cluster_revision),
+  };
+  static_assert(IsSortedAttributeTable(table, ArraySize(table)), "The attribute table must be sorted by cluster and attribute ID");
+  return { table, ArraySize(table) };
+}
+
+Device* Device::changed_devices_head = nullptr;
+bool Device::changed_flush_scheduled = false;
+
+void Device::HandleDeviceStatusChanged(uint32_t itemChangedMask)
+{
+  // Setters only mark bits here - a single work item reports every changed device, so no heap is used for reporting
+  bool schedule_flush = false;
+  taskENTER_CRITICAL();
+  this->changed_attributes |= itemChangedMask;
+  if (!this->changed_queued) {
+    this->changed_queued = true;
+    this->next_changed_device = changed_devices_head;
+    changed_devices_head = this;
+  }
+  if (!changed_flush_scheduled) {
+    changed_flush_scheduled = true;
+    schedule_flush = true;
   }
+  taskEXIT_CRITICAL();
 
-  if ((attributeId == Reachable::Id) && (maxReadLength == 1)) {
-    *buffer = this->IsReachable() ? 1 : 0;
-  } else if ((attributeId == NodeLabel::Id) && (maxReadLength == 32)) {
-    MutableByteSpan zclNameSpan(buffer, maxReadLength);
-    MakeZclCharString(zclNameSpan, this->GetName());
-  } else if ((attributeId == VendorName::Id) && (maxReadLength == 32)) {
-    MutableByteSpan zclNameSpan(buffer, maxReadLength);
-    MakeZclCharString(zclNameSpan, this->GetVendorName());
-  } else if ((attributeId == ProductName::Id) && (maxReadLength == 32)) {
-    MutableByteSpan zclNameSpan(buffer, maxReadLength);
-    MakeZclCharString(zclNameSpan, this->GetProductName());
-  } else if ((attributeId == SerialNumber::Id) && (maxReadLength == 32)) {
-    MutableByteSpan zclNameSpan(buffer, maxReadLength);
-    MakeZclCharString(zclNameSpan, this->GetSerialNumber());
-  } else if ((attributeId == ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t rev = this->GetBridgedDeviceBasicInformationClusterRevision();
-    memcpy(buffer, &rev, sizeof(rev));
-  } else if ((attributeId == FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->GetBridgedDeviceBasicInformationClusterFeatureMap();
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
+  // The flush may run before ScheduleWork() returns, so the flag is set beforehand
+  if (schedule_flush && chip::DeviceLayer::PlatformMgr().ScheduleWork(Device::FlushChangedAttributes) != CHIP_NO_ERROR) {
+    taskENTER_CRITICAL();
+    changed_flush_scheduled = false;
+    taskEXIT_CRITICAL();
   }
+}
 
-  return EMBER_ZCL_STATUS_SUCCESS;
+void Device::FlushChangedAttributes(intptr_t context)
+{
+  (void)context;
+  while (true) {
+    taskENTER_CRITICAL();
+    Device* dev = changed_devices_head;
+    if (!dev) {
+      // Changes made from now on schedule a new flush
+      changed_flush_scheduled = false;
+      taskEXIT_CRITICAL();
+      return;
+    }
+    changed_devices_head = dev->next_changed_device;
+    dev->next_changed_device = nullptr;
+    dev->changed_queued = false;
+    uint32_t changed = dev->changed_attributes;
+    dev->changed_attributes = 0u;
+    taskEXIT_CRITICAL();
+
+    dev->ReportChangedAttributes(changed);
+    if (dev->persistence_key != 0u && (changed & dev->GetPersistentChangedMask())) {
+      dev->SchedulePersistentStateSave();
+    }
+  }
 }
 
-void Device::HandleDeviceStatusChanged(Changed_t itemChangedMask)
+void Device::ReportChangedAttributes(uint32_t itemChangedMask)
 {
   using namespace ::chip::app::Clusters;
 
   if (itemChangedMask & kChanged_Reachable) {
-    ScheduleMatterReportingCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::Reachable::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::Reachable::Id);
   }
   if (itemChangedMask & kChanged_Name) {
-    ScheduleMatterReportingCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::NodeLabel::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::NodeLabel::Id);
   }
   if (itemChangedMask & kChanged_VendorName) {
-    ScheduleMatterReportingCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::VendorName::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::VendorName::Id);
   }
   if (itemChangedMask & kChanged_ProductName) {
-    ScheduleMatterReportingCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::ProductName::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::ProductName::Id);
   }
   if (itemChangedMask & kChanged_SerialNumber) {
-    ScheduleMatterReportingCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::SerialNumber::Id);
+    MatterReportingAttributeChangeCallback(this->endpoint_id, BridgedDeviceBasicInformation::Id, BridgedDeviceBasicInformation::Attributes::SerialNumber::Id);
   }
 }
 
-EmberAfStatus Device::HandleReadIdentifyAttribute(ClusterId clusterId,
-                                                  chip::AttributeId attributeId,
-                                                  uint8_t* buffer,
-                                                  uint16_t maxReadLength)
+// Opens the default NVM3 instance - the Matter stack opens it as well, opening it again with the same parameters does nothing
+static bool OpenPersistentStorage()
 {
-  using namespace chip::app::Clusters;
+  static bool opened = false;
+  if (!opened) {
+    opened = (nvm3_initDefault() == ECODE_NVM3_OK);
+  }
+  return opened;
+}
 
-  if (clusterId != Identify::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
+Device* Device::persistence_devices_head = nullptr;
+bool Device::persistence_timer_scheduled = false;
+uint32_t Device::persistence_write_delay_ms = MATTER_PERSISTENCE_WRITE_DELAY_MS;
+
+bool Device::EnablePersistence(uint16_t key)
+{
+  // Only devices with a persistent state can be persisted - key 0 is reserved for 'not persisted'
+  if (key == 0u || this->GetPersistentChangedMask() == 0u || !OpenPersistentStorage()) {
+    return false;
+  }
+  this->persistence_key = key;
+
+  // The stored state starts with the device type so that the state of a different device type is never applied
+  uint8_t state[MATTER_PERSISTENT_STATE_MAX_SIZE + 1u];
+  uint32_t object_type;
+  size_t length;
+  if (nvm3_getObjectInfo(nvm3_defaultHandle, key, &object_type, &length) != ECODE_NVM3_OK
+      || object_type != NVM3_OBJECTTYPE_DATA || length < 2u || length > sizeof(state)) {
+    return false;
   }
+  if (nvm3_readData(nvm3_defaultHandle, key, state, length) != ECODE_NVM3_OK || state[0] != static_cast<uint8_t>(this->device_type)) {
+    return false;
+  }
+  return this->SetPersistentState(&state[1], length - 1u);
+}
 
-  if ((attributeId == Identify::Attributes::IdentifyTime::Id) && (maxReadLength == 2)) {
-    *buffer = this->identify_time;
-  } else if ((attributeId == Identify::Attributes::IdentifyType::Id) && (maxReadLength == 1)) {
-    *buffer = this->identify_type;
-  } else if ((attributeId == Identify::Attributes::FeatureMap::Id) && (maxReadLength == 4)) {
-    uint32_t featureMap = this->identify_cluster_feature_map;
-    memcpy(buffer, &featureMap, sizeof(featureMap));
-  } else if ((attributeId == Identify::Attributes::ClusterRevision::Id) && (maxReadLength == 2)) {
-    uint16_t clusterRevision = this->identify_cluster_revision;
-    memcpy(buffer, &clusterRevision, sizeof(clusterRevision));
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
+void Device::FlushPersistentState()
+{
+  this->UnlinkPersistentState();
+  (void)this->SavePersistentState();
+}
+
+void Device::FlushAllPersistentStates()
+{
+  while (true) {
+    taskENTER_CRITICAL();
+    Device* dev = persistence_devices_head;
+    if (!dev) {
+      taskEXIT_CRITICAL();
+      return;
+    }
+    persistence_devices_head = dev->next_persistence_device;
+    dev->next_persistence_device = nullptr;
+    dev->persistence_queued = false;
+    taskEXIT_CRITICAL();
+
+    (void)dev->SavePersistentState();
   }
+}
 
-  return EMBER_ZCL_STATUS_SUCCESS;
+void Device::SetPersistenceWriteDelay(uint32_t delay_ms)
+{
+  persistence_write_delay_ms = delay_ms;
 }
 
-EmberAfStatus Device::HandleWriteIdentifyAttribute(ClusterId clusterId,
-                                                   chip::AttributeId attributeId,
-                                                   uint8_t* buffer)
+void Device::SchedulePersistentStateSave()
 {
-  using namespace chip::app::Clusters;
+  // Called on the Matter thread - the timer is only started by the first change, so a burst of changes results in one write
+  bool start_timer = false;
+  taskENTER_CRITICAL();
+  if (!this->persistence_queued) {
+    this->persistence_queued = true;
+    this->next_persistence_device = persistence_devices_head;
+    persistence_devices_head = this;
+  }
+  if (!persistence_timer_scheduled) {
+    persistence_timer_scheduled = true;
+    start_timer = true;
+  }
+  taskEXIT_CRITICAL();
+
+  if (start_timer
+      && chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(persistence_write_delay_ms),
+                                                     Device::PersistenceTimerHandler,
+                                                     nullptr) != CHIP_NO_ERROR) {
+    // Write right away if the timer can't be started
+    Device::PersistenceTimerHandler(nullptr, nullptr);
+  }
+}
 
-  if (clusterId != Identify::Id) {
-    return EMBER_ZCL_STATUS_FAILURE;
+void Device::PersistenceTimerHandler(chip::System::Layer* layer, void* context)
+{
+  (void)layer;
+  (void)context;
+  taskENTER_CRITICAL();
+  persistence_timer_scheduled = false;
+  taskEXIT_CRITICAL();
+  FlushAllPersistentStates();
+}
+
+bool Device::SavePersistentState()
+{
+  if (this->persistence_key == 0u) {
+    return false;
   }
 
-  if (attributeId == Identify::Attributes::IdentifyTime::Id && clusterId == Identify::Id) {
-    this->identify_time = *buffer;
-    app::ConcreteAttributePath attributePath(this->endpoint_id, Identify::Id, Identify::Attributes::IdentifyTime::Id);
-    MatterIdentifyClusterServerAttributeChangedCallback(attributePath);
-  } else if (attributeId == Identify::Attributes::IdentifyType::Id && clusterId == Identify::Id) {
-    this->identify_type = *buffer;
-    app::ConcreteAttributePath attributePath(this->endpoint_id, Identify::Id, Identify::Attributes::IdentifyType::Id);
-    MatterIdentifyClusterServerAttributeChangedCallback(attributePath);
-  } else {
-    return EMBER_ZCL_STATUS_FAILURE;
+  uint8_t state[MATTER_PERSISTENT_STATE_MAX_SIZE + 1u];
+  state[0] = static_cast<uint8_t>(this->device_type);
+  size_t length = this->GetPersistentState(&state[1], MATTER_PERSISTENT_STATE_MAX_SIZE);
+  if (length == 0u) {
+    return false;
   }
+  length += 1u;
+
+  // Changes which end up where they started (e.g. a slider moved back and forth) don't wear the flash
+  uint8_t stored_state[sizeof(state)];
+  uint32_t object_type;
+  size_t stored_length;
+  if (nvm3_getObjectInfo(nvm3_defaultHandle, this->persistence_key, &object_type, &stored_length) == ECODE_NVM3_OK
+      && object_type == NVM3_OBJECTTYPE_DATA && stored_length == length
+      && nvm3_readData(nvm3_defaultHandle, this->persistence_key, stored_state, length) == ECODE_NVM3_OK
+      && memcmp(stored_state, state, length) == 0) {
+    return true;
+  }
+  return nvm3_writeData(nvm3_defaultHandle, this->persistence_key, state, length) == ECODE_NVM3_OK;
+}
 
-  return EMBER_ZCL_STATUS_SUCCESS;
+void Device::UnlinkPersistentState()
+{
+  taskENTER_CRITICAL();
+  if (this->persistence_queued) {
+    for (Device** dev = &persistence_devices_head; *dev; dev = &(*dev)->next_persistence_device) {
+      if (*dev == this) {
+        *dev = this->next_persistence_device;
+        break;
+      }
+    }
+    this->next_persistence_device = nullptr;
+    this->persistence_queued = false;
+  }
+  taskEXIT_CRITICAL();
+}
+
+uint32_t Device::GetPersistentChangedMask()
+{
+  return 0u;
+}
+
+size_t Device::GetPersistentState(uint8_t* buffer, size_t size)
+{
+  (void)buffer;
+  (void)size;
+  return 0u;
+}
+
+bool Device::SetPersistentState(const uint8_t* buffer, size_t length)
+{
+  (void)buffer;
+  (void)length;
+  return false;
 }
 
 void Device::HandleIdentifyStart()
@@ -21,18 +21,59 @@
 #pragma once
 
 #include <app/util/attribute-storage.h>
+#include <app/reporting/reporting.h>
 #include <lib/support/ZclString.h>
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <functional>
 #include <vector>
 
 using namespace ::chip;
 
-extern void CallMatterReportingCallback(intptr_t closure);
-extern void ScheduleMatterReportingCallback(EndpointId endpointId, ClusterId cluster, AttributeId attribute);
+// Logging of every attribute access is compiled out unless MATTER_LOG_ATTRIBUTE_ACCESS is defined
+#ifdef MATTER_LOG_ATTRIBUTE_ACCESS
+#define ChipLogAttributeAccess(...) ChipLogProgress(DeviceLayer, __VA_ARGS__)
+#else
+#define ChipLogAttributeAccess(...) ((void)0)
+#endif
+
+// Delay between the first change of a persistent attribute and writing the device state to NVM3
+#ifndef MATTER_PERSISTENCE_WRITE_DELAY_MS
+#define MATTER_PERSISTENCE_WRITE_DELAY_MS 5000u
+#endif
+
+// Maximum size of the persistent state of a device
+#define MATTER_PERSISTENT_STATE_MAX_SIZE 16u
+
+// Attribute table entries - the expressions can refer to the device as 'dev' with the type of 'DeviceClass'
+#define DEVICE_ATTRIBUTE_READ(DeviceClass, cluster, attribute, value_type, read_expr) \
+  { cluster, attribute, sizeof(value_type),                                           \
+    [](Device* device, uint8_t* buffer) {                                             \
+      DeviceClass* dev = static_cast<DeviceClass*>(device);                           \
+      (void)dev;                                                                      \
+      value_type value = (read_expr);                                                 \
+      memcpy(buffer, &value, sizeof(value));                                          \
+    },                                                                                \
+    nullptr }
+
+// Same as DEVICE_ATTRIBUTE_READ - 'write_stmt' gets the written value as 'value'
+#define DEVICE_ATTRIBUTE_READ_WRITE(DeviceClass, cluster, attribute, value_type, read_expr, write_stmt) \
+  { cluster, attribute, sizeof(value_type),                                                             \
+    [](Device* device, uint8_t* buffer) {                                                               \
+      DeviceClass* dev = static_cast<DeviceClass*>(device);                                             \
+      (void)dev;                                                                                        \
+      value_type value = (read_expr);                                                                   \
+      memcpy(buffer, &value, sizeof(value));                                                            \
+    },                                                                                                  \
+    [](Device* device, const uint8_t* buffer) {                                                         \
+      DeviceClass* dev = static_cast<DeviceClass*>(device);                                             \
+      value_type value;                                                                                 \
+      memcpy(&value, buffer, sizeof(value));                                                            \
+      write_stmt;                                                                                       \
+    } }
 
 class Device
 {
@@ -49,12 +90,45 @@ public:
     kChanged_Last         = kChanged_SerialNumber,
   } Changed;
 
-  Device(const char* device_name);
-
-  virtual ~Device()
-  {
-    ;
-  }
+  // Identifies the device class without RTTI
+  enum DeviceType_t{
+    kDeviceType_Generic,
+    kDeviceType_AirQualitySensor,
+    kDeviceType_ContactSensor,
+    kDeviceType_Fan,
+    kDeviceType_FlowSensor,
+    kDeviceType_HumiditySensor,
+    kDeviceType_IlluminanceSensor,
+    kDeviceType_Lightbulb,
+    kDeviceType_OccupancySensor,
+    kDeviceType_OnOffPluginUnit,
+    kDeviceType_PressureSensor,
+    kDeviceType_Switch,
+    kDeviceType_TempSensor,
+    kDeviceType_Thermostat,
+    kDeviceType_WindowCovering,
+  };
+
+  // Describes how an attribute is read and written - 'write' is nullptr for read-only attributes
+  struct AttributeDescriptor {
+    chip::ClusterId cluster_id;
+    chip::AttributeId attribute_id;
+    uint16_t size;
+    void (*read)(Device* dev, uint8_t* buffer);
+    void (*write)(Device* dev, const uint8_t* buffer);
+  };
+
+  // Attribute tables are sorted by cluster ID and then attribute ID for binary search
+  struct AttributeTable {
+    const AttributeDescriptor* entries;
+    size_t count;
+  };
+
+  Device(const char* device_name,
+         DeviceType_t device_type = kDeviceType_Generic,
+         AttributeTable attribute_table = { nullptr, 0u });
+
+  virtual ~Device();
 
   bool IsReachable();
   bool IsOnline();
@@ -64,38 +138,46 @@ public:
   void SetVendorName(const char* vendorname);
   void SetProductName(const char* productname);
   void SetSerialNumber(const char* serialnumber);
-  void SetLocation(std::string location);
+  void SetLocation(const char* location);
 
-  virtual EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
-                                                   chip::AttributeId attributeId,
-                                                   uint8_t* buffer,
-                                                   uint16_t maxReadLength);
+  EmberAfStatus HandleReadEmberAfAttribute(ClusterId clusterId,
+                                           chip::AttributeId attributeId,
+                                           uint8_t* buffer,
+                                           uint16_t maxReadLength);
 
-  virtual EmberAfStatus HandleWriteEmberAfAttribute(ClusterId clusterId,
-                                                    chip::AttributeId attributeId,
-                                                    uint8_t* buffer);
-
-  EmberAfStatus HandleReadBridgedDeviceBasicAttribute(ClusterId clusterId,
-                                                      chip::AttributeId attributeId,
-                                                      uint8_t * buffer,
-                                                      uint16_t maxReadLength);
-
-  EmberAfStatus HandleReadIdentifyAttribute(ClusterId clusterId,
+  EmberAfStatus HandleWriteEmberAfAttribute(ClusterId clusterId,
                                             chip::AttributeId attributeId,
-                                            uint8_t* buffer,
-                                            uint16_t maxReadLength);
+                                            uint8_t* buffer);
 
-  EmberAfStatus HandleWriteIdentifyAttribute(ClusterId clusterId,
-                                             chip::AttributeId attributeId,
-                                             uint8_t* buffer);
+  static constexpr bool IsSortedAttributeTable(const AttributeDescriptor* entries, size_t count)
+  {
+    for (size_t i = 1u; i < count; i++) {
+      if (entries[i - 1].cluster_id > entries[i].cluster_id
+          || (entries[i - 1].cluster_id == entries[i].cluster_id && entries[i - 1].attribute_id >= entries[i].attribute_id)) {
+        return false;
+      }
+    }
+    return true;
+  }
 
   void HandleIdentifyStart();
   void HandleIdentifyStop();
   bool GetIdentifyInProgress();
 
+  // Persistence of the device state in NVM3 - the state is written with a delay so that bursts of changes are coalesced
+  bool EnablePersistence(uint16_t key);
+  void FlushPersistentState();
+  static void FlushAllPersistentStates();
+  static void SetPersistenceWriteDelay(uint32_t delay_ms);
+
   uint32_t GetBridgedDeviceBasicInformationClusterFeatureMap();
   uint16_t GetBridgedDeviceBasicInformationClusterRevision();
 
+  inline DeviceType_t GetDeviceType()
+  {
+    return this->device_type;
+  }
+
   inline void SetEndpointId(chip::EndpointId id)
   {
     this->endpoint_id = id;
@@ -136,13 +218,20 @@ public:
     return this->serial_number;
   }
 
-  inline std::string GetLocation()
+  inline char* GetLocation()
   {
     return this->location;
   }
 
 protected:
-  void HandleDeviceStatusChanged(Changed_t itemChangedMask);
+  // Marks attributes as changed - they're reported together on the next turn of the Matter event loop
+  void HandleDeviceStatusChanged(uint32_t itemChangedMask);
+  // Reports the changed attributes - called on the Matter thread, devices override it to map their own bits
+  virtual void ReportChangedAttributes(uint32_t itemChangedMask);
+  // Devices keeping their state across reboots override these - the mask selects the changes which are persisted
+  virtual uint32_t GetPersistentChangedMask();
+  virtual size_t GetPersistentState(uint8_t* buffer, size_t size);
+  virtual bool SetPersistentState(const uint8_t* buffer, size_t length);
   bool reachable;
   bool online;
 
@@ -154,7 +243,7 @@ protected:
   char vendor_name[DeviceDescStrSize];
   char product_name[DeviceDescStrSize];
   char serial_number[DeviceDescStrSize];
-  std::string location;
+  char location[DeviceDescStrSize];
   chip::EndpointId endpoint_id;
   chip::EndpointId parent_endpoint_id;
 
@@ -163,4 +252,34 @@ protected:
 
   static const uint32_t identify_cluster_feature_map = 0u;
   static const uint16_t identify_cluster_revision = 4u;
+
+private:
+  static void FlushChangedAttributes(intptr_t context);
+  static void PersistenceTimerHandler(chip::System::Layer* layer, void* context);
+  void SchedulePersistentStateSave();
+  bool SavePersistentState();
+  void UnlinkPersistentState();
+  static AttributeTable GetCommonAttributeTable();
+  static const AttributeDescriptor* SearchAttributeTable(AttributeTable table, ClusterId clusterId, chip::AttributeId attributeId);
+  const AttributeDescriptor* FindAttribute(ClusterId clusterId, chip::AttributeId attributeId);
+
+  const DeviceType_t device_type;
+  const AttributeTable attribute_table;
+
+  // Changed attributes waiting for the next flush - devices with pending changes form a list
+  uint32_t changed_attributes;
+  bool changed_queued;
+  Device* next_changed_device;
+
+  static Device* changed_devices_head;
+  static bool changed_flush_scheduled;
+
+  // NVM3 key of the state (0 if not persisted) - devices with unsaved state form a list
+  uint16_t persistence_key;
+  bool persistence_queued;
+  Device* next_persistence_device;
+
+  static Device* persistence_devices_head;
+  static bool persistence_timer_scheduled;
+  static uint32_t persistence_write_delay_ms;
 };
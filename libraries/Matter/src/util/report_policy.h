@@ -0,0 +1,161 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef REPORT_POLICY_H
+#define REPORT_POLICY_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/***************************************************************************//**
+ * Decides which measurements of a sensor are worth reporting
+ * A new value is reported if it moved out of the deadband around the last
+ * reported value and the minimum interval since the last report has passed.
+ * After the maximum interval the current value is reported even if it's
+ * within the deadband. The samples can be smoothed with an exponential moving
+ * average before the check. The defaults report every sample.
+ ******************************************************************************/
+class ReportPolicy {
+public:
+  ReportPolicy() :
+    deadband(0u),
+    deadband_percent(0.0f),
+    min_interval_ms(0u),
+    max_interval_ms(0u),
+    smoothing(0.0f),
+    smoothed(0.0f),
+    last_reported(0),
+    last_report_ms(0u),
+    has_samples(false),
+    has_reported(false)
+  {
+    ;
+  }
+
+  /***************************************************************************//**
+   * Sets the deadband around the last reported value
+   * The larger of the absolute and the relative deadband is used.
+   *
+   * @param[in] absolute the absolute deadband in raw units
+   * @param[in] percent the relative deadband in percent of the last reported value
+   ******************************************************************************/
+  void set_deadband(uint32_t absolute, float percent)
+  {
+    this->deadband = absolute;
+    this->deadband_percent = percent < 0.0f ? 0.0f : percent;
+  }
+
+  /***************************************************************************//**
+   * Sets the time limits between reports
+   *
+   * @param[in] min_ms the minimum time between two reports - 0 for no limit
+   * @param[in] max_ms the time after which the current value is reported even
+   *                   if it's within the deadband - 0 to disable
+   ******************************************************************************/
+  void set_intervals(uint32_t min_ms, uint32_t max_ms)
+  {
+    this->min_interval_ms = min_ms;
+    this->max_interval_ms = max_ms;
+  }
+
+  /***************************************************************************//**
+   * Sets the weight of new samples in the exponential moving average
+   *
+   * @param[in] factor the weight of a new sample between 0 and 1 - 0 (or 1) disables smoothing
+   ******************************************************************************/
+  void set_smoothing(float factor)
+  {
+    if (factor <= 0.0f || factor >= 1.0f) {
+      factor = 0.0f;
+    }
+    this->smoothing = factor;
+    this->has_samples = false;
+  }
+
+  /***************************************************************************//**
+   * Feeds a new sample into the policy
+   *
+   * @param[in] sample the new sample in raw units
+   * @param[in] now_ms the current time in milliseconds
+   * @param[out] report_value the value to report - only set if true is returned
+   * @param[out] forced true if the report is due to the maximum interval
+   *                    and has to be published even if the value is unchanged
+   *
+   * @return true if the value should be reported, false otherwise
+   ******************************************************************************/
+  bool update(int32_t sample, uint32_t now_ms, int32_t& report_value, bool& forced)
+  {
+    forced = false;
+    int32_t value = sample;
+    if (this->smoothing > 0.0f) {
+      if (!this->has_samples) {
+        this->smoothed = static_cast<float>(sample);
+      } else {
+        this->smoothed += (static_cast<float>(sample) - this->smoothed) * this->smoothing;
+      }
+      value = static_cast<int32_t>(lroundf(this->smoothed));
+    }
+    this->has_samples = true;
+
+    if (this->has_reported) {
+      uint32_t elapsed_ms = now_ms - this->last_report_ms;
+      if (elapsed_ms < this->min_interval_ms) {
+        return false;
+      }
+      uint32_t threshold = this->deadband;
+      uint32_t relative = static_cast<uint32_t>(labs(this->last_reported) * this->deadband_percent / 100.0f);
+      if (relative > threshold) {
+        threshold = relative;
+      }
+      uint32_t difference = static_cast<uint32_t>(labs(static_cast<long>(value) - this->last_reported));
+      bool heartbeat = (this->max_interval_ms != 0u) && (elapsed_ms >= this->max_interval_ms);
+      if (difference <= threshold && !heartbeat) {
+        return false;
+      }
+      forced = heartbeat;
+    }
+
+    this->last_reported = value;
+    this->last_report_ms = now_ms;
+    this->has_reported = true;
+    report_value = value;
+    return true;
+  }
+
+private:
+  uint32_t deadband;
+  float deadband_percent;
+  uint32_t min_interval_ms;
+  uint32_t max_interval_ms;
+  float smoothing;
+  float smoothed;
+  int32_t last_reported;
+  uint32_t last_report_ms;
+  bool has_samples;
+  bool has_reported;
+};
+
+#endif // REPORT_POLICY_H
@@ -0,0 +1,139 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef STATIC_POOL_H
+#define STATIC_POOL_H
+
+#include <new>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/***************************************************************************//**
+ * Fixed number of equally sized slots in static storage
+ * Objects up to the size and alignment of 'Slot' can be created in the pool -
+ * the RAM used is known at link time and nothing is taken from the heap.
+ * Meant for static storage duration instances.
+ ******************************************************************************/
+template<typename Slot, size_t SlotCount>
+class StaticPool {
+public:
+  /***************************************************************************//**
+   * Constructs an object in a free slot
+   *
+   * @param[in] args the arguments passed to the constructor of the object
+   *
+   * @return pointer to the new object or nullptr if the pool is exhausted
+   ******************************************************************************/
+  template<typename T, typename ... Args>
+  T* create(Args&& ... args)
+  {
+    static_assert(sizeof(T) <= sizeof(Slot) && alignof(T) <= alignof(Slot), "Object doesn't fit into the pool's slots");
+    void* slot = this->allocate();
+    if (slot == nullptr) {
+      return nullptr;
+    }
+    return new (slot) T(std::forward<Args>(args) ...);
+  }
+
+  /***************************************************************************//**
+   * Destroys an object created with create() and frees its slot
+   *
+   * @param[in] obj pointer to the object - nullptr is ignored
+   ******************************************************************************/
+  template<typename T>
+  void destroy(T* obj)
+  {
+    if (obj == nullptr) {
+      return;
+    }
+    obj->~T();
+    this->release(obj);
+  }
+
+  /***************************************************************************//**
+   * Reserves a free slot without constructing anything in it
+   *
+   * @return pointer to the slot or nullptr if the pool is exhausted
+   ******************************************************************************/
+  void* allocate()
+  {
+    void* slot = nullptr;
+    taskENTER_CRITICAL();
+    for (size_t i = 0u; i < SlotCount; i++) {
+      if (!this->used[i]) {
+        this->used[i] = true;
+        slot = &this->slots[i];
+        break;
+      }
+    }
+    taskEXIT_CRITICAL();
+    return slot;
+  }
+
+  /***************************************************************************//**
+   * Frees a slot reserved with allocate()
+   *
+   * @param[in] ptr pointer to the slot - pointers outside the pool are ignored
+   ******************************************************************************/
+  void release(void* ptr)
+  {
+    for (size_t i = 0u; i < SlotCount; i++) {
+      if (ptr == &this->slots[i]) {
+        taskENTER_CRITICAL();
+        this->used[i] = false;
+        taskEXIT_CRITICAL();
+        return;
+      }
+    }
+  }
+
+  /***************************************************************************//**
+   * Provides the number of free slots
+   *
+   * @return the number of free slots
+   ******************************************************************************/
+  size_t available()
+  {
+    size_t count = 0u;
+    taskENTER_CRITICAL();
+    for (size_t i = 0u; i < SlotCount; i++) {
+      if (!this->used[i]) {
+        count++;
+      }
+    }
+    taskEXIT_CRITICAL();
+    return count;
+  }
+
+private:
+  typename std::aligned_storage<sizeof(Slot), alignof(Slot)>::type slots[SlotCount];
+  bool used[SlotCount] = {};
+};
+
+#endif // STATIC_POOL_H
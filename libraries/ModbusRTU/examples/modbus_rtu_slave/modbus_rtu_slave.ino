@@ -0,0 +1,74 @@
+/*
+   Modbus RTU slave example
+
+   The example shows how to serve Modbus RTU requests over RS-485 with the ModbusRTU library.
+   Requests are framed as soon as their last byte arrives and are answered directly from the
+   serial frame task - the reply leaves tens of microseconds after the request.
+
+   Connect an RS-485 transceiver (e.g. MAX485) to Serial1 (Serial on boards with a single UART)
+   and its DE and /RE pins to D2.
+
+   Served data:
+   - Coils 0-7: coil 0 drives the built-in LED
+   - Discrete inputs 0-7: the built-in button on input 0 (where available)
+   - Holding registers 0-9: read/write scratch registers
+   - Input registers 0-1: the upper and lower half of millis()
+
+   Try it with a Modbus master on the host, for example with mbpoll:
+     mbpoll -m rtu -a 17 -b 19200 -P none -t 4 -r 1 -c 10 /dev/ttyUSB0
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#include <ModbusRTU.h>
+
+#if (NUM_HW_SERIAL > 1)
+#define RS485_SERIAL Serial1
+#else
+#define RS485_SERIAL Serial
+#endif
+
+const uint8_t slave_address = 17;
+const pin_size_t rs485_de_pin = D2;
+
+uint8_t coils[1];
+uint8_t discrete_inputs[1];
+uint16_t holding_registers[10];
+uint16_t input_registers[2];
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+#if defined(BTN_BUILTIN)
+  pinMode(BTN_BUILTIN, INPUT_PULLUP);
+#endif
+
+  ModbusRTU.setCoils(coils, 8);
+  ModbusRTU.setDiscreteInputs(discrete_inputs, 8);
+  ModbusRTU.setHoldingRegisters(holding_registers, 10);
+  ModbusRTU.setInputRegisters(input_registers, 2);
+
+  RS485_SERIAL.begin(19200);
+  ModbusRTU.beginSlave(RS485_SERIAL, slave_address, rs485_de_pin);
+}
+
+void loop()
+{
+  uint32_t now = millis();
+  input_registers[0] = (uint16_t)(now >> 16);
+  input_registers[1] = (uint16_t)now;
+#if defined(BTN_BUILTIN)
+  discrete_inputs[0] = (digitalRead(BTN_BUILTIN) == LOW) ? 0x01 : 0x00;
+#endif
+  digitalWrite(LED_BUILTIN, (coils[0] & 0x01) ? LED_BUILTIN_ACTIVE : LED_BUILTIN_INACTIVE);
+  delay(10);
+}
@@ -0,0 +1,617 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ModbusRTU.h"
+
+static inline uint16_t get_u16(const uint8_t* data)
+{
+  return (uint16_t)((data[0] << 8) | data[1]);
+}
+
+static inline void put_u16(uint8_t* data, uint16_t value)
+{
+  data[0] = (uint8_t)(value >> 8);
+  data[1] = (uint8_t)value;
+}
+
+ModbusRTUClass::ModbusRTUClass() :
+  serial(nullptr),
+  master(false),
+  slave_address(0u),
+  timeout_ms(default_timeout_ms),
+  turnaround_ms(default_turnaround_ms),
+  coils(nullptr),
+  coil_count(0u),
+  discrete_inputs(nullptr),
+  discrete_input_count(0u),
+  holding_registers(nullptr),
+  holding_register_count(0u),
+  input_registers(nullptr),
+  input_register_count(0u),
+  transaction_mutex(nullptr),
+  response_sem(nullptr),
+  response_pending(false),
+  response_len(0u),
+  bus_free_us(0u),
+  frame_count(0u),
+  error_count(0u)
+{
+  this->transaction_mutex = xSemaphoreCreateMutexStatic(&this->transaction_mutex_buf);
+  configASSERT(this->transaction_mutex);
+  this->response_sem = xSemaphoreCreateBinaryStatic(&this->response_sem_buf);
+  configASSERT(this->response_sem);
+}
+
+void ModbusRTUClass::beginMaster(arduino::UARTClass& serial, pin_size_t de_pin)
+{
+  serial.enableRS485(de_pin);
+  this->begin(serial, true);
+}
+
+void ModbusRTUClass::beginMaster(arduino::UARTClass& serial)
+{
+  this->begin(serial, true);
+}
+
+void ModbusRTUClass::beginSlave(arduino::UARTClass& serial, uint8_t address, pin_size_t de_pin)
+{
+  serial.enableRS485(de_pin);
+  this->slave_address = address;
+  this->begin(serial, false);
+}
+
+void ModbusRTUClass::beginSlave(arduino::UARTClass& serial, uint8_t address)
+{
+  this->slave_address = address;
+  this->begin(serial, false);
+}
+
+void ModbusRTUClass::begin(arduino::UARTClass& serial, bool master)
+{
+  this->serial = &serial;
+  this->master = master;
+  // Frames are sized from their header as they come in, anything else is ended by the RX timeout
+  serial.setFrameTrigger(0u, -1, frame_idle_chars);
+  serial.setFrameLengthFn(master ? ModbusRTUClass::response_length : ModbusRTUClass::request_length);
+  serial.onFrame(ModbusRTUClass::on_frame, frame_idle_chars);
+}
+
+void ModbusRTUClass::end()
+{
+  if (!this->serial) {
+    return;
+  }
+  this->serial->onFrame(nullptr, 2u);
+  this->serial->setFrameLengthFn(nullptr);
+  this->serial->setFrameTrigger(0u, -1, 2u);
+  this->serial->disableRS485();
+  this->serial = nullptr;
+}
+
+void ModbusRTUClass::setCoils(uint8_t* data, uint16_t count)
+{
+  this->coils = data;
+  this->coil_count = data ? count : 0u;
+}
+
+void ModbusRTUClass::setDiscreteInputs(const uint8_t* data, uint16_t count)
+{
+  this->discrete_inputs = data;
+  this->discrete_input_count = data ? count : 0u;
+}
+
+void ModbusRTUClass::setHoldingRegisters(uint16_t* data, uint16_t count)
+{
+  this->holding_registers = data;
+  this->holding_register_count = data ? count : 0u;
+}
+
+void ModbusRTUClass::setInputRegisters(const uint16_t* data, uint16_t count)
+{
+  this->input_registers = data;
+  this->input_register_count = data ? count : 0u;
+}
+
+void ModbusRTUClass::setTimeout(uint32_t timeout_ms)
+{
+  this->timeout_ms = timeout_ms;
+}
+
+void ModbusRTUClass::setTurnaroundDelay(uint32_t turnaround_ms)
+{
+  this->turnaround_ms = turnaround_ms;
+}
+
+uint32_t ModbusRTUClass::getFrameCount()
+{
+  return this->frame_count;
+}
+
+uint32_t ModbusRTUClass::getErrorCount()
+{
+  return this->error_count;
+}
+
+int ModbusRTUClass::readCoils(uint8_t slave, uint16_t address, uint16_t count, uint8_t* data)
+{
+  if (slave == 0u || !data || count == 0u || count > max_read_bits) {
+    return MODBUS_ERR_INVALID_ARGUMENT;
+  }
+  uint8_t request[6] = { slave, MODBUS_READ_COILS };
+  put_u16(&request[2], address);
+  put_u16(&request[4], count);
+  size_t byte_count = (count + 7u) / 8u;
+  return this->transaction(request, sizeof(request), 5u + byte_count, data);
+}
+
+int ModbusRTUClass::readDiscreteInputs(uint8_t slave, uint16_t address, uint16_t count, uint8_t* data)
+{
+  if (slave == 0u || !data || count == 0u || count > max_read_bits) {
+    return MODBUS_ERR_INVALID_ARGUMENT;
+  }
+  uint8_t request[6] = { slave, MODBUS_READ_DISCRETE_INPUTS };
+  put_u16(&request[2], address);
+  put_u16(&request[4], count);
+  size_t byte_count = (count + 7u) / 8u;
+  return this->transaction(request, sizeof(request), 5u + byte_count, data);
+}
+
+int ModbusRTUClass::readHoldingRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t* data)
+{
+  if (slave == 0u || !data || count == 0u || count > max_read_registers) {
+    return MODBUS_ERR_INVALID_ARGUMENT;
+  }
+  uint8_t request[6] = { slave, MODBUS_READ_HOLDING_REGISTERS };
+  put_u16(&request[2], address);
+  put_u16(&request[4], count);
+  int res = this->transaction(request, sizeof(request), 5u + 2u * count, (uint8_t*)data);
+  if (res == MODBUS_OK) {
+    // Each register is converted in the two bytes it was copied to
+    for (uint16_t i = 0; i < count; i++) {
+      data[i] = get_u16((const uint8_t*)&data[i]);
+    }
+  }
+  return res;
+}
+
+int ModbusRTUClass::readInputRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t* data)
+{
+  if (slave == 0u || !data || count == 0u || count > max_read_registers) {
+    return MODBUS_ERR_INVALID_ARGUMENT;
+  }
+  uint8_t request[6] = { slave, MODBUS_READ_INPUT_REGISTERS };
+  put_u16(&request[2], address);
+  put_u16(&request[4], count);
+  int res = this->transaction(request, sizeof(request), 5u + 2u * count, (uint8_t*)data);
+  if (res == MODBUS_OK) {
+    // Each register is converted in the two bytes it was copied to
+    for (uint16_t i = 0; i < count; i++) {
+      data[i] = get_u16((const uint8_t*)&data[i]);
+    }
+  }
+  return res;
+}
+
+int ModbusRTUClass::writeSingleCoil(uint8_t slave, uint16_t address, bool value)
+{
+  uint8_t request[6] = { slave, MODBUS_WRITE_SINGLE_COIL };
+  put_u16(&request[2], address);
+  put_u16(&request[4], value ? 0xFF00u : 0x0000u);
+  return this->transaction(request, sizeof(request), 8u, nullptr);
+}
+
+int ModbusRTUClass::writeSingleRegister(uint8_t slave, uint16_t address, uint16_t value)
+{
+  uint8_t request[6] = { slave, MODBUS_WRITE_SINGLE_REGISTER };
+  put_u16(&request[2], address);
+  put_u16(&request[4], value);
+  return this->transaction(request, sizeof(request), 8u, nullptr);
+}
+
+int ModbusRTUClass::writeMultipleCoils(uint8_t slave, uint16_t address, uint16_t count, const uint8_t* data)
+{
+  if (!data || count == 0u || count > max_write_bits) {
+    return MODBUS_ERR_INVALID_ARGUMENT;
+  }
+  uint8_t byte_count = (uint8_t)((count + 7u) / 8u);
+  uint8_t request[7u + (max_write_bits + 7u) / 8u] = { slave, MODBUS_WRITE_MULTIPLE_COILS };
+  put_u16(&request[2], address);
+  put_u16(&request[4], count);
+  request[6] = byte_count;
+  memcpy(&request[7], data, byte_count);
+  return this->transaction(request, 7u + byte_count, 8u, nullptr);
+}
+
+int ModbusRTUClass::writeMultipleRegisters(uint8_t slave, uint16_t address, uint16_t count, const uint16_t* data)
+{
+  if (!data || count == 0u || count > max_write_registers) {
+    return MODBUS_ERR_INVALID_ARGUMENT;
+  }
+  uint8_t request[7u + 2u * max_write_registers] = { slave, MODBUS_WRITE_MULTIPLE_REGISTERS };
+  put_u16(&request[2], address);
+  put_u16(&request[4], count);
+  request[6] = (uint8_t)(2u * count);
+  for (uint16_t i = 0; i < count; i++) {
+    put_u16(&request[7u + 2u * i], data[i]);
+  }
+  return this->transaction(request, 7u + 2u * count, 8u, nullptr);
+}
+
+// Sends a request and waits for the matching response
+// The data bytes of a successful response are copied to 'data' before the transaction mutex is released
+int ModbusRTUClass::transaction(uint8_t* request, size_t request_len, size_t expected_len, uint8_t* data)
+{
+  xSemaphoreTake(this->transaction_mutex, portMAX_DELAY);
+  int res = this->exchange(request, request_len, expected_len);
+  if (res == MODBUS_OK && data) {
+    memcpy(data, &this->response[3], expected_len - 5u);
+  }
+  xSemaphoreGive(this->transaction_mutex);
+  return res;
+}
+
+// Called with the transaction mutex taken
+int ModbusRTUClass::exchange(uint8_t* request, size_t request_len, size_t expected_len)
+{
+  if (!this->serial || !this->master) {
+    return MODBUS_ERR_NOT_STARTED;
+  }
+
+  bool broadcast = request[0] == 0u;
+  this->wait_bus_free();
+  // Drop a response which arrived after the previous request timed out
+  (void)xSemaphoreTake(this->response_sem, 0u);
+  this->response_pending = !broadcast;
+  memcpy(this->tx_frame, request, request_len);
+  this->send_frame(this->tx_frame, request_len);
+  if (broadcast) {
+    // The slaves don't answer broadcasts - give them the turnaround delay to process it before the next request
+    this->bus_free_us = micros() + this->turnaround_ms * 1000u;
+    return MODBUS_OK;
+  }
+  this->bus_free_us = micros() + this->t35_us();
+
+  if (xSemaphoreTake(this->response_sem, pdMS_TO_TICKS(this->timeout_ms)) != pdTRUE) {
+    this->response_pending = false;
+    return MODBUS_ERR_TIMEOUT;
+  }
+  if (!check_crc(this->response, this->response_len)) {
+    return MODBUS_ERR_CRC;
+  }
+  if (this->response[0] != request[0]) {
+    return MODBUS_ERR_INVALID_RESPONSE;
+  }
+  if (this->response[1] == (request[1] | 0x80u) && this->response_len == 5u) {
+    return this->response[2];
+  }
+  if (this->response[1] != request[1] || this->response_len != expected_len) {
+    return MODBUS_ERR_INVALID_RESPONSE;
+  }
+  return MODBUS_OK;
+}
+
+// Sleeps until the bus has been silent for t3.5 after the last frame - or for the turnaround delay after a broadcast
+void ModbusRTUClass::wait_bus_free()
+{
+  int32_t remaining_us = (int32_t)(this->bus_free_us - micros());
+  if (remaining_us <= 0) {
+    return;
+  }
+  // One extra tick as the current one is already partly over
+  vTaskDelay(pdMS_TO_TICKS(((uint32_t)remaining_us + 999u) / 1000u) + 1u);
+}
+
+// The inter-frame silence - fixed at 1.75 ms above 19200 baud as per the Modbus serial line specification
+uint32_t ModbusRTUClass::t35_us()
+{
+  uint32_t baudrate = this->serial->getBaudrate();
+  if (baudrate > 19200u) {
+    return 1750u;
+  }
+  // 3.5 characters of 11 bits
+  return (38500000u + baudrate - 1u) / baudrate;
+}
+
+void ModbusRTUClass::send_frame(uint8_t* frame, size_t len)
+{
+  uint16_t crc = calculateCRC16(frame, len);
+  frame[len] = (uint8_t)crc;
+  frame[len + 1u] = (uint8_t)(crc >> 8);
+  this->serial->write(frame, len + 2u);
+}
+
+bool ModbusRTUClass::check_crc(const uint8_t* data, size_t len)
+{
+  if (len < 4u) {
+    return false;
+  }
+  uint16_t crc = calculateCRC16(data, len - 2u);
+  return data[len - 2u] == (uint8_t)crc && data[len - 1u] == (uint8_t)(crc >> 8);
+}
+
+// Frame length of a request addressed to this slave - other slaves' responses can't be told
+// apart from requests so their frames are left to the RX timeout
+size_t ModbusRTUClass::request_length(const uint8_t* data, size_t len)
+{
+  if (len < 2u || (data[0] != ModbusRTU.slave_address && data[0] != 0u)) {
+    return 0u;
+  }
+  switch (data[1]) {
+    case MODBUS_READ_COILS:
+    case MODBUS_READ_DISCRETE_INPUTS:
+    case MODBUS_READ_HOLDING_REGISTERS:
+    case MODBUS_READ_INPUT_REGISTERS:
+    case MODBUS_WRITE_SINGLE_COIL:
+    case MODBUS_WRITE_SINGLE_REGISTER:
+      return 8u;
+    case MODBUS_WRITE_MULTIPLE_COILS:
+    case MODBUS_WRITE_MULTIPLE_REGISTERS:
+      return (len < 7u) ? 0u : 9u + data[6];
+    default:
+      return 0u;
+  }
+}
+
+size_t ModbusRTUClass::response_length(const uint8_t* data, size_t len)
+{
+  if (len < 2u) {
+    return 0u;
+  }
+  if (data[1] & 0x80u) {
+    return 5u;
+  }
+  switch (data[1]) {
+    case MODBUS_READ_COILS:
+    case MODBUS_READ_DISCRETE_INPUTS:
+    case MODBUS_READ_HOLDING_REGISTERS:
+    case MODBUS_READ_INPUT_REGISTERS:
+      return (len < 3u) ? 0u : 5u + data[2];
+    case MODBUS_WRITE_SINGLE_COIL:
+    case MODBUS_WRITE_SINGLE_REGISTER:
+    case MODBUS_WRITE_MULTIPLE_COILS:
+    case MODBUS_WRITE_MULTIPLE_REGISTERS:
+      return 8u;
+    default:
+      return 0u;
+  }
+}
+
+void ModbusRTUClass::on_frame(const uint8_t* data, size_t len)
+{
+  ModbusRTU.frame_count++;
+  if (ModbusRTU.master) {
+    ModbusRTU.bus_free_us = micros() + ModbusRTU.t35_us();
+    ModbusRTU.handle_response(data, len);
+  } else {
+    ModbusRTU.handle_request(data, len);
+  }
+}
+
+void ModbusRTUClass::handle_response(const uint8_t* data, size_t len)
+{
+  if (!this->response_pending) {
+    return;
+  }
+  if (len > max_frame_size) {
+    len = max_frame_size;
+  }
+  memcpy(this->response, data, len);
+  this->response_len = len;
+  this->response_pending = false;
+  xSemaphoreGive(this->response_sem);
+}
+
+void ModbusRTUClass::handle_request(const uint8_t* data, size_t len)
+{
+  if (!check_crc(data, len)) {
+    this->error_count++;
+    return;
+  }
+  uint8_t address = data[0];
+  if (address != this->slave_address && address != 0u) {
+    return;
+  }
+  bool broadcast = address == 0u;
+  uint8_t function = data[1];
+  const uint8_t* pdu = &data[2];
+  size_t pdu_len = len - 4u;
+  uint8_t* tx = this->tx_frame;
+  tx[0] = this->slave_address;
+  tx[1] = function;
+
+  // Broadcasts are only valid for the write functions and are never answered
+  switch (function) {
+    case MODBUS_READ_COILS:
+    case MODBUS_READ_DISCRETE_INPUTS:
+    case MODBUS_READ_HOLDING_REGISTERS:
+    case MODBUS_READ_INPUT_REGISTERS: {
+      if (broadcast) {
+        return;
+      }
+      if (pdu_len != 4u) {
+        this->error_count++;
+        return;
+      }
+      uint16_t start = get_u16(&pdu[0]);
+      uint16_t count = get_u16(&pdu[2]);
+      bool bits = function == MODBUS_READ_COILS || function == MODBUS_READ_DISCRETE_INPUTS;
+      if (count == 0u || count > (bits ? (size_t)max_read_bits : (size_t)max_read_registers)) {
+        this->send_exception(function, MODBUS_EX_ILLEGAL_DATA_VALUE);
+        return;
+      }
+      size_t n = 0u;
+      if (function == MODBUS_READ_COILS) {
+        n = this->read_bits(this->coils, this->coil_count, start, count, &tx[3]);
+      } else if (function == MODBUS_READ_DISCRETE_INPUTS) {
+        n = this->read_bits(this->discrete_inputs, this->discrete_input_count, start, count, &tx[3]);
+      } else if (function == MODBUS_READ_HOLDING_REGISTERS) {
+        n = this->read_registers(this->holding_registers, this->holding_register_count, start, count, &tx[3]);
+      } else {
+        n = this->read_registers(this->input_registers, this->input_register_count, start, count, &tx[3]);
+      }
+      if (n == 0u) {
+        this->send_exception(function, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+        return;
+      }
+      tx[2] = (uint8_t)n;
+      this->send_frame(tx, 3u + n);
+      return;
+    }
+
+    case MODBUS_WRITE_SINGLE_COIL: {
+      if (pdu_len != 4u) {
+        this->error_count++;
+        return;
+      }
+      uint16_t coil = get_u16(&pdu[0]);
+      uint16_t value = get_u16(&pdu[2]);
+      if (value != 0xFF00u && value != 0x0000u) {
+        if (!broadcast) {
+          this->send_exception(function, MODBUS_EX_ILLEGAL_DATA_VALUE);
+        }
+        return;
+      }
+      if (coil >= this->coil_count) {
+        if (!broadcast) {
+          this->send_exception(function, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+        }
+        return;
+      }
+      if (value) {
+        this->coils[coil >> 3] |= (uint8_t)(1u << (coil & 7u));
+      } else {
+        this->coils[coil >> 3] &= (uint8_t)~(1u << (coil & 7u));
+      }
+      break;
+    }
+
+    case MODBUS_WRITE_SINGLE_REGISTER: {
+      if (pdu_len != 4u) {
+        this->error_count++;
+        return;
+      }
+      uint16_t reg = get_u16(&pdu[0]);
+      if (reg >= this->holding_register_count) {
+        if (!broadcast) {
+          this->send_exception(function, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+        }
+        return;
+      }
+      this->holding_registers[reg] = get_u16(&pdu[2]);
+      break;
+    }
+
+    case MODBUS_WRITE_MULTIPLE_COILS:
+    case MODBUS_WRITE_MULTIPLE_REGISTERS: {
+      if (pdu_len < 5u || pdu_len != 5u + pdu[4]) {
+        this->error_count++;
+        return;
+      }
+      uint16_t start = get_u16(&pdu[0]);
+      uint16_t count = get_u16(&pdu[2]);
+      uint8_t byte_count = pdu[4];
+      const uint8_t* values = &pdu[5];
+      bool coils = function == MODBUS_WRITE_MULTIPLE_COILS;
+      size_t max_count = coils ? (size_t)max_write_bits : (size_t)max_write_registers;
+      size_t expected_bytes = coils ? (count + 7u) / 8u : 2u * count;
+      if (count == 0u || count > max_count || byte_count != expected_bytes) {
+        if (!broadcast) {
+          this->send_exception(function, MODBUS_EX_ILLEGAL_DATA_VALUE);
+        }
+        return;
+      }
+      uint16_t table_count = coils ? this->coil_count : this->holding_register_count;
+      if ((uint32_t)start + count > table_count) {
+        if (!broadcast) {
+          this->send_exception(function, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+        }
+        return;
+      }
+      for (uint16_t i = 0; i < count; i++) {
+        if (coils) {
+          uint16_t coil = start + i;
+          if (values[i >> 3] & (1u << (i & 7u))) {
+            this->coils[coil >> 3] |= (uint8_t)(1u << (coil & 7u));
+          } else {
+            this->coils[coil >> 3] &= (uint8_t)~(1u << (coil & 7u));
+          }
+        } else {
+          this->holding_registers[start + i] = get_u16(&values[2u * i]);
+        }
+      }
+      break;
+    }
+
+    default:
+      if (!broadcast) {
+        this->send_exception(function, MODBUS_EX_ILLEGAL_FUNCTION);
+      }
+      return;
+  }
+
+  // The write functions echo the address and value / quantity of the request
+  if (!broadcast) {
+    memcpy(&tx[2], pdu, 4u);
+    this->send_frame(tx, 6u);
+  }
+}
+
+size_t ModbusRTUClass::read_bits(const uint8_t* table, uint16_t table_count, uint16_t address, uint16_t count, uint8_t* dst)
+{
+  if ((uint32_t)address + count > table_count) {
+    return 0u;
+  }
+  size_t byte_count = (count + 7u) / 8u;
+  memset(dst, 0, byte_count);
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t bit = address + i;
+    if (table[bit >> 3] & (1u << (bit & 7u))) {
+      dst[i >> 3] |= (uint8_t)(1u << (i & 7u));
+    }
+  }
+  return byte_count;
+}
+
+size_t ModbusRTUClass::read_registers(const uint16_t* table, uint16_t table_count, uint16_t address, uint16_t count, uint8_t* dst)
+{
+  if ((uint32_t)address + count > table_count) {
+    return 0u;
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    put_u16(&dst[2u * i], table[address + i]);
+  }
+  return 2u * count;
+}
+
+void ModbusRTUClass::send_exception(uint8_t function, uint8_t exception)
+{
+  this->tx_frame[0] = this->slave_address;
+  this->tx_frame[1] = function | 0x80u;
+  this->tx_frame[2] = exception;
+  this->send_frame(this->tx_frame, 3u);
+}
+
+ModbusRTUClass ModbusRTU;
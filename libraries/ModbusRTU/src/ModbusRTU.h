@@ -0,0 +1,227 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef MODBUS_RTU_H
+#define MODBUS_RTU_H
+
+#include <Arduino.h>
+
+// Function codes
+enum : uint8_t {
+  MODBUS_READ_COILS               = 0x01,
+  MODBUS_READ_DISCRETE_INPUTS     = 0x02,
+  MODBUS_READ_HOLDING_REGISTERS   = 0x03,
+  MODBUS_READ_INPUT_REGISTERS     = 0x04,
+  MODBUS_WRITE_SINGLE_COIL        = 0x05,
+  MODBUS_WRITE_SINGLE_REGISTER    = 0x06,
+  MODBUS_WRITE_MULTIPLE_COILS     = 0x0F,
+  MODBUS_WRITE_MULTIPLE_REGISTERS = 0x10
+};
+
+// Result codes of the master requests - positive values are the exception codes returned by the slave
+enum : int {
+  MODBUS_OK                       = 0,
+  MODBUS_EX_ILLEGAL_FUNCTION      = 0x01,
+  MODBUS_EX_ILLEGAL_DATA_ADDRESS  = 0x02,
+  MODBUS_EX_ILLEGAL_DATA_VALUE    = 0x03,
+  MODBUS_EX_SLAVE_DEVICE_FAILURE  = 0x04,
+  MODBUS_ERR_TIMEOUT              = -1,
+  MODBUS_ERR_CRC                  = -2,
+  MODBUS_ERR_INVALID_RESPONSE     = -3,
+  MODBUS_ERR_INVALID_ARGUMENT     = -4,
+  MODBUS_ERR_NOT_STARTED          = -5
+};
+
+class ModbusRTUClass {
+public:
+  /***************************************************************************//**
+   * Constructor for ModbusRTUClass
+   ******************************************************************************/
+  ModbusRTUClass();
+
+  /***************************************************************************//**
+   * Starts a Modbus RTU master on a serial port
+   * The serial port has to be started with begin() beforehand.
+   * Responses are framed as soon as their last byte arrives, frames with
+   * unexpected content are ended by the receiver's RX timeout.
+   *
+   * @param[in] serial the serial port connected to the RS-485 transceiver
+   * @param[in] de_pin the driver-enable pin of the transceiver
+   ******************************************************************************/
+  void beginMaster(arduino::UARTClass& serial, pin_size_t de_pin);
+
+  /***************************************************************************//**
+   * Starts a Modbus RTU master on a serial port without driver-enable control
+   * Use with auto-direction transceivers or point-to-point links.
+   *
+   * @param[in] serial the serial port to use
+   ******************************************************************************/
+  void beginMaster(arduino::UARTClass& serial);
+
+  /***************************************************************************//**
+   * Starts a Modbus RTU slave on a serial port
+   * Requests are served directly from the serial frame task with the data
+   * tables set with the setCoils(), setDiscreteInputs(), setHoldingRegisters()
+   * and setInputRegisters() functions.
+   * The serial port has to be started with begin() beforehand.
+   *
+   * @param[in] serial the serial port connected to the RS-485 transceiver
+   * @param[in] address the slave address (1-247)
+   * @param[in] de_pin the driver-enable pin of the transceiver
+   ******************************************************************************/
+  void beginSlave(arduino::UARTClass& serial, uint8_t address, pin_size_t de_pin);
+
+  /***************************************************************************//**
+   * Starts a Modbus RTU slave on a serial port without driver-enable control
+   *
+   * @param[in] serial the serial port to use
+   * @param[in] address the slave address (1-247)
+   ******************************************************************************/
+  void beginSlave(arduino::UARTClass& serial, uint8_t address);
+
+  /***************************************************************************//**
+   * Stops the master or slave - the received data is available with read() again
+   ******************************************************************************/
+  void end();
+
+  /***************************************************************************//**
+   * Sets the data tables served by the slave
+   * Coils and discrete inputs are packed eight to a byte, LSB first.
+   * The tables are accessed from the serial frame task.
+   *
+   * @param[in] data the table
+   * @param[in] count the number of coils / inputs / registers in the table
+   ******************************************************************************/
+  void setCoils(uint8_t* data, uint16_t count);
+  void setDiscreteInputs(const uint8_t* data, uint16_t count);
+  void setHoldingRegisters(uint16_t* data, uint16_t count);
+  void setInputRegisters(const uint16_t* data, uint16_t count);
+
+  /***************************************************************************//**
+   * Sets how long the master waits for a response
+   *
+   * @param[in] timeout_ms the response timeout in milliseconds
+   ******************************************************************************/
+  void setTimeout(uint32_t timeout_ms);
+
+  /***************************************************************************//**
+   * Sets how long the master keeps the bus silent after a broadcast request
+   * so the slaves can process it before the next request
+   *
+   * @param[in] turnaround_ms the turnaround delay in milliseconds
+   ******************************************************************************/
+  void setTurnaroundDelay(uint32_t turnaround_ms);
+
+  /***************************************************************************//**
+   * Master requests
+   * Requests to address 0 are broadcast and return without waiting for a response.
+   * Each request is sent after the bus has been silent for t3.5 - or for the
+   * turnaround delay after a broadcast.
+   * Coils and discrete inputs are packed eight to a byte, LSB first.
+   *
+   * @param[in] slave the address of the slave
+   * @param[in] address the address of the first coil / input / register
+   * @param[in] count the number of coils / inputs / registers
+   *
+   * @return MODBUS_OK on success, the exception code returned by the slave
+   *         or a negative MODBUS_ERR_* value
+   ******************************************************************************/
+  int readCoils(uint8_t slave, uint16_t address, uint16_t count, uint8_t* data);
+  int readDiscreteInputs(uint8_t slave, uint16_t address, uint16_t count, uint8_t* data);
+  int readHoldingRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t* data);
+  int readInputRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t* data);
+  int writeSingleCoil(uint8_t slave, uint16_t address, bool value);
+  int writeSingleRegister(uint8_t slave, uint16_t address, uint16_t value);
+  int writeMultipleCoils(uint8_t slave, uint16_t address, uint16_t count, const uint8_t* data);
+  int writeMultipleRegisters(uint8_t slave, uint16_t address, uint16_t count, const uint16_t* data);
+
+  /***************************************************************************//**
+   * Returns the number of frames received and the number of frames dropped
+   * because of a bad CRC or an invalid format
+   ******************************************************************************/
+  uint32_t getFrameCount();
+  uint32_t getErrorCount();
+
+private:
+  static const size_t max_frame_size = 256u;
+  static const size_t max_read_bits = 2000u;
+  static const size_t max_read_registers = 125u;
+  static const size_t max_write_bits = 1968u;
+  static const size_t max_write_registers = 123u;
+  static const uint32_t default_timeout_ms = 100u;
+  static const uint32_t default_turnaround_ms = 100u;
+  // The RX timeout ends frames the length functions can't size - between t1.5 and t3.5
+  static const uint8_t frame_idle_chars = 3u;
+
+  void begin(arduino::UARTClass& serial, bool master);
+  static size_t request_length(const uint8_t* data, size_t len);
+  static size_t response_length(const uint8_t* data, size_t len);
+  static void on_frame(const uint8_t* data, size_t len);
+  void handle_request(const uint8_t* data, size_t len);
+  void handle_response(const uint8_t* data, size_t len);
+  size_t read_bits(const uint8_t* table, uint16_t table_count, uint16_t address, uint16_t count, uint8_t* dst);
+  size_t read_registers(const uint16_t* table, uint16_t table_count, uint16_t address, uint16_t count, uint8_t* dst);
+  void send_frame(uint8_t* frame, size_t len);
+  void send_exception(uint8_t function, uint8_t exception);
+  int transaction(uint8_t* request, size_t request_len, size_t expected_len, uint8_t* data);
+  int exchange(uint8_t* request, size_t request_len, size_t expected_len);
+  void wait_bus_free();
+  uint32_t t35_us();
+  static bool check_crc(const uint8_t* data, size_t len);
+
+  arduino::UARTClass* serial;
+  bool master;
+  uint8_t slave_address;
+  uint32_t timeout_ms;
+  uint32_t turnaround_ms;
+
+  uint8_t* coils;
+  uint16_t coil_count;
+  const uint8_t* discrete_inputs;
+  uint16_t discrete_input_count;
+  uint16_t* holding_registers;
+  uint16_t holding_register_count;
+  const uint16_t* input_registers;
+  uint16_t input_register_count;
+
+  SemaphoreHandle_t transaction_mutex;
+  StaticSemaphore_t transaction_mutex_buf;
+  SemaphoreHandle_t response_sem;
+  StaticSemaphore_t response_sem_buf;
+  volatile bool response_pending;
+  uint8_t response[max_frame_size];
+  size_t response_len;
+  uint8_t tx_frame[max_frame_size];
+  // micros() timestamp before which the master doesn't start a request
+  volatile uint32_t bus_free_us;
+
+  uint32_t frame_count;
+  uint32_t error_count;
+};
+
+extern ModbusRTUClass ModbusRTU;
+
+#endif // MODBUS_RTU_H
@@ -26,20 +26,49 @@
 
 #include "SPI.h"
 #include "arduino_spi_config.h"
+#include "gpiointerrupt.h"
+#if defined(EUSART_PRESENT)
+#include "em_eusart.h"
+#endif // EUSART_PRESENT
 
 using namespace arduino;
 
 SilabsSPI::SilabsSPI(SPIDRV_Handle_t sl_spidrv_handle, SPIDRV_Init_t* sl_spidrv_config, SPIDRV_Callback_t dma_transfer_finished_callback) :
-  initialized(false)
+  initialized(false),
+  transaction_owner(nullptr),
+  spi_usart(nullptr),
+#if defined(EUSART_PRESENT)
+  spi_eusart(nullptr),
+#endif // EUSART_PRESENT
+  current_device(nullptr),
+  queue_port(*this),
+  queue(queue_port),
+  queue_task_handle(nullptr),
+  queue_dma_active(false),
+  sg_dummy_tx(0xFFFFFFFFu),
+  sg_dummy_rx(0u),
+  sg_blocking(false),
+  sg_dma_active(false)
 {
   this->sl_spidrv_handle = sl_spidrv_handle;
   this->sl_spidrv_config = sl_spidrv_config;
   this->dma_transfer_finished_callback = dma_transfer_finished_callback;
 
+#if defined(EUSART_PRESENT)
+  if (EUSART_NUM((EUSART_TypeDef*)sl_spidrv_config->port) >= 0) {
+    this->spi_eusart = (EUSART_TypeDef*)sl_spidrv_config->port;
+  } else {
+    this->spi_usart = (USART_TypeDef*)sl_spidrv_config->port;
+  }
+#else
+  this->spi_usart = (USART_TypeDef*)sl_spidrv_config->port;
+#endif // EUSART_PRESENT
+
   this->spi_transfer_mutex = xSemaphoreCreateMutexStatic(&this->spi_transfer_mutex_buf);
   configASSERT(this->spi_transfer_mutex);
-  this->spi_busy_mutex = xSemaphoreCreateMutexStatic(&this->spi_busy_mutex_buf);
-  configASSERT(this->spi_busy_mutex);
+  this->spi_busy_sem = xSemaphoreCreateBinaryStatic(&this->spi_busy_sem_buf);
+  configASSERT(this->spi_busy_sem);
+  xSemaphoreGive(this->spi_busy_sem);
 }
 
 void SilabsSPI::begin()
@@ -53,7 +82,40 @@ void SilabsSPI::begin()
 
 void SilabsSPI::beginTransaction(SPISettings settings)
 {
-  xSemaphoreTake(this->spi_busy_mutex, portMAX_DELAY);
+  xSemaphoreTake(this->spi_busy_sem, portMAX_DELAY);
+  this->transaction_owner = xTaskGetCurrentTaskHandle();
+  this->apply_settings(settings);
+}
+
+void SilabsSPI::beginTransaction(SPIDevice& device)
+{
+  xSemaphoreTake(this->spi_busy_sem, portMAX_DELAY);
+  this->transaction_owner = xTaskGetCurrentTaskHandle();
+  if (this->current_device != &device) {
+    if (device.config_saved) {
+      this->restore_device_config(device);
+    } else {
+      // Let the driver calculate the register values once, then keep them
+      this->apply_settings(device.settings);
+      this->save_device_config(device);
+    }
+    this->current_device = &device;
+  }
+  if (device.cs_pin != PIN_NAME_NC) {
+    GPIO_PinOutClear(device.cs_port, device.cs_pin_num);
+  }
+}
+
+void SilabsSPI::endTransaction(SPIDevice& device)
+{
+  if (device.cs_pin != PIN_NAME_NC) {
+    GPIO_PinOutSet(device.cs_port, device.cs_pin_num);
+  }
+  this->endTransaction();
+}
+
+void SilabsSPI::apply_settings(SPISettings settings)
+{
   // Don't do anything if the settings don't change
   if (this->settings.getClockFreq() == settings.getClockFreq()
       && this->settings.getBitOrder() == settings.getBitOrder()
@@ -63,41 +125,124 @@ void SilabsSPI::beginTransaction(SPISettings settings)
   // Deinit the peripheral
   SPIDRV_DeInit(this->sl_spidrv_handle);
   // Apply the new settings
+  this->settings = settings;
   this->sl_spidrv_config->bitRate = settings.getClockFreq();
   setBitOrder(settings.getBitOrder());
   setDataMode(settings.getDataMode());
   // Reinit the peripheral
   SPIDRV_Init(this->sl_spidrv_handle, this->sl_spidrv_config);
+  this->current_device = nullptr;
 }
 
-// Uses direct blocking transfers with the USART/EUSART driver
+void SilabsSPI::save_device_config(SPIDevice& device)
+{
+#if defined(EUSART_PRESENT)
+  if (this->spi_eusart) {
+    device.ctrl_reg = this->spi_eusart->CFG0;
+    device.clock_reg = this->spi_eusart->CFG2;
+    device.config_saved = true;
+    return;
+  }
+#endif // EUSART_PRESENT
+  device.ctrl_reg = this->spi_usart->CTRL;
+  device.clock_reg = this->spi_usart->CLKDIV;
+  device.config_saved = true;
+}
+
+// Only rewrites the registers holding the clock divider, clock mode and bit order - no driver reinit
+void SilabsSPI::restore_device_config(const SPIDevice& device)
+{
+#if defined(EUSART_PRESENT)
+  if (this->spi_eusart) {
+    // CFG0 and CFG2 can only be written while the EUSART is disabled
+    EUSART_Enable(this->spi_eusart, eusartDisable);
+    this->spi_eusart->CFG0 = device.ctrl_reg;
+    this->spi_eusart->CFG2 = device.clock_reg;
+    EUSART_Enable(this->spi_eusart, eusartEnable);
+  } else
+#endif // EUSART_PRESENT
+  {
+    this->spi_usart->CTRL = device.ctrl_reg;
+    this->spi_usart->CLKDIV = device.clock_reg;
+  }
+  // Keep the driver config in sync so a later reinit starts from the same settings
+  this->settings = device.settings;
+  this->sl_spidrv_config->bitRate = device.settings.getClockFreq();
+  setBitOrder(device.settings.getBitOrder());
+  setDataMode(device.settings.getDataMode());
+}
+
+// Inside a transaction the calling task already owns the bus - the transfer mutex is only needed outside of one
+bool SilabsSPI::in_transaction()
+{
+  return this->transaction_owner == xTaskGetCurrentTaskHandle();
+}
+
+// Uses direct blocking transfers by polling the USART/EUSART flags
 uint8_t SilabsSPI::transfer(uint8_t data)
 {
+  if (this->in_transaction()) {
+    return this->transferFast(data);
+  }
   uint8_t rx_byte = 0u;
   xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
-  rx_byte = sl_spi_direct_transfer((void*)this->sl_spidrv_config->port, data);
+  rx_byte = this->transferFast(data);
   xSemaphoreGive(this->spi_transfer_mutex);
   return rx_byte;
 }
 
-// Uses direct blocking transfers with the USART/EUSART driver
+// Uses two 8-bit frames - the byte going out first depends on the bit order
 uint16_t SilabsSPI::transfer16(uint16_t data)
 {
-  uint16_t rx_bytes = 0u;
-  uint8_t rx_data[2];
-  uint8_t tx_data[2];
-  tx_data[0] = (uint8_t)(data >> 8);
-  tx_data[1] = (uint8_t)data;
-  rx_data[0] = this->transfer(tx_data[0]);
-  rx_data[1] = this->transfer(tx_data[1]);
-  rx_bytes = ((uint16_t)rx_data[0] << 8) + rx_data[1];
-  return rx_bytes;
+  bool locked = !this->in_transaction();
+  if (locked) {
+    xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
+  }
+  uint16_t rx_data = this->transfer_word(data);
+  if (locked) {
+    xSemaphoreGive(this->spi_transfer_mutex);
+  }
+  return rx_data;
+}
+
+// Uses four 8-bit frames - the half going out first depends on the bit order
+uint32_t SilabsSPI::transfer32(uint32_t data)
+{
+  bool locked = !this->in_transaction();
+  if (locked) {
+    xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
+  }
+  uint32_t rx_data = 0u;
+  if (this->sl_spidrv_config->bitOrder == spidrvBitOrderLsbFirst) {
+    rx_data = this->transfer_word((uint16_t)data);
+    rx_data |= (uint32_t)this->transfer_word((uint16_t)(data >> 16)) << 16;
+  } else {
+    rx_data = (uint32_t)this->transfer_word((uint16_t)(data >> 16)) << 16;
+    rx_data |= this->transfer_word((uint16_t)data);
+  }
+  if (locked) {
+    xSemaphoreGive(this->spi_transfer_mutex);
+  }
+  return rx_data;
+}
+
+// Sends a 16-bit word as a pair of 8-bit frames, so the frame size of the peripheral never changes mid-transaction
+uint16_t SilabsSPI::transfer_word(uint16_t data)
+{
+  if (this->sl_spidrv_config->bitOrder == spidrvBitOrderLsbFirst) {
+    return this->transfer_frame_pair((uint8_t)data, (uint8_t)(data >> 8));
+  }
+  uint16_t rx_data = this->transfer_frame_pair((uint8_t)(data >> 8), (uint8_t)data);
+  return (uint16_t)((rx_data << 8) | (rx_data >> 8));
 }
 
 // Uses DMA and waits for the transaction to complete, has a large overhead for small amounts of data
 void SilabsSPI::transfer(void* tx_buf, size_t count, bool block)
 {
-  if (block) {
+  if (count > (size_t)DMA_MAX_TRANSFER_SIZE) {
+    SPISegment segment = { tx_buf, nullptr, count };
+    this->transferSegments(&segment, 1u, block);
+  } else if (block) {
     this->_transfer_block(tx_buf, count);
   } else {
     this->_transfer_nonblock(tx_buf, count);
@@ -145,7 +290,10 @@ void SilabsSPI::_transfer_nonblock(void* tx_buf, size_t count)
 
 void SilabsSPI::transfer(void* tx_buf, void* rx_buf, size_t count, bool block)
 {
-  if (block) {
+  if (count > (size_t)DMA_MAX_TRANSFER_SIZE) {
+    SPISegment segment = { tx_buf, rx_buf, count };
+    this->transferSegments(&segment, 1u, block);
+  } else if (block) {
     this->_transfer_block(tx_buf, rx_buf, count);
   } else {
     this->_transfer_nonblock(tx_buf, rx_buf, count);
@@ -159,7 +307,7 @@ void SilabsSPI::_transfer_block(void* tx_buf, void* rx_buf, size_t count)
   while (bytes_transferred < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_transferred, count);
     // Transfer the data
-    SPIDRV_MTransferB(this->sl_spidrv_handle, tx_buf, rx_buf, current_transfer_size);
+    SPIDRV_MTransferB(this->sl_spidrv_handle, (uint8_t*)tx_buf + bytes_transferred, (uint8_t*)rx_buf + bytes_transferred, current_transfer_size);
     // Add the transferred amount to the total transferred bytes
     bytes_transferred += current_transfer_size;
   }
@@ -175,7 +323,7 @@ void SilabsSPI::_transfer_nonblock(void* tx_buf, void* rx_buf, size_t count)
   while (bytes_transferred < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_transferred, count);
     // Transfer the data
-    SPIDRV_MTransfer(this->sl_spidrv_handle, tx_buf, rx_buf, current_transfer_size, this->dma_transfer_finished_callback);
+    SPIDRV_MTransfer(this->sl_spidrv_handle, (uint8_t*)tx_buf + bytes_transferred, (uint8_t*)rx_buf + bytes_transferred, current_transfer_size, this->dma_transfer_finished_callback);
     // Try to take the mutex again - current task will be blocked here until the transfer finishes
     // The dma_transfer_finished_callback will give the mutex back and the next chunk transfer will start then
     xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
@@ -198,7 +346,10 @@ uint16_t SilabsSPI::receive16()
 
 void SilabsSPI::receive(void* rx_buf, size_t count, bool block)
 {
-  if (block) {
+  if (count > (size_t)DMA_MAX_TRANSFER_SIZE) {
+    SPISegment segment = { nullptr, rx_buf, count };
+    this->transferSegments(&segment, 1u, block);
+  } else if (block) {
     this->_receive_block(rx_buf, count);
   } else {
     this->_receive_nonblock(rx_buf, count);
@@ -212,7 +363,7 @@ void SilabsSPI::_receive_block(void* rx_buf, size_t count)
   while (bytes_received < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_received, count);
     // Receive the data
-    SPIDRV_MReceiveB(this->sl_spidrv_handle, rx_buf, current_transfer_size);
+    SPIDRV_MReceiveB(this->sl_spidrv_handle, (uint8_t*)rx_buf + bytes_received, current_transfer_size);
     // Add the transferred amount to the total transferred bytes
     bytes_received += current_transfer_size;
   }
@@ -228,7 +379,7 @@ void SilabsSPI::_receive_nonblock(void* rx_buf, size_t count)
   while (bytes_received < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_received, count);
     // Receive the data
-    SPIDRV_MReceive(this->sl_spidrv_handle, rx_buf, current_transfer_size, this->dma_transfer_finished_callback);
+    SPIDRV_MReceive(this->sl_spidrv_handle, (uint8_t*)rx_buf + bytes_received, current_transfer_size, this->dma_transfer_finished_callback);
     // Try to take the mutex again - current task will be blocked here until the transfer finishes
     // The dma_transfer_finished_callback will give the mutex back and the next chunk transfer will start then
     xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
@@ -239,9 +390,154 @@ void SilabsSPI::_receive_nonblock(void* rx_buf, size_t count)
   xSemaphoreGive(this->spi_transfer_mutex);
 }
 
+void SilabsSPI::transferSegments(const SPISegment* segments, size_t segment_count, bool block)
+{
+  size_t segment_index = 0u;
+  size_t segment_offset = 0u;
+
+  if (!block) {
+    // Take the transfer mutex
+    xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
+  }
+  // Send the list in streams of up to SG_MAX_DESCRIPTORS linked descriptors
+  while (true) {
+    size_t descriptor_count = this->sg_build(segments, segment_count, segment_index, segment_offset);
+    if (descriptor_count == 0u) {
+      break;
+    }
+    this->sg_run(descriptor_count, block);
+  }
+  if (!block) {
+    // Give back the transfer mutex
+    xSemaphoreGive(this->spi_transfer_mutex);
+  }
+}
+
+volatile uint32_t* SilabsSPI::tx_data_register()
+{
+#if defined(EUSART_PRESENT)
+  if (this->spi_eusart) {
+    return &this->spi_eusart->TXDATA;
+  }
+#endif // EUSART_PRESENT
+  return &this->spi_usart->TXDATA;
+}
+
+const volatile uint32_t* SilabsSPI::rx_data_register()
+{
+#if defined(EUSART_PRESENT)
+  if (this->spi_eusart) {
+    return &this->spi_eusart->RXDATA;
+  }
+#endif // EUSART_PRESENT
+  return &this->spi_usart->RXDATA;
+}
+
+size_t SilabsSPI::sg_build(const SPISegment* segments, size_t segment_count, size_t& segment_index, size_t& segment_offset)
+{
+  volatile uint32_t* tx_data_reg = this->tx_data_register();
+  const volatile uint32_t* rx_data_reg = this->rx_data_register();
+
+  size_t descriptor_count = 0u;
+  while (descriptor_count < SG_MAX_DESCRIPTORS && segment_index < segment_count) {
+    const SPISegment& segment = segments[segment_index];
+    if (segment_offset >= segment.len) {
+      segment_index++;
+      segment_offset = 0u;
+      continue;
+    }
+    size_t len = segment.len - segment_offset;
+    if (len > (size_t)DMA_MAX_TRANSFER_SIZE) {
+      len = DMA_MAX_TRANSFER_SIZE;
+    }
+
+    // Missing buffers are replaced by a dummy word which the DMA doesn't step through
+    const void* tx = segment.tx ? (const uint8_t*)segment.tx + segment_offset : (const void*)&this->sg_dummy_tx;
+    void* rx = segment.rx ? (uint8_t*)segment.rx + segment_offset : (void*)&this->sg_dummy_rx;
+    LDMA_Descriptor_t tx_desc = LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(tx, tx_data_reg, len, 1);
+    LDMA_Descriptor_t rx_desc = LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(rx_data_reg, rx, len, 1);
+    if (!segment.tx) {
+      tx_desc.xfer.srcInc = ldmaCtrlSrcIncNone;
+    }
+    if (!segment.rx) {
+      rx_desc.xfer.dstInc = ldmaCtrlDstIncNone;
+    }
+    // Only the end of the stream raises an interrupt
+    tx_desc.xfer.doneIfs = 0;
+    rx_desc.xfer.doneIfs = 0;
+    this->sg_tx_desc[descriptor_count] = tx_desc;
+    this->sg_rx_desc[descriptor_count] = rx_desc;
+    descriptor_count++;
+    segment_offset += len;
+  }
+  return descriptor_count;
+}
+
+void SilabsSPI::sg_run(size_t descriptor_count, bool block)
+{
+  // Terminate the lists at the last descriptor
+  this->sg_tx_desc[descriptor_count - 1u].xfer.link = 0;
+  this->sg_rx_desc[descriptor_count - 1u].xfer.link = 0;
+  this->sg_rx_desc[descriptor_count - 1u].xfer.doneIfs = 1;
+
+  // Drop any stale received data so the receive stream stays aligned with the transmit stream
+#if defined(EUSART_PRESENT)
+  if (this->spi_eusart) {
+    while (this->spi_eusart->STATUS & EUSART_STATUS_RXFL) {
+      (void)this->spi_eusart->RXDATA;
+    }
+  } else {
+    this->spi_usart->CMD = USART_CMD_CLEARRX;
+  }
+#else
+  this->spi_usart->CMD = USART_CMD_CLEARRX;
+#endif // EUSART_PRESENT
+
+  LDMA_TransferCfg_t tx_cfg = LDMA_TRANSFER_CFG_PERIPHERAL((LDMA_PeripheralSignal_t)this->sl_spidrv_handle->txDMASignal);
+  LDMA_TransferCfg_t rx_cfg = LDMA_TRANSFER_CFG_PERIPHERAL((LDMA_PeripheralSignal_t)this->sl_spidrv_handle->rxDMASignal);
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  // Require at least EM1 to keep the DMA and the peripheral running
+  sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+
+  this->sg_blocking = block;
+  this->sg_dma_active = true;
+  // Start the receiving side first so no incoming byte is missed
+  DMADRV_LdmaStartTransfer((int)this->sl_spidrv_handle->rxDMACh, &rx_cfg, this->sg_rx_desc, SilabsSPI::sg_dma_complete, this);
+  DMADRV_LdmaStartTransfer((int)this->sl_spidrv_handle->txDMACh, &tx_cfg, this->sg_tx_desc, nullptr, nullptr);
+
+  if (block) {
+    while (this->sg_dma_active) ;
+  } else {
+    // Try to take the mutex again - current task will be blocked here until the stream finishes
+    // The sg_dma_complete callback will give the mutex back
+    xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
+  }
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+}
+
+bool SilabsSPI::sg_dma_complete(unsigned int channel, unsigned int sequence_no, void* user_param)
+{
+  (void)channel;
+  (void)sequence_no;
+  SilabsSPI* spi = static_cast<SilabsSPI*>(user_param);
+  spi->sg_dma_active = false;
+  if (!spi->sg_blocking) {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(spi->spi_transfer_mutex, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
+  return true;
+}
+
 void SilabsSPI::endTransaction(void)
 {
-  xSemaphoreGive(this->spi_busy_mutex);
+  this->transaction_owner = nullptr;
+  xSemaphoreGive(this->spi_busy_sem);
 }
 
 void SilabsSPI::end(void)
@@ -321,13 +617,196 @@ size_t SilabsSPI::get_next_dma_transfer_size(size_t transferred, size_t total)
 void SilabsSPI::dma_transfer_finished_cb(struct SPIDRV_HandleData *handle, Ecode_t transferStatus, int itemsTransferred)
 {
   (void)handle;
-  (void)transferStatus;
   (void)itemsTransferred;
+  // Transfers of the queue are chained right from the interrupt - the queue task holds the transfer mutex
+  if (this->queue_dma_active) {
+    this->queue_dma_active = false;
+    this->queue.transferComplete((int32_t)transferStatus);
+    return;
+  }
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
   xSemaphoreGiveFromISR(this->spi_transfer_mutex, &xHigherPriorityTaskWoken);
   portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
+bool SilabsSPI::queueTransaction(SPIJob& job)
+{
+  if (!this->initialized) {
+    return false;
+  }
+  if (!this->queue_task_handle) {
+    xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
+    if (!this->queue_task_handle) {
+      xTaskCreate(SilabsSPI::queue_task,
+                  "spi_queue_task",
+                  queue_task_stack_size / sizeof(StackType_t),
+                  this,
+                  queue_task_priority,
+                  &this->queue_task_handle);
+    }
+    xSemaphoreGive(this->spi_transfer_mutex);
+    if (!this->queue_task_handle) {
+      return false;
+    }
+  }
+  if (!this->queue.submit(&job)) {
+    return false;
+  }
+  xTaskNotifyGive(this->queue_task_handle);
+  return true;
+}
+
+bool SilabsSPI::waitForTransaction(SPIJob& job, uint32_t timeout_ms)
+{
+  TickType_t timeout_ticks = portMAX_DELAY;
+  if (timeout_ms != 0xFFFFFFFFu) {
+    timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+  }
+  TickType_t start = xTaskGetTickCount();
+  job.waiter = xTaskGetCurrentTaskHandle();
+  while (job.state == spi_queue::JOB_QUEUED || job.state == spi_queue::JOB_ACTIVE) {
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    if (timeout_ticks != portMAX_DELAY && elapsed >= timeout_ticks) {
+      job.waiter = nullptr;
+      return false;
+    }
+    (void)ulTaskNotifyTake(pdTRUE, (timeout_ticks == portMAX_DELAY) ? portMAX_DELAY : timeout_ticks - elapsed);
+  }
+  job.waiter = nullptr;
+  return job.state == spi_queue::JOB_DONE;
+}
+
+bool SilabsSPI::cancelTransaction(SPIJob& job)
+{
+  return this->queue.cancel(&job);
+}
+
+void SilabsSPI::queue_task(void* p_arg)
+{
+  SilabsSPI* spi = static_cast<SilabsSPI*>(p_arg);
+  while (1) {
+    spi->queue_service();
+  }
+}
+
+// Holds the bus while the queue has jobs - the jobs themselves are chained from the DMA interrupt,
+// the task only steps in to set up a device seen for the first time
+void SilabsSPI::queue_service()
+{
+  (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  xSemaphoreTake(this->spi_busy_sem, portMAX_DELAY);
+  this->transaction_owner = xTaskGetCurrentTaskHandle();
+  // Transfers outside of a transaction only take the transfer mutex - it's held until the queue's
+  // last DMA transfer has completed, so they can't start on the bus in between the queued jobs
+  xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
+  while (true) {
+    spi_queue::Job* setup_job = nullptr;
+    uint8_t res = this->queue.run(&setup_job);
+    if (res == spi_queue::RUN_EMPTY) {
+      break;
+    }
+    if (res == spi_queue::RUN_SETUP) {
+      SPIDevice* device = static_cast<SPIDevice*>(setup_job->device);
+      this->apply_settings(device->settings);
+      this->save_device_config(*device);
+      this->current_device = device;
+      continue;
+    }
+    // Sleep until the engine stops
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  xSemaphoreGive(this->spi_transfer_mutex);
+  this->transaction_owner = nullptr;
+  xSemaphoreGive(this->spi_busy_sem);
+}
+
+SilabsSPI::QueuePort::QueuePort(SilabsSPI& spi) :
+  spi(spi)
+{
+  ;
+}
+
+bool SilabsSPI::QueuePort::select(spi_queue::Job* job)
+{
+  SPIDevice* device = static_cast<SPIDevice*>(job->device);
+  if (device && this->spi.current_device != device) {
+    if (!device->config_saved) {
+      return false;
+    }
+    this->spi.restore_device_config(*device);
+    this->spi.current_device = device;
+  }
+  if (device && device->cs_pin != PIN_NAME_NC) {
+    GPIO_PinOutClear(device->cs_port, device->cs_pin_num);
+  }
+  return true;
+}
+
+void SilabsSPI::QueuePort::deselect(spi_queue::Job* job)
+{
+  SPIDevice* device = static_cast<SPIDevice*>(job->device);
+  if (device && device->cs_pin != PIN_NAME_NC) {
+    GPIO_PinOutSet(device->cs_port, device->cs_pin_num);
+  }
+}
+
+int32_t SilabsSPI::QueuePort::startTransfer(const void* tx, void* rx, size_t len)
+{
+  Ecode_t res;
+  this->spi.queue_dma_active = true;
+  if (tx && rx) {
+    res = SPIDRV_MTransfer(this->spi.sl_spidrv_handle, tx, rx, (int)len, this->spi.dma_transfer_finished_callback);
+  } else if (tx) {
+    res = SPIDRV_MTransmit(this->spi.sl_spidrv_handle, tx, (int)len, this->spi.dma_transfer_finished_callback);
+  } else if (rx) {
+    res = SPIDRV_MReceive(this->spi.sl_spidrv_handle, rx, (int)len, this->spi.dma_transfer_finished_callback);
+  } else {
+    res = ECODE_EMDRV_SPIDRV_PARAM_ERROR;
+  }
+  if (res != ECODE_EMDRV_SPIDRV_OK) {
+    this->spi.queue_dma_active = false;
+  }
+  return (int32_t)res;
+}
+
+size_t SilabsSPI::QueuePort::maxTransferSize()
+{
+  return SilabsSPI::DMA_MAX_TRANSFER_SIZE;
+}
+
+void SilabsSPI::QueuePort::jobComplete(spi_queue::Job* job)
+{
+  TaskHandle_t waiter = (TaskHandle_t)job->waiter;
+  if (!waiter) {
+    return;
+  }
+  if (xPortIsInsideInterrupt()) {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(waiter, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  } else {
+    xTaskNotifyGive(waiter);
+  }
+}
+
+// Only called from the DMA interrupt - run() reports stopping to the queue task directly
+void SilabsSPI::QueuePort::stopped()
+{
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(this->spi.queue_task_handle, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+uint32_t SilabsSPI::QueuePort::lock()
+{
+  return (uint32_t)taskENTER_CRITICAL_FROM_ISR();
+}
+
+void SilabsSPI::QueuePort::unlock(uint32_t state)
+{
+  taskEXIT_CRITICAL_FROM_ISR((UBaseType_t)state);
+}
+
 void SilabsSPI::usingInterrupt(int interruptNumber)
 {
   (void)interruptNumber;
@@ -344,6 +823,424 @@ void spi0_dma_transfer_finished_callback(struct SPIDRV_HandleData *handle, Ecode
   SPI.dma_transfer_finished_cb(handle, transferStatus, itemsTransferred);
 }
 
+SPIDevice::SPIDevice(SilabsSPI& spi, pin_size_t cs_pin, SPISettings settings) :
+  spi(spi),
+  settings(settings),
+  cs_pin(pinToPinName(cs_pin)),
+  cs_port(gpioPortA),
+  cs_pin_num(0u),
+  config_saved(false),
+  ctrl_reg(0u),
+  clock_reg(0u)
+{
+  if (this->cs_pin != PIN_NAME_NC) {
+    this->cs_port = getSilabsPortFromArduinoPin(this->cs_pin);
+    this->cs_pin_num = (uint8_t)getSilabsPinFromArduinoPin(this->cs_pin);
+  }
+}
+
+void SPIDevice::begin()
+{
+  if (this->cs_pin == PIN_NAME_NC) {
+    return;
+  }
+  GPIO_PinModeSet(this->cs_port, this->cs_pin_num, gpioModePushPull, 1u);
+}
+
+void SPIDevice::beginTransaction()
+{
+  this->spi.beginTransaction(*this);
+}
+
+void SPIDevice::endTransaction()
+{
+  this->spi.endTransaction(*this);
+}
+
+SPIFollower::SPIFollower(SilabsSPI& spi) :
+  spi(spi),
+  leader_config(),
+  leader_initialized(false),
+  running(false),
+  cs_pin(PIN_NAME_NC),
+  cs_port(gpioPortA),
+  cs_pin_num(0u),
+  cs_int_no(INTERRUPT_UNAVAILABLE),
+  rx_ring(nullptr),
+  rx_ring_size(0u),
+  rx_last_head(0u),
+  rx_wraps(0u),
+  rx_count(0u),
+  read_count(0u),
+  rx_overflow(false),
+  tx_buf(nullptr),
+  tx_len(0u),
+  tx_fill(0xFFFFFFFFu),
+  registers(nullptr),
+  register_count(0u),
+  register_address(0u),
+  callback(nullptr),
+  drain_pending(false)
+{
+  ;
+}
+
+bool SPIFollower::begin(pin_size_t cs_pin, uint8_t* rx_ring, size_t rx_ring_size, uint8_t data_mode, uint8_t bit_order)
+{
+  if (this->running || !rx_ring || rx_ring_size == 0u
+      || rx_ring_size > RX_MAX_DESCRIPTORS * (size_t)SilabsSPI::DMA_MAX_TRANSFER_SIZE) {
+    return false;
+  }
+  PinName cs_pin_name = pinToPinName(cs_pin);
+  if (cs_pin_name == PIN_NAME_NC) {
+    return false;
+  }
+
+  // The follower holds the bus until end() - released from whichever task calls it
+  xSemaphoreTake(this->spi.spi_busy_sem, portMAX_DELAY);
+
+  this->cs_pin = cs_pin_name;
+  this->cs_port = getSilabsPortFromArduinoPin(cs_pin_name);
+  this->cs_pin_num = (uint8_t)getSilabsPinFromArduinoPin(cs_pin_name);
+  this->rx_ring = rx_ring;
+  this->rx_ring_size = rx_ring_size;
+  this->rx_last_head = 0u;
+  this->rx_wraps = 0u;
+  this->rx_count = 0u;
+  this->read_count = 0u;
+  this->rx_overflow = false;
+
+  // Reinit the driver as a follower with the chip select routed to the peripheral
+  SPIDRV_Init_t* config = this->spi.sl_spidrv_config;
+  this->leader_config = *config;
+  this->leader_initialized = this->spi.initialized;
+  if (this->spi.initialized) {
+    SPIDRV_DeInit(this->spi.sl_spidrv_handle);
+  }
+  config->type = spidrvSlave;
+  config->csControl = spidrvCsControlAuto;
+  config->slaveStartMode = spidrvSlaveStartImmediate;
+  config->portCs = this->cs_port;
+  config->pinCs = this->cs_pin_num;
+  this->spi.setBitOrder(bit_order);
+  this->spi.setDataMode(data_mode);
+  if (SPIDRV_Init(this->spi.sl_spidrv_handle, config) != ECODE_EMDRV_SPIDRV_OK) {
+    *config = this->leader_config;
+    if (this->leader_initialized) {
+      SPIDRV_Init(this->spi.sl_spidrv_handle, config);
+    }
+    xSemaphoreGive(this->spi.spi_busy_sem);
+    return false;
+  }
+  this->spi.current_device = nullptr;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  // Require at least EM1 to keep the DMA and the peripheral running
+  sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+  this->running = true;
+
+  // Fill the RX ring endlessly - the last descriptor links back to the first one
+  const volatile uint32_t* rx_data_reg = this->spi.rx_data_register();
+  size_t descriptor_count = 0u;
+  for (size_t offset = 0u; offset < rx_ring_size; descriptor_count++) {
+    size_t len = rx_ring_size - offset;
+    if (len > (size_t)SilabsSPI::DMA_MAX_TRANSFER_SIZE) {
+      len = SilabsSPI::DMA_MAX_TRANSFER_SIZE;
+    }
+    LDMA_Descriptor_t desc = LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(rx_data_reg, rx_ring + offset, len, 1);
+    desc.xfer.doneIfs = 0;
+    this->rx_desc[descriptor_count] = desc;
+    offset += len;
+  }
+  this->rx_desc[descriptor_count - 1u].xfer.linkAddr = -(int32_t)(descriptor_count - 1u) * LDMA_DESCRIPTOR_NON_EXTEND_SIZE_WORD;
+  // The wraps are counted so that a transaction filling the whole ring isn't mistaken for an empty one
+  this->rx_desc[descriptor_count - 1u].xfer.doneIfs = 1;
+  LDMA_TransferCfg_t rx_cfg = LDMA_TRANSFER_CFG_PERIPHERAL((LDMA_PeripheralSignal_t)this->spi.sl_spidrv_handle->rxDMASignal);
+  DMADRV_LdmaStartTransfer((int)this->spi.sl_spidrv_handle->rxDMACh, &rx_cfg, this->rx_desc, SPIFollower::rx_wrap_handler, this);
+  this->start_tx();
+
+  // Transactions end on the rising edge of the chip select
+  this->cs_int_no = GPIOINT_CallbackRegisterExt(this->cs_pin_num, SPIFollower::cs_irq_handler, this);
+  if (this->cs_int_no == INTERRUPT_UNAVAILABLE) {
+    this->end();
+    return false;
+  }
+  GPIO_ExtIntConfig(this->cs_port, this->cs_pin_num, this->cs_int_no, true, false, true);
+  return true;
+}
+
+void SPIFollower::end()
+{
+  if (!this->running) {
+    return;
+  }
+  if (this->cs_int_no != INTERRUPT_UNAVAILABLE) {
+    GPIO_ExtIntConfig(this->cs_port, this->cs_pin_num, this->cs_int_no, false, false, false);
+    GPIOINT_CallbackUnRegister(this->cs_int_no);
+    this->cs_int_no = INTERRUPT_UNAVAILABLE;
+  }
+  (void)sl_sleeptimer_stop_timer(&this->drain_timer);
+  this->drain_pending = false;
+  DMADRV_StopTransfer(this->spi.sl_spidrv_handle->rxDMACh);
+  DMADRV_StopTransfer(this->spi.sl_spidrv_handle->txDMACh);
+  SPIDRV_DeInit(this->spi.sl_spidrv_handle);
+
+  // Go back to the leader configuration
+  *this->spi.sl_spidrv_config = this->leader_config;
+  if (this->leader_initialized) {
+    SPIDRV_Init(this->spi.sl_spidrv_handle, this->spi.sl_spidrv_config);
+  }
+  this->spi.initialized = this->leader_initialized;
+  this->spi.current_device = nullptr;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+  this->running = false;
+  xSemaphoreGive(this->spi.spi_busy_sem);
+}
+
+void SPIFollower::setTxBuffer(const uint8_t* tx_buf, size_t len)
+{
+  const size_t max_len = (TX_MAX_DESCRIPTORS - 1u) * (size_t)SilabsSPI::DMA_MAX_TRANSFER_SIZE;
+  taskENTER_CRITICAL();
+  this->tx_buf = tx_buf;
+  this->tx_len = (len > max_len) ? max_len : len;
+  // Reload the data right away if the leader isn't in a transaction
+  if (this->running && !this->registers && GPIO_PinInGet(this->cs_port, this->cs_pin_num)) {
+    this->start_tx();
+  }
+  taskEXIT_CRITICAL();
+}
+
+void SPIFollower::onTransaction(transaction_callback_t callback)
+{
+  this->callback = callback;
+}
+
+void SPIFollower::enableRegisters(uint8_t* registers, size_t size)
+{
+  taskENTER_CRITICAL();
+  this->registers = registers;
+  this->register_count = (size > REGISTERS_MAX_SIZE) ? REGISTERS_MAX_SIZE : size;
+  this->register_address = 0u;
+  if (this->running && GPIO_PinInGet(this->cs_port, this->cs_pin_num)) {
+    this->start_tx();
+  }
+  taskEXIT_CRITICAL();
+}
+
+size_t SPIFollower::available()
+{
+  taskENTER_CRITICAL();
+  size_t len = this->rx_count - this->read_count;
+  taskEXIT_CRITICAL();
+  return len;
+}
+
+size_t SPIFollower::read(uint8_t* buf, size_t len)
+{
+  taskENTER_CRITICAL();
+  size_t read_count = this->read_count;
+  size_t available = this->rx_count - read_count;
+  taskEXIT_CRITICAL();
+
+  if (len > available) {
+    len = available;
+  }
+  size_t pos = read_count % this->rx_ring_size;
+  for (size_t i = 0u; i < len; i++) {
+    buf[i] = this->rx_ring[pos];
+    pos++;
+    if (pos == this->rx_ring_size) {
+      pos = 0u;
+    }
+  }
+
+  taskENTER_CRITICAL();
+  // Don't move backwards if the ring overflowed meanwhile
+  if (this->read_count == read_count) {
+    this->read_count = read_count + len;
+  }
+  taskEXIT_CRITICAL();
+  return len;
+}
+
+bool SPIFollower::overflowed()
+{
+  bool overflow = this->rx_overflow;
+  this->rx_overflow = false;
+  return overflow;
+}
+
+void SPIFollower::cs_irq_handler(uint8_t int_no, void* ctx)
+{
+  (void)int_no;
+  static_cast<SPIFollower*>(ctx)->transaction_end();
+}
+
+bool SPIFollower::rx_wrap_handler(unsigned int channel, unsigned int sequence_no, void* user_param)
+{
+  (void)channel;
+  (void)sequence_no;
+  SPIFollower* follower = static_cast<SPIFollower*>(user_param);
+  UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+  follower->rx_wraps++;
+  taskEXIT_CRITICAL_FROM_ISR(state);
+  return true;
+}
+
+void SPIFollower::drain_timer_handler(sl_sleeptimer_timer_handle_t* handle, void* data)
+{
+  (void)handle;
+  SPIFollower* follower = static_cast<SPIFollower*>(data);
+  follower->transaction_complete();
+  follower->drain_pending = false;
+}
+
+bool SPIFollower::rx_fifo_empty()
+{
+#if defined(EUSART_PRESENT)
+  if (this->spi.spi_eusart) {
+    return !(this->spi.spi_eusart->STATUS & EUSART_STATUS_RXFL);
+  }
+#endif // EUSART_PRESENT
+  return !(this->spi.spi_usart->STATUS & USART_STATUS_RXDATAV);
+}
+
+void SPIFollower::transaction_end()
+{
+  // A transaction ending while the drain timer runs is picked up by the timer as well
+  if (this->drain_pending) {
+    return;
+  }
+  // The DMA moves the last bytes out of the receive FIFO right after the clock stops - if some are still there
+  // the transaction is completed from a timer interrupt one tick later instead of waiting for them here
+  if (!this->rx_fifo_empty()) {
+    this->drain_pending = true;
+    if (sl_sleeptimer_start_timer(&this->drain_timer, 1u, SPIFollower::drain_timer_handler, this, 0u, 0u) == SL_STATUS_OK) {
+      return;
+    }
+    this->drain_pending = false;
+  }
+  this->transaction_complete();
+}
+
+// Called from interrupt context
+void SPIFollower::transaction_complete()
+{
+  UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+  // Count a wrap whose DMA interrupt is still pending here - clearing the flag keeps it from being counted twice
+  uint32_t rx_channel_mask = 1u << this->spi.sl_spidrv_handle->rxDMACh;
+  if (LDMA->IF & rx_channel_mask) {
+    LDMA->IF_CLR = rx_channel_mask;
+    this->rx_wraps++;
+  }
+  size_t wraps = this->rx_wraps;
+  this->rx_wraps = 0u;
+  size_t head = this->rx_head();
+  taskEXIT_CRITICAL_FROM_ISR(state);
+
+  size_t start = this->rx_last_head;
+  size_t len = wraps * this->rx_ring_size + head - start;
+  this->rx_last_head = head;
+  this->rx_count += len;
+
+  if (this->registers) {
+    // Register traffic is consumed here, it isn't kept in the ring
+    if (len > 0u) {
+      this->handle_register_command(start, (len > this->rx_ring_size) ? this->rx_ring_size : len);
+    }
+    this->read_count = this->rx_count;
+  } else if (this->rx_count - this->read_count > this->rx_ring_size) {
+    // Drop the oldest data
+    this->read_count = this->rx_count - this->rx_ring_size;
+    this->rx_overflow = true;
+  }
+
+  // Preload the data for the next transaction
+  this->start_tx();
+  if (this->callback) {
+    this->callback(len);
+  }
+}
+
+void SPIFollower::start_tx()
+{
+  SPIDRV_Handle_t handle = this->spi.sl_spidrv_handle;
+  DMADRV_StopTransfer(handle->txDMACh);
+  // Drop the data already loaded into the peripheral for the previous transaction
+#if defined(EUSART_PRESENT)
+  if (this->spi.spi_eusart) {
+    this->spi.spi_eusart->CMD = EUSART_CMD_CLEARTX;
+  } else {
+    this->spi.spi_usart->CMD = USART_CMD_CLEARTX;
+  }
+#else
+  this->spi.spi_usart->CMD = USART_CMD_CLEARTX;
+#endif // EUSART_PRESENT
+
+  const uint8_t* data = this->tx_buf;
+  size_t data_len = this->tx_len;
+  if (this->registers) {
+    data = this->registers + this->register_address;
+    data_len = this->register_count - this->register_address;
+  }
+  if (!data) {
+    data_len = 0u;
+  }
+
+  volatile uint32_t* tx_data_reg = this->spi.tx_data_register();
+  size_t descriptor_count = 0u;
+  for (size_t offset = 0u; offset < data_len && descriptor_count < TX_MAX_DESCRIPTORS - 1u; descriptor_count++) {
+    size_t len = data_len - offset;
+    if (len > (size_t)SilabsSPI::DMA_MAX_TRANSFER_SIZE) {
+      len = SilabsSPI::DMA_MAX_TRANSFER_SIZE;
+    }
+    LDMA_Descriptor_t desc = LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(data + offset, tx_data_reg, len, 1);
+    desc.xfer.doneIfs = 0;
+    this->tx_desc[descriptor_count] = desc;
+    offset += len;
+  }
+  // Keep sending the fill byte once the data runs out - the last descriptor links to itself
+  LDMA_Descriptor_t fill = LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(&this->tx_fill, tx_data_reg, SilabsSPI::DMA_MAX_TRANSFER_SIZE, 0);
+  fill.xfer.srcInc = ldmaCtrlSrcIncNone;
+  fill.xfer.doneIfs = 0;
+  this->tx_desc[descriptor_count] = fill;
+
+  LDMA_TransferCfg_t tx_cfg = LDMA_TRANSFER_CFG_PERIPHERAL((LDMA_PeripheralSignal_t)handle->txDMASignal);
+  DMADRV_LdmaStartTransfer((int)handle->txDMACh, &tx_cfg, this->tx_desc, nullptr, nullptr);
+}
+
+size_t SPIFollower::rx_head()
+{
+  // The current destination address of the receive channel is the write position in the ring
+  size_t head = (size_t)(LDMA->CH[this->spi.sl_spidrv_handle->rxDMACh].DST - (uintptr_t)this->rx_ring);
+  if (head >= this->rx_ring_size) {
+    head -= this->rx_ring_size;
+  }
+  return head;
+}
+
+void SPIFollower::handle_register_command(size_t start, size_t len)
+{
+  uint8_t command = this->rx_ring[start];
+  uint8_t address = command & 0x7Fu;
+  if (command & 0x80u) {
+    // Write the rest of the transaction to the registers
+    size_t pos = start;
+    for (size_t i = 1u; i < len && (size_t)address + i - 1u < this->register_count; i++) {
+      pos++;
+      if (pos == this->rx_ring_size) {
+        pos = 0u;
+      }
+      this->registers[address + i - 1u] = this->rx_ring[pos];
+    }
+  }
+  this->register_address = ((size_t)address < this->register_count) ? address : (uint8_t)this->register_count;
+}
+
 arduino::SilabsSPI SPI(SL_SPIDRV_PERIPHERAL_HANDLE, &sl_spidrv_config, spi0_dma_transfer_finished_callback);
 
 #if (NUM_HW_SPI > 1)
@@ -36,8 +36,18 @@
 #include "spidrv.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+#include "sl_sleeptimer.h"
+#include "spi_queue.h"
 
 namespace arduino {
+class SPIDevice;
+class SPIFollower;
+
+// A queued SPI transaction - 'device' points to the SPIDevice to select, see spi_queue.h
+typedef spi_queue::Job SPIJob;
+typedef spi_queue::Segment SPISegment;
+
 class SilabsSPI : public SPIClass
 {
 public:
@@ -47,12 +57,91 @@ public:
   virtual uint16_t transfer16(uint16_t data);
   virtual void transfer(void *buf, size_t count);
 
+  /***************************************************************************//**
+   * Transfers 32 bits on the SPI bus as four back-to-back 8-bit frames.
+   * The bit order set in beginTransaction() applies to the whole word.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] data the word to be transferred
+   *
+   * @return the word received on the SPI bus
+   ******************************************************************************/
+  uint32_t transfer32(uint32_t data);
+
+  /***************************************************************************//**
+   * Transfers a byte by polling the peripheral's TX/RX flags directly.
+   * Takes no locks - only call it between beginTransaction() and endTransaction().
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] data the byte to be transferred
+   *
+   * @return the byte received on the SPI bus
+   ******************************************************************************/
+  inline uint8_t transferFast(uint8_t data)
+  {
+    return this->transfer_frame(data);
+  }
+
   // Transaction Functions
   virtual void usingInterrupt(int interruptNumber);
   virtual void notUsingInterrupt(int interruptNumber);
   virtual void beginTransaction(SPISettings settings);
   virtual void endTransaction(void);
 
+  /***************************************************************************//**
+   * Starts a transaction with an attached device and asserts its chip select.
+   * The first transaction configures the peripheral through the driver and
+   * stores the resulting register values in the device - switching back to it
+   * later only rewrites those few registers.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] device the device to talk to
+   ******************************************************************************/
+  void beginTransaction(SPIDevice& device);
+
+  /***************************************************************************//**
+   * Releases the chip select of the device and ends the transaction.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] device the device of the current transaction
+   ******************************************************************************/
+  void endTransaction(SPIDevice& device);
+
+  /***************************************************************************//**
+   * Queues a transaction to be run in the background.
+   * Queued jobs run back-to-back with DMA - each one selects its SPIDevice,
+   * transfers its segments and releases the chip select. Jobs with a higher
+   * priority are started first. The job's callback is called from interrupt
+   * context when it completes. The bus is held by the queue while it has jobs.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] job the job to queue - it must stay valid until it completes
+   *
+   * @return true if the job was queued
+   ******************************************************************************/
+  bool queueTransaction(SPIJob& job);
+
+  /***************************************************************************//**
+   * Blocks the calling task until a queued job completes.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] job the job to wait for
+   * @param[in] timeout_ms the maximum time to wait in milliseconds
+   *
+   * @return true if the job completed successfully
+   ******************************************************************************/
+  bool waitForTransaction(SPIJob& job, uint32_t timeout_ms = 0xFFFFFFFFu);
+
+  /***************************************************************************//**
+   * Removes a job from the queue if it hasn't been started yet.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] job the job to remove
+   *
+   * @return true if the job was removed
+   ******************************************************************************/
+  bool cancelTransaction(SPIJob& job);
+
   // SPI Configuration methods
   virtual void attachInterrupt();
   virtual void detachInterrupt();
@@ -113,6 +202,22 @@ public:
    ******************************************************************************/
   void receive(void* rx_buf, size_t count, bool block = false);
 
+  /***************************************************************************//**
+   * Transfers a list of buffers as one continuous DMA stream.
+   * The segments are chained with linked LDMA descriptors, so up to 32 KB
+   * of data completes with a single interrupt - longer lists continue in
+   * further 32 KB streams.
+   * Segments without a tx buffer send 0xFF, segments without an rx buffer
+   * discard the received data.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] segments the buffers to transfer
+   * @param[in] segment_count the number of segments
+   * @param[in] block Sets whether the transfer should busy-wait for completion
+   *                  or the task should yield while the transfer is ongoing
+   ******************************************************************************/
+  void transferSegments(const SPISegment* segments, size_t segment_count, bool block = false);
+
   /***************************************************************************//**
    * Returns the actual clock speed of the SPI bus which can be different
    * than what the user requested. Silabs specific API.
@@ -143,6 +248,76 @@ public:
   void setClockDivider(uint8_t clockDiv);
 
 private:
+  friend class SPIFollower;
+
+  // Runs the queued jobs on the SPIDRV instance of the bus
+  class QueuePort : public spi_queue::Port {
+  public:
+    explicit QueuePort(SilabsSPI& spi);
+    bool select(spi_queue::Job* job);
+    void deselect(spi_queue::Job* job);
+    int32_t startTransfer(const void* tx, void* rx, size_t len);
+    size_t maxTransferSize();
+    void jobComplete(spi_queue::Job* job);
+    void stopped();
+    uint32_t lock();
+    void unlock(uint32_t state);
+  private:
+    SilabsSPI& spi;
+  };
+
+  static const uint32_t queue_task_stack_size = 1024u;
+  static const UBaseType_t queue_task_priority = 3u;
+  static void queue_task(void* p_arg);
+  void queue_service();
+
+  // The peripheral always runs with 8-bit frames - wider words are sent as back-to-back frames
+  inline uint8_t transfer_frame(uint8_t data)
+  {
+#if defined(EUSART_PRESENT)
+    if (this->spi_eusart) {
+      while (!(this->spi_eusart->STATUS & EUSART_STATUS_TXFL)) ;
+      this->spi_eusart->TXDATA = data;
+      while (!(this->spi_eusart->STATUS & EUSART_STATUS_RXFL)) ;
+      return (uint8_t)this->spi_eusart->RXDATA;
+    }
+#endif // EUSART_PRESENT
+    while (!(this->spi_usart->STATUS & USART_STATUS_TXBL)) ;
+    this->spi_usart->TXDATA = data;
+    while (!(this->spi_usart->STATUS & USART_STATUS_TXC)) ;
+    return (uint8_t)this->spi_usart->RXDATA;
+  }
+
+  // Sends 'first' and then 'second' without a gap - the byte received first is returned in bits 7:0
+  inline uint16_t transfer_frame_pair(uint8_t first, uint8_t second)
+  {
+#if defined(EUSART_PRESENT)
+    if (this->spi_eusart) {
+      // The second frame is queued in the FIFO while the first one is shifted out
+      while (!(this->spi_eusart->STATUS & EUSART_STATUS_TXFL)) ;
+      this->spi_eusart->TXDATA = first;
+      while (!(this->spi_eusart->STATUS & EUSART_STATUS_TXFL)) ;
+      this->spi_eusart->TXDATA = second;
+      while (!(this->spi_eusart->STATUS & EUSART_STATUS_RXFL)) ;
+      uint16_t rx_data = (uint16_t)(this->spi_eusart->RXDATA & 0xFFu);
+      while (!(this->spi_eusart->STATUS & EUSART_STATUS_RXFL)) ;
+      return rx_data | (uint16_t)((this->spi_eusart->RXDATA & 0xFFu) << 8);
+    }
+#endif // EUSART_PRESENT
+    // With 8-bit frames the double data registers of the USART hold two frames
+    while (!(this->spi_usart->STATUS & USART_STATUS_TXBL)) ;
+    this->spi_usart->TXDOUBLE = (uint32_t)first | ((uint32_t)second << _USART_TXDOUBLE_TXDATA1_SHIFT);
+    while (!(this->spi_usart->STATUS & USART_STATUS_TXC)) ;
+    uint32_t rx_double = this->spi_usart->RXDOUBLE;
+    return (uint16_t)((rx_double & _USART_RXDOUBLE_RXDATA0_MASK) | (((rx_double & _USART_RXDOUBLE_RXDATA1_MASK) >> _USART_RXDOUBLE_RXDATA1_SHIFT) << 8));
+  }
+
+  uint16_t transfer_word(uint16_t data);
+  bool in_transaction();
+  void apply_settings(SPISettings settings);
+  void save_device_config(SPIDevice& device);
+  void restore_device_config(const SPIDevice& device);
+
   void _transfer_block(void* tx_buf, size_t count);
   void _transfer_nonblock(void* tx_buf, size_t count);
 
@@ -155,6 +330,12 @@ private:
   static const int DMA_MAX_TRANSFER_SIZE = 2048;
   size_t get_next_dma_transfer_size(size_t transferred, size_t total);
 
+  volatile uint32_t* tx_data_register();
+  const volatile uint32_t* rx_data_register();
+  size_t sg_build(const SPISegment* segments, size_t segment_count, size_t& segment_index, size_t& segment_offset);
+  void sg_run(size_t descriptor_count, bool block);
+  static bool sg_dma_complete(unsigned int channel, unsigned int sequence_no, void* user_param);
+
   bool initialized;
   SPISettings settings = SPISettings(1000000, LSBFIRST, SPI_MODE0);
 
@@ -163,8 +344,212 @@ private:
   SPIDRV_Callback_t dma_transfer_finished_callback;
   SemaphoreHandle_t spi_transfer_mutex;
   StaticSemaphore_t spi_transfer_mutex_buf;
-  SemaphoreHandle_t spi_busy_mutex;
-  StaticSemaphore_t spi_busy_mutex_buf;
+  // Binary semaphore rather than a mutex - the follower holds the bus from begin() to end() which may be called from different tasks
+  SemaphoreHandle_t spi_busy_sem;
+  StaticSemaphore_t spi_busy_sem_buf;
+  // The task holding the bus between beginTransaction() and endTransaction()
+  volatile TaskHandle_t transaction_owner;
+
+  USART_TypeDef* spi_usart;
+#if defined(EUSART_PRESENT)
+  EUSART_TypeDef* spi_eusart;
+#endif // EUSART_PRESENT
+  // The device whose register values are currently loaded into the peripheral
+  SPIDevice* current_device;
+
+  QueuePort queue_port;
+  spi_queue::Engine queue;
+  TaskHandle_t queue_task_handle;
+  volatile bool queue_dma_active;
+
+  // Linked descriptor lists of the scatter-gather transfers - each descriptor moves up to DMA_MAX_TRANSFER_SIZE bytes
+  static const size_t SG_MAX_DESCRIPTORS = 16u;
+  LDMA_Descriptor_t sg_tx_desc[SG_MAX_DESCRIPTORS];
+  LDMA_Descriptor_t sg_rx_desc[SG_MAX_DESCRIPTORS];
+  uint32_t sg_dummy_tx;
+  uint32_t sg_dummy_rx;
+  bool sg_blocking;
+  volatile bool sg_dma_active;
+};
+
+class SPIDevice
+{
+public:
+  /***************************************************************************//**
+   * Constructor for SPIDevice - describes a device attached to an SPI bus
+   *
+   * @param[in] spi the SPI bus the device is attached to
+   * @param[in] cs_pin the chip select pin of the device - an invalid pin (e.g. 0xFF) if the application drives it
+   * @param[in] settings the clock speed, bit order and mode of the device
+   ******************************************************************************/
+  SPIDevice(SilabsSPI& spi, pin_size_t cs_pin, SPISettings settings);
+
+  /***************************************************************************//**
+   * Configures the chip select pin of the device as an inactive output
+   ******************************************************************************/
+  void begin();
+
+  /***************************************************************************//**
+   * Starts / ends a transaction with the device on its SPI bus
+   ******************************************************************************/
+  void beginTransaction();
+  void endTransaction();
+
+private:
+  friend class SilabsSPI;
+
+  SilabsSPI& spi;
+  SPISettings settings;
+  PinName cs_pin;
+  GPIO_Port_TypeDef cs_port;
+  uint8_t cs_pin_num;
+  // Register values captured after the first configuration - CFG0/CFG2 on EUSART, CTRL/CLKDIV on USART
+  bool config_saved;
+  uint32_t ctrl_reg;
+  uint32_t clock_reg;
+};
+
+class SPIFollower
+{
+public:
+  // Called from interrupt context when the leader releases the chip select - 'len' is the length of the transaction
+  typedef void (*transaction_callback_t)(size_t len);
+
+  /***************************************************************************//**
+   * Constructor for SPIFollower - runs an SPI bus in follower (slave) mode
+   *
+   * @param[in] spi the SPI bus to use - it can't be used as a leader while the follower runs
+   ******************************************************************************/
+  SPIFollower(SilabsSPI& spi);
+
+  /***************************************************************************//**
+   * Starts follower mode on the bus.
+   * The received data is written into the RX ring by DMA, the bytes of a
+   * transaction become available when the leader releases the chip select.
+   * The bus is held by the follower until end() is called.
+   *
+   * @param[in] cs_pin the chip select input driven by the leader
+   * @param[in] rx_ring the buffer for the received data
+   * @param[in] rx_ring_size the size of the RX ring - up to 8 KB
+   * @param[in] data_mode the SPI mode used by the leader
+   * @param[in] bit_order the bit order used by the leader
+   *
+   * @return true if the follower mode was started
+   ******************************************************************************/
+  bool begin(pin_size_t cs_pin, uint8_t* rx_ring, size_t rx_ring_size, uint8_t data_mode = SPI_MODE0, uint8_t bit_order = MSBFIRST);
+
+  /***************************************************************************//**
+   * Stops follower mode, restores the leader configuration and releases the bus
+   ******************************************************************************/
+  void end();
+
+  /***************************************************************************//**
+   * Sets the data clocked out to the leader.
+   * The buffer is sent from its start in every transaction, followed by 0xFF
+   * once it runs out. It takes effect at the start of the next transaction.
+   *
+   * @param[in] tx_buf the data to send - it must stay valid while it's in use
+   * @param[in] len the length of the data - up to 6 KB
+   ******************************************************************************/
+  void setTxBuffer(const uint8_t* tx_buf, size_t len);
+
+  /***************************************************************************//**
+   * Sets the callback called at the end of each transaction
+   *
+   * @param[in] callback the callback function, called from interrupt context
+   ******************************************************************************/
+  void onTransaction(transaction_callback_t callback);
+
+  /***************************************************************************//**
+   * Emulates a register file instead of passing the data through the RX ring.
+   * The first byte of each transaction is a command: bit 7 set writes the
+   * rest of the transaction to the registers from the address in bits 6..0,
+   * bit 7 cleared only sets the address. The next transaction clocks out the
+   * registers from the last address, so a read takes an address transaction
+   * followed by a data transaction - whose own first byte can already be the
+   * next command. The buffer set with setTxBuffer() isn't used in this mode.
+   *
+   * @param[in] registers the register file
+   * @param[in] size the number of registers - up to 128
+   ******************************************************************************/
+  void enableRegisters(uint8_t* registers, size_t size);
+
+  /***************************************************************************//**
+   * Returns the number of received bytes waiting in the RX ring
+   *
+   * @return the number of bytes available for reading
+   ******************************************************************************/
+  size_t available();
+
+  /***************************************************************************//**
+   * Reads received data from the RX ring
+   *
+   * @param[out] buf the buffer for the data
+   * @param[in] len the maximum number of bytes to read
+   *
+   * @return the number of bytes read
+   ******************************************************************************/
+  size_t read(uint8_t* buf, size_t len);
+
+  /***************************************************************************//**
+   * Returns whether received data was overwritten before it was read
+   * and clears the flag
+   *
+   * @return true if the RX ring overflowed
+   ******************************************************************************/
+  bool overflowed();
+
+private:
+  static void cs_irq_handler(uint8_t int_no, void* ctx);
+  static bool rx_wrap_handler(unsigned int channel, unsigned int sequence_no, void* user_param);
+  static void drain_timer_handler(sl_sleeptimer_timer_handle_t* handle, void* data);
+  void transaction_end();
+  void transaction_complete();
+  bool rx_fifo_empty();
+  void start_tx();
+  size_t rx_head();
+  void handle_register_command(size_t start, size_t len);
+
+  static const size_t RX_MAX_DESCRIPTORS = 4u;
+  static const size_t TX_MAX_DESCRIPTORS = 4u;
+  static const size_t REGISTERS_MAX_SIZE = 128u;
+
+  SilabsSPI& spi;
+  SPIDRV_Init_t leader_config;
+  bool leader_initialized;
+  bool running;
+  PinName cs_pin;
+  GPIO_Port_TypeDef cs_port;
+  uint8_t cs_pin_num;
+  unsigned int cs_int_no;
+
+  uint8_t* rx_ring;
+  size_t rx_ring_size;
+  // Position of the DMA in the ring at the end of the last transaction
+  size_t rx_last_head;
+  // Number of times the DMA wrapped around the ring since the last transaction ended
+  volatile size_t rx_wraps;
+  // Total number of bytes received and read - their difference is the amount of unread data
+  volatile size_t rx_count;
+  volatile size_t read_count;
+  volatile bool rx_overflow;
+
+  const uint8_t* volatile tx_buf;
+  volatile size_t tx_len;
+  uint32_t tx_fill;
+
+  uint8_t* registers;
+  size_t register_count;
+  uint8_t register_address;
+
+  transaction_callback_t callback;
+
+  // Completes a transaction whose last bytes were still in the receive FIFO when the chip select was released
+  sl_sleeptimer_timer_handle_t drain_timer;
+  volatile bool drain_pending;
+
+  LDMA_Descriptor_t rx_desc[RX_MAX_DESCRIPTORS];
+  LDMA_Descriptor_t tx_desc[TX_MAX_DESCRIPTORS];
 };
 } // namespace arduino
 
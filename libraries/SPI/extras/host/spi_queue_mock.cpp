@@ -0,0 +1,379 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Runs the SPI queue engine on a Linux host against a mocked SPIDRV
+// The mock completes each DMA transfer from a simulated interrupt and loops the
+// transmitted data back, so the job ordering, chaining, chunking, chip select
+// handling and error paths can be checked without hardware.
+//
+// Build and run:
+//   g++ -O2 -std=c++11 -Wall -I../.. spi_queue_mock.cpp ../../spi_queue.cpp -o spi_queue_mock
+//   ./spi_queue_mock
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "spi_queue.h"
+
+using namespace spi_queue;
+
+// Stand-in for the SPIDRV master transfer functions
+class MockSpidrv {
+public:
+  static const int ECODE_OK = 0;
+  static const int ECODE_BUSY = 0x0F000003;
+  static const int ECODE_PARAM_ERROR = 0x0F000001;
+  static const int max_transfer_size = 2048;
+
+  MockSpidrv() :
+    busy(false), tx(nullptr), rx(nullptr), count(0), transfers(0), fail_next(false)
+  {
+    ;
+  }
+
+  int MTransfer(const void* tx_buf, void* rx_buf, int item_count)
+  {
+    if (this->busy) {
+      return ECODE_BUSY;
+    }
+    if ((!tx_buf && !rx_buf) || item_count <= 0 || item_count > max_transfer_size) {
+      return ECODE_PARAM_ERROR;
+    }
+    this->busy = true;
+    this->tx = (const uint8_t*)tx_buf;
+    this->rx = (uint8_t*)rx_buf;
+    this->count = item_count;
+    this->transfers++;
+    return ECODE_OK;
+  }
+
+  // The DMA complete interrupt - loops the data back, dummy transmissions read back as 0xFF
+  bool irq(Engine& engine)
+  {
+    if (!this->busy) {
+      return false;
+    }
+    if (this->rx) {
+      for (int i = 0; i < this->count; i++) {
+        this->rx[i] = this->tx ? this->tx[i] : 0xFF;
+      }
+    }
+    this->busy = false;
+    int status = this->fail_next ? ECODE_PARAM_ERROR : ECODE_OK;
+    this->fail_next = false;
+    engine.transferComplete(status);
+    return true;
+  }
+
+  bool busy;
+  const uint8_t* tx;
+  uint8_t* rx;
+  int count;
+  int transfers;
+  bool fail_next;
+};
+
+struct MockDevice {
+  const char* name;
+  bool configured;
+};
+
+class MockPort : public Port {
+public:
+  explicit MockPort(MockSpidrv& spidrv) :
+    spidrv(spidrv), selected(nullptr), stop_count(0), lock_depth(0)
+  {
+    ;
+  }
+
+  bool select(Job* job)
+  {
+    MockDevice* device = static_cast<MockDevice*>(job->device);
+    if (!device->configured) {
+      return false;
+    }
+    if (this->selected) {
+      this->log += "!overlap ";
+    }
+    this->selected = device;
+    this->log += std::string("+") + device->name + " ";
+    return true;
+  }
+
+  void deselect(Job* job)
+  {
+    MockDevice* device = static_cast<MockDevice*>(job->device);
+    if (this->selected != device) {
+      this->log += "!deselect ";
+    }
+    this->selected = nullptr;
+    this->log += std::string("-") + device->name + " ";
+  }
+
+  int32_t startTransfer(const void* tx, void* rx, size_t len)
+  {
+    return this->spidrv.MTransfer(tx, rx, (int)len);
+  }
+
+  size_t maxTransferSize()
+  {
+    return MockSpidrv::max_transfer_size;
+  }
+
+  void jobComplete(Job* job)
+  {
+    this->completed.push_back(job);
+  }
+
+  void stopped()
+  {
+    this->stop_count++;
+  }
+
+  uint32_t lock()
+  {
+    return (uint32_t)this->lock_depth++;
+  }
+
+  void unlock(uint32_t state)
+  {
+    this->lock_depth = (int)state;
+  }
+
+  MockSpidrv& spidrv;
+  MockDevice* selected;
+  std::string log;
+  std::vector<Job*> completed;
+  int stop_count;
+  int lock_depth;
+};
+
+static int failures = 0;
+
+#define CHECK(cond)                                                \
+  do {                                                             \
+    if (!(cond)) {                                                 \
+      printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+      failures++;                                                  \
+    }                                                              \
+  } while (0)
+
+// Runs the engine like the queue task does - sets up unconfigured devices and pumps the interrupts
+static void run_queue(Engine& engine, MockSpidrv& spidrv)
+{
+  while (true) {
+    Job* setup_job = nullptr;
+    uint8_t res = engine.run(&setup_job);
+    if (res == RUN_EMPTY) {
+      return;
+    }
+    if (res == RUN_SETUP) {
+      static_cast<MockDevice*>(setup_job->device)->configured = true;
+      continue;
+    }
+    while (spidrv.irq(engine)) {
+      ;
+    }
+  }
+}
+
+static void test_priority_order()
+{
+  printf("priority order\n");
+  MockSpidrv spidrv;
+  MockPort port(spidrv);
+  Engine engine(port);
+  MockDevice dev = { "d", true };
+  uint8_t data[4] = { 1, 2, 3, 4 };
+  Segment seg = { data, nullptr, sizeof(data) };
+  Job a(&dev, &seg, 1, 0), b(&dev, &seg, 1, 2), c(&dev, &seg, 1, 1), d(&dev, &seg, 1, 2);
+  CHECK(engine.submit(&a));
+  CHECK(engine.submit(&b));
+  CHECK(engine.submit(&c));
+  CHECK(engine.submit(&d));
+  CHECK(!engine.submit(&d));
+  run_queue(engine, spidrv);
+  CHECK(port.completed.size() == 4);
+  if (port.completed.size() == 4) {
+    CHECK(port.completed[0] == &b);
+    CHECK(port.completed[1] == &d);
+    CHECK(port.completed[2] == &c);
+    CHECK(port.completed[3] == &a);
+  }
+  CHECK(a.state == JOB_DONE && b.state == JOB_DONE && c.state == JOB_DONE && d.state == JOB_DONE);
+  CHECK(port.stop_count == 1);
+  CHECK(!engine.busy());
+}
+
+static void test_segments_and_chunks()
+{
+  printf("segments and chunks\n");
+  MockSpidrv spidrv;
+  MockPort port(spidrv);
+  Engine engine(port);
+  MockDevice dev = { "flash", true };
+  static uint8_t tx[5000];
+  static uint8_t rx[5000];
+  for (size_t i = 0; i < sizeof(tx); i++) {
+    tx[i] = (uint8_t)(i * 7u);
+  }
+  memset(rx, 0, sizeof(rx));
+  uint8_t cmd[4] = { 0x03, 0x00, 0x10, 0x00 };
+  uint8_t dummy_rx[3];
+  Segment segs[4] = {
+    { cmd, nullptr, sizeof(cmd) },
+    { nullptr, nullptr, 0 },
+    { tx, rx, sizeof(tx) },
+    { nullptr, dummy_rx, sizeof(dummy_rx) }
+  };
+  Job job(&dev, segs, 4);
+  CHECK(engine.submit(&job));
+  run_queue(engine, spidrv);
+  CHECK(job.state == JOB_DONE);
+  // 4 byte command + 3 chunks of the 5000 byte segment + the receive only segment
+  CHECK(spidrv.transfers == 5);
+  CHECK(memcmp(tx, rx, sizeof(tx)) == 0);
+  CHECK(dummy_rx[0] == 0xFF && dummy_rx[2] == 0xFF);
+  CHECK(port.log == "+flash -flash ");
+}
+
+static void test_device_setup_and_chip_select()
+{
+  printf("device setup and chip select\n");
+  MockSpidrv spidrv;
+  MockPort port(spidrv);
+  Engine engine(port);
+  MockDevice flash = { "flash", false };
+  MockDevice sensor = { "sensor", true };
+  uint8_t data[2] = { 0xAA, 0x55 };
+  Segment seg = { data, nullptr, sizeof(data) };
+  Job j1(&sensor, &seg, 1), j2(&flash, &seg, 1), j3(&sensor, &seg, 1);
+  engine.submit(&j1);
+  engine.submit(&j2);
+  engine.submit(&j3);
+  run_queue(engine, spidrv);
+  CHECK(flash.configured);
+  CHECK(port.log == "+sensor -sensor +flash -flash +sensor -sensor ");
+  // The engine stopped once for the flash setup and once at the end
+  CHECK(port.stop_count == 2);
+  CHECK(j1.state == JOB_DONE && j2.state == JOB_DONE && j3.state == JOB_DONE);
+}
+
+static Job* chained_job = nullptr;
+static Engine* chained_engine = nullptr;
+
+static void resubmit_callback(Job* job, void* context)
+{
+  int* count = static_cast<int*>(context);
+  (*count)++;
+  if (*count < 3) {
+    chained_engine->submit(job);
+  } else if (chained_job) {
+    chained_engine->submit(chained_job);
+    chained_job = nullptr;
+  }
+}
+
+static void test_chaining_from_callback()
+{
+  printf("chaining from callbacks\n");
+  MockSpidrv spidrv;
+  MockPort port(spidrv);
+  Engine engine(port);
+  MockDevice dev = { "d", true };
+  uint8_t data[1] = { 0x42 };
+  Segment seg = { data, nullptr, sizeof(data) };
+  int count = 0;
+  Job job(&dev, &seg, 1, 0, resubmit_callback, &count);
+  Job other(&dev, &seg, 1);
+  chained_engine = &engine;
+  chained_job = &other;
+  engine.submit(&job);
+  run_queue(engine, spidrv);
+  CHECK(count == 3);
+  CHECK(other.state == JOB_DONE);
+  CHECK(spidrv.transfers == 4);
+  // Everything was chained from the interrupt without the engine stopping in between
+  CHECK(port.stop_count == 1);
+}
+
+static void test_errors_and_cancel()
+{
+  printf("errors and cancel\n");
+  MockSpidrv spidrv;
+  MockPort port(spidrv);
+  Engine engine(port);
+  MockDevice dev = { "d", true };
+  uint8_t data[8] = { 0 };
+  Segment good = { data, nullptr, sizeof(data) };
+  Segment bad = { nullptr, nullptr, sizeof(data) };
+  Segment two[2] = { good, good };
+  Job j_bad_start(&dev, &bad, 1, 3);
+  Job j_bad_dma(&dev, two, 2, 2);
+  Job j_canceled(&dev, &good, 1, 1);
+  Job j_ok(&dev, &good, 1, 0);
+  Job j_empty(&dev, nullptr, 0, 0);
+  engine.submit(&j_bad_start);
+  engine.submit(&j_bad_dma);
+  engine.submit(&j_canceled);
+  engine.submit(&j_ok);
+  engine.submit(&j_empty);
+  CHECK(engine.cancel(&j_canceled));
+  CHECK(!engine.cancel(&j_canceled));
+  CHECK(j_canceled.state == JOB_CANCELED);
+
+  Job* setup_job = nullptr;
+  // The first job fails to start, the second one starts its DMA
+  CHECK(engine.run(&setup_job) == RUN_STARTED);
+  CHECK(j_bad_start.state == JOB_ERROR && j_bad_start.status == MockSpidrv::ECODE_PARAM_ERROR);
+  CHECK(engine.run(&setup_job) == RUN_BUSY);
+  spidrv.fail_next = true;
+  while (spidrv.irq(engine)) {
+    ;
+  }
+  CHECK(j_bad_dma.state == JOB_ERROR);
+  CHECK(j_ok.state == JOB_DONE);
+  CHECK(j_empty.state == JOB_DONE);
+  CHECK(port.completed.size() == 4);
+  CHECK(port.log == "+d -d +d -d +d -d +d -d ");
+  CHECK(port.lock_depth == 0);
+}
+
+int main()
+{
+  test_priority_order();
+  test_segments_and_chunks();
+  test_device_setup_and_chip_select();
+  test_chaining_from_callback();
+  test_errors_and_cancel();
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,233 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "spi_queue.h"
+
+namespace spi_queue {
+
+Job::Job() :
+  device(nullptr),
+  segments(nullptr),
+  segment_count(0u),
+  priority(0u),
+  callback(nullptr),
+  context(nullptr),
+  state(JOB_IDLE),
+  status(0),
+  waiter(nullptr),
+  next(nullptr),
+  segment_index(0u),
+  segment_offset(0u)
+{
+  ;
+}
+
+Job::Job(void* device, const Segment* segments, size_t segment_count, uint8_t priority,
+         job_callback_t callback, void* context) :
+  device(device),
+  segments(segments),
+  segment_count(segment_count),
+  priority(priority),
+  callback(callback),
+  context(context),
+  state(JOB_IDLE),
+  status(0),
+  waiter(nullptr),
+  next(nullptr),
+  segment_index(0u),
+  segment_offset(0u)
+{
+  ;
+}
+
+Engine::Engine(Port& port) :
+  port(port),
+  head(nullptr),
+  active(nullptr),
+  chunk_len(0u),
+  running(false)
+{
+  ;
+}
+
+bool Engine::submit(Job* job)
+{
+  if (!job || (job->segment_count > 0u && !job->segments)) {
+    return false;
+  }
+  uint32_t lock_state = this->port.lock();
+  if (job->state == JOB_QUEUED || job->state == JOB_ACTIVE) {
+    this->port.unlock(lock_state);
+    return false;
+  }
+  job->state = JOB_QUEUED;
+  job->status = 0;
+  job->segment_index = 0u;
+  job->segment_offset = 0u;
+  // Keep the queue sorted by priority - a new job goes behind the jobs with the same priority
+  Job** link = &this->head;
+  while (*link && (*link)->priority >= job->priority) {
+    link = &(*link)->next;
+  }
+  job->next = *link;
+  *link = job;
+  this->port.unlock(lock_state);
+  return true;
+}
+
+bool Engine::cancel(Job* job)
+{
+  bool removed = false;
+  uint32_t lock_state = this->port.lock();
+  if (job && job->state == JOB_QUEUED) {
+    for (Job** link = &this->head; *link; link = &(*link)->next) {
+      if (*link == job) {
+        *link = job->next;
+        job->next = nullptr;
+        job->state = JOB_CANCELED;
+        removed = true;
+        break;
+      }
+    }
+  }
+  this->port.unlock(lock_state);
+  return removed;
+}
+
+uint8_t Engine::run(Job** setup_job)
+{
+  uint32_t lock_state = this->port.lock();
+  if (this->running) {
+    this->port.unlock(lock_state);
+    return RUN_BUSY;
+  }
+  this->running = true;
+  this->port.unlock(lock_state);
+  return this->advance(setup_job);
+}
+
+void Engine::transferComplete(int32_t status)
+{
+  Job* job = this->active;
+  if (!job) {
+    return;
+  }
+  if (status != 0) {
+    this->finish_job(JOB_ERROR, status);
+  } else {
+    job->segment_offset += this->chunk_len;
+    if (job->segment_offset >= job->segments[job->segment_index].len) {
+      job->segment_index++;
+      job->segment_offset = 0u;
+    }
+  }
+  Job* setup_job = nullptr;
+  if (this->advance(&setup_job) != RUN_STARTED) {
+    this->port.stopped();
+  }
+}
+
+bool Engine::busy()
+{
+  return this->running;
+}
+
+// Keeps the bus busy - continues the active job, then starts the queued jobs until a transfer is in flight
+uint8_t Engine::advance(Job** setup_job)
+{
+  while (true) {
+    if (this->active) {
+      int32_t status = 0;
+      if (this->start_chunk(&status)) {
+        return RUN_STARTED;
+      }
+      this->finish_job((status == 0) ? JOB_DONE : JOB_ERROR, status);
+    }
+
+    uint32_t lock_state = this->port.lock();
+    Job* job = this->head;
+    if (!job) {
+      this->running = false;
+      this->port.unlock(lock_state);
+      return RUN_EMPTY;
+    }
+    if (!this->port.select(job)) {
+      this->running = false;
+      this->port.unlock(lock_state);
+      if (setup_job) {
+        *setup_job = job;
+      }
+      return RUN_SETUP;
+    }
+    this->head = job->next;
+    job->next = nullptr;
+    job->state = JOB_ACTIVE;
+    this->active = job;
+    this->port.unlock(lock_state);
+  }
+}
+
+// Starts the next piece of the active job - returns false when the job is complete or failed to start
+bool Engine::start_chunk(int32_t* status)
+{
+  Job* job = this->active;
+  while (job->segment_index < job->segment_count
+         && job->segment_offset >= job->segments[job->segment_index].len) {
+    job->segment_index++;
+    job->segment_offset = 0u;
+  }
+  if (job->segment_index >= job->segment_count) {
+    *status = 0;
+    return false;
+  }
+
+  const Segment& segment = job->segments[job->segment_index];
+  size_t len = segment.len - job->segment_offset;
+  size_t max_len = this->port.maxTransferSize();
+  if (len > max_len) {
+    len = max_len;
+  }
+  const uint8_t* tx = segment.tx ? (const uint8_t*)segment.tx + job->segment_offset : nullptr;
+  uint8_t* rx = segment.rx ? (uint8_t*)segment.rx + job->segment_offset : nullptr;
+  this->chunk_len = len;
+  *status = this->port.startTransfer(tx, rx, len);
+  return *status == 0;
+}
+
+void Engine::finish_job(uint8_t state, int32_t status)
+{
+  Job* job = this->active;
+  this->active = nullptr;
+  this->port.deselect(job);
+  job->status = status;
+  job->state = state;
+  if (job->callback) {
+    job->callback(job, job->context);
+  }
+  this->port.jobComplete(job);
+}
+
+} // namespace spi_queue
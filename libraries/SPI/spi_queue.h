@@ -0,0 +1,171 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SPI_QUEUE_H
+#define SPI_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The queue engine has no Arduino dependencies so that it can also be built and run on a Linux host
+// The hardware specific parts (driver calls, chip select, locking) are provided through a Port
+
+namespace spi_queue {
+
+// Job states
+enum : uint8_t {
+  JOB_IDLE     = 0,
+  JOB_QUEUED   = 1,
+  JOB_ACTIVE   = 2,
+  JOB_DONE     = 3,
+  JOB_ERROR    = 4,
+  JOB_CANCELED = 5
+};
+
+// One contiguous piece of a job - a null 'tx' sends dummy bytes, a null 'rx' discards the received bytes
+struct Segment {
+  const void* tx;
+  void* rx;
+  size_t len;
+};
+
+struct Job;
+
+// Called from the transfer complete interrupt when a job finishes - keep it short
+typedef void (*job_callback_t)(Job* job, void* context);
+
+struct Job {
+  Job();
+  Job(void* device, const Segment* segments, size_t segment_count, uint8_t priority = 0u,
+      job_callback_t callback = nullptr, void* context = nullptr);
+
+  // Set by the application
+  void* device;                 // the device to select for the job - interpreted by the Port
+  const Segment* segments;      // transferred back-to-back with the device selected
+  size_t segment_count;
+  uint8_t priority;             // higher priorities are started first, equal priorities in order of submission
+  job_callback_t callback;
+  void* context;
+
+  // Set by the engine
+  volatile uint8_t state;
+  volatile int32_t status;      // the status reported by the Port for the failing segment, 0 on success
+  void* volatile waiter;        // used by the Port to wake up a task waiting for the job
+
+  // Engine internal
+  Job* next;
+  size_t segment_index;
+  size_t segment_offset;
+};
+
+class Port {
+public:
+  virtual ~Port() {}
+  // Selects the job's device - returns false if the device has to be set up from task context first
+  virtual bool select(Job* job) = 0;
+  virtual void deselect(Job* job) = 0;
+  // Starts a transfer, its completion has to be reported with Engine::transferComplete()
+  virtual int32_t startTransfer(const void* tx, void* rx, size_t len) = 0;
+  // The largest length startTransfer() accepts
+  virtual size_t maxTransferSize() = 0;
+  // Called after the job's callback - from the transfer complete interrupt
+  virtual void jobComplete(Job* job) = 0;
+  // Called when the engine stops - the queue is empty or the next job needs setup from task context
+  virtual void stopped() = 0;
+  // Interrupt safe critical section
+  virtual uint32_t lock() = 0;
+  virtual void unlock(uint32_t state) = 0;
+};
+
+// Results of Engine::run()
+enum : uint8_t {
+  RUN_STARTED = 0,
+  RUN_BUSY    = 1,
+  RUN_EMPTY   = 2,
+  RUN_SETUP   = 3
+};
+
+class Engine {
+public:
+  explicit Engine(Port& port);
+
+  /***************************************************************************//**
+   * Adds a job to the queue - the job and its segments must stay valid until it completes
+   *
+   * @param[in] job the job to queue
+   *
+   * @return true if the job was queued, false if it's already queued or active
+   ******************************************************************************/
+  bool submit(Job* job);
+
+  /***************************************************************************//**
+   * Removes a job from the queue - jobs already on the bus can't be canceled
+   *
+   * @param[in] job the job to remove
+   *
+   * @return true if the job was removed
+   ******************************************************************************/
+  bool cancel(Job* job);
+
+  /***************************************************************************//**
+   * Starts processing the queue if the engine is stopped
+   * Following jobs are chained from transferComplete() until the queue runs empty
+   * or a job's device needs setup.
+   *
+   * @param[out] setup_job set to the job whose device needs setup on RUN_SETUP
+   *
+   * @return RUN_STARTED, RUN_BUSY if already running, RUN_EMPTY or RUN_SETUP
+   ******************************************************************************/
+  uint8_t run(Job** setup_job);
+
+  /***************************************************************************//**
+   * Reports the completion of the transfer started by the Port - called from interrupt
+   *
+   * @param[in] status 0 on success - any other value fails the job
+   ******************************************************************************/
+  void transferComplete(int32_t status);
+
+  /***************************************************************************//**
+   * Returns whether a job is on the bus
+   ******************************************************************************/
+  bool busy();
+
+private:
+  uint8_t advance(Job** setup_job);
+  bool start_chunk(int32_t* status);
+  void finish_job(uint8_t state, int32_t status);
+
+  Port& port;
+  Job* head;
+  Job* active;
+  size_t chunk_len;
+  // Set from run() until the engine stops - only one context drives the engine at a time
+  volatile bool running;
+};
+
+} // namespace spi_queue
+
+#endif // SPI_QUEUE_H
@@ -0,0 +1,90 @@
+/*
+   Serial RPC basic example
+
+   The example shows how to expose functions and memory regions to a host computer
+   with the SerialRPC library. The host sends COBS framed binary requests over Serial
+   and the board answers them directly from the serial frame task - no parsing in loop().
+
+   Exposed functions:
+   - 0: "add"    - adds two little-endian int32 numbers and returns the sum
+   - 1: "led"    - turns the built-in LED on or off (1 byte argument)
+   - 2: "millis" - returns the current millis() value as a little-endian uint32
+   Exposed memory regions:
+   - 0: a 64 byte scratch buffer (read/write)
+   - 1: the request statistics (read only)
+
+   Use the host side Python or C client from the library's 'extras/host' folder:
+     python3 serial_rpc_client.py /dev/ttyACM0 --baudrate 115200 --bench 1000
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#include <SerialRPC.h>
+
+uint8_t scratch[64];
+uint32_t stats[2];
+
+int rpc_add(const uint8_t* args, size_t args_len, uint8_t* result, size_t result_max)
+{
+  if (args_len != 8 || result_max < 4) {
+    return -1;
+  }
+  int32_t a, b;
+  memcpy(&a, args, 4);
+  memcpy(&b, args + 4, 4);
+  int32_t sum = a + b;
+  memcpy(result, &sum, 4);
+  return 4;
+}
+
+int rpc_led(const uint8_t* args, size_t args_len, uint8_t* result, size_t result_max)
+{
+  (void)result;
+  (void)result_max;
+  if (args_len != 1) {
+    return -1;
+  }
+  digitalWrite(LED_BUILTIN, args[0] ? LED_BUILTIN_ACTIVE : LED_BUILTIN_INACTIVE);
+  return 0;
+}
+
+int rpc_millis(const uint8_t* args, size_t args_len, uint8_t* result, size_t result_max)
+{
+  (void)args;
+  (void)args_len;
+  if (result_max < 4) {
+    return -1;
+  }
+  uint32_t now = millis();
+  memcpy(result, &now, 4);
+  return 4;
+}
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+
+  Serial.begin(115200);
+  SerialRPC.addFunction(0, "add", rpc_add);
+  SerialRPC.addFunction(1, "led", rpc_led);
+  SerialRPC.addFunction(2, "millis", rpc_millis);
+  SerialRPC.addRegion(0, scratch, sizeof(scratch), true);
+  SerialRPC.addRegion(1, stats, sizeof(stats), false);
+  SerialRPC.begin(Serial);
+}
+
+void loop()
+{
+  stats[0] = SerialRPC.getRequestCount();
+  stats[1] = SerialRPC.getErrorCount();
+  delay(100);
+}
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Linux stand-in for the device side of the SerialRPC protocol
+// Runs the same protocol engine as the boards on a pseudo terminal, so the host
+// clients can be developed and tested without hardware.
+//
+// Build and run:
+//   g++ -O2 -std=c++11 -I../../src pty_device.cpp ../../src/rpc_server.cpp -o pty_device
+//   ./pty_device
+// Then connect a client to the printed /dev/pts/N path.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "rpc_server.h"
+
+static uint8_t scratch[64];
+static uint32_t stats[2];
+static struct timespec start_time;
+
+static int rpc_add(const uint8_t* args, size_t args_len, uint8_t* result, size_t result_max)
+{
+  if (args_len != 8 || result_max < 4) {
+    return -1;
+  }
+  int32_t a, b;
+  memcpy(&a, args, 4);
+  memcpy(&b, args + 4, 4);
+  int32_t sum = a + b;
+  memcpy(result, &sum, 4);
+  return 4;
+}
+
+static int rpc_led(const uint8_t* args, size_t args_len, uint8_t* result, size_t result_max)
+{
+  (void)result;
+  (void)result_max;
+  if (args_len != 1) {
+    return -1;
+  }
+  printf("LED %s\n", args[0] ? "on" : "off");
+  return 0;
+}
+
+static int rpc_millis(const uint8_t* args, size_t args_len, uint8_t* result, size_t result_max)
+{
+  (void)args;
+  (void)args_len;
+  if (result_max < 4) {
+    return -1;
+  }
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  uint32_t ms = (uint32_t)((now.tv_sec - start_time.tv_sec) * 1000 + (now.tv_nsec - start_time.tv_nsec) / 1000000);
+  memcpy(result, &ms, 4);
+  return 4;
+}
+
+static void write_output(const uint8_t* data, size_t len, void* context)
+{
+  int fd = *(int*)context;
+  while (len > 0) {
+    ssize_t res = write(fd, data, len);
+    if (res < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        continue;
+      }
+      perror("write");
+      exit(1);
+    }
+    data += res;
+    len -= (size_t)res;
+  }
+}
+
+int main()
+{
+  int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+    perror("posix_openpt");
+    return 1;
+  }
+  struct termios tio;
+  tcgetattr(fd, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(fd, TCSANOW, &tio);
+
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+  static serial_rpc::RpcServer server;
+  server.setOutput(write_output, &fd);
+  server.addFunction(0, "add", rpc_add);
+  server.addFunction(1, "led", rpc_led);
+  server.addFunction(2, "millis", rpc_millis);
+  server.addRegion(0, scratch, sizeof(scratch), true);
+  server.addRegion(1, stats, sizeof(stats), false);
+
+  printf("%s\n", ptsname(fd));
+  fflush(stdout);
+
+  uint8_t buf[4096];
+  while (1) {
+    ssize_t len = read(fd, buf, sizeof(buf));
+    if (len < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        continue;
+      }
+      // EIO is returned while no client has the pty open
+      if (errno == EIO) {
+        usleep(10000);
+        continue;
+      }
+      perror("read");
+      return 1;
+    }
+    server.feed(buf, (size_t)len);
+    stats[0] = server.getRequestCount();
+    stats[1] = server.getErrorCount();
+  }
+  return 0;
+}
@@ -0,0 +1,342 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Host side C client for the SerialRPC Arduino library (Linux / POSIX)
+//
+// Build the benchmark tool:
+//   gcc -O2 -DSERIAL_RPC_CLIENT_MAIN serial_rpc_client.c -o serial_rpc_client
+//   ./serial_rpc_client /dev/ttyACM0 115200 10000
+
+#include "serial_rpc_client.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static uint32_t crc32(const uint8_t* data, size_t len)
+{
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+static size_t cobs_encode(const uint8_t* src, size_t len, uint8_t* dst)
+{
+  size_t code_idx = 0;
+  size_t out_idx = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < len; i++) {
+    if (src[i] != 0) {
+      dst[out_idx++] = src[i];
+      code++;
+    }
+    if (src[i] == 0 || code == 0xFF) {
+      dst[code_idx] = code;
+      code = 1;
+      code_idx = out_idx++;
+    }
+  }
+  dst[code_idx] = code;
+  return out_idx;
+}
+
+static size_t cobs_decode(const uint8_t* src, size_t len, uint8_t* dst)
+{
+  size_t in_idx = 0;
+  size_t out_idx = 0;
+  while (in_idx < len) {
+    uint8_t code = src[in_idx++];
+    if (code == 0 || in_idx + code - 1 > len) {
+      return 0;
+    }
+    for (uint8_t i = 1; i < code; i++) {
+      dst[out_idx++] = src[in_idx++];
+    }
+    if (code != 0xFF && in_idx < len) {
+      dst[out_idx++] = 0;
+    }
+  }
+  return out_idx;
+}
+
+static speed_t baudrate_to_speed(int baudrate)
+{
+  switch (baudrate) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    default: return B115200;
+  }
+}
+
+static int write_all(int fd, const uint8_t* data, size_t len)
+{
+  while (len > 0) {
+    ssize_t res = write(fd, data, len);
+    if (res < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        continue;
+      }
+      return -1;
+    }
+    data += res;
+    len -= (size_t)res;
+  }
+  return 0;
+}
+
+int serial_rpc_open(serial_rpc_client_t* client, const char* port, int baudrate)
+{
+  memset(client, 0, sizeof(*client));
+  client->timeout_ms = 1000;
+  client->fd = open(port, O_RDWR | O_NOCTTY);
+  if (client->fd < 0) {
+    return -1;
+  }
+  struct termios tio;
+  if (tcgetattr(client->fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, baudrate_to_speed(baudrate));
+    cfsetospeed(&tio, baudrate_to_speed(baudrate));
+    tcsetattr(client->fd, TCSANOW, &tio);
+  }
+  // An empty frame makes the device drop any partially received garbage
+  uint8_t delimiter = 0;
+  return write_all(client->fd, &delimiter, 1);
+}
+
+void serial_rpc_close(serial_rpc_client_t* client)
+{
+  close(client->fd);
+  client->fd = -1;
+}
+
+int serial_rpc_submit(serial_rpc_client_t* client, uint8_t opcode, const uint8_t* body, size_t body_len)
+{
+  uint8_t payload[SERIAL_RPC_MAX_FRAME_SIZE];
+  uint8_t frame[SERIAL_RPC_MAX_FRAME_SIZE + SERIAL_RPC_MAX_FRAME_SIZE / 254 + 2];
+  if (3 + body_len + 4 > sizeof(payload)) {
+    return -1;
+  }
+  uint16_t request_id = client->next_id++;
+  payload[0] = opcode;
+  payload[1] = (uint8_t)request_id;
+  payload[2] = (uint8_t)(request_id >> 8);
+  if (body_len > 0) {
+    memcpy(payload + 3, body, body_len);
+  }
+  size_t payload_len = 3 + body_len;
+  uint32_t crc = crc32(payload, payload_len);
+  for (int i = 0; i < 4; i++) {
+    payload[payload_len++] = (uint8_t)(crc >> (8 * i));
+  }
+  size_t frame_len = cobs_encode(payload, payload_len, frame);
+  frame[frame_len++] = 0;
+  if (write_all(client->fd, frame, frame_len) != 0) {
+    return -1;
+  }
+  return request_id;
+}
+
+// Decodes and checks a response frame - returns the payload length or 0 if the frame is invalid
+static size_t parse_frame(const uint8_t* frame, size_t len, uint8_t* payload)
+{
+  if (len == 0 || len > SERIAL_RPC_MAX_FRAME_SIZE + SERIAL_RPC_MAX_FRAME_SIZE / 254 + 2) {
+    return 0;
+  }
+  size_t payload_len = cobs_decode(frame, len, payload);
+  if (payload_len < 8) {
+    return 0;
+  }
+  payload_len -= 4;
+  uint32_t crc = (uint32_t)payload[payload_len] | ((uint32_t)payload[payload_len + 1] << 8)
+                 | ((uint32_t)payload[payload_len + 2] << 16) | ((uint32_t)payload[payload_len + 3] << 24);
+  if (crc32(payload, payload_len) != crc || (payload[0] & 0x80) == 0) {
+    return 0;
+  }
+  return payload_len;
+}
+
+int serial_rpc_wait(serial_rpc_client_t* client, uint16_t request_id, uint8_t* data, size_t data_max, size_t* data_len)
+{
+  uint8_t payload[SERIAL_RPC_RX_BUFFER_SIZE];
+  while (1) {
+    // Process the complete frames already in the buffer
+    uint8_t* end = memchr(client->rx_buf, 0, client->rx_len);
+    if (end) {
+      size_t frame_len = (size_t)(end - client->rx_buf);
+      size_t payload_len = parse_frame(client->rx_buf, frame_len, payload);
+      client->rx_len -= frame_len + 1;
+      memmove(client->rx_buf, end + 1, client->rx_len);
+      if (payload_len == 0 || (uint16_t)(payload[1] | (payload[2] << 8)) != request_id) {
+        continue;
+      }
+      size_t len = payload_len - 4;
+      if (len > data_max) {
+        len = data_max;
+      }
+      if (data && len > 0) {
+        memcpy(data, payload + 4, len);
+      }
+      if (data_len) {
+        *data_len = len;
+      }
+      return payload[3];
+    }
+
+    if (client->rx_len == sizeof(client->rx_buf)) {
+      client->rx_len = 0;
+    }
+    struct pollfd pfd = { client->fd, POLLIN, 0 };
+    if (poll(&pfd, 1, client->timeout_ms) <= 0) {
+      return SERIAL_RPC_ERROR_TIMEOUT;
+    }
+    ssize_t res = read(client->fd, client->rx_buf + client->rx_len, sizeof(client->rx_buf) - client->rx_len);
+    if (res <= 0) {
+      if (res < 0 && (errno == EINTR || errno == EAGAIN)) {
+        continue;
+      }
+      return SERIAL_RPC_ERROR_TIMEOUT;
+    }
+    client->rx_len += (size_t)res;
+  }
+}
+
+int serial_rpc_call(serial_rpc_client_t* client, uint8_t function_id, const uint8_t* args, size_t args_len,
+                    uint8_t* result, size_t result_max, size_t* result_len)
+{
+  uint8_t body[SERIAL_RPC_MAX_FRAME_SIZE];
+  if (args_len + 1 > sizeof(body)) {
+    return SERIAL_RPC_ERROR_TIMEOUT;
+  }
+  body[0] = function_id;
+  if (args_len > 0) {
+    memcpy(body + 1, args, args_len);
+  }
+  int request_id = serial_rpc_submit(client, SERIAL_RPC_OP_CALL, body, args_len + 1);
+  if (request_id < 0) {
+    return SERIAL_RPC_ERROR_TIMEOUT;
+  }
+  return serial_rpc_wait(client, (uint16_t)request_id, result, result_max, result_len);
+}
+
+int serial_rpc_mem_read(serial_rpc_client_t* client, uint8_t region, uint32_t offset, uint16_t len, uint8_t* data)
+{
+  uint8_t body[7] = { region,
+                      (uint8_t)offset, (uint8_t)(offset >> 8), (uint8_t)(offset >> 16), (uint8_t)(offset >> 24),
+                      (uint8_t)len, (uint8_t)(len >> 8) };
+  int request_id = serial_rpc_submit(client, SERIAL_RPC_OP_MEM_READ, body, sizeof(body));
+  if (request_id < 0) {
+    return SERIAL_RPC_ERROR_TIMEOUT;
+  }
+  return serial_rpc_wait(client, (uint16_t)request_id, data, len, NULL);
+}
+
+int serial_rpc_mem_write(serial_rpc_client_t* client, uint8_t region, uint32_t offset, const uint8_t* data, size_t len)
+{
+  uint8_t body[SERIAL_RPC_MAX_FRAME_SIZE];
+  if (len + 5 > sizeof(body)) {
+    return SERIAL_RPC_ERROR_TIMEOUT;
+  }
+  body[0] = region;
+  for (int i = 0; i < 4; i++) {
+    body[1 + i] = (uint8_t)(offset >> (8 * i));
+  }
+  memcpy(body + 5, data, len);
+  int request_id = serial_rpc_submit(client, SERIAL_RPC_OP_MEM_WRITE, body, len + 5);
+  if (request_id < 0) {
+    return SERIAL_RPC_ERROR_TIMEOUT;
+  }
+  return serial_rpc_wait(client, (uint16_t)request_id, NULL, 0, NULL);
+}
+
+#if defined(SERIAL_RPC_CLIENT_MAIN)
+#include <time.h>
+
+// Benchmark: pipelined calls of the 'add' function (ID 0) of the example sketch
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <port> [baudrate] [calls] [window]\n", argv[0]);
+    return 1;
+  }
+  int baudrate = argc > 2 ? atoi(argv[2]) : 115200;
+  int calls = argc > 3 ? atoi(argv[3]) : 10000;
+  int window = argc > 4 ? atoi(argv[4]) : 32;
+
+  static serial_rpc_client_t client;
+  if (serial_rpc_open(&client, argv[1], baudrate) != 0) {
+    perror("open");
+    return 1;
+  }
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  int errors = 0;
+  int next_wait = 0;
+  int first_id = client.next_id;
+  for (int i = 0; i < calls || next_wait < calls; ) {
+    if (i < calls && i - next_wait < window) {
+      int32_t args[2] = { i, i };
+      uint8_t body[9];
+      body[0] = 0;
+      memcpy(body + 1, args, sizeof(args));
+      if (serial_rpc_submit(&client, SERIAL_RPC_OP_CALL, body, sizeof(body)) < 0) {
+        errors++;
+      }
+      i++;
+      continue;
+    }
+    int32_t sum = 0;
+    size_t len = 0;
+    int status = serial_rpc_wait(&client, (uint16_t)(first_id + next_wait), (uint8_t*)&sum, sizeof(sum), &len);
+    if (status != 0 || len != sizeof(sum) || sum != 2 * next_wait) {
+      errors++;
+    }
+    next_wait++;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+  printf("%d calls in %.3f s - %.0f calls/s, %d errors\n", calls, elapsed, calls / elapsed, errors);
+  serial_rpc_close(&client);
+  return errors ? 1 : 0;
+}
+#endif // SERIAL_RPC_CLIENT_MAIN
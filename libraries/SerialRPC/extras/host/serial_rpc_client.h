@@ -0,0 +1,86 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Host side C client for the SerialRPC Arduino library (Linux / POSIX)
+
+#ifndef SERIAL_RPC_CLIENT_H
+#define SERIAL_RPC_CLIENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SERIAL_RPC_OP_PING       0x01
+#define SERIAL_RPC_OP_CALL       0x02
+#define SERIAL_RPC_OP_MEM_READ   0x03
+#define SERIAL_RPC_OP_MEM_WRITE  0x04
+#define SERIAL_RPC_OP_LIST       0x05
+
+#define SERIAL_RPC_MAX_FRAME_SIZE 240
+#define SERIAL_RPC_RX_BUFFER_SIZE 4096
+
+// Returned instead of a status code when no response arrives in time or the port fails
+#define SERIAL_RPC_ERROR_TIMEOUT  (-1)
+
+typedef struct {
+  int fd;
+  int timeout_ms;
+  uint16_t next_id;
+  uint8_t rx_buf[SERIAL_RPC_RX_BUFFER_SIZE];
+  size_t rx_len;
+} serial_rpc_client_t;
+
+// Opens the serial port (or pty) - returns 0 on success
+int serial_rpc_open(serial_rpc_client_t* client, const char* port, int baudrate);
+
+void serial_rpc_close(serial_rpc_client_t* client);
+
+// Sends a request without waiting for the response - returns the request ID or -1 on error
+int serial_rpc_submit(serial_rpc_client_t* client, uint8_t opcode, const uint8_t* body, size_t body_len);
+
+// Waits for the response of a request - responses to requests submitted earlier are dropped,
+// so pipelined requests have to be waited for in submission order
+// Returns the response status (0 on success) or SERIAL_RPC_ERROR_TIMEOUT
+int serial_rpc_wait(serial_rpc_client_t* client, uint16_t request_id, uint8_t* data, size_t data_max, size_t* data_len);
+
+// Calls a function on the device and waits for the result - returns the response status
+int serial_rpc_call(serial_rpc_client_t* client, uint8_t function_id, const uint8_t* args, size_t args_len,
+                    uint8_t* result, size_t result_max, size_t* result_len);
+
+// Reads from a memory region of the device - returns the response status
+int serial_rpc_mem_read(serial_rpc_client_t* client, uint8_t region, uint32_t offset, uint16_t len, uint8_t* data);
+
+// Writes to a memory region of the device - returns the response status
+int serial_rpc_mem_write(serial_rpc_client_t* client, uint8_t region, uint32_t offset, const uint8_t* data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SERIAL_RPC_CLIENT_H
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+# Host side client for the SerialRPC Arduino library
+# Only uses the Python standard library - works with serial ports and the pty_device stand-in
+#
+# Usage:
+#   python3 serial_rpc_client.py /dev/ttyACM0 --baudrate 115200 --list
+#   python3 serial_rpc_client.py /dev/ttyACM0 --bench 10000 --window 32
+
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+import zlib
+
+OP_PING = 0x01
+OP_CALL = 0x02
+OP_MEM_READ = 0x03
+OP_MEM_WRITE = 0x04
+OP_LIST = 0x05
+OP_RESPONSE = 0x80
+
+STATUS_NAMES = {
+    0x00: "OK",
+    0x01: "BAD_REQUEST",
+    0x02: "UNKNOWN_FUNCTION",
+    0x03: "UNKNOWN_REGION",
+    0x04: "OUT_OF_BOUNDS",
+    0x05: "READ_ONLY",
+    0x06: "FUNCTION_ERROR",
+}
+
+
+class RpcError(Exception):
+    def __init__(self, status):
+        super().__init__(STATUS_NAMES.get(status, "STATUS_0x%02x" % status))
+        self.status = status
+
+
+def cobs_encode(data):
+    out = bytearray(b"\x00")
+    code_idx = 0
+    code = 1
+    for byte in data:
+        if byte != 0:
+            out.append(byte)
+            code += 1
+        if byte == 0 or code == 0xFF:
+            out[code_idx] = code
+            code = 1
+            code_idx = len(out)
+            out.append(0)
+    out[code_idx] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        code = data[idx]
+        idx += 1
+        if code == 0 or idx + code - 1 > len(data):
+            raise ValueError("malformed COBS frame")
+        out += data[idx:idx + code - 1]
+        idx += code - 1
+        if code != 0xFF and idx < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class SerialRpcClient:
+    def __init__(self, port, baudrate=115200, timeout=1.0):
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self.fd):
+            tty.setraw(self.fd)
+            attrs = termios.tcgetattr(self.fd)
+            speed = getattr(termios, "B%d" % baudrate, None)
+            if speed is not None:
+                attrs[4] = speed
+                attrs[5] = speed
+                termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        self.timeout = timeout
+        self.next_id = 0
+        self.rx_buf = bytearray()
+        self.responses = {}
+        # An empty frame makes the device drop any partially received garbage
+        os.write(self.fd, b"\x00")
+
+    def close(self):
+        os.close(self.fd)
+
+    def submit(self, opcode, body=b""):
+        """Sends a request without waiting for the response - returns the request ID"""
+        request_id = self.next_id
+        self.next_id = (self.next_id + 1) & 0xFFFF
+        payload = struct.pack("<BH", opcode, request_id) + body
+        frame = cobs_encode(payload + struct.pack("<I", zlib.crc32(payload))) + b"\x00"
+        os.write(self.fd, frame)
+        return request_id
+
+    def wait(self, request_id):
+        """Waits for the response of a submitted request - returns the response data"""
+        deadline = time.monotonic() + self.timeout
+        while request_id not in self.responses:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                raise TimeoutError("no response for request %d" % request_id)
+            self._receive(remaining)
+        status, data = self.responses.pop(request_id)
+        if status != 0:
+            raise RpcError(status)
+        return data
+
+    def _receive(self, timeout):
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        if not ready:
+            return
+        self.rx_buf += os.read(self.fd, 4096)
+        while True:
+            end = self.rx_buf.find(b"\x00")
+            if end < 0:
+                return
+            frame = bytes(self.rx_buf[:end])
+            del self.rx_buf[:end + 1]
+            self._handle_frame(frame)
+
+    def _handle_frame(self, frame):
+        if not frame:
+            return
+        try:
+            payload = cobs_decode(frame)
+        except ValueError:
+            return
+        if len(payload) < 8:
+            return
+        body, crc = payload[:-4], struct.unpack("<I", payload[-4:])[0]
+        if zlib.crc32(body) != crc or not body[0] & OP_RESPONSE:
+            return
+        _, request_id, status = struct.unpack("<BHB", body[:4])
+        self.responses[request_id] = (status, body[4:])
+
+    def request(self, opcode, body=b""):
+        return self.wait(self.submit(opcode, body))
+
+    def ping(self, data=b""):
+        return self.request(OP_PING, data)
+
+    def call(self, function_id, args=b""):
+        return self.request(OP_CALL, bytes([function_id]) + args)
+
+    def mem_read(self, region, offset, length):
+        return self.request(OP_MEM_READ, struct.pack("<BIH", region, offset, length))
+
+    def mem_write(self, region, offset, data):
+        self.request(OP_MEM_WRITE, struct.pack("<BI", region, offset) + data)
+
+    def list_functions(self):
+        data = self.request(OP_LIST)
+        functions = {}
+        idx = 0
+        while idx + 2 <= len(data):
+            function_id, name_len = data[idx], data[idx + 1]
+            functions[function_id] = data[idx + 2:idx + 2 + name_len].decode(errors="replace")
+            idx += 2 + name_len
+        return functions
+
+    def pipeline(self, requests, window=32):
+        """Sends (opcode, body) requests keeping up to 'window' of them in flight - returns the responses in order"""
+        results = []
+        in_flight = []
+        for opcode, body in requests:
+            if len(in_flight) >= window:
+                results.append(self.wait(in_flight.pop(0)))
+            in_flight.append(self.submit(opcode, body))
+        for request_id in in_flight:
+            results.append(self.wait(request_id))
+        return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SerialRPC host client")
+    parser.add_argument("port", help="serial port or pty path")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--list", action="store_true", help="list the functions exposed by the device")
+    parser.add_argument("--bench", type=int, default=0, help="number of 'add' calls to run for benchmarking")
+    parser.add_argument("--window", type=int, default=32, help="number of pipelined requests in flight")
+    args = parser.parse_args()
+
+    client = SerialRpcClient(args.port, args.baudrate)
+    if args.list:
+        for function_id, name in sorted(client.list_functions().items()):
+            print("%3d: %s" % (function_id, name))
+
+    result = struct.unpack("<i", client.call(0, struct.pack("<ii", 40, 2)))[0]
+    print("add(40, 2) = %d" % result)
+
+    if args.bench:
+        requests = [(OP_CALL, bytes([0]) + struct.pack("<ii", i, i)) for i in range(args.bench)]
+        start = time.monotonic()
+        results = client.pipeline(requests, args.window)
+        elapsed = time.monotonic() - start
+        errors = sum(1 for i, r in enumerate(results) if struct.unpack("<i", r)[0] != 2 * i)
+        print("%d calls in %.3f s - %.0f calls/s, %d errors" % (args.bench, elapsed, args.bench / elapsed, errors))
+    client.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
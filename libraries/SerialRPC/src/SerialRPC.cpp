@@ -0,0 +1,67 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SerialRPC.h"
+
+SerialRPCClass::SerialRPCClass() :
+  serial(nullptr)
+{
+  ;
+}
+
+void SerialRPCClass::begin(arduino::UARTClass& serial)
+{
+  this->serial = &serial;
+  this->setOutput(SerialRPCClass::write_output, this);
+  // Frames end on the COBS delimiter - idle-line detection is not needed
+  serial.setFrameTrigger(0u, 0x00, 0u);
+  serial.onFrame(SerialRPCClass::on_frame, 0u);
+}
+
+void SerialRPCClass::end()
+{
+  if (!this->serial) {
+    return;
+  }
+  this->serial->onFrame(nullptr, 2u);
+  this->serial->setFrameTrigger(0u, -1, 2u);
+  this->serial = nullptr;
+}
+
+void SerialRPCClass::on_frame(const uint8_t* data, size_t len)
+{
+  SerialRPC.handleFrame(data, len);
+}
+
+void SerialRPCClass::write_output(const uint8_t* data, size_t len, void* context)
+{
+  SerialRPCClass* rpc = static_cast<SerialRPCClass*>(context);
+  if (rpc->serial) {
+    rpc->serial->write(data, len);
+  }
+}
+
+SerialRPCClass SerialRPC;
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SERIAL_RPC_H
+#define SERIAL_RPC_H
+
+#include <Arduino.h>
+#include "rpc_server.h"
+
+class SerialRPCClass : public serial_rpc::RpcServer {
+public:
+  /***************************************************************************//**
+   * Constructor for SerialRPCClass
+   ******************************************************************************/
+  SerialRPCClass();
+
+  /***************************************************************************//**
+   * Starts serving RPC requests on a serial port
+   * The requests are received with the framed Serial reception (frames delimited
+   * by zero bytes) and are served directly from the frame task.
+   * The serial port has to be started with begin() beforehand.
+   *
+   * @param[in] serial the serial port to serve the requests on
+   ******************************************************************************/
+  void begin(arduino::UARTClass& serial);
+
+  /***************************************************************************//**
+   * Stops serving RPC requests - the received data is available with read() again
+   ******************************************************************************/
+  void end();
+
+private:
+  static void on_frame(const uint8_t* data, size_t len);
+  static void write_output(const uint8_t* data, size_t len, void* context);
+
+  arduino::UARTClass* serial;
+};
+
+extern SerialRPCClass SerialRPC;
+
+#endif // SERIAL_RPC_H
@@ -0,0 +1,370 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "rpc_server.h"
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_SILABS)
+#include "Arduino.h"
+#endif // ARDUINO_ARCH_SILABS
+
+namespace serial_rpc {
+
+static inline uint16_t get_le16(const uint8_t* p)
+{
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_le32(const uint8_t* p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void put_le32(uint8_t* p, uint32_t value)
+{
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+  p[2] = (uint8_t)(value >> 16);
+  p[3] = (uint8_t)(value >> 24);
+}
+
+size_t cobs_encode(const uint8_t* src, size_t len, uint8_t* dst)
+{
+  size_t code_idx = 0u;
+  size_t out_idx = 1u;
+  uint8_t code = 1u;
+
+  for (size_t i = 0u; i < len; i++) {
+    if (src[i] != 0u) {
+      dst[out_idx++] = src[i];
+      code++;
+    }
+    if (src[i] == 0u || code == 0xFFu) {
+      dst[code_idx] = code;
+      code = 1u;
+      code_idx = out_idx++;
+    }
+  }
+  dst[code_idx] = code;
+  return out_idx;
+}
+
+size_t cobs_decode(const uint8_t* src, size_t len, uint8_t* dst)
+{
+  size_t in_idx = 0u;
+  size_t out_idx = 0u;
+
+  while (in_idx < len) {
+    uint8_t code = src[in_idx++];
+    if (code == 0u || in_idx + code - 1u > len) {
+      return 0u;
+    }
+    for (uint8_t i = 1u; i < code; i++) {
+      if (src[in_idx] == 0u) {
+        return 0u;
+      }
+      dst[out_idx++] = src[in_idx++];
+    }
+    // A zero is implied after every block except the last and the ones with the maximum length
+    if (code != 0xFFu && in_idx < len) {
+      dst[out_idx++] = 0u;
+    }
+  }
+  return out_idx;
+}
+
+uint32_t crc32(const uint8_t* data, size_t len)
+{
+#if defined(ARDUINO_ARCH_SILABS)
+  return calculateCRC32(data, len);
+#else
+  static const uint32_t crc32_nibble_table[16] = {
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu, 0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+  };
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0u; i < len; i++) {
+    crc = crc32_nibble_table[(crc ^ data[i]) & 0x0Fu] ^ (crc >> 4);
+    crc = crc32_nibble_table[(crc ^ (data[i] >> 4)) & 0x0Fu] ^ (crc >> 4);
+  }
+  return crc ^ 0xFFFFFFFFu;
+#endif // ARDUINO_ARCH_SILABS
+}
+
+RpcServer::RpcServer() :
+  write_fn(nullptr),
+  write_context(nullptr),
+  stream_len(0u),
+  stream_overflow(false),
+  request_count(0u),
+  error_count(0u)
+{
+  memset(this->functions, 0, sizeof(this->functions));
+  memset(this->regions, 0, sizeof(this->regions));
+}
+
+void RpcServer::setOutput(rpc_write_t write_fn, void* context)
+{
+  this->write_fn = write_fn;
+  this->write_context = context;
+}
+
+bool RpcServer::addFunction(uint8_t id, const char* name, rpc_function_t fn)
+{
+  if (id >= max_functions || fn == nullptr) {
+    return false;
+  }
+  this->functions[id].name = name;
+  this->functions[id].fn = fn;
+  return true;
+}
+
+bool RpcServer::addRegion(uint8_t id, void* base, size_t size, bool writable)
+{
+  if (id >= max_regions || base == nullptr) {
+    return false;
+  }
+  this->regions[id].base = (uint8_t*)base;
+  this->regions[id].size = size;
+  this->regions[id].writable = writable;
+  return true;
+}
+
+uint32_t RpcServer::getRequestCount()
+{
+  return this->request_count;
+}
+
+uint32_t RpcServer::getErrorCount()
+{
+  return this->error_count;
+}
+
+void RpcServer::feed(const uint8_t* data, size_t len)
+{
+  for (size_t i = 0u; i < len; i++) {
+    if (data[i] == 0u) {
+      if (this->stream_overflow) {
+        this->error_count++;
+      } else {
+        this->handleFrame(this->stream_buf, this->stream_len);
+      }
+      this->stream_len = 0u;
+      this->stream_overflow = false;
+      continue;
+    }
+    if (this->stream_len >= sizeof(this->stream_buf)) {
+      this->stream_overflow = true;
+      continue;
+    }
+    this->stream_buf[this->stream_len++] = data[i];
+  }
+}
+
+void RpcServer::handleFrame(const uint8_t* frame, size_t len)
+{
+  if (len > 0u && frame[len - 1u] == 0u) {
+    len--;
+  }
+  // Empty frames are used by the clients to resynchronize - ignore them
+  if (len == 0u) {
+    return;
+  }
+  if (len > max_encoded_size) {
+    this->error_count++;
+    return;
+  }
+
+  size_t decoded_len = cobs_decode(frame, len, this->decode_buf);
+  if (decoded_len < header_size + crc_size) {
+    this->error_count++;
+    return;
+  }
+
+  size_t payload_len = decoded_len - crc_size;
+  if (crc32(this->decode_buf, payload_len) != get_le32(this->decode_buf + payload_len)) {
+    this->error_count++;
+    return;
+  }
+
+  this->handle_request(this->decode_buf, payload_len);
+}
+
+void RpcServer::handle_request(const uint8_t* request, size_t len)
+{
+  uint8_t opcode = request[0];
+  uint16_t request_id = get_le16(request + 1u);
+  const uint8_t* body = request + header_size;
+  size_t body_len = len - header_size;
+
+  // The response consists of the header, a status byte, the result and the CRC
+  uint8_t* result = this->response_buf + header_size + 1u;
+  size_t result_max = max_frame_size - header_size - 1u - crc_size;
+  size_t result_len = 0u;
+  uint8_t status = STATUS_OK;
+
+  switch (opcode) {
+    case OP_PING:
+      if (body_len > result_max) {
+        status = STATUS_BAD_REQUEST;
+        break;
+      }
+      memcpy(result, body, body_len);
+      result_len = body_len;
+      break;
+    case OP_CALL:
+      result_len = this->handle_call(body, body_len, result, result_max, &status);
+      break;
+    case OP_MEM_READ:
+      result_len = this->handle_mem_read(body, body_len, result, result_max, &status);
+      break;
+    case OP_MEM_WRITE:
+      result_len = this->handle_mem_write(body, body_len, &status);
+      break;
+    case OP_LIST:
+      result_len = this->handle_list(result, result_max);
+      break;
+    default:
+      status = STATUS_BAD_REQUEST;
+      break;
+  }
+
+  this->request_count++;
+  this->send_response(opcode, request_id, status, result_len);
+}
+
+size_t RpcServer::handle_call(const uint8_t* body, size_t len, uint8_t* result, size_t result_max, uint8_t* status)
+{
+  if (len < 1u) {
+    *status = STATUS_BAD_REQUEST;
+    return 0u;
+  }
+  uint8_t id = body[0];
+  if (id >= max_functions || this->functions[id].fn == nullptr) {
+    *status = STATUS_UNKNOWN_FUNCTION;
+    return 0u;
+  }
+  int res = this->functions[id].fn(body + 1u, len - 1u, result, result_max);
+  if (res < 0 || (size_t)res > result_max) {
+    *status = STATUS_FUNCTION_ERROR;
+    return 0u;
+  }
+  return (size_t)res;
+}
+
+size_t RpcServer::handle_mem_read(const uint8_t* body, size_t len, uint8_t* result, size_t result_max, uint8_t* status)
+{
+  // region (1) + offset (4) + length (2)
+  if (len != 7u) {
+    *status = STATUS_BAD_REQUEST;
+    return 0u;
+  }
+  uint8_t id = body[0];
+  uint32_t offset = get_le32(body + 1u);
+  uint16_t read_len = get_le16(body + 5u);
+  if (id >= max_regions || this->regions[id].base == nullptr) {
+    *status = STATUS_UNKNOWN_REGION;
+    return 0u;
+  }
+  const rpc_region_entry_t& region = this->regions[id];
+  if (read_len > result_max || offset > region.size || read_len > region.size - offset) {
+    *status = STATUS_OUT_OF_BOUNDS;
+    return 0u;
+  }
+  memcpy(result, region.base + offset, read_len);
+  return read_len;
+}
+
+size_t RpcServer::handle_mem_write(const uint8_t* body, size_t len, uint8_t* status)
+{
+  // region (1) + offset (4) + data
+  if (len < 5u) {
+    *status = STATUS_BAD_REQUEST;
+    return 0u;
+  }
+  uint8_t id = body[0];
+  uint32_t offset = get_le32(body + 1u);
+  size_t write_len = len - 5u;
+  if (id >= max_regions || this->regions[id].base == nullptr) {
+    *status = STATUS_UNKNOWN_REGION;
+    return 0u;
+  }
+  const rpc_region_entry_t& region = this->regions[id];
+  if (!region.writable) {
+    *status = STATUS_READ_ONLY;
+    return 0u;
+  }
+  if (offset > region.size || write_len > region.size - offset) {
+    *status = STATUS_OUT_OF_BOUNDS;
+    return 0u;
+  }
+  memcpy(region.base + offset, body + 5u, write_len);
+  return 0u;
+}
+
+size_t RpcServer::handle_list(uint8_t* result, size_t result_max)
+{
+  // Each registered function is reported as: id (1) + name length (1) + name
+  size_t result_len = 0u;
+  for (uint8_t id = 0u; id < max_functions; id++) {
+    if (this->functions[id].fn == nullptr) {
+      continue;
+    }
+    const char* name = this->functions[id].name ? this->functions[id].name : "";
+    size_t name_len = strlen(name);
+    if (name_len > 0xFFu) {
+      name_len = 0xFFu;
+    }
+    if (result_len + 2u + name_len > result_max) {
+      break;
+    }
+    result[result_len++] = id;
+    result[result_len++] = (uint8_t)name_len;
+    memcpy(result + result_len, name, name_len);
+    result_len += name_len;
+  }
+  return result_len;
+}
+
+void RpcServer::send_response(uint8_t opcode, uint16_t request_id, uint8_t status, size_t data_len)
+{
+  if (this->write_fn == nullptr) {
+    return;
+  }
+  this->response_buf[0] = opcode | OP_RESPONSE;
+  this->response_buf[1] = (uint8_t)request_id;
+  this->response_buf[2] = (uint8_t)(request_id >> 8);
+  this->response_buf[3] = status;
+
+  size_t payload_len = header_size + 1u + data_len;
+  put_le32(this->response_buf + payload_len, crc32(this->response_buf, payload_len));
+
+  size_t encoded_len = cobs_encode(this->response_buf, payload_len + crc_size, this->encode_buf);
+  this->encode_buf[encoded_len++] = 0u;
+  this->write_fn(this->encode_buf, encoded_len, this->write_context);
+}
+
+} // namespace serial_rpc
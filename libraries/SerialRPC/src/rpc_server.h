@@ -0,0 +1,224 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RPC_SERVER_H
+#define RPC_SERVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The protocol engine has no Arduino dependencies so that it can also be built and run on a Linux host
+
+namespace serial_rpc {
+
+// Request opcodes - responses carry the request's opcode with the highest bit set
+enum : uint8_t {
+  OP_PING      = 0x01,
+  OP_CALL      = 0x02,
+  OP_MEM_READ  = 0x03,
+  OP_MEM_WRITE = 0x04,
+  OP_LIST      = 0x05,
+  OP_RESPONSE  = 0x80
+};
+
+// Response status codes
+enum : uint8_t {
+  STATUS_OK               = 0x00,
+  STATUS_BAD_REQUEST      = 0x01,
+  STATUS_UNKNOWN_FUNCTION = 0x02,
+  STATUS_UNKNOWN_REGION   = 0x03,
+  STATUS_OUT_OF_BOUNDS    = 0x04,
+  STATUS_READ_ONLY        = 0x05,
+  STATUS_FUNCTION_ERROR   = 0x06
+};
+
+/***************************************************************************//**
+ * RPC function handler
+ *
+ * @param[in] args pointer to the arguments received in the request
+ * @param[in] args_len length of the arguments in bytes
+ * @param[out] result buffer for the result of the call
+ * @param[in] result_max size of the result buffer in bytes
+ *
+ * @return the length of the result in bytes, or a negative value on error
+ ******************************************************************************/
+typedef int (*rpc_function_t)(const uint8_t* args, size_t args_len, uint8_t* result, size_t result_max);
+
+// Output function for the encoded response frames
+typedef void (*rpc_write_t)(const uint8_t* data, size_t len, void* context);
+
+/***************************************************************************//**
+ * Encodes a buffer with Consistent Overhead Byte Stuffing (COBS)
+ * The encoded data contains no zero bytes - the frame delimiter is not appended.
+ * The destination must be able to hold at least len + len / 254 + 1 bytes.
+ *
+ * @param[in] src the data to encode
+ * @param[in] len length of the data in bytes
+ * @param[out] dst buffer for the encoded data
+ *
+ * @return the length of the encoded data in bytes
+ ******************************************************************************/
+size_t cobs_encode(const uint8_t* src, size_t len, uint8_t* dst);
+
+/***************************************************************************//**
+ * Decodes a COBS encoded buffer (without the frame delimiter)
+ * The destination must be able to hold at least len bytes.
+ *
+ * @param[in] src the encoded data
+ * @param[in] len length of the encoded data in bytes
+ * @param[out] dst buffer for the decoded data
+ *
+ * @return the length of the decoded data in bytes, or 0 if the data is malformed
+ ******************************************************************************/
+size_t cobs_decode(const uint8_t* src, size_t len, uint8_t* dst);
+
+/***************************************************************************//**
+ * Calculates the CRC-32 (IEEE 802.3) checksum of a buffer
+ * Uses the GPCRC hardware on Silicon Labs devices and a software fallback on other hosts.
+ *
+ * @param[in] data pointer to the data
+ * @param[in] len length of the data in bytes
+ *
+ * @return the CRC-32 checksum of the data
+ ******************************************************************************/
+uint32_t crc32(const uint8_t* data, size_t len);
+
+class RpcServer {
+public:
+  static const size_t max_frame_size = 240u;
+  static const uint8_t max_functions = 32u;
+  static const uint8_t max_regions = 8u;
+
+  /***************************************************************************//**
+   * Constructor for RpcServer
+   ******************************************************************************/
+  RpcServer();
+
+  /***************************************************************************//**
+   * Sets the function used to send the encoded response frames
+   *
+   * @param[in] write_fn the output function
+   * @param[in] context user context passed to the output function
+   ******************************************************************************/
+  void setOutput(rpc_write_t write_fn, void* context);
+
+  /***************************************************************************//**
+   * Registers a function which can be called remotely
+   *
+   * @param[in] id the ID of the function used in the requests
+   * @param[in] name the name of the function reported to the clients (must remain valid)
+   * @param[in] fn the function handler
+   *
+   * @return true if the function was registered, false otherwise
+   ******************************************************************************/
+  bool addFunction(uint8_t id, const char* name, rpc_function_t fn);
+
+  /***************************************************************************//**
+   * Registers a memory region which can be read and optionally written remotely
+   *
+   * @param[in] id the ID of the region used in the requests
+   * @param[in] base the start of the memory region
+   * @param[in] size the size of the memory region in bytes
+   * @param[in] writable true if the clients are allowed to write the region
+   *
+   * @return true if the region was registered, false otherwise
+   ******************************************************************************/
+  bool addRegion(uint8_t id, void* base, size_t size, bool writable);
+
+  /***************************************************************************//**
+   * Processes one received frame
+   * The frame delimiter (zero byte) at the end is optional.
+   *
+   * @param[in] frame the COBS encoded frame
+   * @param[in] len length of the frame in bytes
+   ******************************************************************************/
+  void handleFrame(const uint8_t* frame, size_t len);
+
+  /***************************************************************************//**
+   * Processes a received byte stream - splits it into frames on the delimiters
+   *
+   * @param[in] data the received bytes
+   * @param[in] len number of the received bytes
+   ******************************************************************************/
+  void feed(const uint8_t* data, size_t len);
+
+  /***************************************************************************//**
+   * Returns the number of requests served
+   *
+   * @return the number of requests served
+   ******************************************************************************/
+  uint32_t getRequestCount();
+
+  /***************************************************************************//**
+   * Returns the number of dropped frames (malformed, too long or bad CRC)
+   *
+   * @return the number of dropped frames
+   ******************************************************************************/
+  uint32_t getErrorCount();
+
+private:
+  static const size_t header_size = 3u;   // opcode + request ID
+  static const size_t crc_size = 4u;
+  static const size_t max_encoded_size = max_frame_size + max_frame_size / 254u + 2u;
+
+  struct rpc_function_entry_t {
+    const char* name;
+    rpc_function_t fn;
+  };
+
+  struct rpc_region_entry_t {
+    uint8_t* base;
+    size_t size;
+    bool writable;
+  };
+
+  void handle_request(const uint8_t* request, size_t len);
+  size_t handle_call(const uint8_t* body, size_t len, uint8_t* result, size_t result_max, uint8_t* status);
+  size_t handle_mem_read(const uint8_t* body, size_t len, uint8_t* result, size_t result_max, uint8_t* status);
+  size_t handle_mem_write(const uint8_t* body, size_t len, uint8_t* status);
+  size_t handle_list(uint8_t* result, size_t result_max);
+  void send_response(uint8_t opcode, uint16_t request_id, uint8_t status, size_t data_len);
+
+  rpc_function_entry_t functions[max_functions];
+  rpc_region_entry_t regions[max_regions];
+
+  rpc_write_t write_fn;
+  void* write_context;
+
+  uint8_t decode_buf[max_encoded_size];
+  uint8_t response_buf[max_frame_size];
+  uint8_t encode_buf[max_encoded_size];
+  uint8_t stream_buf[max_encoded_size];
+  size_t stream_len;
+  bool stream_overflow;
+
+  uint32_t request_count;
+  uint32_t error_count;
+};
+
+} // namespace serial_rpc
+
+#endif // RPC_SERVER_H
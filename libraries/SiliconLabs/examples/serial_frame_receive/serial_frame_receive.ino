@@ -0,0 +1,46 @@
+/*
+   Serial frame receive example
+
+   The example shows how to receive packets on a serial port using idle-line framing.
+   Instead of polling available() the sketch registers a callback with Serial.onFrame()
+   which is called with a complete frame as soon as the line goes idle for the given
+   number of character times after the last received byte.
+
+   Send some data to the board (e.g. type a line in the Serial Monitor) and the sketch
+   will print the length and the contents of each received frame.
+
+   The frame callback runs in a separate task - keep it short and don't block in it.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+volatile uint32_t frames_received = 0u;
+
+void on_frame_received(const uint8_t* data, size_t len)
+{
+  frames_received++;
+  Serial.printf("Frame #%lu, %u bytes: ", frames_received, (unsigned int)len);
+  Serial.write(data, len);
+  Serial.println();
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println("Serial frame receive example");
+  // A frame ends when the line is idle for at least 2 character times
+  Serial.onFrame(on_frame_received, 2);
+}
+
+void loop()
+{
+  delay(1000);
+}
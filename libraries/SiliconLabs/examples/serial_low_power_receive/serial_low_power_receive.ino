@@ -0,0 +1,52 @@
+/*
+   Serial low power receive example
+
+   The example shows how to receive data on Serial1 while the device sleeps in EM2.
+   Serial1.beginLowPower() clocks the EUSART from the low frequency crystal (LFXO), so the
+   receiver keeps working in EM2 at up to 9600 baud. The received bytes are moved to a
+   ring buffer by the DMA and the sketch task only wakes up when a configured trigger fires.
+
+   Available wake triggers:
+   - a number of received bytes
+   - a delimiter character
+   - the RX line going idle for a number of character times
+
+   Connect a serial adapter (9600 baud, 8N1) to the Serial1 pins and send lines of text.
+   The sketch prints every received line on Serial.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println("Serial low power receive example");
+
+  if (!Serial1.beginLowPower(9600)) {
+    Serial.println("Low power serial is not supported on this board");
+    while (1) {
+      delay(1000);
+    }
+  }
+  // Wake up when a full line (terminated by '\n') or 64 bytes are received - don't use idle detection
+  Serial1.setFrameTrigger(64, '\n', 0);
+}
+
+void loop()
+{
+  // The device can sleep in EM2 while waiting here
+  if (!Serial1.waitForFrame(10000)) {
+    Serial.println("Nothing received in the last 10 seconds");
+    return;
+  }
+
+  Serial.print("Received: ");
+  while (Serial1.available()) {
+    Serial.write(Serial1.read());
+  }
+}
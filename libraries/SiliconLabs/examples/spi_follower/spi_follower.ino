@@ -0,0 +1,68 @@
+/*
+   SPI follower example
+
+   The example shows how to run the board as an SPI follower (slave) behind another
+   controller - for example a Linux SoC using the board as a co-processor.
+   The received data is written into a ring buffer by DMA and the data clocked out
+   to the leader is preloaded, so the CPU doesn't have to handle individual bytes.
+
+   The sketch emulates a small register file: the first byte of each transaction
+   is a command - with bit 7 set the rest of the transaction is written to the
+   registers from the address in bits 6..0, otherwise only the address is set.
+   The next transaction clocks out the registers from that address.
+   Register 0 holds a counter of the transactions, registers 1..3 can be written
+   by the leader and register 1 controls the built-in LED.
+
+   Connect the leader's SCK, MOSI, MISO and chip select lines to the SCK, MOSI,
+   MISO and SS pins of the board.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#include <SPI.h>
+
+SPIFollower follower(SPI);
+
+uint8_t rx_ring[256];
+uint8_t registers[16];
+volatile bool transaction_received = false;
+
+void on_transaction(size_t len)
+{
+  (void)len;
+  registers[0]++;
+  transaction_received = true;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+
+  follower.enableRegisters(registers, sizeof(registers));
+  follower.onTransaction(on_transaction);
+  if (!follower.begin(SS, rx_ring, sizeof(rx_ring), SPI_MODE0)) {
+    Serial.println("Failed to start SPI follower mode");
+    while (true) ;
+  }
+  Serial.println("SPI follower example");
+}
+
+void loop()
+{
+  if (!transaction_received) {
+    return;
+  }
+  transaction_received = false;
+  digitalWrite(LED_BUILTIN, registers[1] ? LED_BUILTIN_ACTIVE : LED_BUILTIN_INACTIVE);
+  Serial.printf("Transactions: %u, registers: %02x %02x %02x\n", registers[0], registers[1], registers[2], registers[3]);
+}
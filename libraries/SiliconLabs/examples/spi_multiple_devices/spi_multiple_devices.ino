@@ -0,0 +1,78 @@
+/*
+   SPI multiple devices example
+
+   The example shows how to share an SPI bus between devices with different settings
+   using SPIDevice. Each device keeps its own clock speed, mode, bit order and chip select.
+   The peripheral is configured through the driver only on the first transaction with
+   a device - afterwards switching between the devices only rewrites a few registers.
+
+   The sketch reads the JEDEC ID of a SPI flash at 20 MHz and the ID register of
+   a sensor at 1 MHz in turns and prints how long a thousand device switches take.
+   Change the chip select pins to match your wiring.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#include <SPI.h>
+
+#define FLASH_CS_PIN  SS
+#if defined(ARDUINO_SILABS_THINGPLUSMATTER)
+#define SENSOR_CS_PIN D7
+#else
+#define SENSOR_CS_PIN D5
+#endif
+
+SPIDevice flash(SPI, FLASH_CS_PIN, SPISettings(20000000, MSBFIRST, SPI_MODE0));
+SPIDevice sensor(SPI, SENSOR_CS_PIN, SPISettings(1000000, MSBFIRST, SPI_MODE3));
+
+uint32_t read_flash_id()
+{
+  flash.beginTransaction();
+  SPI.transfer(0x9F);
+  uint32_t id = 0;
+  for (int i = 0; i < 3; i++) {
+    id = (id << 8) | SPI.transfer(0x00);
+  }
+  flash.endTransaction();
+  return id;
+}
+
+uint8_t read_sensor_id()
+{
+  sensor.beginTransaction();
+  SPI.transfer(0x80 | 0x0F);
+  uint8_t id = SPI.transfer(0x00);
+  sensor.endTransaction();
+  return id;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  SPI.begin();
+  flash.begin();
+  sensor.begin();
+  Serial.println("SPI multiple devices example");
+}
+
+void loop()
+{
+  uint32_t flash_id = 0;
+  uint8_t sensor_id = 0;
+  uint32_t start = micros();
+  for (int i = 0; i < 500; i++) {
+    flash_id = read_flash_id();
+    sensor_id = read_sensor_id();
+  }
+  uint32_t elapsed = micros() - start;
+  Serial.printf("Flash ID: 0x%06lx, sensor ID: 0x%02x, 1000 transactions took %lu us\n", flash_id, sensor_id, elapsed);
+  delay(1000);
+}
@@ -0,0 +1,76 @@
+/*
+   SPI queued transactions example
+
+   The example shows how to queue SPI transactions to multiple devices and let them
+   run in the background. Each job lists its device and the buffers to transfer -
+   the queue selects the device, transfers the buffers with DMA, releases the chip
+   select and starts the next job right from the DMA interrupt.
+
+   The sketch queues a JEDEC ID read to a SPI flash and an ID register read
+   to a sensor, then counts how many loops it could run while the transfers were in progress.
+   Change the chip select pins to match your wiring.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#include <SPI.h>
+
+#define FLASH_CS_PIN  SS
+#if defined(ARDUINO_SILABS_THINGPLUSMATTER)
+#define SENSOR_CS_PIN D7
+#else
+#define SENSOR_CS_PIN D5
+#endif
+
+SPIDevice flash(SPI, FLASH_CS_PIN, SPISettings(20000000, MSBFIRST, SPI_MODE0));
+SPIDevice sensor(SPI, SENSOR_CS_PIN, SPISettings(1000000, MSBFIRST, SPI_MODE3));
+
+uint8_t flash_cmd[1] = { 0x9F };
+uint8_t flash_id[3];
+SPISegment flash_segments[2] = {
+  { flash_cmd, nullptr, sizeof(flash_cmd) },
+  { nullptr, flash_id, sizeof(flash_id) }
+};
+SPIJob flash_job(&flash, flash_segments, 2);
+
+uint8_t sensor_tx[2] = { 0x80 | 0x0F, 0x00 };
+uint8_t sensor_rx[2];
+SPISegment sensor_segment = { sensor_tx, sensor_rx, sizeof(sensor_tx) };
+// The sensor job gets a higher priority - it is started first
+SPIJob sensor_job(&sensor, &sensor_segment, 1, 1);
+
+void setup()
+{
+  Serial.begin(115200);
+  SPI.begin();
+  flash.begin();
+  sensor.begin();
+  Serial.println("SPI queued transactions example");
+}
+
+void loop()
+{
+  SPI.queueTransaction(flash_job);
+  SPI.queueTransaction(sensor_job);
+
+  // Do other work while the transfers run
+  uint32_t idle_loops = 0;
+  while (flash_job.state == spi_queue::JOB_QUEUED || flash_job.state == spi_queue::JOB_ACTIVE) {
+    idle_loops++;
+  }
+
+  bool flash_ok = SPI.waitForTransaction(flash_job, 100);
+  bool sensor_ok = SPI.waitForTransaction(sensor_job, 100);
+  Serial.printf("Flash ID: %02x%02x%02x (%s), sensor ID: 0x%02x (%s), %lu loops ran meanwhile\n",
+                flash_id[0], flash_id[1], flash_id[2], flash_ok ? "ok" : "failed",
+                sensor_rx[1], sensor_ok ? "ok" : "failed", idle_loops);
+  delay(1000);
+}
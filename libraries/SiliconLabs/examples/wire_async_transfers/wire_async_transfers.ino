@@ -0,0 +1,78 @@
+/*
+   Wire asynchronous transfers example
+
+   The example shows how to run I2C transfers in the background with
+   Wire.requestFromAsync() and Wire.endTransmissionAsync(). The transfer is driven
+   by the I2C interrupt - the sketch can do other work (or the CPU can sleep)
+   while the bytes move on the bus, and a callback reports the completion.
+
+   The sketch reads the 6 bytes of accelerometer data from an I2C IMU at address 0x68
+   (an MPU-6050 or similar) and counts how many loops ran while the transfer was in progress.
+   Change the address and the register to match your device.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#include <Wire.h>
+
+#define IMU_ADDRESS    0x68
+#define IMU_DATA_REG   0x3B
+
+volatile bool transfer_done = false;
+volatile uint8_t transfer_status = 0;
+
+void on_transfer_done(uint8_t status)
+{
+  transfer_status = status;
+  transfer_done = true;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Wire.begin();
+  Wire.setClock(100000);
+  Serial.println("Wire asynchronous transfers example");
+}
+
+void loop()
+{
+  // Write the register address, then read the data with a repeated start
+  Wire.beginTransmission(IMU_ADDRESS);
+  Wire.write(IMU_DATA_REG);
+  Wire.endTransmission(false);
+  transfer_done = false;
+  if (!Wire.requestFromAsync(IMU_ADDRESS, 6, on_transfer_done)) {
+    Serial.println("Failed to start the transfer");
+    delay(1000);
+    return;
+  }
+
+  // Do other work while the transfer is in progress
+  uint32_t idle_loops = 0;
+  while (!transfer_done) {
+    idle_loops++;
+  }
+
+  if (transfer_status == 0) {
+    uint8_t data[6];
+    for (int i = 0; i < 6; i++) {
+      data[i] = Wire.read();
+    }
+    int16_t x = (data[0] << 8) | data[1];
+    int16_t y = (data[2] << 8) | data[3];
+    int16_t z = (data[4] << 8) | data[5];
+    Serial.printf("Accel x: %d, y: %d, z: %d, %lu loops ran during the transfer\n", x, y, z, idle_loops);
+  } else {
+    Serial.printf("Transfer failed with status %u\n", transfer_status);
+  }
+  delay(1000);
+}
@@ -0,0 +1,74 @@
+/*
+   Wire follower registers example
+
+   The example shows how to make the board behave like an I2C peripheral with a register map.
+   The leader writes a register address followed by data to write registers, or writes
+   the address and reads with a repeated start to read registers - the register pointer
+   increments after each byte. The requests are served right in the I2C interrupt without
+   calling any sketch code, so the response time doesn't depend on the sketch.
+
+   The register map has 8 registers:
+   - 0x00: device ID (read-only)
+   - 0x01: LED control - 1 turns the built-in LED on, 0 turns it off
+   - 0x02..0x03: uptime in seconds, MSB first (read-only)
+   - 0x04..0x07: scratch registers
+
+   The board joins the bus at address 0x42.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG27 Dev Kit
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - BGM220 Explorer Kit
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#include <Wire.h>
+
+#define FOLLOWER_ADDRESS 0x42
+
+uint8_t registers[8] = { 0xA5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+const uint8_t register_access[8] = {
+  TwoWire::REGISTER_READ,
+  TwoWire::REGISTER_READ_WRITE,
+  TwoWire::REGISTER_READ,
+  TwoWire::REGISTER_READ,
+  TwoWire::REGISTER_READ_WRITE,
+  TwoWire::REGISTER_READ_WRITE,
+  TwoWire::REGISTER_READ_WRITE,
+  TwoWire::REGISTER_READ_WRITE
+};
+
+// Called from a task after the leader wrote registers
+void on_registers_written(uint8_t first_register, size_t count)
+{
+  Serial.printf("Leader wrote %u register(s) from 0x%02x\n", count, first_register);
+  if (first_register <= 0x01 && first_register + count > 0x01) {
+    digitalWrite(LED_BUILTIN, registers[1] ? LED_BUILTIN_ACTIVE : LED_BUILTIN_INACTIVE);
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+
+  Wire.setRegisterMap(registers, sizeof(registers), register_access);
+  Wire.onRegistersWritten(on_registers_written);
+  Wire.begin(FOLLOWER_ADDRESS);
+  Serial.println("Wire follower registers example");
+}
+
+void loop()
+{
+  uint16_t uptime = millis() / 1000;
+  noInterrupts();
+  registers[2] = uptime >> 8;
+  registers[3] = uptime & 0xFF;
+  interrupts();
+  delay(100);
+}
@@ -37,6 +37,7 @@ TwoWire::TwoWire(I2C_TypeDef* i2c_peripheral,
                  I2CSPM_Init_TypeDef* i2c_config) :
   role(wire_role_t::NOT_INITIALIZED),
   timeout_flag(false),
+  reset_on_timeout(true),
   follower_address(0u),
   transmission_in_progress(false),
   tx_buf_write_idx(0u),
@@ -46,7 +47,24 @@ TwoWire::TwoWire(I2C_TypeDef* i2c_peripheral,
   follower_transaction_in_progress(false),
   user_onreceive_cb(nullptr),
   user_onrequest_cb(nullptr),
+  register_map(nullptr),
+  register_map_size(0u),
+  register_access(nullptr),
+  register_pointer(0u),
+  register_pointer_pending(false),
+  registers_written_first(UINT16_MAX),
+  registers_written_last(0u),
+  user_onregisterswritten_cb(nullptr),
+  register_task_handle(nullptr),
   wire_mutex(nullptr),
+  timeout_us(25000u),
+  transfer_progress_us(0u),
+  transfer_active(false),
+  transfer_timed_out(false),
+  transfer_result(i2cTransferDone),
+  transfer_rx_len(0u),
+  transfer_callback(nullptr),
+  transfer_done(nullptr),
   i2c_peripheral(i2c_peripheral),
   i2c_peripheral_num(i2c_peripheral_num),
   i2c_scl_port(i2c_scl_port),
@@ -59,6 +77,10 @@ TwoWire::TwoWire(I2C_TypeDef* i2c_peripheral,
   memset(this->tx_buffer, 0x00, sizeof(this->tx_buffer));
   this->wire_mutex = xSemaphoreCreateMutexStatic(&this->wire_mutex_buf);
   configASSERT(this->wire_mutex);
+  this->transfer_done = xSemaphoreCreateBinaryStatic(&this->transfer_done_buf);
+  configASSERT(this->transfer_done);
+  memset(&this->transfer_seq, 0x00, sizeof(this->transfer_seq));
+  memset(&this->abort_counters, 0x00, sizeof(this->abort_counters));
 }
 
 void TwoWire::begin()
@@ -68,6 +90,12 @@ void TwoWire::begin()
   }
   this->role = wire_role_t::LEADER;
   I2CSPM_Init(this->i2c_config);
+  // Free the bus if a follower was left holding SDA low - e.g. by a reset during a transfer
+  if (!GPIO_PinInGet(this->i2c_sda_port, this->i2c_sda_pin)) {
+    this->recoverBus();
+  }
+  // Transfers are driven by the interrupt handler
+  this->enable_irq();
 }
 
 void TwoWire::begin(uint8_t follower_mode_address)
@@ -107,6 +135,11 @@ void TwoWire::begin(uint8_t follower_mode_address)
   I2C_IntClear(this->i2c_peripheral, _I2C_IF_MASK);
   I2C_IntEnable(this->i2c_peripheral, I2C_IEN_ADDR | I2C_IEN_RXDATAV | I2C_IEN_ACK | I2C_IEN_SSTOP | I2C_IEN_BUSERR | I2C_IEN_ARBLOST);
 
+  this->enable_irq();
+}
+
+void TwoWire::enable_irq()
+{
   #if defined(I2C0)
   if (this->i2c_peripheral == I2C0) {
     NVIC_EnableIRQ(I2C0_IRQn);
@@ -126,6 +159,12 @@ void TwoWire::begin(uint8_t follower_mode_address)
 
 void TwoWire::end()
 {
+  // An asynchronous transfer may still be using the bus - wait for it the same way the other leader calls do
+  bool leader = this->role == wire_role_t::LEADER;
+  if (leader) {
+    xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+    this->wait_transfer();
+  }
   this->role = wire_role_t::NOT_INITIALIZED;
   this->timeout_flag = false;
   this->follower_address = 0u;
@@ -140,6 +179,9 @@ void TwoWire::end()
   this->follower_mode_rx_buffer.clear();
 
   I2C_Deinit(this->i2c_peripheral);
+  if (leader) {
+    xSemaphoreGive(this->wire_mutex);
+  }
 }
 
 uint8_t TwoWire::requestFrom(uint8_t follower_address, uint8_t number_of_bytes)
@@ -148,11 +190,16 @@ uint8_t TwoWire::requestFrom(uint8_t follower_address, uint8_t number_of_bytes)
     return 0;
   }
 
+  // The transfer sequence and the buffers are shared with the other tasks using the bus
+  xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+  this->wait_transfer();
+
   // Check for overflow when requesting more bytes than the buffer size
   if (number_of_bytes > this->rx_buffer_size) {
     this->tx_buf_write_idx = 0u;
     this->rx_buf_read_idx = 0u;
     this->rx_buf_available = 0u;
+    xSemaphoreGive(this->wire_mutex);
     return 0;
   }
 
@@ -162,33 +209,27 @@ uint8_t TwoWire::requestFrom(uint8_t follower_address, uint8_t number_of_bytes)
   this->tx_buf_write_idx = 0u;
   this->rx_buf_read_idx = 0u;
   this->rx_buf_available = 0u;
+  // The read always ends with a STOP condition - any transmission left open by endTransmission(false) is over
+  this->follower_address = 0;
+  this->transmission_in_progress = false;
 
   // If the I2C operation was successful
   if (ret == 0) {
     this->rx_buf_available = number_of_bytes;
-    if (this->user_onreceive_cb) {
-      this->user_onreceive_cb(this->rx_buf_available);
-    }
-    return this->rx_buf_available;
   }
+  xSemaphoreGive(this->wire_mutex);
 
-  // End the transmission if configured and it has run to a timeout
-  if (this->reset_on_timeout && this->timeout_flag && ret != 0) {
-    this->endTransmission(true);
+  if (ret == 0 && this->user_onreceive_cb) {
+    this->user_onreceive_cb(this->rx_buf_available);
   }
-
-  return 0;
+  return (ret == 0) ? number_of_bytes : 0;
 }
 
 uint8_t TwoWire::requestFrom(uint8_t address, uint8_t number_of_bytes, uint8_t stop)
 {
-  if (this->role == wire_role_t::NOT_INITIALIZED || this->role == wire_role_t::FOLLOWER) {
-    return 0;
-  }
-
-  uint8_t result = this->requestFrom(address, number_of_bytes);
-  this->endTransmission(stop);
-  return result;
+  // The read always ends with a STOP condition - endTransmission() isn't called as it releases the bus mutex
+  (void)stop;
+  return this->requestFrom(address, number_of_bytes);
 }
 
 void TwoWire::beginTransmission(uint16_t follower_address)
@@ -198,6 +239,8 @@ void TwoWire::beginTransmission(uint16_t follower_address)
   }
 
   xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+  // The Tx buffer may still be in use by an asynchronous transfer
+  this->wait_transfer();
   this->follower_address = follower_address;
   transmission_in_progress = true;
 }
@@ -221,13 +264,87 @@ uint8_t TwoWire::endTransmission(bool stop)
 
     if (ret != 0) {
       xSemaphoreGive(this->wire_mutex);
-      return WireStatus::OTHER_ERROR;
+      return this->to_wire_status((I2C_TransferReturn_TypeDef)ret);
     }
   }
   xSemaphoreGive(this->wire_mutex);
   return 0;
 }
 
+bool TwoWire::requestFromAsync(uint8_t address, uint8_t number_of_bytes, transfer_callback_t callback)
+{
+  if (this->role != wire_role_t::LEADER || number_of_bytes > this->rx_buffer_size) {
+    return false;
+  }
+  // The transfer sequence and the buffers are shared with the other tasks using the bus
+  xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+  this->wait_transfer();
+
+  this->transfer_seq.addr = address << 1;
+  if (this->tx_buf_write_idx > 0) {
+    this->transfer_seq.flags = I2C_FLAG_WRITE_READ;
+    this->transfer_seq.buf[0].data = this->tx_buffer;
+    this->transfer_seq.buf[0].len = this->tx_buf_write_idx;
+    this->transfer_seq.buf[1].data = this->rx_buffer;
+    this->transfer_seq.buf[1].len = number_of_bytes;
+  } else {
+    this->transfer_seq.flags = I2C_FLAG_READ;
+    this->transfer_seq.buf[0].data = this->rx_buffer;
+    this->transfer_seq.buf[0].len = number_of_bytes;
+  }
+  this->tx_buf_write_idx = 0u;
+  bool started = this->start_transfer(number_of_bytes, callback);
+  xSemaphoreGive(this->wire_mutex);
+  return started;
+}
+
+bool TwoWire::endTransmissionAsync(transfer_callback_t callback)
+{
+  if (this->role != wire_role_t::LEADER || !this->transmission_in_progress) {
+    return false;
+  }
+
+  bool started = true;
+  if (this->tx_buf_write_idx > 0) {
+    this->transfer_seq.addr = this->follower_address << 1;
+    this->transfer_seq.flags = I2C_FLAG_WRITE;
+    this->transfer_seq.buf[0].data = this->tx_buffer;
+    this->transfer_seq.buf[0].len = this->tx_buf_write_idx;
+    started = this->start_transfer(0u, callback);
+  } else if (callback) {
+    // Nothing to send - same as endTransmission()
+    callback(WireStatus::SUCCESS);
+  }
+
+  this->tx_buf_write_idx = 0u;
+  this->follower_address = 0;
+  this->transmission_in_progress = false;
+  xSemaphoreGive(this->wire_mutex);
+  return started;
+}
+
+bool TwoWire::isBusy()
+{
+  // Polling also enforces the timeout of asynchronous transfers - the abort (and the bus recovery)
+  // is left to the mutex holder if another transmission is in progress, polling never blocks
+  if (this->transfer_stalled() && xSemaphoreTake(this->wire_mutex, 0u) == pdTRUE) {
+    if (this->transfer_stalled()) {
+      this->abort_transfer();
+    }
+    xSemaphoreGive(this->wire_mutex);
+  }
+  return this->transfer_active;
+}
+
+uint8_t TwoWire::waitForTransfer()
+{
+  // The wait may abort the transfer on a timeout and recover the bus
+  xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+  I2C_TransferReturn_TypeDef ret = this->wait_transfer();
+  xSemaphoreGive(this->wire_mutex);
+  return this->to_wire_status(ret);
+}
+
 size_t TwoWire::write(uint8_t value)
 {
   if (this->role == wire_role_t::NOT_INITIALIZED) {
@@ -268,17 +385,67 @@ size_t TwoWire::write(const uint8_t* data, size_t size)
   if (!data || size == 0) {
     return 0;
   }
-  size_t bytes_written = 0;
-  for (size_t i = 0; i < size; i++) {
-    size_t res = this->write(data[i]);
-    if (res == 0) {
-      return bytes_written;
-    }
-    bytes_written += res;
+  if (!this->transmission_in_progress) {
+    return -1;
   }
+
+  // Copy as much as fits into the Tx buffer - the truncated data is kept and the returned count tells what was taken
+  size_t space = this->tx_buffer_size - this->tx_buf_write_idx;
+  size_t bytes_written = (size > space) ? space : size;
+  memcpy(this->tx_buffer + this->tx_buf_write_idx, data, bytes_written);
+  this->tx_buf_write_idx += bytes_written;
   return bytes_written;
 }
 
+uint8_t TwoWire::readRegisters(uint8_t address, uint16_t reg, uint8_t* buf, size_t len, uint8_t reg_size)
+{
+  return this->register_transfer(address, reg, reg_size, I2C_FLAG_WRITE_READ, buf, len);
+}
+
+uint8_t TwoWire::writeRegisters(uint8_t address, uint16_t reg, const uint8_t* buf, size_t len, uint8_t reg_size)
+{
+  // The buffer is only read by the transfer
+  return this->register_transfer(address, reg, reg_size, I2C_FLAG_WRITE_WRITE, const_cast<uint8_t*>(buf), len);
+}
+
+uint8_t TwoWire::register_transfer(uint8_t address, uint16_t reg, uint8_t reg_size, uint16_t flags, uint8_t* buf, size_t len)
+{
+  if (this->role != wire_role_t::LEADER) {
+    return WireStatus::OTHER_ERROR;
+  }
+  if (!buf || len == 0u || (reg_size != 1u && reg_size != 2u)) {
+    return WireStatus::OTHER_ERROR;
+  }
+  // The length of an emlib transfer buffer is 16 bits
+  if (len > UINT16_MAX) {
+    return WireStatus::DATA_TOO_LONG;
+  }
+
+  xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+  this->wait_transfer();
+
+  if (reg_size == 2u) {
+    this->register_address_buf[0] = (uint8_t)(reg >> 8);
+    this->register_address_buf[1] = (uint8_t)reg;
+  } else {
+    this->register_address_buf[0] = (uint8_t)reg;
+  }
+  this->transfer_seq.addr = address << 1;
+  this->transfer_seq.flags = flags;
+  this->transfer_seq.buf[0].data = this->register_address_buf;
+  this->transfer_seq.buf[0].len = reg_size;
+  this->transfer_seq.buf[1].data = buf;
+  this->transfer_seq.buf[1].len = (uint16_t)len;
+
+  I2C_TransferReturn_TypeDef ret = this->transfer_result;
+  if (this->start_transfer(0u, nullptr)) {
+    ret = this->wait_transfer();
+  }
+  xSemaphoreGive(this->wire_mutex);
+
+  return this->to_wire_status(ret);
+}
+
 int TwoWire::available()
 {
   if (this->role == wire_role_t::FOLLOWER) {
@@ -334,10 +501,34 @@ void TwoWire::onRequest(void (*user_onrequest_cb)(void))
   this->user_onrequest_cb = user_onrequest_cb;
 }
 
+void TwoWire::setRegisterMap(uint8_t* registers, size_t size, const uint8_t* access)
+{
+  taskENTER_CRITICAL();
+  this->register_map = registers;
+  this->register_map_size = (size > 256u) ? 256u : size;
+  this->register_access = access;
+  this->register_pointer = 0u;
+  this->register_pointer_pending = false;
+  taskEXIT_CRITICAL();
+}
+
+void TwoWire::onRegistersWritten(void (*user_onregisterswritten_cb)(uint8_t, size_t))
+{
+  this->user_onregisterswritten_cb = user_onregisterswritten_cb;
+  if (this->register_task_handle || !user_onregisterswritten_cb) {
+    return;
+  }
+  xTaskCreate(TwoWire::register_task,
+              "wire_register_task",
+              register_task_stack_size / sizeof(StackType_t),
+              this,
+              register_task_priority,
+              &this->register_task_handle);
+}
+
 void TwoWire::setWireTimeout(int timeout, bool reset_on_timeout)
 {
-  // The I2CSPM driver doesn't allow us to configure the timeout value
-  (void)timeout;
+  this->timeout_us = (timeout > 0) ? (uint32_t)timeout : 0u;
   this->reset_on_timeout = reset_on_timeout;
 }
 
@@ -351,11 +542,70 @@ bool TwoWire::getWireTimeoutFlag()
   return this->timeout_flag;
 }
 
+bool TwoWire::recoverBus()
+{
+  if (this->role != wire_role_t::LEADER) {
+    return false;
+  }
+  // Take the pins from the peripheral and drive them by hand
+  GPIO->I2CROUTE[this->i2c_peripheral_num].ROUTEEN = 0u;
+  GPIO_PinModeSet(this->i2c_scl_port, this->i2c_scl_pin, gpioModeWiredAndPullUp, 1);
+  GPIO_PinModeSet(this->i2c_sda_port, this->i2c_sda_pin, gpioModeWiredAndPullUp, 1);
+
+  // Clock the follower until it releases SDA - it's done after at most 9 clocks (8 data bits and an ACK)
+  const uint32_t half_period_us = 5u;
+  for (uint8_t i = 0u; i < 9u && !GPIO_PinInGet(this->i2c_sda_port, this->i2c_sda_pin); i++) {
+    GPIO_PinOutClear(this->i2c_scl_port, this->i2c_scl_pin);
+    delayMicroseconds(half_period_us);
+    GPIO_PinOutSet(this->i2c_scl_port, this->i2c_scl_pin);
+    // Wait for a follower stretching the clock
+    for (uint32_t wait_us = 0u; wait_us < 1000u && !GPIO_PinInGet(this->i2c_scl_port, this->i2c_scl_pin); wait_us++) {
+      delayMicroseconds(1u);
+    }
+    delayMicroseconds(half_period_us);
+  }
+
+  // Generate a STOP condition - SDA rising while SCL is high
+  GPIO_PinOutClear(this->i2c_scl_port, this->i2c_scl_pin);
+  delayMicroseconds(half_period_us);
+  GPIO_PinOutClear(this->i2c_sda_port, this->i2c_sda_pin);
+  delayMicroseconds(half_period_us);
+  GPIO_PinOutSet(this->i2c_scl_port, this->i2c_scl_pin);
+  delayMicroseconds(half_period_us);
+  GPIO_PinOutSet(this->i2c_sda_port, this->i2c_sda_pin);
+  delayMicroseconds(half_period_us);
+  bool released = GPIO_PinInGet(this->i2c_sda_port, this->i2c_sda_pin);
+
+  // Reinitialize the peripheral - this also routes the pins back to it
+  I2CSPM_Init(this->i2c_config);
+  I2C_IntClear(this->i2c_peripheral, _I2C_IF_MASK);
+  this->abort_counters.bus_recoveries++;
+  return released;
+}
+
+TwoWire::AbortCounters TwoWire::getAbortCounters()
+{
+  taskENTER_CRITICAL();
+  AbortCounters counters = this->abort_counters;
+  taskEXIT_CRITICAL();
+  return counters;
+}
+
+void TwoWire::clearAbortCounters()
+{
+  taskENTER_CRITICAL();
+  memset(&this->abort_counters, 0x00, sizeof(this->abort_counters));
+  taskEXIT_CRITICAL();
+}
+
 uint32_t TwoWire::i2c_leader_read(uint8_t *cmd, size_t cmdLen, uint8_t *result, size_t resultLen, uint16_t i2c_address)
 {
-  I2C_TransferSeq_TypeDef seq;
+  I2C_TransferSeq_TypeDef& seq = this->transfer_seq;
   I2C_TransferReturn_TypeDef ret;
 
+  // Wait for the asynchronous transfer in progress
+  this->wait_transfer();
+
   seq.addr = i2c_address << 1;
 
   if (cmdLen > 0) {
@@ -372,23 +622,23 @@ uint32_t TwoWire::i2c_leader_read(uint8_t *cmd, size_t cmdLen, uint8_t *result,
     seq.buf[0].len  = resultLen;
   }
 
-  ret = I2CSPM_Transfer(this->i2c_peripheral, &seq);
-
-  if (ret == i2cTransferNack) {
-    return ret;
-  } else if (ret != i2cTransferDone) {
-    this->timeout_flag = true;
-    return ret;
+  // The task yields until the interrupt handler finishes the transfer
+  if (!this->start_transfer(0u, nullptr)) {
+    return this->transfer_result;
   }
+  ret = this->wait_transfer();
 
   return ret;
 }
 
 uint32_t TwoWire::i2c_leader_write(uint8_t *cmd, size_t cmdLen, uint8_t *data, size_t dataLen, uint16_t i2c_address)
 {
-  I2C_TransferSeq_TypeDef seq;
+  I2C_TransferSeq_TypeDef& seq = this->transfer_seq;
   I2C_TransferReturn_TypeDef ret;
 
+  // Wait for the asynchronous transfer in progress
+  this->wait_transfer();
+
   seq.addr = i2c_address << 1;
   seq.buf[0].data = cmd;
   seq.buf[0].len = cmdLen;
@@ -401,20 +651,179 @@ uint32_t TwoWire::i2c_leader_write(uint8_t *cmd, size_t cmdLen, uint8_t *data, s
     seq.flags = I2C_FLAG_WRITE;
   }
 
-  ret = I2CSPM_Transfer(this->i2c_peripheral, &seq);
+  // The task yields until the interrupt handler finishes the transfer
+  if (!this->start_transfer(0u, nullptr)) {
+    return this->transfer_result;
+  }
+  ret = this->wait_transfer();
+
+  return ret;
+}
+
+bool TwoWire::start_transfer(size_t rx_len, transfer_callback_t callback)
+{
+  // Drop the completion signal of an earlier transfer nobody waited for
+  xSemaphoreTake(this->transfer_done, 0);
 
-  if (ret == i2cTransferNack) {
-    return ret;
-  } else if (ret != i2cTransferDone) {
+  this->transfer_rx_len = rx_len;
+  this->transfer_callback = callback;
+  this->transfer_timed_out = false;
+  if (rx_len > 0u) {
+    this->rx_buf_read_idx = 0u;
+    this->rx_buf_available = 0u;
+  }
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  // Require at least EM1 to keep the I2C peripheral running while the CPU sleeps
+  sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+
+  this->transfer_progress_us = micros();
+  this->transfer_active = true;
+  I2C_TransferReturn_TypeDef ret = I2C_TransferInit(this->i2c_peripheral, &this->transfer_seq);
+  if (ret != i2cTransferInProgress) {
+    this->transfer_active = false;
+    this->transfer_result = ret;
+    this->transfer_callback = nullptr;
+    #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+    sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+    #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+    return false;
+  }
+  return true;
+}
+
+I2C_TransferReturn_TypeDef TwoWire::wait_transfer()
+{
+  while (this->transfer_active) {
+    if (this->timeout_us == 0u) {
+      xSemaphoreTake(this->transfer_done, portMAX_DELAY);
+      continue;
+    }
+    // Sleep until the transfer completes or the time without progress reaches the timeout
+    uint32_t idle_us = micros() - this->transfer_progress_us;
+    if (idle_us >= this->timeout_us) {
+      this->abort_transfer();
+      break;
+    }
+    TickType_t wait_ticks = pdMS_TO_TICKS((this->timeout_us - idle_us + 999u) / 1000u);
+    xSemaphoreTake(this->transfer_done, (wait_ticks > 0u) ? wait_ticks : 1u);
+  }
+  return this->transfer_result;
+}
+
+bool TwoWire::transfer_stalled()
+{
+  return this->transfer_active && this->timeout_us > 0u
+         && (uint32_t)(micros() - this->transfer_progress_us) >= this->timeout_us;
+}
+
+void TwoWire::abort_transfer()
+{
+  transfer_callback_t callback = nullptr;
+  taskENTER_CRITICAL();
+  bool aborted = this->transfer_active;
+  if (aborted) {
+    I2C_IntDisable(this->i2c_peripheral, _I2C_IEN_MASK);
+    I2C_IntClear(this->i2c_peripheral, _I2C_IF_MASK);
+    this->i2c_peripheral->CMD = I2C_CMD_ABORT;
+    this->transfer_timed_out = true;
     this->timeout_flag = true;
-    return ret;
+    this->transfer_result = i2cTransferSwFault;
+    this->transfer_active = false;
+    this->abort_counters.timeouts++;
+    callback = this->transfer_callback;
+    this->transfer_callback = nullptr;
   }
+  taskEXIT_CRITICAL();
 
-  return ret;
+  if (!aborted) {
+    return;
+  }
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+  // A follower holding the bus is freed before anyone is told about the timeout
+  if (this->reset_on_timeout) {
+    this->recoverBus();
+  }
+  if (callback) {
+    callback(WireStatus::TIMEOUT);
+  }
+}
+
+// Called from the interrupt handler when the transfer finishes
+void TwoWire::finish_transfer(I2C_TransferReturn_TypeDef result)
+{
+  this->transfer_result = result;
+  switch (result) {
+    case i2cTransferDone:
+      break;
+    case i2cTransferNack:
+      this->abort_counters.nacks++;
+      break;
+    case i2cTransferBusErr:
+      this->abort_counters.bus_errors++;
+      break;
+    case i2cTransferArbLost:
+      this->abort_counters.arbitration_lost++;
+      break;
+    default:
+      this->abort_counters.other_errors++;
+      break;
+  }
+  if (result == i2cTransferDone && this->transfer_rx_len > 0u) {
+    this->rx_buf_read_idx = 0u;
+    this->rx_buf_available = this->transfer_rx_len;
+  }
+  this->transfer_active = false;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+
+  transfer_callback_t callback = this->transfer_callback;
+  this->transfer_callback = nullptr;
+  if (callback) {
+    callback(this->to_wire_status(result));
+  }
+
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  xSemaphoreGiveFromISR(this->transfer_done, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+uint8_t TwoWire::to_wire_status(I2C_TransferReturn_TypeDef result)
+{
+  switch (result) {
+    case i2cTransferDone:
+      return WireStatus::SUCCESS;
+    case i2cTransferNack:
+      return WireStatus::NACK_ADDRESS;
+    case i2cTransferSwFault:
+      if (this->transfer_timed_out) {
+        return WireStatus::TIMEOUT;
+      }
+      return WireStatus::OTHER_ERROR;
+    default:
+      return WireStatus::OTHER_ERROR;
+  }
 }
 
 void TwoWire::_wire_irq_handler()
 {
+  // Leader transfers are driven by the emlib transfer state machine
+  if (this->role == wire_role_t::LEADER) {
+    if (this->transfer_active) {
+      this->transfer_progress_us = micros();
+      I2C_TransferReturn_TypeDef ret = I2C_Transfer(this->i2c_peripheral);
+      if (ret != i2cTransferInProgress) {
+        this->finish_transfer(ret);
+      }
+    }
+    return;
+  }
+
   if (this->role != wire_role_t::FOLLOWER) {
     return;
   }
@@ -422,6 +831,11 @@ void TwoWire::_wire_irq_handler()
   uint32_t i2c_int_flags = this->i2c_peripheral->IF;
   uint32_t rx_data;
 
+  if (this->register_map) {
+    this->register_map_irq_handler(i2c_int_flags);
+    return;
+  }
+
   // If some sort of fault occurred - abort the current transaction and return
   if (i2c_int_flags & (I2C_IF_BUSERR | I2C_IF_ARBLOST)) {
     this->follower_transaction_in_progress = false;
@@ -473,6 +887,109 @@ void TwoWire::_wire_irq_handler()
   }
 }
 
+// Serves the register map without calling any user code
+void TwoWire::register_map_irq_handler(uint32_t i2c_int_flags)
+{
+  // If some sort of fault occurred - abort the current transaction and return
+  if (i2c_int_flags & (I2C_IF_BUSERR | I2C_IF_ARBLOST)) {
+    this->follower_transaction_in_progress = false;
+    this->register_pointer_pending = false;
+    I2C_IntClear(this->i2c_peripheral, I2C_IF_BUSERR | I2C_IF_ARBLOST);
+    return;
+  }
+
+  if (i2c_int_flags & I2C_IF_ADDR) {
+    this->follower_transaction_in_progress = true;
+    uint32_t rx_data = this->i2c_peripheral->RXDATA;
+    if (rx_data & 0x1) {
+      // Leader read - send the register at the pointer
+      this->i2c_peripheral->TXDATA = this->register_map_read();
+    } else {
+      // Leader write - the first byte is the register pointer
+      this->register_pointer_pending = true;
+    }
+    this->i2c_peripheral->CMD = I2C_CMD_ACK;
+    I2C_IntClear(this->i2c_peripheral, I2C_IF_ADDR | I2C_IF_RXDATAV);
+  } else if (i2c_int_flags & I2C_IF_RXDATAV) {
+    uint8_t rx_data = (uint8_t)this->i2c_peripheral->RXDATA;
+    if (this->register_pointer_pending) {
+      this->register_pointer = rx_data;
+      this->register_pointer_pending = false;
+      this->i2c_peripheral->CMD = I2C_CMD_ACK;
+    } else if (this->register_pointer < this->register_map_size) {
+      // Writes to read-only registers are acknowledged and dropped
+      uint16_t reg = this->register_pointer++;
+      if (!this->register_access || (this->register_access[reg] & REGISTER_WRITE)) {
+        this->register_map[reg] = rx_data;
+        if (reg < this->registers_written_first) {
+          this->registers_written_first = reg;
+        }
+        if (reg > this->registers_written_last) {
+          this->registers_written_last = reg;
+        }
+      }
+      this->i2c_peripheral->CMD = I2C_CMD_ACK;
+    } else {
+      // Past the end of the map
+      this->i2c_peripheral->CMD = I2C_CMD_NACK;
+    }
+    I2C_IntClear(this->i2c_peripheral, I2C_IF_RXDATAV);
+  }
+
+  // Leader acknowledged the last byte and reads on
+  if (i2c_int_flags & I2C_IF_ACK) {
+    this->i2c_peripheral->TXDATA = this->register_map_read();
+    this->i2c_peripheral->CMD = I2C_CMD_ACK;
+    I2C_IntClear(this->i2c_peripheral, I2C_IF_ACK);
+  }
+
+  // End of transaction - let the task report the written registers
+  if (i2c_int_flags & I2C_IF_SSTOP) {
+    this->follower_transaction_in_progress = false;
+    this->register_pointer_pending = false;
+    I2C_IntClear(this->i2c_peripheral, I2C_IF_SSTOP);
+    if (this->register_task_handle && this->registers_written_first <= this->registers_written_last) {
+      BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+      vTaskNotifyGiveFromISR(this->register_task_handle, &xHigherPriorityTaskWoken);
+      portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+  }
+}
+
+// Returns the register at the pointer and advances the pointer - unreadable registers read as 0xFF
+uint8_t TwoWire::register_map_read()
+{
+  if (this->register_pointer >= this->register_map_size) {
+    return 0xFF;
+  }
+  uint16_t reg = this->register_pointer++;
+  if (this->register_access && !(this->register_access[reg] & REGISTER_READ)) {
+    return 0xFF;
+  }
+  return this->register_map[reg];
+}
+
+void TwoWire::register_task(void* p_arg)
+{
+  static_cast<TwoWire*>(p_arg)->register_service();
+}
+
+void TwoWire::register_service()
+{
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    taskENTER_CRITICAL();
+    uint16_t first = this->registers_written_first;
+    uint16_t last = this->registers_written_last;
+    this->registers_written_first = UINT16_MAX;
+    this->registers_written_last = 0u;
+    taskEXIT_CRITICAL();
+    if (first <= last && this->user_onregisterswritten_cb) {
+      this->user_onregisterswritten_cb((uint8_t)first, (size_t)(last - first) + 1u);
+    }
+  }
+}
+
 I2C_TypeDef* TwoWire::_get_i2c_peripheral()
 {
   return this->i2c_peripheral;
@@ -40,6 +40,14 @@
 #include "arduino_i2c_config.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+
+// Size of the buffers used by beginTransmission()/write() and requestFrom()/read()
+// Can be overridden with a build flag, e.g. -DWIRE_BUFFER_SIZE=128 - at most 255 as requestFrom() takes a uint8_t count
+#ifndef WIRE_BUFFER_SIZE
+#define WIRE_BUFFER_SIZE 64
+#endif // WIRE_BUFFER_SIZE
+static_assert(WIRE_BUFFER_SIZE <= 255, "requestFrom() can't request more than 255 bytes");
 
 namespace arduino {
 class TwoWire {
@@ -99,13 +107,31 @@ public:
    *
    * @param[in] address The address of the I2C follower
    * @param[in] number_of_bytes The number of bytes requested from the follower
-   * @param[in] stop Indicates whether the I2C communication should be ended
-   *                 after the reception
+   * @param[in] stop Kept for compatibility - the reception always ends with
+   *                 a STOP condition
    *
    * @return Returns the number of bytes received
    ******************************************************************************/
   uint8_t requestFrom(uint8_t address, uint8_t number_of_bytes, uint8_t stop);
 
+  // Called from interrupt context when an asynchronous transfer completes - 'status' is a WireStatus
+  typedef void (*transfer_callback_t)(uint8_t status);
+
+  /***************************************************************************//**
+   * Starts requesting bytes from an I2C follower and returns immediately
+   * The contents of the Tx buffer are sent first with a repeated start - as
+   * with requestFrom() after endTransmission(false). The received bytes can
+   * be read with read() once the transfer completes.
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] number_of_bytes The number of bytes requested from the follower
+   * @param[in] callback Called from interrupt context when the transfer completes
+   *
+   * @return Returns true if the transfer was started
+   ******************************************************************************/
+  bool requestFromAsync(uint8_t address, uint8_t number_of_bytes, transfer_callback_t callback = nullptr);
+
   /***************************************************************************//**
    * Starts an I2C transmission with a follower device
    * (leader mode only)
@@ -125,6 +151,34 @@ public:
    ******************************************************************************/
   uint8_t endTransmission(bool stop = true);
 
+  /***************************************************************************//**
+   * Starts sending the Tx buffer to the follower device and returns immediately
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @param[in] callback Called from interrupt context when the transfer completes
+   *
+   * @return Returns true if the transfer was started
+   ******************************************************************************/
+  bool endTransmissionAsync(transfer_callback_t callback = nullptr);
+
+  /***************************************************************************//**
+   * Returns whether an asynchronous transfer is in progress
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @return Returns true if a transfer is in progress
+   ******************************************************************************/
+  bool isBusy();
+
+  /***************************************************************************//**
+   * Waits for the asynchronous transfer in progress to complete
+   * The calling task yields while waiting. Must not be called between
+   * beginTransmission() and endTransmission().
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @return Returns a WireStatus indicating the result of the last transfer
+   ******************************************************************************/
+  uint8_t waitForTransfer();
+
   /***************************************************************************//**
    * Sends the provided byte over the I2C bus
    * (leader/follower mode)
@@ -142,10 +196,44 @@ public:
    * @param[in] data Pointer to the data to be sent
    * @param[in] size Size of the data to be sent
    *
-   * @return Returns the number of bytes sent
+   * @return Returns the number of bytes put into the Tx buffer - less than
+   *         'size' if the buffer got full, the bytes that fit are still sent
    ******************************************************************************/
   size_t write(const uint8_t* data, size_t size);
 
+  /***************************************************************************//**
+   * Reads consecutive registers of a follower device in a single transaction
+   * Writes the register address then reads the data with a repeated start
+   * straight into the provided buffer - the Tx/Rx buffers aren't used, so the
+   * length isn't limited by their size.
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] reg The address of the first register
+   * @param[out] buf The buffer for the register values
+   * @param[in] len The number of bytes to read
+   * @param[in] reg_size The size of the register address in bytes (1 or 2, MSB first)
+   *
+   * @return Returns a WireStatus indicating the result of the operation
+   ******************************************************************************/
+  uint8_t readRegisters(uint8_t address, uint16_t reg, uint8_t* buf, size_t len, uint8_t reg_size = 1u);
+
+  /***************************************************************************//**
+   * Writes consecutive registers of a follower device in a single transaction
+   * The register address and the data are sent straight from the provided
+   * buffer - the length isn't limited by the size of the Tx buffer.
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] reg The address of the first register
+   * @param[in] buf The register values to write
+   * @param[in] len The number of bytes to write
+   * @param[in] reg_size The size of the register address in bytes (1 or 2, MSB first)
+   *
+   * @return Returns a WireStatus indicating the result of the operation
+   ******************************************************************************/
+  uint8_t writeRegisters(uint8_t address, uint16_t reg, const uint8_t* buf, size_t len, uint8_t reg_size = 1u);
+
   /***************************************************************************//**
    * Gets the number of bytes received from the leader/follower device
    * (leader/follower mode)
@@ -186,16 +274,51 @@ public:
    ******************************************************************************/
   void onRequest(void (*user_onrequest_cb)(void));
 
+  // Access flags of the registers served in register map mode
+  enum RegisterAccess {
+    REGISTER_READ       = 0x01,
+    REGISTER_WRITE      = 0x02,
+    REGISTER_READ_WRITE = 0x03
+  };
+
+  /***************************************************************************//**
+   * Serves a register map to the leader from the interrupt handler
+   * The first byte of a leader write sets the register pointer, the following
+   * bytes are written to the registers. Leader reads return the registers
+   * from the pointer. The pointer increments after each byte and is kept
+   * across a repeated start. No user callback is called from the interrupt -
+   * onReceive() and onRequest() aren't used in this mode.
+   * Silabs specific, non-standard Arduino call. (follower mode only)
+   *
+   * @param[in] registers The register map - nullptr turns the mode off
+   * @param[in] size The number of registers - up to 256
+   * @param[in] access The RegisterAccess flags of each register - nullptr makes all registers read-write
+   ******************************************************************************/
+  void setRegisterMap(uint8_t* registers, size_t size, const uint8_t* access = nullptr);
+
+  /***************************************************************************//**
+   * Sets the function called after the leader wrote registers in register map mode
+   * The function is called from a task after the transaction ended - writes
+   * arriving before it runs are merged into a single call.
+   * Silabs specific, non-standard Arduino call. (follower mode only)
+   *
+   * @param[in] user_onregisterswritten_cb Pointer to the callback function, receiving
+   *                                       the first written register and the number of registers
+   ******************************************************************************/
+  void onRegistersWritten(void (*user_onregisterswritten_cb)(uint8_t, size_t));
+
   /***************************************************************************//**
    * Sets the timeout and whether a reset should occur on timeout
-   * Note: setting the timeout amount has no effect, only the timeout behaviour
-   * (leader/follower mode)
+   * A transfer is aborted when it makes no progress on the bus for the timeout
+   * period. With reset_on_timeout the bus is recovered with recoverBus().
+   * Asynchronous transfers are checked when waited for or polled with isBusy().
+   * (leader mode only)
    *
-   * @param[in] timeout The requested timeout amount in microseconds
+   * @param[in] timeout The requested timeout amount in microseconds - 0 disables the timeout
    * @param[in] reset_on_timeout Indicates whether a communication reset
    *                             should be performed on timeout
    ******************************************************************************/
-  void setWireTimeout(int timeout, bool reset_on_timeout);
+  void setWireTimeout(int timeout = 25000, bool reset_on_timeout = true);
 
   /***************************************************************************//**
    * Clears the communication timeout flag
@@ -211,10 +334,44 @@ public:
    ******************************************************************************/
   bool getWireTimeoutFlag();
 
+  /***************************************************************************//**
+   * Frees a bus held by a stuck follower
+   * Clocks SCL up to 9 times until the follower releases SDA, generates a
+   * STOP condition and reinitializes the I2C peripheral.
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @return Returns true if SDA is released
+   ******************************************************************************/
+  bool recoverBus();
+
+  // Number of transfers ended by each abort reason
+  struct AbortCounters {
+    uint32_t timeouts;
+    uint32_t nacks;
+    uint32_t bus_errors;
+    uint32_t arbitration_lost;
+    uint32_t other_errors;
+    uint32_t bus_recoveries;
+  };
+
+  /***************************************************************************//**
+   * Returns the number of aborted transfers by reason
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   *
+   * @return Returns the abort counters
+   ******************************************************************************/
+  AbortCounters getAbortCounters();
+
+  /***************************************************************************//**
+   * Clears the abort counters
+   * Silabs specific, non-standard Arduino call. (leader mode only)
+   ******************************************************************************/
+  void clearAbortCounters();
+
   /***************************************************************************//**
    * Interrupt handler for the I2C peripheral
    * Meant to be called by the I2C ISR and not externally by users.
-   * (follower mode only)
+   * (leader/follower mode)
    ******************************************************************************/
   void _wire_irq_handler();
 
@@ -268,11 +425,54 @@ private:
    ******************************************************************************/
   uint32_t i2c_leader_write(uint8_t *cmd, size_t cmdLen, uint8_t *data, size_t dataLen, uint16_t i2c_address);
 
+  /***************************************************************************//**
+   * Starts the transfer described by 'transfer_seq' - the interrupt handler
+   * drives it to completion
+   *
+   * @param[in] rx_len The number of bytes the transfer reads into the Rx buffer
+   * @param[in] callback Called from interrupt context when the transfer completes
+   *
+   * @return Returns true if the transfer was started
+   ******************************************************************************/
+  bool start_transfer(size_t rx_len, transfer_callback_t callback);
+
+  /***************************************************************************//**
+   * Waits for the current transfer to complete, aborts it if it makes no
+   * progress for the timeout period
+   *
+   * @return Returns the result of the transfer
+   ******************************************************************************/
+  I2C_TransferReturn_TypeDef wait_transfer();
+
+  /***************************************************************************//**
+   * Runs a register access transfer and waits for its completion
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] reg The address of the first register
+   * @param[in] reg_size The size of the register address in bytes
+   * @param[in] flags The emlib transfer flags - I2C_FLAG_WRITE_READ or I2C_FLAG_WRITE_WRITE
+   * @param[in] buf The data buffer of the transfer
+   * @param[in] len The length of the data
+   *
+   * @return Returns a WireStatus indicating the result of the operation
+   ******************************************************************************/
+  uint8_t register_transfer(uint8_t address, uint16_t reg, uint8_t reg_size, uint16_t flags, uint8_t* buf, size_t len);
+
+  void finish_transfer(I2C_TransferReturn_TypeDef result);
+  bool transfer_stalled();
+  void abort_transfer();
+  void register_map_irq_handler(uint32_t i2c_int_flags);
+  uint8_t register_map_read();
+  static void register_task(void* p_arg);
+  void register_service();
+  void enable_irq();
+  uint8_t to_wire_status(I2C_TransferReturn_TypeDef result);
+
   bool timeout_flag;
   bool reset_on_timeout;
 
-  static const uint32_t tx_buffer_size = 64u;
-  static const uint32_t rx_buffer_size = 64u;
+  static const uint32_t tx_buffer_size = WIRE_BUFFER_SIZE;
+  static const uint32_t rx_buffer_size = WIRE_BUFFER_SIZE;
   uint8_t tx_buffer[tx_buffer_size];
   uint8_t rx_buffer[rx_buffer_size];
 
@@ -285,14 +485,44 @@ private:
 
   uint8_t follower_mode_address;
   bool follower_transaction_in_progress;
-  RingBufferN<64> follower_mode_rx_buffer;
+  RingBufferN<WIRE_BUFFER_SIZE> follower_mode_rx_buffer;
 
   void (*user_onreceive_cb)(int);
   void (*user_onrequest_cb)(void);
 
+  // Register map mode
+  static const uint32_t register_task_stack_size = 1024u;
+  static const UBaseType_t register_task_priority = 3u;
+  uint8_t* register_map;
+  size_t register_map_size;
+  const uint8_t* register_access;
+  uint16_t register_pointer;
+  bool register_pointer_pending;
+  // The range of registers written since the last notification - first > last if none
+  volatile uint16_t registers_written_first;
+  volatile uint16_t registers_written_last;
+  void (*user_onregisterswritten_cb)(uint8_t, size_t);
+  TaskHandle_t register_task_handle;
+
   SemaphoreHandle_t wire_mutex;
   StaticSemaphore_t wire_mutex_buf;
 
+  // Interrupt driven leader transfers
+  uint32_t timeout_us;
+  // Time of the last interrupt of the transfer in progress
+  volatile uint32_t transfer_progress_us;
+  AbortCounters abort_counters;
+  I2C_TransferSeq_TypeDef transfer_seq;
+  // Register address of the readRegisters()/writeRegisters() transfer in progress
+  uint8_t register_address_buf[2];
+  volatile bool transfer_active;
+  volatile bool transfer_timed_out;
+  volatile I2C_TransferReturn_TypeDef transfer_result;
+  size_t transfer_rx_len;
+  transfer_callback_t transfer_callback;
+  SemaphoreHandle_t transfer_done;
+  StaticSemaphore_t transfer_done_buf;
+
   I2C_TypeDef* const i2c_peripheral;
   const uint8_t i2c_peripheral_num;
   const GPIO_Port_TypeDef i2c_scl_port;
@@ -102,6 +102,19 @@ public:
     this->end_transfer();
   }
 
+  // Sets all LEDs to a HSV color - hue and saturation are full scale 16-bit values (see hsvToRgb16())
+  // The color is gamma corrected and the brightness percentage follows the perceptual brightness curve
+  void set_all_hsv(uint16_t hue, uint16_t saturation, uint8_t brightness = 100)
+  {
+    if (brightness > 100) {
+      brightness = 100;
+    }
+    rgb16_t color = hsvToLinearRgb16(hue, saturation, (uint8_t)((uint32_t)brightness * 255u / 100u));
+    this->set_all((uint8_t)scaleToResolution16(color.red, 8u),
+                  (uint8_t)scaleToResolution16(color.green, 8u),
+                  (uint8_t)scaleToResolution16(color.blue, 8u));
+  }
+
   void end_transfer()
   {
     this->SPI_peripheral.transfer(0);
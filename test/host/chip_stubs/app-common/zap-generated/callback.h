@@ -0,0 +1,100 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <app/util/attribute-storage.h>
+
+namespace chip {
+namespace app {
+struct ConcreteAttributePath {
+  ConcreteAttributePath(EndpointId endpoint, ClusterId cluster, AttributeId attribute) :
+    mEndpointId(endpoint), mClusterId(cluster), mAttributeId(attribute)
+  {
+    ;
+  }
+  EndpointId mEndpointId;
+  ClusterId mClusterId;
+  AttributeId mAttributeId;
+};
+
+namespace Clusters {
+namespace Globals {
+namespace Attributes {
+namespace FeatureMap {
+static constexpr AttributeId Id = 0x0000FFFC;
+} // namespace FeatureMap
+namespace ClusterRevision {
+static constexpr AttributeId Id = 0x0000FFFD;
+} // namespace ClusterRevision
+} // namespace Attributes
+} // namespace Globals
+
+namespace Identify {
+static constexpr ClusterId Id = 0x00000003;
+namespace Attributes {
+namespace IdentifyTime {
+static constexpr AttributeId Id = 0x00000000;
+} // namespace IdentifyTime
+namespace IdentifyType {
+static constexpr AttributeId Id = 0x00000001;
+} // namespace IdentifyType
+namespace FeatureMap = Globals::Attributes::FeatureMap;
+namespace ClusterRevision = Globals::Attributes::ClusterRevision;
+} // namespace Attributes
+} // namespace Identify
+
+namespace BridgedDeviceBasicInformation {
+static constexpr ClusterId Id = 0x00000039;
+namespace Attributes {
+namespace VendorName {
+static constexpr AttributeId Id = 0x00000001;
+} // namespace VendorName
+namespace ProductName {
+static constexpr AttributeId Id = 0x00000003;
+} // namespace ProductName
+namespace NodeLabel {
+static constexpr AttributeId Id = 0x00000005;
+} // namespace NodeLabel
+namespace SerialNumber {
+static constexpr AttributeId Id = 0x0000000F;
+} // namespace SerialNumber
+namespace Reachable {
+static constexpr AttributeId Id = 0x00000011;
+} // namespace Reachable
+namespace FeatureMap = Globals::Attributes::FeatureMap;
+namespace ClusterRevision = Globals::Attributes::ClusterRevision;
+} // namespace Attributes
+} // namespace BridgedDeviceBasicInformation
+
+namespace Actions {
+static constexpr ClusterId Id = 0x00000025;
+} // namespace Actions
+} // namespace Clusters
+} // namespace app
+} // namespace chip
+
+void MatterIdentifyClusterServerAttributeChangedCallback(const chip::app::ConcreteAttributePath& attributePath);
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Host stand-in for the CHIP headers used by devices/MatterDevice.cpp
+// Only the declarations the device uses are provided - they're implemented
+// by the fakes in matter_device_test.cpp.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <chrono>
+
+typedef int CHIP_ERROR;
+#define CHIP_NO_ERROR 0
+
+namespace chip {
+typedef uint16_t EndpointId;
+typedef uint32_t ClusterId;
+typedef uint32_t AttributeId;
+
+template<typename T, size_t N>
+constexpr size_t ArraySize(T (&)[N])
+{
+  return N;
+}
+
+namespace System {
+namespace Clock {
+typedef std::chrono::duration<uint32_t, std::milli> Milliseconds32;
+} // namespace Clock
+
+class Layer {
+public:
+  typedef void (*TimerCompleteCallback)(Layer* layer, void* appState);
+  CHIP_ERROR StartTimer(Clock::Milliseconds32 delay, TimerCompleteCallback onComplete, void* appState);
+};
+} // namespace System
+} // namespace chip
+
+typedef enum {
+  EMBER_ZCL_STATUS_SUCCESS = 0x00,
+  EMBER_ZCL_STATUS_FAILURE = 0x01,
+} EmberAfStatus;
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <app/util/attribute-storage.h>
+
+namespace chip {
+class MutableByteSpan {
+public:
+  MutableByteSpan(uint8_t* data, size_t size) : data_ptr(data), data_size(size)
+  {
+    ;
+  }
+  uint8_t* data() const
+  {
+    return this->data_ptr;
+  }
+  size_t size() const
+  {
+    return this->data_size;
+  }
+
+private:
+  uint8_t* data_ptr;
+  size_t data_size;
+};
+
+// Length prefixed string - same layout as the CHIP implementation
+inline bool MakeZclCharString(MutableByteSpan& buffer, const char* cString)
+{
+  size_t len = strlen(cString);
+  if (buffer.size() == 0u || len >= buffer.size() || len > 254u) {
+    return false;
+  }
+  buffer.data()[0] = static_cast<uint8_t>(len);
+  memcpy(&buffer.data()[1], cString, len);
+  return true;
+}
+} // namespace chip
@@ -0,0 +1,52 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <app/util/attribute-storage.h>
+
+#define ChipLogProgress(module, ...) ((void)0)
+
+namespace chip {
+namespace Platform {
+template<size_t N>
+inline void CopyString(char (&dest)[N], const char* source)
+{
+  snprintf(dest, N, "%s", source);
+}
+} // namespace Platform
+
+namespace DeviceLayer {
+class PlatformManager {
+public:
+  typedef void (*AsyncWorkFunct)(intptr_t arg);
+  CHIP_ERROR ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg = 0);
+};
+PlatformManager& PlatformMgr();
+System::Layer& SystemLayer();
+} // namespace DeviceLayer
+} // namespace chip
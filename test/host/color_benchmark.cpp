@@ -0,0 +1,132 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Host benchmark of the fixed-point color conversion against the floating point HSVtoRGB()/RGBtoHSV()
+// Build and run from this directory:
+//   g++ -O2 -I../../cores/silabs color_benchmark.cpp ../../cores/silabs/color_conversion.cpp -o color_benchmark && ./color_benchmark
+// The host has a double precision FPU - on the Cortex-M33 the difference is larger, as every double operation is a library call.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdint.h>
+
+#include "color_conversion.h"
+
+// Arduino macros used by the floating point implementation
+#define abs(x) ((x) > 0 ? (x) : -(x))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#include "../../libraries/Matter/src/util/hsv_rgb.h"
+#undef abs
+#undef constrain
+
+static const uint32_t iterations = 2000000u;
+static volatile uint32_t sink;
+
+template<typename F>
+static double measure_ns(F function)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0u; i < iterations; i++) {
+    function(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main()
+{
+  // Accuracy of the fixed-point HSV to RGB conversion against the floating point one (in 8-bit steps)
+  int max_error = 0;
+  for (uint32_t hue = 0u; hue < 360u; hue++) {
+    for (uint32_t saturation = 0u; saturation <= 254u; saturation += 2u) {
+      double hsv[3] = { (double)hue, saturation / 254.0, 1.0 };
+      uint8_t rgb[3];
+      HSVtoRGB(hsv, rgb);
+      rgb16_t color = hsvToRgb16((uint16_t)(hue * 65536u / 360u), (uint16_t)(saturation * 65535u / 254u), 65535u);
+      int error_r = std::abs((color.red >> 8) - rgb[0]);
+      int error_g = std::abs((color.green >> 8) - rgb[1]);
+      int error_b = std::abs((color.blue >> 8) - rgb[2]);
+      int error = error_r > error_g ? (error_r > error_b ? error_r : error_b) : (error_g > error_b ? error_g : error_b);
+      if (error > max_error) {
+        max_error = error;
+      }
+    }
+  }
+  printf("HSV to RGB max difference: %d (8-bit steps)\n", max_error);
+
+  // Round trip of the fixed-point conversion
+  int max_hue_error = 0;
+  for (uint32_t hue = 0u; hue < 65536u; hue += 97u) {
+    rgb16_t color = hsvToRgb16((uint16_t)hue, 65535u, 65535u);
+    uint16_t hue_out, saturation_out, value_out;
+    rgbToHsv16(color, &hue_out, &saturation_out, &value_out);
+    int error = std::abs((int)hue_out - (int)hue);
+    if (error > 32768) {
+      error = 65536 - error;
+    }
+    if (error > max_hue_error) {
+      max_hue_error = error;
+    }
+  }
+  printf("HSV round trip max hue difference: %d / 65536\n", max_hue_error);
+
+  double float_hsv_to_rgb = measure_ns([](uint32_t i) {
+    double hsv[3] = { (double)(i % 360u), (i & 0xFFu) / 255.0, ((i >> 8) & 0xFFu) / 255.0 };
+    uint8_t rgb[3];
+    HSVtoRGB(hsv, rgb);
+    sink = rgb[0] + rgb[1] + rgb[2];
+  });
+  double fixed_hsv_to_rgb = measure_ns([](uint32_t i) {
+    rgb16_t color = hsvToRgb16((uint16_t)(i * 181u), (uint16_t)(i * 257u), (uint16_t)((i >> 8) * 257u));
+    sink = color.red + color.green + color.blue;
+  });
+  double fixed_pipeline = measure_ns([](uint32_t i) {
+    rgb16_t color = hsvToLinearRgb16((uint16_t)(i * 181u), (uint16_t)(i * 257u), (uint8_t)(i >> 8));
+    sink = scaleToResolution16(color.red, 12u) + scaleToResolution16(color.green, 12u) + scaleToResolution16(color.blue, 12u);
+  });
+  double float_rgb_to_hsv = measure_ns([](uint32_t i) {
+    // RGBtoHSV() divides by zero for grays - the blue channel always differs from the red one
+    uint8_t rgb[3] = { (uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i + 128u) };
+    double hsv[3];
+    RGBtoHSV(rgb, hsv);
+    sink = (uint32_t)(hsv[0] + hsv[1] + hsv[2]);
+  });
+  double fixed_rgb_to_hsv = measure_ns([](uint32_t i) {
+    rgb16_t color = { (uint16_t)((i & 0xFFu) * 257u), (uint16_t)(((i >> 8) & 0xFFu) * 257u), (uint16_t)(((i + 128u) & 0xFFu) * 257u) };
+    uint16_t hue, saturation, value;
+    rgbToHsv16(color, &hue, &saturation, &value);
+    sink = hue + saturation + value;
+  });
+
+  printf("HSV to RGB, double:      %6.1f ns\n", float_hsv_to_rgb);
+  printf("HSV to RGB, fixed-point: %6.1f ns\n", fixed_hsv_to_rgb);
+  printf("HSV to PWM (gamma, brightness, 12 bits), fixed-point: %6.1f ns\n", fixed_pipeline);
+  printf("RGB to HSV, double:      %6.1f ns\n", float_rgb_to_hsv);
+  printf("RGB to HSV, fixed-point: %6.1f ns\n", fixed_rgb_to_hsv);
+  return 0;
+}
@@ -0,0 +1,421 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Host test of MatterBridge driven by a fake MatterBridgeSource
+// The bridge is compiled against the stand-ins in matter_stubs/ instead of the CHIP stack.
+// '-I-' keeps the quoted includes of MatterBridge.cpp from picking up the real headers next to it.
+// Build and run from this directory:
+//   g++ -std=gnu++17 -Imatter_stubs -I- -I../../libraries/Matter/src matter_bridge_test.cpp ../../libraries/Matter/src/MatterBridge.cpp -o matter_bridge_test && ./matter_bridge_test
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "MatterBridge.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                   \
+  do {                                                                     \
+    if (!(condition)) {                                                    \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                          \
+    }                                                                      \
+  } while (0)
+
+// Fakes of the platform
+
+static uint32_t now_ms = 0u;
+static int critical_nesting = 0;
+static int chip_stack_lock_count = 0;
+static size_t max_endpoints = MATTER_DYNAMIC_ENDPOINT_POOL_SIZE;
+static size_t add_endpoints_calls = 0u;
+static std::vector<Device*> endpoints;
+static std::vector<Device*> removed_endpoints;
+static size_t data_version_storages = 0u;
+
+uint32_t millis()
+{
+  return now_ms;
+}
+
+void taskENTER_CRITICAL()
+{
+  critical_nesting++;
+}
+
+void taskEXIT_CRITICAL()
+{
+  critical_nesting--;
+}
+
+void PlatformManager::LockChipStack()
+{
+  chip_stack_lock_count++;
+}
+
+void PlatformManager::UnlockChipStack()
+{
+  chip_stack_lock_count--;
+}
+
+PlatformManager& PlatformMgr()
+{
+  static PlatformManager platform_manager;
+  return platform_manager;
+}
+
+Device::Device(const char* device_name) :
+  reachable(true)
+{
+  snprintf(this->name, sizeof(this->name), "%s", device_name);
+  this->serial_number[0] = '\0';
+}
+
+Device::~Device()
+{
+  ;
+}
+
+void Device::SetReachable(bool reachable)
+{
+  this->reachable = reachable;
+}
+
+bool Device::IsReachable()
+{
+  return this->reachable;
+}
+
+void Device::SetProductName(const char* productname)
+{
+  (void)productname;
+}
+
+void Device::SetSerialNumber(const char* serialnumber)
+{
+  snprintf(this->serial_number, sizeof(this->serial_number), "%s", serialnumber);
+}
+
+const char* Device::GetName()
+{
+  return this->name;
+}
+
+const char* Device::GetSerialNumber()
+{
+  return this->serial_number;
+}
+
+DevicePool gDevicePool;
+
+void DevicePool::destroy(Device* device)
+{
+  if (device == nullptr) {
+    return;
+  }
+  this->live_count--;
+  delete device;
+}
+
+void DestroyDevice(Device* dev)
+{
+  // The real one holds the CHIP stack lock while destroying the device
+  CHECK(chip_stack_lock_count == 0);
+  chip_stack_lock_count++;
+  gDevicePool.destroy(dev);
+  chip_stack_lock_count--;
+}
+
+DataVersion* AllocateDataVersionStorage(size_t cluster_count)
+{
+  data_version_storages++;
+  return new DataVersion[cluster_count];
+}
+
+void FreeDataVersionStorage(DataVersion* storage)
+{
+  if (storage == nullptr) {
+    return;
+  }
+  data_version_storages--;
+  delete[] storage;
+}
+
+size_t AddDeviceEndpoints(DeviceEndpointRequest* requests, size_t count)
+{
+  add_endpoints_calls++;
+  size_t added = 0u;
+  for (size_t i = 0u; i < count; i++) {
+    CHECK(requests[i].parentEndpointId == MATTER_AGGREGATOR_ENDPOINT_ID);
+    CHECK(requests[i].dataVersionStorage.size() == requests[i].ep->clusterCount);
+    if (endpoints.size() >= max_endpoints) {
+      requests[i].result = -1;
+      continue;
+    }
+    requests[i].result = static_cast<int>(endpoints.size());
+    endpoints.push_back(requests[i].dev);
+    added++;
+  }
+  return added;
+}
+
+int RemoveDeviceEndpoint(Device* dev)
+{
+  for (size_t i = 0u; i < endpoints.size(); i++) {
+    if (endpoints[i] == dev) {
+      endpoints.erase(endpoints.begin() + i);
+      removed_endpoints.push_back(dev);
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+const EmberAfEndpointType tempMeasurementEndpointType = { 5u };
+const EmberAfEndpointType humidityMeasurementEndpointType = { 5u };
+const EmberAfEndpointType contactSensorEndpointType = { 5u };
+const EmberAfDeviceType gTempSensorDeviceTypes[] = { { 0x0302u, 2u } };
+const EmberAfDeviceType gHumiditySensorDeviceTypes[] = { { 0x0307u, 2u } };
+const EmberAfDeviceType gContactSensorDeviceTypes[] = { { 0x0015u, 1u } };
+
+// Source with a temperature, a humidity and a contact sensor - posts one reading of each on every poll
+
+class FakeSource : public MatterBridgeSource {
+public:
+  void begin(MatterBridge& bridge) override
+  {
+    this->temperature = bridge.add_child(MatterBridge::child_temperature, 0xA1A2A3A4A5A6ull, "Kitchen");
+    this->humidity = bridge.add_child(MatterBridge::child_humidity, 0xB1ull, "Bathroom");
+    this->contact = bridge.add_child(MatterBridge::child_contact, 0xC1ull, "Door");
+  }
+
+  void poll(MatterBridge& bridge) override
+  {
+    this->poll_count++;
+    if (!this->post_readings) {
+      return;
+    }
+    bridge.post_temperature(this->temperature, this->celsius);
+    bridge.post_humidity(this->humidity, this->percent);
+    bridge.post_contact(this->contact, this->closed);
+  }
+
+  int temperature = -1;
+  int humidity = -1;
+  int contact = -1;
+  uint32_t poll_count = 0u;
+  bool post_readings = true;
+  float celsius = 21.5f;
+  float percent = 40.0f;
+  bool closed = true;
+};
+
+template<typename T>
+static T* endpoint_device(size_t index)
+{
+  return index < endpoints.size() ? static_cast<T*>(endpoints[index]) : nullptr;
+}
+
+static void test_children_added()
+{
+  FakeSource source;
+  MatterBridge bridge;
+  CHECK(bridge.begin(&source));
+  CHECK(!bridge.begin(&source));
+  CHECK(source.temperature == 0 && source.humidity == 1 && source.contact == 2);
+  CHECK(bridge.find_child(0xB1ull) == source.humidity);
+  CHECK(bridge.find_child(0xD1ull) == -1);
+  // Adding the same address twice fails
+  CHECK(bridge.add_child(MatterBridge::child_contact, 0xC1ull, "Door") == -1);
+
+  // Nothing is registered before the first process()
+  CHECK(endpoints.empty());
+  CHECK(!bridge.is_child_online(source.temperature));
+
+  bridge.process();
+  CHECK(source.poll_count == 1u);
+  // All the children are registered in one batch
+  CHECK(add_endpoints_calls == 1u);
+  CHECK(endpoints.size() == 3u);
+  CHECK(data_version_storages == 3u);
+  CHECK(strcmp(endpoint_device<Device>(0)->GetName(), "Kitchen") == 0);
+  CHECK(strcmp(endpoint_device<Device>(0)->GetSerialNumber(), "0000A1A2A3A4A5A6") == 0);
+  CHECK(bridge.is_child_online(source.temperature));
+  CHECK(bridge.is_child_online(source.humidity));
+  CHECK(bridge.is_child_online(source.contact));
+  CHECK(chip_stack_lock_count == 0);
+  CHECK(critical_nesting == 0);
+
+  // Registered children aren't added again
+  bridge.process();
+  CHECK(add_endpoints_calls == 1u);
+
+  bridge.end();
+  CHECK(endpoints.empty());
+  CHECK(gDevicePool.live_count == 0u);
+  CHECK(data_version_storages == 0u);
+}
+
+static void test_children_updated()
+{
+  FakeSource source;
+  MatterBridge bridge;
+  CHECK(bridge.begin(&source));
+  source.post_readings = false;
+  bridge.process();
+
+  // Children are unreachable until their link is reported or a reading arrives
+  DeviceTempSensor* temperature = endpoint_device<DeviceTempSensor>(0);
+  DeviceHumiditySensor* humidity = endpoint_device<DeviceHumiditySensor>(1);
+  DeviceContactSensor* contact = endpoint_device<DeviceContactSensor>(2);
+  CHECK(temperature && humidity && contact);
+  CHECK(!temperature->IsReachable());
+  CHECK(!bridge.is_child_online(source.temperature));
+
+  source.post_readings = true;
+  bridge.process();
+  CHECK(temperature->measured_value == 2150);
+  CHECK(humidity->measured_value == 4000u);
+  CHECK(contact->state_value);
+  CHECK(temperature->IsReachable());
+
+  // Updates are applied in order
+  bridge.post_temperature(source.temperature, 22.0f);
+  bridge.post_temperature(source.temperature, 23.25f);
+  source.post_readings = false;
+  bridge.process();
+  CHECK(temperature->measured_value == 2325);
+  CHECK(temperature->update_count == 3u);
+
+  // Link state
+  CHECK(bridge.post_link_state(source.humidity, false));
+  bridge.process();
+  CHECK(!humidity->IsReachable());
+  CHECK(!bridge.is_child_online(source.humidity));
+  CHECK(bridge.post_humidity(source.humidity, 55.5f));
+  bridge.process();
+  CHECK(humidity->IsReachable());
+  CHECK(humidity->measured_value == 5550u);
+
+  // Children without updates time out
+  bridge.set_link_timeout(1000u);
+  now_ms += 500u;
+  bridge.post_contact(source.contact, false);
+  bridge.process();
+  now_ms += 700u;
+  bridge.process();
+  CHECK(!temperature->IsReachable());
+  CHECK(contact->IsReachable());
+  CHECK(!contact->state_value);
+  now_ms += 400u;
+  bridge.process();
+  CHECK(!contact->IsReachable());
+
+  // Posting fails for invalid children and once the queue is full
+  CHECK(!bridge.post_temperature(-1, 20.0f));
+  CHECK(!bridge.post_temperature(MATTER_BRIDGE_MAX_CHILDREN, 20.0f));
+  for (int i = 0; i < MATTER_BRIDGE_UPDATE_QUEUE_SIZE; i++) {
+    CHECK(bridge.post_temperature(source.temperature, 20.0f));
+  }
+  CHECK(!bridge.post_temperature(source.temperature, 20.0f));
+  CHECK(bridge.get_dropped_update_count() == 1u);
+  bridge.process();
+  CHECK(temperature->measured_value == 2000);
+  CHECK(critical_nesting == 0);
+  CHECK(chip_stack_lock_count == 0);
+
+  bridge.end();
+  CHECK(gDevicePool.live_count == 0u);
+}
+
+static void test_children_released()
+{
+  FakeSource source;
+  MatterBridge bridge;
+  CHECK(bridge.begin(&source));
+  source.post_readings = false;
+  bridge.process();
+  CHECK(endpoints.size() == 3u);
+
+  // Removing a child removes its endpoint and frees its device
+  Device* humidity = endpoints[1];
+  removed_endpoints.clear();
+  bridge.remove_child(source.humidity);
+  CHECK(removed_endpoints.size() == 1u && removed_endpoints[0] == humidity);
+  CHECK(endpoints.size() == 2u);
+  CHECK(gDevicePool.live_count == 2u);
+  CHECK(data_version_storages == 2u);
+  CHECK(bridge.find_child(0xB1ull) == -1);
+  CHECK(!bridge.is_child_online(source.humidity));
+  // Removing it again does nothing
+  bridge.remove_child(source.humidity);
+  CHECK(removed_endpoints.size() == 1u);
+
+  // Queued updates of a removed child don't reach a new child in the same slot
+  CHECK(bridge.post_temperature(source.temperature, 19.0f));
+  CHECK(bridge.post_humidity(source.humidity, 70.0f));
+  bridge.remove_child(source.temperature);
+  int reused = bridge.add_child(MatterBridge::child_temperature, 0xE1ull, "Garage");
+  CHECK(reused == source.temperature);
+  bridge.process();
+  DeviceTempSensor* garage = endpoint_device<DeviceTempSensor>(1);
+  CHECK(garage && strcmp(garage->GetName(), "Garage") == 0);
+  CHECK(garage && garage->update_count == 0u);
+  CHECK(garage && !garage->IsReachable());
+
+  // Children which don't get an endpoint are released
+  max_endpoints = endpoints.size();
+  int pending = bridge.add_child(MatterBridge::child_contact, 0xF1ull, "Window");
+  CHECK(pending >= 0);
+  bridge.process();
+  CHECK(bridge.find_child(0xF1ull) == -1);
+  CHECK(gDevicePool.live_count == 2u);
+  CHECK(data_version_storages == 2u);
+  max_endpoints = MATTER_DYNAMIC_ENDPOINT_POOL_SIZE;
+
+  // Ending the bridge releases the remaining children
+  bridge.end();
+  CHECK(endpoints.empty());
+  CHECK(gDevicePool.live_count == 0u);
+  CHECK(data_version_storages == 0u);
+  CHECK(bridge.add_child(MatterBridge::child_contact, 0xC1ull, "Door") == -1);
+}
+
+int main()
+{
+  test_children_added();
+  add_endpoints_calls = 0u;
+  test_children_updated();
+  test_children_released();
+
+  if (failures) {
+    printf("MatterBridge: %d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("MatterBridge: all checks passed\n");
+  return 0;
+}
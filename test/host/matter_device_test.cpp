@@ -0,0 +1,238 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Host test of the attribute access of devices/MatterDevice.cpp
+// The device is compiled against the stand-ins in chip_stubs/ instead of the CHIP stack.
+// Build and run from this directory:
+//   g++ -std=gnu++17 -Ichip_stubs -I../../libraries/Matter/src matter_device_test.cpp ../../libraries/Matter/src/devices/MatterDevice.cpp -o matter_device_test && ./matter_device_test
+
+#include <cstdio>
+#include <cstring>
+
+#include "devices/MatterDevice.h"
+#include <app-common/zap-generated/callback.h>
+#include <platform/CHIPDeviceLayer.h>
+#include "nvm3_default.h"
+
+using namespace ::chip::app::Clusters;
+
+static int failures = 0;
+
+#define CHECK(condition)                                                   \
+  do {                                                                     \
+    if (!(condition)) {                                                    \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                          \
+    }                                                                      \
+  } while (0)
+
+// Fakes of the platform
+
+static int critical_nesting = 0;
+static int scheduled_work = 0;
+static int identify_changes = 0;
+
+void taskENTER_CRITICAL()
+{
+  critical_nesting++;
+}
+
+void taskEXIT_CRITICAL()
+{
+  critical_nesting--;
+}
+
+CHIP_ERROR chip::DeviceLayer::PlatformManager::ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg)
+{
+  (void)workFunct;
+  (void)arg;
+  scheduled_work++;
+  return CHIP_NO_ERROR;
+}
+
+chip::DeviceLayer::PlatformManager& chip::DeviceLayer::PlatformMgr()
+{
+  static PlatformManager platform_manager;
+  return platform_manager;
+}
+
+CHIP_ERROR chip::System::Layer::StartTimer(Clock::Milliseconds32 delay, TimerCompleteCallback onComplete, void* appState)
+{
+  (void)delay;
+  (void)onComplete;
+  (void)appState;
+  return CHIP_NO_ERROR;
+}
+
+chip::System::Layer& chip::DeviceLayer::SystemLayer()
+{
+  static System::Layer system_layer;
+  return system_layer;
+}
+
+void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId)
+{
+  (void)endpoint;
+  (void)clusterId;
+  (void)attributeId;
+}
+
+void MatterIdentifyClusterServerAttributeChangedCallback(const chip::app::ConcreteAttributePath& attributePath)
+{
+  (void)attributePath;
+  identify_changes++;
+}
+
+nvm3_Handle_t* nvm3_defaultHandle = nullptr;
+
+Ecode_t nvm3_initDefault(void)
+{
+  return 1u;
+}
+
+Ecode_t nvm3_getObjectInfo(nvm3_Handle_t* h, nvm3_ObjectKey_t key, uint32_t* type, size_t* len)
+{
+  (void)h;
+  (void)key;
+  (void)type;
+  (void)len;
+  return 1u;
+}
+
+Ecode_t nvm3_readData(nvm3_Handle_t* h, nvm3_ObjectKey_t key, void* value, size_t len)
+{
+  (void)h;
+  (void)key;
+  (void)value;
+  (void)len;
+  return 1u;
+}
+
+Ecode_t nvm3_writeData(nvm3_Handle_t* h, nvm3_ObjectKey_t key, const void* value, size_t len)
+{
+  (void)h;
+  (void)key;
+  (void)value;
+  (void)len;
+  return 1u;
+}
+
+// A device with one attribute of its own
+
+static constexpr chip::ClusterId kTestClusterId = 0x0402;
+static constexpr chip::AttributeId kTestAttributeId = 0x0000;
+
+class TestDevice : public Device {
+public:
+  TestDevice(const char* device_name) : Device(device_name, kDeviceType_Generic, TestDevice::GetAttributeTable()), value(2150)
+  {
+    ;
+  }
+
+  int16_t value;
+
+private:
+  static AttributeTable GetAttributeTable()
+  {
+    static constexpr AttributeDescriptor table[] = {
+      DEVICE_ATTRIBUTE_READ(TestDevice, kTestClusterId, kTestAttributeId, int16_t, dev->value),
+    };
+    return { table, ArraySize(table) };
+  }
+};
+
+// Tests
+
+static void test_unreachable_device()
+{
+  TestDevice device("Sensor");
+  uint8_t buffer[Device::DeviceDescStrSize];
+
+  // Reachable is read as false - the device starts unreachable
+  memset(buffer, 0xAA, sizeof(buffer));
+  CHECK(device.HandleReadEmberAfAttribute(BridgedDeviceBasicInformation::Id,
+                                          BridgedDeviceBasicInformation::Attributes::Reachable::Id,
+                                          buffer, sizeof(buffer)) == EMBER_ZCL_STATUS_SUCCESS);
+  CHECK(buffer[0] == 0u);
+
+  // The rest of the common attributes are served as well
+  CHECK(device.HandleReadEmberAfAttribute(BridgedDeviceBasicInformation::Id,
+                                          BridgedDeviceBasicInformation::Attributes::NodeLabel::Id,
+                                          buffer, sizeof(buffer)) == EMBER_ZCL_STATUS_SUCCESS);
+  CHECK(buffer[0] == strlen("Sensor") && memcmp(&buffer[1], "Sensor", buffer[0]) == 0);
+  uint16_t identify_time = 5u;
+  memcpy(buffer, &identify_time, sizeof(identify_time));
+  CHECK(device.HandleWriteEmberAfAttribute(Identify::Id, Identify::Attributes::IdentifyTime::Id, buffer) == EMBER_ZCL_STATUS_SUCCESS);
+  CHECK(identify_changes == 1);
+
+  // The attributes of the device itself aren't
+  CHECK(device.HandleReadEmberAfAttribute(kTestClusterId, kTestAttributeId, buffer, sizeof(buffer)) == EMBER_ZCL_STATUS_FAILURE);
+}
+
+static void test_reachable_device()
+{
+  TestDevice device("Sensor");
+  uint8_t buffer[Device::DeviceDescStrSize];
+
+  device.SetReachable(true);
+  CHECK(scheduled_work > 0);
+  CHECK(critical_nesting == 0);
+
+  memset(buffer, 0xAA, sizeof(buffer));
+  CHECK(device.HandleReadEmberAfAttribute(BridgedDeviceBasicInformation::Id,
+                                          BridgedDeviceBasicInformation::Attributes::Reachable::Id,
+                                          buffer, sizeof(buffer)) == EMBER_ZCL_STATUS_SUCCESS);
+  CHECK(buffer[0] == 1u);
+
+  int16_t value = 0;
+  CHECK(device.HandleReadEmberAfAttribute(kTestClusterId, kTestAttributeId, buffer, sizeof(buffer)) == EMBER_ZCL_STATUS_SUCCESS);
+  memcpy(&value, buffer, sizeof(value));
+  CHECK(value == 2150);
+
+  // Too small buffers and unknown attributes fail
+  CHECK(device.HandleReadEmberAfAttribute(kTestClusterId, kTestAttributeId, buffer, 1u) == EMBER_ZCL_STATUS_FAILURE);
+  CHECK(device.HandleReadEmberAfAttribute(kTestClusterId, 0x1234, buffer, sizeof(buffer)) == EMBER_ZCL_STATUS_FAILURE);
+
+  // Going offline is read back through Reachable
+  device.SetReachable(false);
+  CHECK(device.HandleReadEmberAfAttribute(BridgedDeviceBasicInformation::Id,
+                                          BridgedDeviceBasicInformation::Attributes::Reachable::Id,
+                                          buffer, sizeof(buffer)) == EMBER_ZCL_STATUS_SUCCESS);
+  CHECK(buffer[0] == 0u);
+}
+
+int main()
+{
+  test_unreachable_device();
+  test_reachable_device();
+
+  if (failures) {
+    printf("MatterDevice: %d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("MatterDevice: all checks passed\n");
+  return 0;
+}
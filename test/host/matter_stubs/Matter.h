@@ -0,0 +1,160 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2024 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Host stand-in for the Matter library headers used by MatterBridge.cpp
+// Only the declarations the bridge uses are provided - they're implemented
+// by the fakes in matter_bridge_test.cpp.
+
+#ifndef MATTER_H
+#define MATTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+
+// Arduino and FreeRTOS
+uint32_t millis();
+void taskENTER_CRITICAL();
+void taskEXIT_CRITICAL();
+
+// CHIP stack
+namespace chip {
+typedef uint16_t EndpointId;
+typedef uint32_t DataVersion;
+
+template<typename T>
+class Span {
+public:
+  Span() : data_ptr(nullptr), data_size(0u)
+  {
+    ;
+  }
+  Span(T* data, size_t size) : data_ptr(data), data_size(size)
+  {
+    ;
+  }
+  T* data() const
+  {
+    return this->data_ptr;
+  }
+  size_t size() const
+  {
+    return this->data_size;
+  }
+
+private:
+  T* data_ptr;
+  size_t data_size;
+};
+
+namespace app {
+namespace Clusters {
+} // namespace Clusters
+} // namespace app
+} // namespace chip
+
+using namespace ::chip;
+
+class PlatformManager {
+public:
+  void LockChipStack();
+  void UnlockChipStack();
+};
+PlatformManager& PlatformMgr();
+
+typedef struct {
+  uint8_t clusterCount;
+} EmberAfEndpointType;
+
+typedef struct {
+  uint16_t deviceId;
+  uint8_t deviceVersion;
+} EmberAfDeviceType;
+
+// Device
+class Device {
+public:
+  Device(const char* device_name);
+  virtual ~Device();
+  void SetReachable(bool reachable);
+  bool IsReachable();
+  void SetProductName(const char* productname);
+  void SetSerialNumber(const char* serialnumber);
+  const char* GetName();
+  const char* GetSerialNumber();
+
+private:
+  char name[32];
+  char serial_number[32];
+  bool reachable;
+};
+
+// Dynamic endpoints
+#define MATTER_DYNAMIC_ENDPOINT_POOL_SIZE 4
+#define MATTER_AGGREGATOR_ENDPOINT_ID 1
+
+class DevicePool {
+public:
+  template<typename T, typename ... Args>
+  T* create(Args&& ... args)
+  {
+    if (this->live_count >= MATTER_DYNAMIC_ENDPOINT_POOL_SIZE) {
+      return nullptr;
+    }
+    this->live_count++;
+    return new T(std::forward<Args>(args) ...);
+  }
+  void destroy(Device* device);
+  size_t live_count = 0u;
+};
+extern DevicePool gDevicePool;
+
+DataVersion* AllocateDataVersionStorage(size_t cluster_count);
+void FreeDataVersionStorage(DataVersion* storage);
+void DestroyDevice(Device* dev);
+
+typedef struct {
+  Device* dev;
+  const EmberAfEndpointType* ep;
+  Span<const EmberAfDeviceType> deviceTypeList;
+  Span<DataVersion> dataVersionStorage;
+  chip::EndpointId parentEndpointId;
+  int result;
+} DeviceEndpointRequest;
+
+size_t AddDeviceEndpoints(DeviceEndpointRequest* requests, size_t count);
+int RemoveDeviceEndpoint(Device* dev);
+
+extern const EmberAfEndpointType tempMeasurementEndpointType;
+extern const EmberAfEndpointType humidityMeasurementEndpointType;
+extern const EmberAfEndpointType contactSensorEndpointType;
+extern const EmberAfDeviceType gTempSensorDeviceTypes[];
+extern const EmberAfDeviceType gHumiditySensorDeviceTypes[];
+extern const EmberAfDeviceType gContactSensorDeviceTypes[];
+
+#endif // MATTER_H
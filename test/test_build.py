@@ -58,6 +58,18 @@ boards_with_dac = [
     ["xg24devkit", "matter"],
 ]
 
+boards_with_low_power_serial = [
+    ["nano_matter", "none"],
+    ["nano_matter", "ble"],
+    ["nano_matter", "matter"],
+    ["thingplusmatter", "none"],
+    ["thingplusmatter", "ble"],
+    ["thingplusmatter", "matter"],
+    ["xg24explorerkit", "none"],
+    ["xg24explorerkit", "ble"],
+    ["xg24explorerkit", "matter"],
+]
+
 all_matter = [
     ["nano_matter", "matter"],
     ["thingplusmatter", "matter"],
@@ -85,6 +97,13 @@ testlist_ble = {
     "../libraries/SiliconLabs/examples/ble_thingplus_battery_gauge/ble_thingplus_battery_gauge.ino":                thingplusmatter_ble,
     "../libraries/SiliconLabs/examples/ble_xg27_devkit_sensors/ble_xg27_devkit_sensors.ino":                        xg27devkit_ble,
     "../libraries/SiliconLabs/examples/dac_sawtooth/dac_sawtooth.ino":                                              boards_with_dac,
+    "../libraries/SiliconLabs/examples/serial_frame_receive/serial_frame_receive.ino":                              all_variants,
+    "../libraries/SiliconLabs/examples/serial_low_power_receive/serial_low_power_receive.ino":                      boards_with_low_power_serial,
+    "../libraries/SiliconLabs/examples/spi_follower/spi_follower.ino":                                              all_variants,
+    "../libraries/SiliconLabs/examples/spi_multiple_devices/spi_multiple_devices.ino":                              all_variants,
+    "../libraries/SiliconLabs/examples/spi_queued_transactions/spi_queued_transactions.ino":                        all_variants,
+    "../libraries/SiliconLabs/examples/wire_async_transfers/wire_async_transfers.ino":                              all_variants,
+    "../libraries/SiliconLabs/examples/wire_follower_registers/wire_follower_registers.ino":                        all_variants,
     "../libraries/SiliconLabs/examples/xg27devkit_sensors/xg27devkit_sensors.ino":                                  xg27devkit_ble,
     "../libraries/SiliconLabs/examples/thingplusmatter_debug_unix/thingplusmatter_debug_unix.ino":                  all_ble,
     "../libraries/SiliconLabs/examples/thingplusmatter_debug_win/thingplusmatter_debug_win.ino":                    all_ble,
@@ -98,6 +117,10 @@ testlist_ble = {
     "../libraries/ezWS2812/examples/blink_all/blink_all.ino":                                                       all_variants,
     "../libraries/ezWS2812/examples/colors/colors.ino":                                                             all_variants,
     "../libraries/ezWS2812/examples/individual_leds/individual_leds.ino":                                           all_variants,
+    # ModbusRTU
+    "../libraries/ModbusRTU/examples/modbus_rtu_slave/modbus_rtu_slave.ino":                                         all_variants,
+    # SerialRPC
+    "../libraries/SerialRPC/examples/serial_rpc_basic/serial_rpc_basic.ino":                                         all_variants,
     # Si7210Hall
     "../libraries/Si7210_hall/examples/Si7210_hall_measure/Si7210_hall_measure.ino":                                all_variants,
     # SilabsMicrophonePDM
@@ -106,8 +129,10 @@ testlist_ble = {
 
 testlist_matter = {
     "../libraries/Matter/examples/matter_air_quality_sensor/matter_air_quality_sensor.ino":                         all_matter,
+    "../libraries/Matter/examples/matter_bridge_simulated/matter_bridge_simulated.ino":                             all_matter,
     "../libraries/Matter/examples/matter_contact_sensor/matter_contact_sensor.ino":                                 all_matter,
     "../libraries/Matter/examples/matter_fan/matter_fan.ino":                                                       all_matter,
+    "../libraries/Matter/examples/matter_fast_boot/matter_fast_boot.ino":                                           all_matter,
     "../libraries/Matter/examples/matter_flow_sensor/matter_flow_sensor.ino":                                       all_matter,
     "../libraries/Matter/examples/matter_humidity_sensor/matter_humidity_sensor.ino":                               all_matter,
     "../libraries/Matter/examples/matter_illuminance_sensor/matter_illuminance_sensor.ino":                         all_matter,
@@ -115,7 +140,9 @@ testlist_matter = {
     "../libraries/Matter/examples/matter_lightbulb_color/matter_lightbulb_color.ino":                               all_matter,
     "../libraries/Matter/examples/matter_lightbulb_custom_name/matter_lightbulb_custom_name.ino":                   all_matter,
     "../libraries/Matter/examples/matter_lightbulb_dimmable/matter_lightbulb_dimmable.ino":                         all_matter,
+    "../libraries/Matter/examples/matter_lightbulb_dimmable_fade/matter_lightbulb_dimmable_fade.ino":               all_matter,
     "../libraries/Matter/examples/matter_lightbulb_dimmable_multiple/matter_lightbulb_dimmable_multiple.ino":       all_matter,
+    "../libraries/Matter/examples/matter_lightbulb_events/matter_lightbulb_events.ino":                             all_matter,
     "../libraries/Matter/examples/matter_lightbulb_identify/matter_lightbulb_identify.ino":                         all_matter,
     "../libraries/Matter/examples/matter_lightbulb_multiple/matter_lightbulb_multiple.ino":                         all_matter,
     "../libraries/Matter/examples/matter_lightbulb_multiple_color/matter_lightbulb_multiple_color.ino":             all_matter,
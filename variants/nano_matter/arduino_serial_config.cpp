@@ -25,8 +25,10 @@
  */
 
 #include "arduino_serial_config.h"
+#include <cstring>
 extern "C" {
   #include "em_cmu.h"
+  #include "sl_iostream_eusart.h"
 }
 
 sl_iostream_t* sl_serial_stream_handle = sl_iostream_instance_nanomatter_info.handle;
@@ -78,3 +80,48 @@ void sl_serial1_deinit()
   GPIO->EUSARTROUTE[SL_IOSTREAM_EUSART_NANOMATTER1_PERIPHERAL_NO].CTSROUTE = 0;
   GPIO->EUSARTROUTE[SL_IOSTREAM_EUSART_NANOMATTER1_PERIPHERAL_NO].RTSROUTE = 0;
 }
+
+bool sl_serial1_low_power_init(uint32_t baudrate)
+{
+  static sl_iostream_eusart_context_t low_power_context;
+  static uint8_t low_power_rx_buffer[SL_IOSTREAM_EUSART_NANOMATTER1_RX_BUFFER_SIZE];
+
+  EUSART_UartInit_TypeDef init = EUSART_UART_INIT_DEFAULT_LF;
+  init.baudrate = baudrate;
+  init.parity = SL_IOSTREAM_EUSART_NANOMATTER1_PARITY;
+  init.stopbits = SL_IOSTREAM_EUSART_NANOMATTER1_STOP_BITS;
+
+  // Clock the EUSART from the EM23GRPACLK (LFXO) so that the receiver keeps running in EM2
+  sl_iostream_eusart_config_t eusart_config;
+  memset(&eusart_config, 0, sizeof(eusart_config));
+  eusart_config.eusart = SL_IOSTREAM_EUSART_NANOMATTER1_PERIPHERAL;
+  eusart_config.flow_control = eusartHwFlowControlNone;
+  eusart_config.enable_high_frequency = false;
+  eusart_config.clock = cmuClock_EUSART0;
+  eusart_config.port_index = SL_IOSTREAM_EUSART_NANOMATTER1_PERIPHERAL_NO;
+  eusart_config.tx_port = SL_IOSTREAM_EUSART_NANOMATTER1_TX_PORT;
+  eusart_config.tx_pin = SL_IOSTREAM_EUSART_NANOMATTER1_TX_PIN;
+  eusart_config.rx_port = SL_IOSTREAM_EUSART_NANOMATTER1_RX_PORT;
+  eusart_config.rx_pin = SL_IOSTREAM_EUSART_NANOMATTER1_RX_PIN;
+
+  // The received bytes are moved to the RX ring buffer by the LDMA without waking up the CPU
+  sl_iostream_uart_config_t uart_config;
+  memset(&uart_config, 0, sizeof(uart_config));
+  uart_config.dma_cfg.peripheral_signal = dmadrvPeripheralSignal_EUSART0_RXDATAV;
+  uart_config.dma_cfg.src = (uint8_t*)&SL_IOSTREAM_EUSART_NANOMATTER1_PERIPHERAL->RXDATA;
+  uart_config.rx_irq_number = EUSART0_RX_IRQn;
+  uart_config.tx_irq_number = EUSART0_TX_IRQn;
+  uart_config.rx_buffer = low_power_rx_buffer;
+  uart_config.rx_buffer_length = sizeof(low_power_rx_buffer);
+  uart_config.lf_to_crlf = SL_IOSTREAM_EUSART_NANOMATTER1_CONVERT_BY_DEFAULT_LF_TO_CRLF;
+  uart_config.rx_when_sleeping = true;
+  uart_config.sw_flow_control = false;
+
+  // Re-initialize the Serial1 stream in place so that the EUSART0 IRQ handler keeps serving it
+  sl_status_t status = sl_iostream_eusart_init(sl_serial1_instance_handle,
+                                               &uart_config,
+                                               &init,
+                                               &eusart_config,
+                                               &low_power_context);
+  return status == SL_STATUS_OK;
+}
@@ -73,8 +73,3 @@ SPIDRV_Init_t sl_spidrv_config_spi1 = {
   .csControl = SL_SPIDRV_EUSART_NANOMATTER1_CS_CONTROL,
   .slaveStartMode = SL_SPIDRV_EUSART_NANOMATTER1_SLAVE_START_MODE,
 };
-
-uint8_t sl_spi_direct_transfer(void* spi_peripheral, uint8_t data)
-{
-  return EUSART_Spi_TxRx((EUSART_TypeDef*)spi_peripheral, (uint16_t)data);
-}
@@ -58,4 +58,8 @@ void sl_serial1_set_baud_rate(uint32_t baudrate);
 void sl_serial1_init();
 void sl_serial1_deinit();
 
+// Serial1 is on EUSART0 which can keep receiving in EM2 when clocked from the LFXO
+#define SL_SERIAL1_LOW_POWER_CAPABLE
+bool sl_serial1_low_power_init(uint32_t baudrate);
+
 #endif // ARDUINO_SERIAL_CONFIG_H
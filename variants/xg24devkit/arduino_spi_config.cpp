@@ -49,8 +49,3 @@ SPIDRV_Init_t sl_spidrv_config = {
   .csControl = SL_SPIDRV_EUSART_EXP_CS_CONTROL,
   .slaveStartMode = SL_SPIDRV_EUSART_EXP_SLAVE_START_MODE,
 };
-
-uint8_t sl_spi_direct_transfer(void* spi_peripheral, uint8_t data)
-{
-  return EUSART_Spi_TxRx((EUSART_TypeDef*)spi_peripheral, (uint16_t)data);
-}
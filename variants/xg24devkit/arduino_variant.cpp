@@ -38,23 +38,8 @@ extern "C" {
 
 #ifdef ARDUINO_MATTER
 
-#include "AppConfig.h"
-#include <DeviceInfoProviderImpl.h>
-#include <MatterConfig.h>
-#include <app/server/Server.h>
 #include <platform/silabs/platformAbstraction/SilabsPlatform.h>
-#include <provision/ProvisionManager.h>
 
-#ifdef BLE_DEV_NAME
-#undef BLE_DEV_NAME
-#endif
-#define BLE_DEV_NAME "Arduino Matter device"
-
-static chip::DeviceLayer::DeviceInfoProviderImpl gExampleDeviceInfoProvider;
-
-using namespace ::chip;
-using namespace ::chip::DeviceLayer;
-using namespace ::chip::Credentials;
 using namespace chip::DeviceLayer::Silabs;
 
 #else //ARDUINO_MATTER
@@ -68,30 +53,23 @@ extern "C" {
 void init_arduino_variant()
 {
   #ifdef ARDUINO_MATTER
-  // Initialize the Matter stack
+  // Initialize the Matter platform
   GetPlatform().Init();
+  bootPhaseEnd(BOOT_PHASE_PLATFORM_INIT);
 
-  if (Provision::Manager::GetInstance().ProvisionRequired()) {
-    Provision::Manager::GetInstance().Start();
-  } else {
-    if (SilabsMatterConfig::InitMatter(BLE_DEV_NAME) != CHIP_NO_ERROR) {
-      appError(CHIP_ERROR_INTERNAL);
-    }
-    gExampleDeviceInfoProvider.SetStorageDelegate(&chip::Server::GetInstance().GetPersistentStorage());
-    chip::DeviceLayer::SetDeviceInfoProvider(&gExampleDeviceInfoProvider);
-
-    chip::DeviceLayer::PlatformMgr().LockChipStack();
-    // Initialize device attestation config
-    SetDeviceAttestationCredentialsProvider(&Provision::Manager::GetInstance().GetStorage());
-    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+  // In fast boot mode the Matter stack is initialized by a task running concurrently with setup()
+  if (!matterFastBootEnabled()) {
+    init_arduino_matter();
   }
 
   #else //ARDUINO_MATTER
 
   sl_system_init();
+  bootPhaseEnd(BOOT_PHASE_PLATFORM_INIT);
 
   #endif //ARDUINO_MATTER
 
+  bootPhaseStart(BOOT_PHASE_PERIPHERAL_DEINIT);
   // Disable SWO by default and allow PA3 to be used as a GPIO pin
   GPIO_DbgSWOEnable(false);
 
@@ -107,6 +85,7 @@ void init_arduino_variant()
   Serial.end();
   I2C_Deinit(SL_I2C_PERIPHERAL); // Wire.end()
   SPIDRV_DeInit(SL_SPIDRV_PERIPHERAL_HANDLE); //SPI.end();
+  bootPhaseEnd(BOOT_PHASE_PERIPHERAL_DEINIT);
 }
 
 // Variant pin mapping - maps Arduino pin numbers to Silabs ports/pins
@@ -46,6 +46,4 @@ extern SPIDRV_Init_t sl_spidrv_config;
 extern SPIDRV_Init_t sl_spidrv_config_spi1;
 #define SL_SPIDRV1_PERIPHERAL_HANDLE sl_spidrv_eusart_xg24explorerkit1_handle
 
-uint8_t sl_spi_direct_transfer(void* spi_peripheral, uint8_t data);
-
 #endif // ARDUINO_SPI_CONFIG_H
@@ -38,6 +38,4 @@ extern "C" {
 extern SPIDRV_Init_t sl_spidrv_config;
 #define SL_SPIDRV_PERIPHERAL_HANDLE sl_spidrv_eusart_exp_handle
 
-uint8_t sl_spi_direct_transfer(void* spi_peripheral, uint8_t data);
-
 #endif // ARDUINO_SPI_CONFIG_H
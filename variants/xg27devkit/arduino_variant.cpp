@@ -41,7 +41,9 @@ extern "C" {
 void init_arduino_variant()
 {
   sl_system_init();
+  bootPhaseEnd(BOOT_PHASE_PLATFORM_INIT);
 
+  bootPhaseStart(BOOT_PHASE_PERIPHERAL_DEINIT);
   // Disable SWO by default and allow PA3 to be used as a GPIO pin
   GPIO_DbgSWOEnable(false);
 
@@ -58,6 +60,7 @@ void init_arduino_variant()
   Serial1.end();
   I2C_Deinit(SL_I2C_PERIPHERAL); // Wire.end()
   SPIDRV_DeInit(SL_SPIDRV_PERIPHERAL_HANDLE); //SPI.end();
+  bootPhaseEnd(BOOT_PHASE_PERIPHERAL_DEINIT);
 }
 
 // Variant pin mapping - maps Arduino pin numbers to Silabs ports/pins